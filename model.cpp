@@ -1,35 +1,45 @@
 ///
 // \file model.cpp
 // \brief P3 Model Library Implementation
-// \details Simple implementation for the P3 Model library
+// \details Library lifetime and identification
 //
 
 #include "model.h"
 
 namespace ultralove::p3::model {
-// Simple placeholder implementation for library functionality
-namespace {
-bool g_initialized = false;
-} // namespace
-
-bool Model::Initialize()
+bool Model::Initialize(const size_t concurrency)
 {
-    g_initialized = true;
+    // A pool left by an earlier call stays, one created here is released again if the engine fails
+    const bool pooled = runtime::StringPool::IsInitialized();
+    if (runtime::StringPool::Initialize() == false) {
+        return false;
+    }
+    if (BuildEngine::Initialize(concurrency) == false) {
+        if (pooled == false) {
+            runtime::StringPool::Shutdown();
+        }
+        return false;
+    }
     return true;
 }
 
 void Model::Shutdown()
 {
-    g_initialized = false;
+    // Builds may still intern strings, so the workers stop first
+    BuildEngine::Shutdown();
+
+    // Interned strings handed out so far become invalid here
+    runtime::StringPool::Shutdown();
 }
 
 runtime::String Model::GetVersion()
 {
-    return runtime::String{}; // Placeholder until String is fully implemented
+    // Injected by the build from version.in
+    return runtime::String(P3_MODEL_VERSION);
 }
 
 runtime::String Model::GetLibraryName()
 {
-    return runtime::String{}; // Placeholder until String is fully implemented
+    return runtime::String("p3-model");
 }
 } // namespace ultralove::p3::model
@@ -10,14 +10,34 @@
 #pragma pack(push, 8)
 
 // Include all utility structs
+#include "runtimearena.h"
+#include "runtimeconcurrentmap.h"
 #include "runtimeguid.h"
+#include "runtimehasher.h"
+#include "runtimejsonreader.h"
+#include "runtimejsonwriter.h"
+#include "runtimemappedfile.h"
+#include "runtimeoutputsink.h"
 #include "runtimestring.h"
+#include "runtimestringpool.h"
+#include "runtimetaskpool.h"
+#include "runtimetextdictionary.h"
+#include "runtimetextstore.h"
 #include "runtimetimespan.h"
 #include "runtimetimestamp.h"
+#include "runtimexmlreader.h"
+#include "runtimexmlwriter.h"
 
 // Include all P3 model classes
 #include "modelasset.h"
+#include "modelbuildengine.h"
+#include "modelcatalog.h"
+#include "modelcatalogindex.h"
+#include "modelchapter.h"
+#include "modelchapterreader.h"
 #include "modelchaptertag.h"
+#include "modelchapterwriter.h"
+#include "modelcontenthash.h"
 #include "modelcontribution.h"
 #include "modelcontributor.h"
 #include "modelcontributorpresence.h"
@@ -25,18 +45,39 @@
 #include "modelcontributorrole.h"
 #include "modelenclosure.h"
 #include "modelenclosuretype.h"
+#include "modelentityhandle.h"
+#include "modelentityregistry.h"
 #include "modelepisode.h"
+#include "modelepisodestore.h"
 #include "modelepisodetype.h"
 #include "modelfabric.h"
+#include "modelfeedreader.h"
+#include "modelfeedwindow.h"
+#include "modelfeedwriter.h"
+#include "modeljsonfeedreader.h"
+#include "modeljsonfeedwriter.h"
+#include "modellazytext.h"
+#include "modellocationindex.h"
 #include "modellocationtag.h"
+#include "modelmodification.h"
 #include "modelpicture.h"
 #include "modelpicturetype.h"
 #include "modelpodcast.h"
+#include "modelpodcastdiff.h"
+#include "modelpodcastversion.h"
 #include "modelpublisher.h"
 #include "modelseason.h"
+#include "modelsearchindex.h"
+#include "modelsnapshot.h"
+#include "modelsnapshotformat.h"
+#include "modelsnapshotview.h"
 #include "modeltag.h"
 #include "modeltagreference.h"
 #include "modeltagreferencetype.h"
+#include "modeltimelineindex.h"
+#include "modeltranscript.h"
+#include "modeltranscriptformat.h"
+#include "modeltranscriptreader.h"
 #include "modeltranscripttag.h"
 
 namespace ultralove::p3::model {
@@ -56,10 +97,16 @@ struct Model
     static runtime::String GetLibraryName();
 
     /// \brief Initialize the P3 Model library
-    /// \return True if initialization was successful, false otherwise
-    static bool Initialize();
+    /// \details Creates the process-wide StringPool used by runtime::String::Intern() and starts the
+    /// workers of the BuildEngine
+    /// \param concurrency Maximum number of build worker threads, 0 for one per hardware thread
+    /// \return True if initialization was successful; false otherwise, a StringPool created by this
+    /// call is then released again
+    static bool Initialize(const size_t concurrency = 0);
 
     /// \brief Cleanup and shutdown the P3 Model library
+    /// \details Waits for a running build, stops the BuildEngine and releases the StringPool;
+    /// interned strings must not be used afterwards
     static void Shutdown();
 
     // Deleted constructors and assignment operators - this is a utility struct
@@ -0,0 +1,180 @@
+///
+// \file modelbuildengine.cpp
+// \brief P3 Model Build Engine implementation
+// \details Process-wide task pool and parallel feed generation
+//
+
+#include "modelbuildengine.h"
+
+#include "modelfeedwriter.h"
+#include "runtimeoutputsink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace ultralove::p3::model {
+namespace {
+// Serializes builds with each other and with Initialize() and Shutdown()
+std::mutex g_mutex;
+std::atomic<runtime::TaskPool*> g_pool{nullptr};
+
+size_t CountEpisodes(const Podcast& podcast) noexcept
+{
+    size_t count = 0;
+    for (const Season& season : podcast.seasons) {
+        count += season.episodes.size();
+    }
+    return count;
+}
+
+bool IsSplit(const Podcast& podcast, const runtime::TaskContext& context) noexcept
+{
+    return (context.pool != nullptr) && (podcast.seasons.size() > 1) && (CountEpisodes(podcast) >= BuildEngine::SEASON_SPLIT_THRESHOLD);
+}
+} // namespace
+
+bool BuildEngine::Initialize(const size_t concurrency)
+{
+    const std::lock_guard<std::mutex> lock(g_mutex);
+    runtime::TaskPool* pool = g_pool.load(std::memory_order_acquire);
+    if ((pool != nullptr) && ((concurrency == 0) || (pool->GetConcurrency() == concurrency))) {
+        return true;
+    }
+    // A different concurrency limit restarts the workers
+    delete g_pool.exchange(nullptr, std::memory_order_acq_rel);
+    try {
+        g_pool.store(new runtime::TaskPool(concurrency), std::memory_order_release);
+    }
+    catch (const std::system_error&) {
+        // The system refused another thread
+        return false;
+    }
+    catch (const std::bad_alloc&) {
+        return false;
+    }
+    return true;
+}
+
+void BuildEngine::Shutdown()
+{
+    const std::lock_guard<std::mutex> lock(g_mutex);
+    delete g_pool.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+bool BuildEngine::IsInitialized() noexcept
+{
+    return g_pool.load(std::memory_order_acquire) != nullptr;
+}
+
+size_t BuildEngine::GetConcurrency()
+{
+    const std::lock_guard<std::mutex> lock(g_mutex);
+    const runtime::TaskPool* pool = g_pool.load(std::memory_order_acquire);
+    return (pool != nullptr) ? pool->GetConcurrency() : 1;
+}
+
+void BuildEngine::Build(std::span<const Podcast> podcasts, const PodcastTask& task)
+{
+    // A build started from a task cannot take the lock held by the outer build, and need not
+    runtime::TaskPool* pool = g_pool.load(std::memory_order_acquire);
+    if (runtime::TaskContext* context = (pool != nullptr) ? pool->GetCurrentContext() : nullptr) {
+        for (size_t i = 0; i < podcasts.size(); ++i) {
+            task(podcasts[i], i, *context);
+        }
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(g_mutex);
+    pool = g_pool.load(std::memory_order_acquire);
+    if (pool == nullptr) {
+        runtime::TaskContext context;
+        for (size_t i = 0; i < podcasts.size(); ++i) {
+            task(podcasts[i], i, context);
+        }
+        return;
+    }
+
+    // Largest podcasts first, so no worker picks up a huge one at the very end
+    std::vector<size_t> order(podcasts.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::vector<size_t> sizes(podcasts.size());
+    for (size_t i = 0; i < podcasts.size(); ++i) {
+        sizes[i] = CountEpisodes(podcasts[i]);
+    }
+    std::stable_sort(order.begin(), order.end(), [&sizes](const size_t lhs, const size_t rhs) {
+        return sizes[lhs] > sizes[rhs];
+    });
+
+    runtime::TaskGroup group;
+    for (const size_t index : order) {
+        pool->Run(group, [&task, &podcasts, index](runtime::TaskContext& context) {
+            task(podcasts[index], index, context);
+        });
+    }
+    try {
+        pool->Wait(group);
+    }
+    catch (...) {
+        pool->ResetArenas();
+        throw;
+    }
+    pool->ResetArenas();
+}
+
+void BuildEngine::ForEachSeason(const Podcast& podcast, runtime::TaskContext& context, const SeasonTask& task)
+{
+    if (IsSplit(podcast, context) == false) {
+        for (size_t i = 0; i < podcast.seasons.size(); ++i) {
+            task(podcast.seasons[i], i, context);
+        }
+        return;
+    }
+
+    runtime::TaskGroup group;
+    for (size_t i = 0; i < podcast.seasons.size(); ++i) {
+        context.pool->Run(group, [&task, &podcast, i](runtime::TaskContext& seasonContext) {
+            task(podcast.seasons[i], i, seasonContext);
+        });
+    }
+    context.pool->Wait(group);
+}
+
+bool BuildEngine::WriteFeeds(std::span<const Podcast> podcasts, const FeedConsumer& consumer)
+{
+    std::atomic<bool> good{true};
+    Build(podcasts, [&consumer, &good](const Podcast& podcast, const size_t index, runtime::TaskContext& context) {
+        if (IsSplit(podcast, context) == false) {
+            context.buffer.clear();
+            runtime::StringOutputSink sink(context.buffer);
+            FeedWriter writer(sink);
+            if ((writer.Write(podcast) == false) || (consumer(podcast, index, context.buffer) == false)) {
+                good.store(false);
+            }
+            return;
+        }
+
+        // Items are rendered per season in parallel and spliced between head and tail; waiting for
+        // the seasons may run other tasks on this worker, so its buffer is only used afterwards
+        std::vector<std::string> items(podcast.seasons.size());
+        ForEachSeason(podcast, context, [&items](const Season& season, const size_t seasonIndex, runtime::TaskContext&) {
+            runtime::StringOutputSink sink(items[seasonIndex]);
+            FeedWriter writer(sink);
+            writer.WriteItems(season, season.episodes);
+        });
+
+        context.buffer.clear();
+        runtime::StringOutputSink sink(context.buffer);
+        FeedWriter writer(sink);
+        if ((writer.Write(podcast, items) == false) || (consumer(podcast, index, context.buffer) == false)) {
+            good.store(false);
+        }
+    });
+    return good.load();
+}
+} // namespace ultralove::p3::model
@@ -0,0 +1,99 @@
+///
+// \file modelbuildengine.h
+// \brief P3 Model Build Engine
+// \details Parallel generation of feeds, snapshots and indexes for a catalog
+//
+
+#ifndef __P3_MODEL_BUILD_ENGINE_H_INCL__
+#define __P3_MODEL_BUILD_ENGINE_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelpodcast.h"
+#include "modelseason.h"
+#include "runtimetaskpool.h"
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string_view>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Process-wide parallel build engine
+/// \details Runs per-podcast work of a catalog build, such as writing feeds, snapshots or indexes,
+/// on a work-stealing runtime::TaskPool. Every podcast is a task; ForEachSeason() splits a large
+/// podcast further into one task per season, which idle workers steal, so a catalog with a few
+/// huge podcasts still keeps all workers busy. Tasks receive the runtime::TaskContext of their
+/// worker with its arena and output buffer.
+///
+/// The engine is created by Model::Initialize() and destroyed by Model::Shutdown(). Builds from
+/// several threads run one after another; worker arenas are reset when a build finishes. While the
+/// engine is not initialized, builds run on the calling thread.
+struct BuildEngine
+{
+    /// \brief Work for one podcast
+    using PodcastTask = std::function<void(const Podcast& podcast, const size_t index, runtime::TaskContext& context)>;
+
+    /// \brief Work for one season
+    using SeasonTask = std::function<void(const Season& season, const size_t index, runtime::TaskContext& context)>;
+
+    /// \brief Consumer of a finished feed, called concurrently from the workers
+    using FeedConsumer = std::function<bool(const Podcast& podcast, const size_t index, const std::string_view feed)>;
+
+    /// \brief Number of episodes from which ForEachSeason() runs seasons in parallel
+    static constexpr size_t SEASON_SPLIT_THRESHOLD = 256;
+
+    /// \brief Create the process-wide engine
+    /// \param concurrency Maximum number of worker threads, 0 for one per hardware thread
+    /// \return True if the engine is available, also when it already was; false if the workers could
+    /// not be started, the engine is then not available
+    static bool Initialize(const size_t concurrency = 0);
+
+    /// \brief Destroy the process-wide engine after the running build finished
+    static void Shutdown();
+
+    /// \brief Check whether the engine is available
+    /// \return True between Initialize() and Shutdown()
+    static bool IsInitialized() noexcept;
+
+    /// \brief Get the number of worker threads
+    /// \return Number of workers, 1 while the engine is not initialized
+    static size_t GetConcurrency();
+
+    /// \brief Run a task for every podcast of a catalog and wait for all of them
+    /// \details Called from within a task, the podcasts run on the calling worker. An exception
+    /// thrown by a task is rethrown after all tasks finished.
+    /// \param podcasts Catalog
+    /// \param task Work for one podcast
+    static void Build(std::span<const Podcast> podcasts, const PodcastTask& task);
+
+    /// \brief Run a task for every season of a podcast and wait for all of them
+    /// \details Seasons run in parallel if the podcast has more than one season and at least
+    /// SEASON_SPLIT_THRESHOLD episodes, otherwise in order on the calling worker.
+    /// \param podcast Podcast
+    /// \param context Context of the calling task
+    /// \param task Work for one season
+    static void ForEachSeason(const Podcast& podcast, runtime::TaskContext& context, const SeasonTask& task);
+
+    /// \brief Write the RSS feeds of a catalog in parallel
+    /// \details Every feed is rendered into the output buffer of its worker and handed to the
+    /// consumer; the items of large podcasts are rendered season by season in parallel. The bytes
+    /// are the same FeedWriter::Write() produces.
+    /// \param podcasts Catalog
+    /// \param consumer Receives every feed, e.g. to write it to a file
+    /// \return True if the consumer accepted all feeds
+    static bool WriteFeeds(std::span<const Podcast> podcasts, const FeedConsumer& consumer);
+
+    // Deleted constructors and assignment operators - this is a utility struct
+    BuildEngine()                              = delete;
+    virtual ~BuildEngine()                     = delete;
+    BuildEngine(const BuildEngine&)            = delete;
+    BuildEngine& operator=(const BuildEngine&) = delete;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_BUILD_ENGINE_H_INCL__
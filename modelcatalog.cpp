@@ -0,0 +1,146 @@
+///
+// \file modelcatalog.cpp
+// \brief P3 Model Catalog implementation
+// \details Podcast replacement with incremental episode mapping
+//
+
+#include "modelcatalog.h"
+
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+namespace ultralove::p3::model {
+Catalog::Catalog(const size_t shardCount) :
+    podcasts_(shardCount), episodes_(shardCount), contributors_(shardCount), publishers_(shardCount)
+{
+}
+
+std::mutex& Catalog::GetPodcastLock(const runtime::Guid& id) noexcept
+{
+    return podcastLocks_[std::hash<runtime::Guid>{}(id) % PODCAST_LOCK_COUNT];
+}
+
+void Catalog::PutPodcasts(std::span<const std::shared_ptr<const PodcastVersion>> podcasts)
+{
+    for (const auto& podcast : podcasts) {
+        if ((podcast == nullptr) || podcast->GetFields().id.IsNil()) {
+            continue;
+        }
+        const std::lock_guard<std::mutex> lock(GetPodcastLock(podcast->GetFields().id));
+        const std::shared_ptr<const PodcastVersion> previous = podcasts_.Put(podcast->GetFields().id, podcast);
+        Replace(previous.get(), *podcast);
+    }
+}
+
+void Catalog::Replace(const PodcastVersion* previous, const PodcastVersion& next)
+{
+    // Episodes of the previous version by identifier; whatever is left at the end was removed
+    std::unordered_map<runtime::Guid, std::pair<const Episode*, runtime::Guid>> existing;
+    if (previous != nullptr) {
+        for (size_t i = 0; i < previous->GetSeasonCount(); ++i) {
+            const SeasonVersion& season = previous->GetSeason(i);
+            for (size_t j = 0; j < season.GetEpisodeCount(); ++j) {
+                existing.emplace(season.GetEpisode(j).id, std::make_pair(&season.GetEpisode(j), season.GetFields().id));
+            }
+        }
+    }
+
+    const runtime::Guid& podcast = next.GetFields().id;
+    std::vector<std::pair<runtime::Guid, CatalogEpisode>> changed;
+    for (size_t i = 0; i < next.GetSeasonCount(); ++i) {
+        const SeasonVersion& season = next.GetSeason(i);
+        for (size_t j = 0; j < season.GetEpisodeCount(); ++j) {
+            const std::shared_ptr<const Episode>& episode = season.GetSharedEpisode(j);
+            if (episode->id.IsNil()) {
+                continue;
+            }
+            const auto it        = existing.find(episode->id);
+            const bool unchanged = (it != existing.end()) && (it->second.first == episode.get()) && (it->second.second == season.GetFields().id);
+            if (it != existing.end()) {
+                existing.erase(it);
+            }
+            if (unchanged == false) {
+                changed.emplace_back(episode->id, CatalogEpisode{episode, podcast, season.GetFields().id});
+            }
+        }
+    }
+    episodes_.Put(changed);
+
+    std::vector<runtime::Guid> removed;
+    removed.reserve(existing.size());
+    for (const auto& [id, entry] : existing) {
+        removed.push_back(id);
+    }
+    RemoveEpisodes(podcast, removed);
+
+    const Publisher& publisher = next.GetFields().publisher;
+    if ((publisher.id.IsNil() == false) &&
+        ((previous == nullptr) || (previous->GetFields().publisher.id != publisher.id) ||
+            (previous->GetFields().publisher.modificationDate != publisher.modificationDate))) {
+        publishers_.Put(publisher.id, std::make_shared<const Publisher>(publisher));
+    }
+}
+
+void Catalog::RemoveEpisodes(const runtime::Guid& podcast, const std::vector<runtime::Guid>& episodes)
+{
+    for (const runtime::Guid& id : episodes) {
+        // The episode may have moved to another podcast in the meantime, checked under the shard lock
+        episodes_.RemoveIf(id, [&podcast](const CatalogEpisode& current) {
+            return current.podcast == podcast;
+        });
+    }
+}
+
+void Catalog::PutContributors(std::span<const Contributor> contributors)
+{
+    std::vector<std::pair<runtime::Guid, std::shared_ptr<const Contributor>>> entries;
+    entries.reserve(contributors.size());
+    for (const Contributor& contributor : contributors) {
+        if (contributor.id.IsNil() == false) {
+            entries.emplace_back(contributor.id, std::make_shared<const Contributor>(contributor));
+        }
+    }
+    contributors_.Put(entries);
+}
+
+void Catalog::PutPublishers(std::span<const Publisher> publishers)
+{
+    std::vector<std::pair<runtime::Guid, std::shared_ptr<const Publisher>>> entries;
+    entries.reserve(publishers.size());
+    for (const Publisher& publisher : publishers) {
+        if (publisher.id.IsNil() == false) {
+            entries.emplace_back(publisher.id, std::make_shared<const Publisher>(publisher));
+        }
+    }
+    publishers_.Put(entries);
+}
+
+bool Catalog::RemovePodcast(const runtime::Guid& id)
+{
+    const std::lock_guard<std::mutex> lock(GetPodcastLock(id));
+    const std::shared_ptr<const PodcastVersion> previous = podcasts_.Remove(id);
+    if (previous == nullptr) {
+        return false;
+    }
+    std::vector<runtime::Guid> removed;
+    for (size_t i = 0; i < previous->GetSeasonCount(); ++i) {
+        const SeasonVersion& season = previous->GetSeason(i);
+        for (size_t j = 0; j < season.GetEpisodeCount(); ++j) {
+            removed.push_back(season.GetEpisode(j).id);
+        }
+    }
+    RemoveEpisodes(id, removed);
+    return true;
+}
+
+bool Catalog::RemoveContributor(const runtime::Guid& id)
+{
+    return contributors_.Remove(id) != nullptr;
+}
+
+bool Catalog::RemovePublisher(const runtime::Guid& id)
+{
+    return publishers_.Remove(id) != nullptr;
+}
+} // namespace ultralove::p3::model
@@ -0,0 +1,182 @@
+///
+// \file modelcatalog.h
+// \brief P3 Model Catalog
+// \details Thread-safe container of all podcasts, episodes, contributors and publishers
+//
+
+#ifndef __P3_MODEL_CATALOG_H_INCL__
+#define __P3_MODEL_CATALOG_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelcontributor.h"
+#include "modelepisode.h"
+#include "modelpodcastversion.h"
+#include "modelpublisher.h"
+#include "runtimeconcurrentmap.h"
+#include "runtimeguid.h"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Episode found in a Catalog
+struct CatalogEpisode
+{
+    /// \brief Episode, shared with the PodcastVersion it belongs to
+    std::shared_ptr<const Episode> episode;
+
+    /// \brief Identifier of the podcast
+    runtime::Guid podcast;
+
+    /// \brief Identifier of the season
+    runtime::Guid season;
+
+    /// \brief Check whether the episode was found
+    explicit operator bool() const noexcept
+    {
+        return episode != nullptr;
+    }
+};
+
+/// \brief Thread-safe catalog of podcasts, episodes, contributors and publishers
+/// \details Maps Fabric::id to immutable entities through runtime::ConcurrentMap, so lookups never
+/// take a lock and writers only lock the shards they change. Podcasts are stored as PodcastVersion;
+/// putting a podcast also maps its episodes and its publisher. Episodes unchanged since the
+/// previous version of their podcast are shared with it and not written again, and episodes that
+/// disappeared from a podcast are removed. Updates of the same podcast are serialized, updates of
+/// different podcasts run in parallel. Entities with a nil identifier are ignored.
+class Catalog
+{
+public:
+    /// \brief Default number of shards of every map
+    static constexpr size_t DEFAULT_SHARD_COUNT = 64;
+
+    /// \brief Create an empty catalog
+    /// \param shardCount Number of shards of every map
+    explicit Catalog(const size_t shardCount = DEFAULT_SHARD_COUNT);
+
+    /// \brief Destroy the catalog
+    virtual ~Catalog() = default;
+
+    Catalog(const Catalog&)            = delete;
+    Catalog& operator=(const Catalog&) = delete;
+
+    /// \brief Insert or replace podcasts together with their episodes and publishers
+    /// \param podcasts Podcast versions
+    void PutPodcasts(std::span<const std::shared_ptr<const PodcastVersion>> podcasts);
+
+    /// \brief Insert or replace a podcast together with its episodes and publisher
+    /// \param podcast Podcast version
+    void PutPodcast(const std::shared_ptr<const PodcastVersion>& podcast)
+    {
+        PutPodcasts(std::span(&podcast, 1));
+    }
+
+    /// \brief Insert or replace contributors
+    /// \param contributors Contributors
+    void PutContributors(std::span<const Contributor> contributors);
+
+    /// \brief Insert or replace publishers
+    /// \param publishers Publishers
+    void PutPublishers(std::span<const Publisher> publishers);
+
+    /// \brief Remove a podcast and its episodes
+    /// \param id Identifier of the podcast
+    /// \return True if the podcast was removed
+    bool RemovePodcast(const runtime::Guid& id);
+
+    /// \brief Remove a contributor
+    /// \param id Identifier of the contributor
+    /// \return True if the contributor was removed
+    bool RemoveContributor(const runtime::Guid& id);
+
+    /// \brief Remove a publisher
+    /// \param id Identifier of the publisher
+    /// \return True if the publisher was removed
+    bool RemovePublisher(const runtime::Guid& id);
+
+    /// \brief Find a podcast
+    /// \param id Identifier of the podcast
+    /// \return Current version, nullptr if the podcast is not in the catalog
+    std::shared_ptr<const PodcastVersion> FindPodcast(const runtime::Guid& id) const
+    {
+        return podcasts_.Find(id);
+    }
+
+    /// \brief Find an episode
+    /// \param id Identifier of the episode
+    /// \return Episode with its podcast and season, empty if the episode is not in the catalog
+    CatalogEpisode FindEpisode(const runtime::Guid& id) const
+    {
+        return episodes_.Find(id);
+    }
+
+    /// \brief Find a contributor
+    /// \param id Identifier of the contributor
+    /// \return Contributor, nullptr if the contributor is not in the catalog
+    std::shared_ptr<const Contributor> FindContributor(const runtime::Guid& id) const
+    {
+        return contributors_.Find(id);
+    }
+
+    /// \brief Find a publisher
+    /// \param id Identifier of the publisher
+    /// \return Publisher, nullptr if the publisher is not in the catalog
+    std::shared_ptr<const Publisher> FindPublisher(const runtime::Guid& id) const
+    {
+        return publishers_.Find(id);
+    }
+
+    /// \brief Get the number of podcasts
+    /// \return Number of podcasts
+    size_t GetPodcastCount() const noexcept
+    {
+        return podcasts_.GetCount();
+    }
+
+    /// \brief Get the number of episodes
+    /// \return Number of episodes
+    size_t GetEpisodeCount() const noexcept
+    {
+        return episodes_.GetCount();
+    }
+
+    /// \brief Get the number of contributors
+    /// \return Number of contributors
+    size_t GetContributorCount() const noexcept
+    {
+        return contributors_.GetCount();
+    }
+
+    /// \brief Get the number of publishers
+    /// \return Number of publishers
+    size_t GetPublisherCount() const noexcept
+    {
+        return publishers_.GetCount();
+    }
+
+private:
+    static constexpr size_t PODCAST_LOCK_COUNT = 64;
+
+    std::mutex& GetPodcastLock(const runtime::Guid& id) noexcept;
+    void RemoveEpisodes(const runtime::Guid& podcast, const std::vector<runtime::Guid>& episodes);
+    void Replace(const PodcastVersion* previous, const PodcastVersion& next);
+
+    runtime::ConcurrentMap<std::shared_ptr<const PodcastVersion>> podcasts_;
+    runtime::ConcurrentMap<CatalogEpisode> episodes_;
+    runtime::ConcurrentMap<std::shared_ptr<const Contributor>> contributors_;
+    runtime::ConcurrentMap<std::shared_ptr<const Publisher>> publishers_;
+    std::array<std::mutex, PODCAST_LOCK_COUNT> podcastLocks_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_CATALOG_H_INCL__
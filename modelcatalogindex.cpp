@@ -0,0 +1,175 @@
+///
+// \file modelcatalogindex.cpp
+// \brief P3 Model Catalog Index implementation
+// \details Index maintenance and queries
+//
+
+#include "modelcatalogindex.h"
+
+#include "modelcontribution.h"
+#include "modelcontributor.h"
+#include "modeltag.h"
+#include "modeltagreference.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace ultralove::p3::model {
+void CatalogIndex::AddPodcast(const Podcast& podcast)
+{
+    for (const Season& season : podcast.seasons) {
+        for (const Episode& episode : season.episodes) {
+            Update(podcast, season, episode);
+        }
+    }
+}
+
+bool CatalogIndex::Update(const Podcast& podcast, const Season& season, const Episode& episode)
+{
+    if (episode.id.IsNil()) {
+        return false;
+    }
+
+    IndexedEpisode entry{podcast.id, season.seasonNumber, episode.episodeNumber, episode.publicationDate, {}, {}};
+    entry.tags.reserve(episode.tags.size());
+    for (const TagReference& reference : episode.tags) {
+        if (reference.tag) {
+            entry.tags.push_back(reference.tag->id);
+        }
+    }
+    entry.contributors.reserve(episode.contributors.size());
+    for (const Contribution& contribution : episode.contributors) {
+        if (contribution.contributor) {
+            entry.contributors.push_back(contribution.contributor->id);
+        }
+    }
+    // A contributor with several roles is indexed once
+    std::sort(entry.tags.begin(), entry.tags.end());
+    entry.tags.erase(std::unique(entry.tags.begin(), entry.tags.end()), entry.tags.end());
+    std::sort(entry.contributors.begin(), entry.contributors.end());
+    entry.contributors.erase(std::unique(entry.contributors.begin(), entry.contributors.end()), entry.contributors.end());
+
+    const auto existing = entries_.find(episode.id);
+    if (existing != entries_.end()) {
+        Erase(episode.id, existing->second);
+        existing->second = std::move(entry);
+        Insert(episode.id, existing->second);
+    }
+    else {
+        Insert(episode.id, entries_.emplace(episode.id, std::move(entry)).first->second);
+    }
+    return true;
+}
+
+bool CatalogIndex::Remove(const runtime::Guid& episode)
+{
+    const auto existing = entries_.find(episode);
+    if (existing == entries_.end()) {
+        return false;
+    }
+    Erase(episode, existing->second);
+    entries_.erase(existing);
+    return true;
+}
+
+void CatalogIndex::Clear() noexcept
+{
+    entries_.clear();
+    byDate_.clear();
+    byNumber_.clear();
+    byTag_.clear();
+    byContributor_.clear();
+}
+
+const IndexedEpisode* CatalogIndex::Find(const runtime::Guid& episode) const noexcept
+{
+    const auto existing = entries_.find(episode);
+    return (existing != entries_.end()) ? &existing->second : nullptr;
+}
+
+runtime::Guid CatalogIndex::Find(const runtime::Guid& podcast, const uint32_t seasonNumber, const uint32_t episodeNumber) const noexcept
+{
+    const auto it = byNumber_.lower_bound(NumberKey{podcast, seasonNumber, episodeNumber, runtime::Guid()});
+    if ((it == byNumber_.end()) || (it->podcast != podcast) || (it->seasonNumber != seasonNumber) || (it->episodeNumber != episodeNumber)) {
+        return runtime::Guid();
+    }
+    return it->episode;
+}
+
+size_t CatalogIndex::GetLatest(const size_t count, std::vector<runtime::Guid>& episodes) const
+{
+    return CopyNewest(byDate_, count, episodes);
+}
+
+size_t CatalogIndex::GetPublished(const runtime::Timestamp& from, const runtime::Timestamp& until, std::vector<runtime::Guid>& episodes) const
+{
+    const auto first  = byDate_.lower_bound(DateKey{from.GetMicroseconds(), runtime::Guid()});
+    const auto last   = byDate_.lower_bound(DateKey{until.GetMicroseconds(), runtime::Guid()});
+    const size_t size = episodes.size();
+    for (auto it = std::make_reverse_iterator(last); it != std::make_reverse_iterator(first); ++it) {
+        episodes.push_back(it->episode);
+    }
+    return episodes.size() - size;
+}
+
+size_t CatalogIndex::FindByTag(const runtime::Guid& tag, const size_t count, std::vector<runtime::Guid>& episodes) const
+{
+    const auto postings = byTag_.find(tag);
+    return (postings != byTag_.end()) ? CopyNewest(postings->second, count, episodes) : 0;
+}
+
+size_t CatalogIndex::FindByContributor(const runtime::Guid& contributor, const size_t count, std::vector<runtime::Guid>& episodes) const
+{
+    const auto postings = byContributor_.find(contributor);
+    return (postings != byContributor_.end()) ? CopyNewest(postings->second, count, episodes) : 0;
+}
+
+void CatalogIndex::Insert(const runtime::Guid& episode, const IndexedEpisode& entry)
+{
+    const DateKey key{entry.publicationDate.GetMicroseconds(), episode};
+    byDate_.insert(key);
+    byNumber_.insert(NumberKey{entry.podcast, entry.seasonNumber, entry.episodeNumber, episode});
+    for (const runtime::Guid& tag : entry.tags) {
+        byTag_[tag].insert(key);
+    }
+    for (const runtime::Guid& contributor : entry.contributors) {
+        byContributor_[contributor].insert(key);
+    }
+}
+
+void CatalogIndex::Erase(const runtime::Guid& episode, const IndexedEpisode& entry)
+{
+    const DateKey key{entry.publicationDate.GetMicroseconds(), episode};
+    byDate_.erase(key);
+    byNumber_.erase(NumberKey{entry.podcast, entry.seasonNumber, entry.episodeNumber, episode});
+
+    // Empty posting lists are dropped so removed tags and contributors do not accumulate
+    const auto erasePosting = [&key](std::unordered_map<runtime::Guid, Postings>& index, const runtime::Guid& id) {
+        const auto postings = index.find(id);
+        if (postings != index.end()) {
+            postings->second.erase(key);
+            if (postings->second.empty()) {
+                index.erase(postings);
+            }
+        }
+    };
+    for (const runtime::Guid& tag : entry.tags) {
+        erasePosting(byTag_, tag);
+    }
+    for (const runtime::Guid& contributor : entry.contributors) {
+        erasePosting(byContributor_, contributor);
+    }
+}
+
+size_t CatalogIndex::CopyNewest(const Postings& postings, const size_t count, std::vector<runtime::Guid>& episodes)
+{
+    const size_t size = std::min(count, postings.size());
+    episodes.reserve(episodes.size() + size);
+    auto it = postings.rbegin();
+    for (size_t i = 0; i < size; ++i, ++it) {
+        episodes.push_back(it->episode);
+    }
+    return size;
+}
+} // namespace ultralove::p3::model
@@ -0,0 +1,170 @@
+///
+// \file modelcatalogindex.h
+// \brief P3 Model Catalog Index
+// \details Secondary indexes over the episodes of a catalog
+//
+
+#ifndef __P3_MODEL_CATALOG_INDEX_H_INCL__
+#define __P3_MODEL_CATALOG_INDEX_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelepisode.h"
+#include "modelpodcast.h"
+#include "modelseason.h"
+#include "runtimeguid.h"
+#include "runtimetimestamp.h"
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Indexed fields of an episode
+struct IndexedEpisode
+{
+    /// \brief Identifier of the podcast
+    runtime::Guid podcast;
+
+    /// \brief Season number
+    uint32_t seasonNumber;
+
+    /// \brief Episode number
+    uint32_t episodeNumber;
+
+    /// \brief Publication date
+    runtime::Timestamp publicationDate;
+
+    /// \brief Identifiers of the tags referenced by the episode
+    std::vector<runtime::Guid> tags;
+
+    /// \brief Identifiers of the contributors of the episode
+    std::vector<runtime::Guid> contributors;
+};
+
+/// \brief Secondary indexes over a catalog of podcasts
+/// \details Maintains a sorted index on the publication date, inverted indexes from Tag and
+/// Contributor identifiers to episodes, and a lookup by podcast, season number and episode number.
+/// Episodes are identified by Fabric::id; episodes with a nil identifier are not indexed. Update()
+/// replaces the entry of one episode in logarithmic time, so the indexes can follow a catalog as
+/// episodes are added or modified. Query results are episode identifiers, newest first where an
+/// order applies. An index is not thread-safe.
+class CatalogIndex
+{
+public:
+    /// \brief Create an empty index
+    CatalogIndex() = default;
+
+    /// \brief Destroy the index
+    virtual ~CatalogIndex() = default;
+
+    CatalogIndex(const CatalogIndex&)            = delete;
+    CatalogIndex& operator=(const CatalogIndex&) = delete;
+
+    /// \brief Index all episodes of a podcast
+    /// \param podcast Podcast to index
+    void AddPodcast(const Podcast& podcast);
+
+    /// \brief Add or replace the entry of an episode
+    /// \param podcast Podcast of the episode
+    /// \param season Season of the episode
+    /// \param episode Episode to index
+    /// \return True if the episode was indexed, false if its identifier is nil
+    bool Update(const Podcast& podcast, const Season& season, const Episode& episode);
+
+    /// \brief Remove the entry of an episode
+    /// \param episode Identifier of the episode
+    /// \return True if the episode was indexed
+    bool Remove(const runtime::Guid& episode);
+
+    /// \brief Remove all entries
+    void Clear() noexcept;
+
+    /// \brief Get the number of indexed episodes
+    /// \return Number of episodes
+    size_t GetCount() const noexcept
+    {
+        return entries_.size();
+    }
+
+    /// \brief Get the indexed fields of an episode
+    /// \param episode Identifier of the episode
+    /// \return Indexed fields, nullptr if the episode is not indexed
+    const IndexedEpisode* Find(const runtime::Guid& episode) const noexcept;
+
+    /// \brief Find an episode by its numbers
+    /// \param podcast Identifier of the podcast
+    /// \param seasonNumber Season number
+    /// \param episodeNumber Episode number
+    /// \return Identifier of the episode, nil if there is none
+    runtime::Guid Find(const runtime::Guid& podcast, const uint32_t seasonNumber, const uint32_t episodeNumber) const noexcept;
+
+    /// \brief Get the most recently published episodes
+    /// \param count Maximum number of episodes
+    /// \param episodes Receives the episode identifiers, newest first
+    /// \return Number of identifiers appended
+    size_t GetLatest(const size_t count, std::vector<runtime::Guid>& episodes) const;
+
+    /// \brief Get the episodes published in a period
+    /// \param from Start of the period, inclusive
+    /// \param until End of the period, exclusive
+    /// \param episodes Receives the episode identifiers, newest first
+    /// \return Number of identifiers appended
+    size_t GetPublished(const runtime::Timestamp& from, const runtime::Timestamp& until, std::vector<runtime::Guid>& episodes) const;
+
+    /// \brief Get the episodes that reference a tag
+    /// \param tag Identifier of the tag
+    /// \param count Maximum number of episodes
+    /// \param episodes Receives the episode identifiers, newest first
+    /// \return Number of identifiers appended
+    size_t FindByTag(const runtime::Guid& tag, const size_t count, std::vector<runtime::Guid>& episodes) const;
+
+    /// \brief Get the episodes a contributor contributed to
+    /// \param contributor Identifier of the contributor
+    /// \param count Maximum number of episodes
+    /// \param episodes Receives the episode identifiers, newest first
+    /// \return Number of identifiers appended
+    size_t FindByContributor(const runtime::Guid& contributor, const size_t count, std::vector<runtime::Guid>& episodes) const;
+
+private:
+    // Postings are ordered by publication date, so every list can be read newest first
+    struct DateKey
+    {
+        int64_t publicationDate;
+        runtime::Guid episode;
+
+        friend constexpr std::strong_ordering operator<=>(const DateKey&, const DateKey&) = default;
+    };
+
+    struct NumberKey
+    {
+        runtime::Guid podcast;
+        uint32_t seasonNumber;
+        uint32_t episodeNumber;
+        runtime::Guid episode;
+
+        friend constexpr std::strong_ordering operator<=>(const NumberKey&, const NumberKey&) = default;
+    };
+
+    using Postings = std::set<DateKey>;
+
+    void Insert(const runtime::Guid& episode, const IndexedEpisode& entry);
+    void Erase(const runtime::Guid& episode, const IndexedEpisode& entry);
+    static size_t CopyNewest(const Postings& postings, const size_t count, std::vector<runtime::Guid>& episodes);
+
+    std::unordered_map<runtime::Guid, IndexedEpisode> entries_;
+    Postings byDate_;
+    std::set<NumberKey> byNumber_;
+    std::unordered_map<runtime::Guid, Postings> byTag_;
+    std::unordered_map<runtime::Guid, Postings> byContributor_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_CATALOG_INDEX_H_INCL__
@@ -0,0 +1,43 @@
+///
+// \file modelchapter.h
+// \brief P3 Model Chapter
+// \details Chapter of a Podcasting 2.0 chapters document
+//
+
+#ifndef __P3_MODEL_CHAPTER_H_INCL__
+#define __P3_MODEL_CHAPTER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelchaptertag.h"
+#include "modellocationtag.h"
+#include "modelpicture.h"
+#include "runtimestring.h"
+#include <optional>
+
+namespace ultralove::p3::model {
+/// \brief Chapter
+/// \details One entry of a podcast:chapters document: the timed ChapterTag with the optional
+/// artwork, location and link shown while the chapter plays
+struct Chapter
+{
+    /// \brief Title as Tag::name, start time and end time; a zero end time is absent
+    ChapterTag tag;
+
+    /// \brief Artwork of the chapter
+    std::optional<Picture> image;
+
+    /// \brief Location the chapter is about
+    std::optional<LocationTag> location;
+
+    /// \brief Web page of the chapter
+    runtime::String url;
+
+    /// \brief False for chapters that players leave out of the table of contents
+    bool toc = true;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_CHAPTER_H_INCL__
@@ -0,0 +1,237 @@
+///
+// \file modelchapterreader.cpp
+// \brief P3 Model Chapter Reader implementation
+// \details Chapters array, chapter members and geo URIs
+//
+
+#include "modelchapterreader.h"
+
+#include "modelparsing.h"
+#include "runtimemappedfile.h"
+
+#include <charconv>
+#include <utility>
+
+namespace ultralove::p3::model {
+namespace {
+using namespace parsing;
+using Token = runtime::JsonToken;
+
+enum class ChapterField
+{
+    OTHER,
+    CHAPTERS,
+    START_TIME,
+    END_TIME,
+    TITLE,
+    IMG,
+    URL,
+    TOC,
+    LOCATION,
+    NAME,
+    GEO
+};
+
+// RFC 5870 "geo:48.2082,16.3738", an altitude after a second comma and parameters after a
+// semicolon are ignored
+bool ParseGeo(const std::string_view uri, double& latitude, double& longitude) noexcept
+{
+    const std::string_view text = Trim(uri);
+    if ((text.size() < 4) || (EqualsIgnoreCase(text.substr(0, 4), "geo:") == false)) {
+        return false;
+    }
+    const std::string_view coordinates = text.substr(4, text.find(';') - 4);
+    const size_t comma                 = coordinates.find(',');
+    if (comma == std::string_view::npos) {
+        return false;
+    }
+    const std::string_view first  = Trim(coordinates.substr(0, comma));
+    const std::string_view second = Trim(coordinates.substr(comma + 1, coordinates.find(',', comma + 1) - comma - 1));
+    double lat                    = 0;
+    double lon                    = 0;
+    const auto [latEnd, latCode]  = std::from_chars(first.data(), first.data() + first.size(), lat);
+    const auto [lonEnd, lonCode]  = std::from_chars(second.data(), second.data() + second.size(), lon);
+    if ((latCode != std::errc()) || (lonCode != std::errc()) || (latEnd != first.data() + first.size()) ||
+        (lonEnd != second.data() + second.size())) {
+        return false;
+    }
+    latitude  = lat;
+    longitude = lon;
+    return true;
+}
+
+constexpr FieldName<ChapterField> CHAPTER_FIELD_NAMES[] = {{"startTime", ChapterField::START_TIME}, {"title", ChapterField::TITLE},
+    {"img", ChapterField::IMG}, {"endTime", ChapterField::END_TIME}, {"url", ChapterField::URL}, {"toc", ChapterField::TOC},
+    {"location", ChapterField::LOCATION}, {"name", ChapterField::NAME}, {"geo", ChapterField::GEO}, {"chapters", ChapterField::CHAPTERS}};
+
+constexpr NameTable CHAPTER_FIELDS(CHAPTER_FIELD_NAMES);
+
+ChapterField Classify(const std::string_view key) noexcept
+{
+    return CHAPTER_FIELDS.Find(key, ChapterField::OTHER);
+}
+} // namespace
+
+ChapterReader::ChapterReader(runtime::Arena& arena) : arena_(arena) {}
+
+bool ChapterReader::Read(const std::string_view document, std::vector<Chapter>& chapters)
+{
+    chapters.clear();
+    runtime::JsonReader reader(document);
+    if (reader.Next() != Token::BEGIN_OBJECT) {
+        return false;
+    }
+    for (;;) {
+        Token token = reader.Next();
+        if (token == Token::END_OBJECT) {
+            break;
+        }
+        if (token != Token::KEY) {
+            return false;
+        }
+        if (Classify(Decode(reader.GetValue())) != ChapterField::CHAPTERS) {
+            if (reader.Skip() == false) {
+                return false;
+            }
+            continue;
+        }
+        token = reader.Next();
+        if (token != Token::BEGIN_ARRAY) {
+            if (SkipValue(reader, token) == false) {
+                return false;
+            }
+            continue;
+        }
+        for (token = reader.Next(); token != Token::END_ARRAY; token = reader.Next()) {
+            if (token == Token::BEGIN_OBJECT) {
+                if (ReadChapter(reader, chapters.emplace_back()) == false) {
+                    return false;
+                }
+            }
+            else if (SkipValue(reader, token) == false) {
+                return false;
+            }
+        }
+    }
+    return reader.Next() == Token::END;
+}
+
+bool ChapterReader::ReadFile(const char* path, std::vector<Chapter>& chapters)
+{
+    // All strings end up inline or in the arena, so the mapping is released right after reading
+    runtime::MappedFile file;
+    if (file.Open(path) == false) {
+        chapters.clear();
+        return false;
+    }
+    return Read(file.GetView(), chapters);
+}
+
+bool ChapterReader::ReadChapter(runtime::JsonReader& reader, Chapter& chapter)
+{
+    for (;;) {
+        Token token = reader.Next();
+        if (token == Token::END_OBJECT) {
+            return true;
+        }
+        if (token != Token::KEY) {
+            return false;
+        }
+        const ChapterField field = Classify(Decode(reader.GetValue()));
+        token                    = reader.Next();
+        switch (field) {
+        case ChapterField::START_TIME:
+        case ChapterField::END_TIME: {
+            runtime::Timespan& time = (field == ChapterField::START_TIME) ? chapter.tag.startTime : chapter.tag.endTime;
+            if (token == Token::NUMBER) {
+                time = ParseSeconds(reader.GetValue().raw).value_or(runtime::Timespan());
+                continue;
+            }
+            break;
+        }
+        case ChapterField::TITLE:
+            if (token == Token::STRING) {
+                chapter.tag.name = MakeString(reader.GetValue());
+                continue;
+            }
+            break;
+        case ChapterField::IMG:
+            if (token == Token::STRING) {
+                Picture& image = chapter.image.emplace();
+                image.uri      = MakeString(reader.GetValue());
+                image.type     = PictureTypeFromUri(image.uri.GetView());
+                image.width    = 0;
+                image.height   = 0;
+                continue;
+            }
+            break;
+        case ChapterField::URL:
+            if (token == Token::STRING) {
+                chapter.url = MakeString(reader.GetValue());
+                continue;
+            }
+            break;
+        case ChapterField::TOC:
+            if (token == Token::BOOLEAN) {
+                chapter.toc = reader.GetBoolean();
+                continue;
+            }
+            break;
+        case ChapterField::LOCATION:
+            if (token == Token::BEGIN_OBJECT) {
+                LocationTag& location = chapter.location.emplace();
+                location.latitude     = 0;
+                location.longitude    = 0;
+                if (ReadLocation(reader, location) == false) {
+                    return false;
+                }
+                continue;
+            }
+            break;
+        default:
+            break;
+        }
+        if (SkipValue(reader, token) == false) {
+            return false;
+        }
+    }
+}
+
+bool ChapterReader::ReadLocation(runtime::JsonReader& reader, LocationTag& location)
+{
+    for (;;) {
+        Token token = reader.Next();
+        if (token == Token::END_OBJECT) {
+            return true;
+        }
+        if (token != Token::KEY) {
+            return false;
+        }
+        const ChapterField field = Classify(Decode(reader.GetValue()));
+        token                    = reader.Next();
+        if (token == Token::STRING) {
+            if (field == ChapterField::NAME) {
+                location.name = MakeString(reader.GetValue());
+                continue;
+            }
+            if (field == ChapterField::GEO) {
+                ParseGeo(Decode(reader.GetValue()), location.latitude, location.longitude);
+                continue;
+            }
+        }
+        if (SkipValue(reader, token) == false) {
+            return false;
+        }
+    }
+}
+
+runtime::String ChapterReader::MakeString(const runtime::JsonValue& value)
+{
+    return parsing::MakeString(value, arena_);
+}
+
+std::string_view ChapterReader::Decode(const runtime::JsonValue& value)
+{
+    return parsing::Decode(value, decoded_);
+}
+} // namespace ultralove::p3::model
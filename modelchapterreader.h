@@ -0,0 +1,71 @@
+///
+// \file modelchapterreader.h
+// \brief P3 Model Chapter Reader
+// \details Reads Podcasting 2.0 JSON chapters into Chapter entries
+//
+
+#ifndef __P3_MODEL_CHAPTER_READER_H_INCL__
+#define __P3_MODEL_CHAPTER_READER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelchapter.h"
+#include "runtimearena.h"
+#include "runtimejsonreader.h"
+#include "runtimestring.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Chapter reader
+/// \details Fills a list of Chapter entries with a single pass over a podcast:chapters document,
+/// which is typically the view of a runtime::MappedFile. Every object of the "chapters" array
+/// becomes a Chapter: "title" is the tag name, "startTime" and "endTime" are seconds, "img" the
+/// image, "url" the link and "toc" the table of contents flag. A "location" object becomes a
+/// LocationTag with its "name" and the coordinates of its "geo" URI; "osm" is not kept. Strings are
+/// stored like FeedReader stores them: inline, or in the arena passed to the constructor. The
+/// picture type is taken from the file extension of the image. Unknown members, such as the
+/// document version or waypoints, are skipped. A reader is not thread-safe; use one reader per thread.
+class ChapterReader
+{
+public:
+    /// \brief Create a reader
+    /// \param arena Arena receiving long strings, must outlive everything read
+    explicit ChapterReader(runtime::Arena& arena);
+
+    /// \brief Destroy the reader
+    virtual ~ChapterReader() = default;
+
+    ChapterReader(const ChapterReader&)            = delete;
+    ChapterReader& operator=(const ChapterReader&) = delete;
+
+    /// \brief Read a chapters document
+    /// \param document Complete JSON document
+    /// \param chapters Chapters to replace, in document order
+    /// \return True if the document is a well-formed JSON object
+    bool Read(const std::string_view document, std::vector<Chapter>& chapters);
+
+    /// \brief Read a chapters document from a file through a read-only memory mapping
+    /// \param path Path of the chapters file
+    /// \param chapters Chapters to replace, in document order
+    /// \return True if the file could be mapped and is a well-formed JSON object
+    bool ReadFile(const char* path, std::vector<Chapter>& chapters);
+
+private:
+    bool ReadChapter(runtime::JsonReader& reader, Chapter& chapter);
+    bool ReadLocation(runtime::JsonReader& reader, LocationTag& location);
+    runtime::String MakeString(const runtime::JsonValue& value);
+    std::string_view Decode(const runtime::JsonValue& value);
+
+    runtime::Arena& arena_;
+    std::string decoded_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_CHAPTER_READER_H_INCL__
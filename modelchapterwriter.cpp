@@ -0,0 +1,162 @@
+///
+// \file modelchapterwriter.cpp
+// \brief P3 Model Chapter Writer implementation
+// \details Chapter members, geo URIs and the per-episode document cache
+//
+
+#include "modelchapterwriter.h"
+
+#include <bit>
+#include <charconv>
+
+namespace ultralove::p3::model {
+ChapterWriter::ChapterWriter(runtime::OutputSink& sink, const size_t bufferSize) : writer_(sink, bufferSize) {}
+
+bool ChapterWriter::Write(const std::vector<Chapter>& chapters)
+{
+    writer_.BeginObject();
+    writer_.Key("version");
+    writer_.Text(VERSION);
+    writer_.Key("chapters");
+    writer_.BeginArray();
+    for (const Chapter& chapter : chapters) {
+        WriteChapter(chapter);
+    }
+    writer_.EndArray();
+    writer_.EndObject();
+    return writer_.Flush();
+}
+
+void ChapterWriter::WriteChapter(const Chapter& chapter)
+{
+    writer_.BeginObject();
+    // The start time is the one required member, a chapter at zero is written as such
+    WriteSeconds("startTime", chapter.tag.startTime);
+    if (chapter.tag.endTime.IsZero() == false) {
+        WriteSeconds("endTime", chapter.tag.endTime);
+    }
+    WriteString("title", chapter.tag.name);
+    if (chapter.image.has_value()) {
+        WriteString("img", chapter.image->uri);
+    }
+    WriteString("url", chapter.url);
+    if (chapter.toc == false) {
+        writer_.Key("toc");
+        writer_.Boolean(false);
+    }
+    if (chapter.location.has_value()) {
+        WriteLocation(*chapter.location);
+    }
+    writer_.EndObject();
+}
+
+void ChapterWriter::WriteLocation(const LocationTag& location)
+{
+    writer_.Key("location");
+    writer_.BeginObject();
+    WriteString("name", location.name);
+    if ((location.latitude != 0) || (location.longitude != 0)) {
+        // RFC 5870 geo URI, shortest representation that reads back to the same coordinates
+        char text[64] = {'g', 'e', 'o', ':'};
+        auto result   = std::to_chars(text + 4, text + sizeof(text), location.latitude);
+        *result.ptr++ = ',';
+        result        = std::to_chars(result.ptr, text + sizeof(text), location.longitude);
+        writer_.Key("geo");
+        writer_.Text(std::string_view(text, static_cast<size_t>(result.ptr - text)));
+    }
+    writer_.EndObject();
+}
+
+void ChapterWriter::WriteString(const std::string_view name, const runtime::String& value)
+{
+    if (value.IsEmpty() == false) {
+        writer_.Key(name);
+        writer_.Text(value.GetView());
+    }
+}
+
+void ChapterWriter::WriteSeconds(const std::string_view name, const runtime::Timespan& timespan)
+{
+    // Whole seconds, then the fraction without trailing zeros, so that nanoseconds round-trip
+    const int64_t nanoseconds = timespan.GetNanoseconds();
+    const uint64_t magnitude  = (nanoseconds < 0) ? (0 - static_cast<uint64_t>(nanoseconds)) : static_cast<uint64_t>(nanoseconds);
+    const uint64_t perSecond  = static_cast<uint64_t>(runtime::Timespan::NANOSECONDS_PER_SECOND);
+    char text[32];
+    size_t length = 0;
+    if (nanoseconds < 0) {
+        text[length++] = '-';
+    }
+    const auto result = std::to_chars(text + length, text + sizeof(text), magnitude / perSecond);
+    length            = static_cast<size_t>(result.ptr - text);
+    uint64_t fraction = magnitude % perSecond;
+    if (fraction > 0) {
+        text[length++] = '.';
+        for (uint64_t scale = perSecond / 10; (fraction > 0) && (scale > 0); scale /= 10) {
+            text[length++] = static_cast<char>('0' + fraction / scale);
+            fraction %= scale;
+        }
+    }
+    writer_.Key(name);
+    writer_.Raw(std::string_view(text, length));
+}
+
+ChapterCache::ChapterCache() : sink_(fragment_), writer_(sink_, runtime::JsonWriter::DEFAULT_BUFFER_SIZE) {}
+
+std::shared_ptr<const std::string> ChapterCache::Get(const Episode& episode, const std::vector<Chapter>& chapters)
+{
+    const runtime::Hash128 stamp = MakeStamp(chapters);
+    const bool cached            = episode.id.IsNil() == false;
+    if (cached) {
+        const std::shared_ptr<const Document> document = documents_.Find(episode.id);
+        if ((document != nullptr) && (document->stamp == stamp)) {
+            return std::shared_ptr<const std::string>(document, &document->bytes);
+        }
+    }
+
+    auto document = std::make_shared<Document>();
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        fragment_.clear();
+        writer_.Write(chapters);
+        document->bytes.assign(fragment_);
+    }
+    document->stamp = stamp;
+    rendered_.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<const Document> published = std::move(document);
+    if (cached) {
+        documents_.Put(episode.id, published);
+    }
+    return std::shared_ptr<const std::string>(published, &published->bytes);
+}
+
+void ChapterCache::Remove(const runtime::Guid& id)
+{
+    documents_.Remove(id);
+}
+
+runtime::Hash128 ChapterCache::MakeStamp(const std::vector<Chapter>& chapters) noexcept
+{
+    // Everything a document is rendered from; strings carry their length and optional parts a
+    // presence flag, so different chapters never feed the hasher the same bytes
+    runtime::Hasher hasher;
+    hasher.Update(static_cast<uint64_t>(chapters.size()));
+    for (const Chapter& chapter : chapters) {
+        hasher.Update(static_cast<uint64_t>(chapter.tag.startTime.GetNanoseconds()));
+        hasher.Update(static_cast<uint64_t>(chapter.tag.endTime.GetNanoseconds()));
+        hasher.Update(chapter.tag.name.GetView());
+        hasher.Update(static_cast<uint64_t>(chapter.image.has_value() ? 1 : 0));
+        if (chapter.image.has_value()) {
+            hasher.Update(chapter.image->uri.GetView());
+        }
+        hasher.Update(chapter.url.GetView());
+        hasher.Update(static_cast<uint64_t>(chapter.toc ? 1 : 0));
+        hasher.Update(static_cast<uint64_t>(chapter.location.has_value() ? 1 : 0));
+        if (chapter.location.has_value()) {
+            hasher.Update(chapter.location->name.GetView());
+            hasher.Update(std::bit_cast<uint64_t>(chapter.location->latitude));
+            hasher.Update(std::bit_cast<uint64_t>(chapter.location->longitude));
+        }
+    }
+    return hasher.Finish();
+}
+} // namespace ultralove::p3::model
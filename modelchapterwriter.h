@@ -0,0 +1,147 @@
+///
+// \file modelchapterwriter.h
+// \brief P3 Model Chapter Writer
+// \details Streams Podcasting 2.0 JSON chapters and caches them per episode
+//
+
+#ifndef __P3_MODEL_CHAPTER_WRITER_H_INCL__
+#define __P3_MODEL_CHAPTER_WRITER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelchapter.h"
+#include "modelepisode.h"
+#include "runtimeconcurrentmap.h"
+#include "runtimeguid.h"
+#include "runtimehasher.h"
+#include "runtimejsonwriter.h"
+#include "runtimeoutputsink.h"
+#include "runtimetimespan.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Chapter writer
+/// \details Streams a podcast:chapters document, version 1.2.0, through a runtime::JsonWriter into
+/// an OutputSink. Nothing but the fixed output buffer is allocated, and the buffer is reused by
+/// every Write(). Times are written as seconds with as many decimals as needed for nanoseconds.
+/// Empty strings and zero end times are treated as absent and not written, "toc" only when it is
+/// false. A location is written with its name and, unless both coordinates are zero, a geo URI.
+class ChapterWriter
+{
+public:
+    /// \brief Version written into every document
+    static constexpr std::string_view VERSION = "1.2.0";
+
+    /// \brief Create a chapter writer
+    /// \param sink Destination of the documents, must outlive the writer
+    /// \param bufferSize Size of the output buffer
+    explicit ChapterWriter(runtime::OutputSink& sink, const size_t bufferSize = runtime::JsonWriter::DEFAULT_BUFFER_SIZE);
+
+    /// \brief Destroy the chapter writer
+    virtual ~ChapterWriter() = default;
+
+    ChapterWriter(const ChapterWriter&)            = delete;
+    ChapterWriter& operator=(const ChapterWriter&) = delete;
+
+    /// \brief Write a complete chapters document and flush it to the sink
+    /// \param chapters Chapters in playback order
+    /// \return True if the sink accepted the whole document
+    bool Write(const std::vector<Chapter>& chapters);
+
+    /// \brief Get the number of bytes produced so far
+    /// \return Byte count over all documents written by this writer
+    uint64_t GetBytesWritten() const noexcept
+    {
+        return writer_.GetBytesWritten();
+    }
+
+private:
+    void WriteChapter(const Chapter& chapter);
+    void WriteLocation(const LocationTag& location);
+    void WriteString(const std::string_view name, const runtime::String& value);
+    void WriteSeconds(const std::string_view name, const runtime::Timespan& timespan);
+
+    runtime::JsonWriter writer_;
+};
+
+/// \brief Rendered chapters documents of many episodes
+/// \details Keeps the bytes of the chapters document of every episode together with a 128-bit
+/// runtime::Hasher hash of what it was rendered from: the times, title, image, link, toc flag and
+/// location of every chapter. Get() serves a document from the cache while the hash is unchanged
+/// and renders it again otherwise, so chapters edited in any way, also without touching a
+/// modification date, get a new document unless the edit collides in all 128 bits. That does not
+/// happen by chance, but the hash is no defence against crafted collisions. Hashing the chapters is
+/// still far cheaper than rendering the document.
+///
+/// Documents are immutable once rendered and handed out as shared strings. Lookups never take the
+/// render lock and run in parallel with each other and with rendering, see runtime::ConcurrentMap;
+/// rendering is serialized and streams through one ChapterWriter into one reusable buffer. Episodes
+/// with a nil identifier are rendered on every call and not kept.
+class ChapterCache
+{
+public:
+    /// \brief Create an empty cache
+    ChapterCache();
+
+    /// \brief Destroy the cache
+    virtual ~ChapterCache() = default;
+
+    ChapterCache(const ChapterCache&)            = delete;
+    ChapterCache& operator=(const ChapterCache&) = delete;
+
+    /// \brief Get the chapters document of an episode
+    /// \param episode Episode the chapters belong to
+    /// \param chapters Chapters of the episode in playback order
+    /// \return Document, never null; it stays valid while the caller holds it, even after the
+    /// episode was rendered again or removed
+    std::shared_ptr<const std::string> Get(const Episode& episode, const std::vector<Chapter>& chapters);
+
+    /// \brief Drop the document of an episode
+    /// \param id Identifier of the episode
+    void Remove(const runtime::Guid& id);
+
+    /// \brief Get the number of cached documents
+    /// \return Number of documents
+    size_t GetCount() const noexcept
+    {
+        return documents_.GetCount();
+    }
+
+    /// \brief Get the number of documents rendered since the cache was created, the other calls of
+    /// Get() were served from the cache
+    /// \return Number of documents
+    uint64_t GetRenderedCount() const noexcept
+    {
+        return rendered_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Document
+    {
+        runtime::Hash128 stamp{};
+        std::string bytes;
+    };
+
+    static runtime::Hash128 MakeStamp(const std::vector<Chapter>& chapters) noexcept;
+
+    runtime::ConcurrentMap<std::shared_ptr<const Document>> documents_;
+    std::mutex mutex_;
+    std::string fragment_;
+    runtime::StringOutputSink sink_;
+    ChapterWriter writer_;
+    std::atomic<uint64_t> rendered_ = 0;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_CHAPTER_WRITER_H_INCL__
@@ -0,0 +1,317 @@
+///
+// \file modelcontenthash.cpp
+// \brief P3 Model Content Hash implementation
+// \details Field serialization and the per-entity hash cache
+//
+
+#include "modelcontenthash.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include <vector>
+
+namespace ultralove::p3::model {
+namespace {
+// Every entity kind starts from its own seed, so a season and an episode with the same values differ
+enum Seed : uint64_t
+{
+    CONTRIBUTOR_SEED = 1,
+    TAG_SEED,
+    EPISODE_SEED,
+    SEASON_SEED,
+    SEASON_FIELDS_SEED,
+    PODCAST_SEED,
+    PODCAST_FIELDS_SEED
+};
+
+void Update(runtime::Hasher& hasher, const runtime::String& value) noexcept
+{
+    hasher.Update(value.GetView());
+}
+
+void Update(runtime::Hasher& hasher, const runtime::Guid& value) noexcept
+{
+    hasher.Update(value.high);
+    hasher.Update(value.low);
+}
+
+void Update(runtime::Hasher& hasher, const runtime::Timestamp& value) noexcept
+{
+    hasher.Update(static_cast<uint64_t>(value.GetMicroseconds()));
+    hasher.Update(static_cast<uint64_t>(static_cast<int64_t>(value.GetOffsetMinutes())));
+}
+
+void Update(runtime::Hasher& hasher, const runtime::Timespan& value) noexcept
+{
+    hasher.Update(static_cast<uint64_t>(value.GetNanoseconds()));
+}
+
+void Update(runtime::Hasher& hasher, const Fabric& fabric) noexcept
+{
+    Update(hasher, fabric.id);
+    Update(hasher, fabric.typeId);
+    Update(hasher, fabric.creationDate);
+    Update(hasher, fabric.comment);
+}
+
+void Update(runtime::Hasher& hasher, const Asset& asset) noexcept
+{
+    Update(hasher, asset.uri);
+    Update(hasher, asset.author);
+    Update(hasher, asset.license);
+    Update(hasher, asset.copyright);
+}
+
+void Update(runtime::Hasher& hasher, const Picture& picture) noexcept
+{
+    Update(hasher, static_cast<const Asset&>(picture));
+    hasher.Update(static_cast<uint64_t>(picture.type));
+    hasher.Update(static_cast<uint64_t>(picture.width));
+    hasher.Update(static_cast<uint64_t>(picture.height));
+}
+
+void Update(runtime::Hasher& hasher, const std::vector<TagReference>& tags) noexcept
+{
+    hasher.Update(static_cast<uint64_t>(tags.size()));
+    for (const TagReference& reference : tags) {
+        Update(hasher, reference.tag.GetId());
+        hasher.Update(std::bit_cast<uint64_t>(reference.weight));
+    }
+}
+
+void Update(runtime::Hasher& hasher, const std::vector<Contribution>& contributors) noexcept
+{
+    hasher.Update(static_cast<uint64_t>(contributors.size()));
+    for (const Contribution& contribution : contributors) {
+        Update(hasher, contribution.contributor.GetId());
+        Update(hasher, contribution.type);
+        Update(hasher, contribution.notes);
+    }
+}
+
+// Collect the shared entities referenced anywhere in a podcast, including the creators of its tags
+struct References
+{
+    std::vector<const Contributor*> contributors;
+    std::vector<const Tag*> tags;
+
+    void Add(const EntityHandle<Contributor>& contributor)
+    {
+        if (contributor) {
+            contributors.push_back(contributor.Get());
+        }
+    }
+
+    void Add(const std::vector<TagReference>& references, const std::vector<Contribution>& contributions)
+    {
+        for (const TagReference& reference : references) {
+            if (reference.tag) {
+                tags.push_back(reference.tag.Get());
+                Add(reference.tag->creator);
+            }
+        }
+        for (const Contribution& contribution : contributions) {
+            Add(contribution.contributor);
+        }
+    }
+
+    // Order by identifier so the podcast hash does not depend on where an entity is referenced first
+    void Sort()
+    {
+        const auto byId = [](const Fabric* lhs, const Fabric* rhs) {
+            return lhs->id < rhs->id;
+        };
+        const auto sameId = [](const Fabric* lhs, const Fabric* rhs) {
+            return lhs->id == rhs->id;
+        };
+        std::sort(contributors.begin(), contributors.end(), byId);
+        contributors.erase(std::unique(contributors.begin(), contributors.end(), sameId), contributors.end());
+        std::sort(tags.begin(), tags.end(), byId);
+        tags.erase(std::unique(tags.begin(), tags.end(), sameId), tags.end());
+    }
+};
+} // namespace
+
+template<typename T, typename Compute>
+runtime::Hash128 ContentHasher::Cached(const Kind kind, const T& entity, Compute&& compute)
+{
+    // Entities without an identifier cannot be told apart and are never cached
+    if (entity.id.IsNil()) {
+        return compute();
+    }
+    auto& entries = entries_[static_cast<size_t>(kind)];
+    auto it       = entries.find(entity.id);
+    if ((it != entries.end()) && (it->second.modificationDate == entity.modificationDate) &&
+        (it->second.modificationDate.GetOffsetMinutes() == entity.modificationDate.GetOffsetMinutes())) {
+        return it->second.hash;
+    }
+    const runtime::Hash128 hash = compute();
+    entries.insert_or_assign(entity.id, Entry{entity.modificationDate, hash});
+    return hash;
+}
+
+runtime::Hash128 ContentHasher::Hash(const Contributor& contributor)
+{
+    return Cached(Kind::CONTRIBUTOR, contributor, [&contributor] {
+        runtime::Hasher hasher(CONTRIBUTOR_SEED);
+        Update(hasher, static_cast<const Fabric&>(contributor));
+        Update(hasher, contributor.name);
+        Update(hasher, contributor.email);
+        Update(hasher, contributor.url);
+        Update(hasher, contributor.role);
+        Update(hasher, contributor.bio);
+        Update(hasher, contributor.image);
+        hasher.Update(static_cast<uint64_t>(contributor.presence.size()));
+        for (const ContributorPresence& presence : contributor.presence) {
+            Update(hasher, presence.startTime);
+            Update(hasher, presence.endTime);
+        }
+        return hasher.Finish();
+    });
+}
+
+runtime::Hash128 ContentHasher::Hash(const Tag& tag)
+{
+    return Cached(Kind::TAG, tag, [&tag] {
+        runtime::Hasher hasher(TAG_SEED);
+        Update(hasher, static_cast<const Fabric&>(tag));
+        Update(hasher, tag.name);
+        Update(hasher, tag.description);
+        Update(hasher, tag.creator.GetId());
+        return hasher.Finish();
+    });
+}
+
+runtime::Hash128 ContentHasher::Hash(const Episode& episode)
+{
+    return Cached(Kind::EPISODE, episode, [&episode] {
+        runtime::Hasher hasher(EPISODE_SEED);
+        Update(hasher, static_cast<const Fabric&>(episode));
+        hasher.Update(static_cast<uint64_t>(episode.episodeNumber));
+        Update(hasher, episode.title);
+        Update(hasher, episode.subtitle);
+        Update(hasher, episode.description);
+        Update(hasher, episode.summary);
+        hasher.Update(static_cast<uint64_t>(episode.type));
+        Update(hasher, episode.publicationDate);
+        Update(hasher, episode.duration);
+        Update(hasher, episode.coverArt);
+        hasher.Update(static_cast<uint64_t>(episode.enclosures.size()));
+        for (const Enclosure& enclosure : episode.enclosures) {
+            Update(hasher, static_cast<const Asset&>(enclosure));
+            hasher.Update(static_cast<uint64_t>(enclosure.type));
+            Update(hasher, enclosure.mimeType);
+            hasher.Update(enclosure.fileSize);
+        }
+        Update(hasher, episode.tags);
+        Update(hasher, episode.contributors);
+        return hasher.Finish();
+    });
+}
+
+runtime::Hash128 ContentHasher::HashFields(const Season& season)
+{
+    return Cached(Kind::SEASON_FIELDS, season, [&season] {
+        runtime::Hasher hasher(SEASON_FIELDS_SEED);
+        Update(hasher, static_cast<const Fabric&>(season));
+        hasher.Update(static_cast<uint64_t>(season.seasonNumber));
+        Update(hasher, season.title);
+        Update(hasher, season.description);
+        Update(hasher, season.publicationDate);
+        Update(hasher, season.coverArt);
+        Update(hasher, season.tags);
+        Update(hasher, season.contributors);
+        return hasher.Finish();
+    });
+}
+
+runtime::Hash128 ContentHasher::Hash(const Season& season)
+{
+    return Cached(Kind::SEASON, season, [this, &season] {
+        runtime::Hasher hasher(SEASON_SEED);
+        hasher.Update(HashFields(season));
+        hasher.Update(static_cast<uint64_t>(season.episodes.size()));
+        for (const Episode& episode : season.episodes) {
+            hasher.Update(Hash(episode));
+        }
+        return hasher.Finish();
+    });
+}
+
+runtime::Hash128 ContentHasher::HashFields(const Podcast& podcast)
+{
+    return Cached(Kind::PODCAST_FIELDS, podcast, [&podcast] {
+        runtime::Hasher hasher(PODCAST_FIELDS_SEED);
+        Update(hasher, static_cast<const Fabric&>(podcast));
+        Update(hasher, podcast.title);
+        Update(hasher, podcast.subtitle);
+        Update(hasher, podcast.description);
+        Update(hasher, podcast.summary);
+        Update(hasher, podcast.language);
+        hasher.Update(static_cast<uint64_t>(podcast.categories.size()));
+        for (const runtime::String& category : podcast.categories) {
+            Update(hasher, category);
+        }
+        Update(hasher, podcast.publicationDate);
+        Update(hasher, podcast.lastBuildDate);
+        Update(hasher, podcast.managingEditor);
+        Update(hasher, podcast.webmaster);
+        Update(hasher, podcast.copyright);
+        Update(hasher, podcast.link);
+        Update(hasher, static_cast<const Fabric&>(podcast.publisher));
+        Update(hasher, podcast.publisher.name);
+        Update(hasher, podcast.publisher.email);
+        Update(hasher, podcast.publisher.url);
+        Update(hasher, podcast.publisher.description);
+        Update(hasher, podcast.coverArt);
+        Update(hasher, podcast.tags);
+        Update(hasher, podcast.contributors);
+        return hasher.Finish();
+    });
+}
+
+runtime::Hash128 ContentHasher::Hash(const Podcast& podcast)
+{
+    // Not cached: the podcast date does not move when a shared entity changes
+    References references;
+    references.Add(podcast.tags, podcast.contributors);
+    for (const Season& season : podcast.seasons) {
+        references.Add(season.tags, season.contributors);
+        for (const Episode& episode : season.episodes) {
+            references.Add(episode.tags, episode.contributors);
+        }
+    }
+    references.Sort();
+
+    runtime::Hasher hasher(PODCAST_SEED);
+    hasher.Update(HashFields(podcast));
+    hasher.Update(static_cast<uint64_t>(podcast.seasons.size()));
+    for (const Season& season : podcast.seasons) {
+        hasher.Update(Hash(season));
+    }
+    hasher.Update(static_cast<uint64_t>(references.contributors.size()));
+    for (const Contributor* contributor : references.contributors) {
+        hasher.Update(Hash(*contributor));
+    }
+    hasher.Update(static_cast<uint64_t>(references.tags.size()));
+    for (const Tag* tag : references.tags) {
+        hasher.Update(Hash(*tag));
+    }
+    return hasher.Finish();
+}
+
+void ContentHasher::Invalidate(const runtime::Guid& id)
+{
+    for (auto& entries : entries_) {
+        entries.erase(id);
+    }
+}
+
+void ContentHasher::Clear() noexcept
+{
+    for (auto& entries : entries_) {
+        entries.clear();
+    }
+}
+} // namespace ultralove::p3::model
@@ -0,0 +1,120 @@
+///
+// \file modelcontenthash.h
+// \brief P3 Model Content Hash
+// \details Merkle hashes over the entities of a podcast
+//
+
+#ifndef __P3_MODEL_CONTENT_HASH_H_INCL__
+#define __P3_MODEL_CONTENT_HASH_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelcontributor.h"
+#include "modelepisode.h"
+#include "modelpodcast.h"
+#include "modelseason.h"
+#include "modeltag.h"
+#include "runtimeguid.h"
+#include "runtimehasher.h"
+#include "runtimetimestamp.h"
+#include <unordered_map>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Content hashes of model entities
+/// \details A content hash covers every value of an entity except its modification date, so two
+/// versions with the same values have the same hash wherever they were computed. Hashes are Merkle
+/// hashes: a season combines its own values with the hashes of its episodes in order, and a podcast
+/// combines its own values with the hashes of its seasons and of every Contributor and Tag it
+/// references. Episodes and tags refer to shared entities by identifier only, so changing a shared
+/// contributor changes the podcast hash but not the hashes of the episodes that credit it. Tags are
+/// hashed by their Tag values; values of derived tag types are not covered.
+///
+/// Hashes are cached by Fabric::id together with Fabric::modificationDate and reused as long as
+/// the date does not move, so after MarkModified() only the modified entities and their parents
+/// are hashed again. Changing an entity without moving its date requires Invalidate(). A hasher is
+/// not thread-safe.
+class ContentHasher
+{
+public:
+    /// \brief Create a hasher with an empty cache
+    ContentHasher() = default;
+
+    /// \brief Destroy the hasher
+    virtual ~ContentHasher() = default;
+
+    ContentHasher(const ContentHasher&)            = delete;
+    ContentHasher& operator=(const ContentHasher&) = delete;
+
+    /// \brief Hash a contributor
+    /// \param contributor Contributor
+    /// \return Content hash
+    runtime::Hash128 Hash(const Contributor& contributor);
+
+    /// \brief Hash a tag, including the identifier of its creator
+    /// \param tag Tag
+    /// \return Content hash
+    runtime::Hash128 Hash(const Tag& tag);
+
+    /// \brief Hash an episode, including the identifiers of its contributors and tags
+    /// \param episode Episode
+    /// \return Content hash
+    runtime::Hash128 Hash(const Episode& episode);
+
+    /// \brief Hash a season and its episodes
+    /// \param season Season
+    /// \return Content hash
+    runtime::Hash128 Hash(const Season& season);
+
+    /// \brief Hash a podcast, its seasons and the shared entities it references
+    /// \details Suitable as a strong ETag of everything a feed of the podcast is rendered from
+    /// \param podcast Podcast
+    /// \return Content hash
+    runtime::Hash128 Hash(const Podcast& podcast);
+
+    /// \brief Hash the values of a season without its episodes
+    /// \param season Season
+    /// \return Content hash
+    runtime::Hash128 HashFields(const Season& season);
+
+    /// \brief Hash the values of a podcast without its seasons and shared entities
+    /// \param podcast Podcast
+    /// \return Content hash
+    runtime::Hash128 HashFields(const Podcast& podcast);
+
+    /// \brief Drop the cached hashes of an entity
+    /// \param id Identifier of the entity
+    void Invalidate(const runtime::Guid& id);
+
+    /// \brief Drop all cached hashes
+    void Clear() noexcept;
+
+private:
+    enum class Kind : uint8_t
+    {
+        CONTRIBUTOR,
+        TAG,
+        EPISODE,
+        SEASON,
+        SEASON_FIELDS,
+        PODCAST_FIELDS
+    };
+
+    struct Entry
+    {
+        runtime::Timestamp modificationDate;
+        runtime::Hash128 hash;
+    };
+
+    template<typename T, typename Compute>
+    runtime::Hash128 Cached(const Kind kind, const T& entity, Compute&& compute);
+
+    std::unordered_map<runtime::Guid, Entry> entries_[6];
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_CONTENT_HASH_H_INCL__
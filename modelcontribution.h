@@ -10,6 +10,7 @@
 #pragma pack(push, 8)
 
 #include "modelcontributor.h"
+#include "modelentityhandle.h"
 #include "runtimestring.h"
 
 namespace ultralove::p3::model {
@@ -17,8 +18,8 @@ namespace ultralove::p3::model {
 /// \details Represents a contributor's contribution to content
 struct Contribution
 {
-    /// \brief Contributing person
-    Contributor contributor;
+    /// \brief Contributing person, shared through an EntityRegistry<Contributor>
+    EntityHandle<Contributor> contributor;
 
     /// \brief Contribution type/role
     runtime::String type;
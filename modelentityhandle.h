@@ -0,0 +1,115 @@
+///
+// \file modelentityhandle.h
+// \brief P3 Model Entity Handle
+// \details Lightweight reference to an entity shared through an EntityRegistry
+//
+
+#ifndef __P3_MODEL_ENTITY_HANDLE_H_INCL__
+#define __P3_MODEL_ENTITY_HANDLE_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "runtimeguid.h"
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Handle to a shared entity
+/// \details Refers to one shared instance of an entity instead of embedding a copy of it. A
+/// contributor appearing in thousands of episodes exists once; every Contribution and Tag only
+/// holds a 16 byte handle. Handles keep their entity alive, so they stay valid even after the
+/// entity has been removed from its EntityRegistry. Handles give read-only access to an immutable
+/// instance; an update through the registry publishes a new instance, which a handle refers to once
+/// it is refreshed, see EntityRegistry::Refresh().
+/// \tparam T Entity type, derived from Fabric
+template<typename T>
+class EntityHandle
+{
+public:
+    /// \brief Create an empty handle
+    EntityHandle() noexcept = default;
+
+    /// \brief Create a handle to an existing shared entity
+    /// \param entity Shared entity
+    explicit EntityHandle(std::shared_ptr<const T> entity) noexcept : entity_(std::move(entity)) {}
+
+    /// \brief Create a handle to a base entity type from a handle to a derived entity type
+    /// \param other Handle to convert, e.g. an EntityHandle<ChapterTag> to an EntityHandle<Tag>
+    template<typename U, typename = std::enable_if_t<std::is_base_of_v<T, U> && (std::is_same_v<T, U> == false)>>
+    EntityHandle(const EntityHandle<U>& other) noexcept : entity_(other.GetShared())
+    {
+    }
+
+    /// \brief Create a handle to a new entity that is not tracked by any registry
+    /// \param entity Entity value
+    /// \return Handle owning the entity
+    static EntityHandle Make(T entity)
+    {
+        return EntityHandle(std::make_shared<const T>(std::move(entity)));
+    }
+
+    /// \brief Check whether the handle refers to an entity
+    /// \return True if the handle is not empty
+    bool IsValid() const noexcept
+    {
+        return entity_ != nullptr;
+    }
+
+    /// \brief Check whether the handle refers to an entity
+    explicit operator bool() const noexcept
+    {
+        return IsValid();
+    }
+
+    /// \brief Get the referenced entity
+    /// \return Pointer to the entity, nullptr for an empty handle
+    const T* Get() const noexcept
+    {
+        return entity_.get();
+    }
+
+    /// \brief Get the shared entity
+    /// \return Shared pointer to the entity
+    const std::shared_ptr<const T>& GetShared() const noexcept
+    {
+        return entity_;
+    }
+
+    /// \brief Get the identifier of the referenced entity
+    /// \return Entity identifier, a zero Guid for an empty handle
+    runtime::Guid GetId() const noexcept
+    {
+        return (entity_ != nullptr) ? entity_->id : runtime::Guid{};
+    }
+
+    /// \brief Access the referenced entity
+    const T& operator*() const noexcept
+    {
+        return *entity_;
+    }
+
+    /// \brief Access the referenced entity
+    const T* operator->() const noexcept
+    {
+        return entity_.get();
+    }
+
+    /// \brief Compare two handles
+    /// \return True if both handles refer to the same instance
+    friend bool operator==(const EntityHandle& lhs, const EntityHandle& rhs) noexcept
+    {
+        return lhs.entity_ == rhs.entity_;
+    }
+
+private:
+    std::shared_ptr<const T> entity_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_ENTITY_HANDLE_H_INCL__
@@ -0,0 +1,125 @@
+///
+// \file modelentityregistry.h
+// \brief P3 Model Entity Registry
+// \details Guid-keyed store of shared entities
+//
+
+#ifndef __P3_MODEL_ENTITY_REGISTRY_H_INCL__
+#define __P3_MODEL_ENTITY_REGISTRY_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelentityhandle.h"
+#include "modelfabric.h"
+#include "runtimeguid.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace ultralove::p3::model {
+/// \brief Registry of shared entities keyed by Fabric::id
+/// \details Holds the current instance of every identifier and hands out EntityHandle references to
+/// it. Instances are immutable: registering an entity whose identifier is already known publishes a
+/// new instance and leaves the previous one untouched, so threads and PodcastVersion snapshots that
+/// hold handles to it keep reading consistent values. Handles pick up the update when they are
+/// looked up again, see Refresh(). The registry is thread-safe.
+/// \tparam T Entity type, derived from Fabric
+template<typename T>
+class EntityRegistry
+{
+    static_assert(std::is_base_of_v<Fabric, T>, "registered entities must derive from Fabric");
+
+public:
+    EntityRegistry() = default;
+    virtual ~EntityRegistry() = default;
+
+    EntityRegistry(const EntityRegistry&)            = delete;
+    EntityRegistry& operator=(const EntityRegistry&) = delete;
+
+    /// \brief Add an entity or replace the entity with the same identifier
+    /// \param entity Entity value
+    /// \return Handle to the new shared instance
+    EntityHandle<T> Register(T entity)
+    {
+        return Register(EntityHandle<T>::Make(std::move(entity)));
+    }
+
+    /// \brief Add an existing shared instance or replace the entity with the same identifier
+    /// \param entity Handle to the instance, nothing is registered for an empty handle
+    /// \return The handle passed in
+    EntityHandle<T> Register(EntityHandle<T> entity)
+    {
+        if (entity) {
+            const std::unique_lock<std::shared_mutex> lock(mutex_);
+            entities_.insert_or_assign(entity->id, entity.GetShared());
+        }
+        return entity;
+    }
+
+    /// \brief Look up an entity
+    /// \param id Entity identifier
+    /// \return Handle to the shared instance, empty if the identifier is unknown
+    EntityHandle<T> Find(const runtime::Guid& id) const
+    {
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        const auto it = entities_.find(id);
+        return (it != entities_.end()) ? EntityHandle<T>(it->second) : EntityHandle<T>();
+    }
+
+    /// \brief Point a handle at the current instance of its entity
+    /// \param handle Handle to update, left as it is if its entity is not registered
+    /// \return True if the handle refers to a registered entity
+    bool Refresh(EntityHandle<T>& handle) const
+    {
+        if (handle.IsValid() == false) {
+            return false;
+        }
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        const auto it = entities_.find(handle->id);
+        if (it == entities_.end()) {
+            return false;
+        }
+        if (handle.GetShared() != it->second) {
+            handle = EntityHandle<T>(it->second);
+        }
+        return true;
+    }
+
+    /// \brief Remove an entity from the registry
+    /// \details Existing handles keep the entity alive
+    /// \param id Entity identifier
+    /// \return True if the entity was registered
+    bool Remove(const runtime::Guid& id)
+    {
+        const std::unique_lock<std::shared_mutex> lock(mutex_);
+        return entities_.erase(id) > 0;
+    }
+
+    /// \brief Get the number of registered entities
+    /// \return Entity count
+    size_t GetCount() const
+    {
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        return entities_.size();
+    }
+
+    /// \brief Remove all entities from the registry
+    void Clear()
+    {
+        const std::unique_lock<std::shared_mutex> lock(mutex_);
+        entities_.clear();
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<runtime::Guid, std::shared_ptr<const T>> entities_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_ENTITY_REGISTRY_H_INCL__
@@ -0,0 +1,124 @@
+///
+// \file modelepisodestore.cpp
+// \brief P3 Model Episode Store implementation
+// \details Row construction and column scans
+//
+
+#include "modelepisodestore.h"
+
+namespace ultralove::p3::model {
+uint32_t EpisodeStore::AddPodcast(const Podcast& podcast)
+{
+    const uint32_t index = static_cast<uint32_t>(podcasts_.size());
+    podcasts_.push_back(&podcast);
+    AddRows(index);
+    return index;
+}
+
+void EpisodeStore::Rebuild()
+{
+    locations_.clear();
+    episodeNumbers_.clear();
+    types_.clear();
+    publicationDates_.clear();
+    durations_.clear();
+    enclosureOffsets_.assign(1, 0);
+    enclosureFileSizes_.clear();
+    enclosureTypes_.clear();
+    enclosureRows_.clear();
+    for (uint32_t podcast = 0; podcast < podcasts_.size(); ++podcast) {
+        AddRows(podcast);
+    }
+}
+
+void EpisodeStore::Clear() noexcept
+{
+    podcasts_.clear();
+    Rebuild();
+}
+
+void EpisodeStore::AddRows(const uint32_t podcast)
+{
+    const std::vector<Season>& seasons = podcasts_[podcast]->seasons;
+    size_t episodes                    = 0;
+    for (const Season& season : seasons) {
+        episodes += season.episodes.size();
+    }
+    const size_t rows = locations_.size() + episodes;
+    locations_.reserve(rows);
+    episodeNumbers_.reserve(rows);
+    types_.reserve(rows);
+    publicationDates_.reserve(rows);
+    durations_.reserve(rows);
+    enclosureOffsets_.reserve(rows + 1);
+
+    for (uint32_t seasonIndex = 0; seasonIndex < seasons.size(); ++seasonIndex) {
+        const std::vector<Episode>& seasonEpisodes = seasons[seasonIndex].episodes;
+        for (uint32_t episodeIndex = 0; episodeIndex < seasonEpisodes.size(); ++episodeIndex) {
+            const Episode& episode = seasonEpisodes[episodeIndex];
+            const uint32_t row     = static_cast<uint32_t>(locations_.size());
+            locations_.push_back(EpisodeLocation{podcast, seasonIndex, episodeIndex});
+            episodeNumbers_.push_back(episode.episodeNumber);
+            types_.push_back(static_cast<uint8_t>(episode.type));
+            publicationDates_.push_back(episode.publicationDate.GetMicroseconds());
+            durations_.push_back(episode.duration.GetNanoseconds());
+            for (const Enclosure& enclosure : episode.enclosures) {
+                enclosureFileSizes_.push_back(enclosure.fileSize);
+                enclosureTypes_.push_back(static_cast<uint8_t>(enclosure.type));
+                enclosureRows_.push_back(row);
+            }
+            enclosureOffsets_.push_back(static_cast<uint32_t>(enclosureFileSizes_.size()));
+        }
+    }
+}
+
+// The scans below avoid branches in their loop bodies so the compiler can vectorize them
+
+runtime::Timespan EpisodeStore::SumDuration(const runtime::Timestamp& from, const runtime::Timestamp& until) const noexcept
+{
+    const int64_t lower      = from.GetMicroseconds();
+    const int64_t upper      = until.GetMicroseconds();
+    const size_t count       = publicationDates_.size();
+    const int64_t* dates     = publicationDates_.data();
+    const int64_t* durations = durations_.data();
+    int64_t total            = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const int64_t mask = -static_cast<int64_t>((dates[i] >= lower) & (dates[i] < upper));
+        total += durations[i] & mask;
+    }
+    return runtime::Timespan::FromNanoseconds(total);
+}
+
+size_t EpisodeStore::CountPublished(const runtime::Timestamp& from, const runtime::Timestamp& until) const noexcept
+{
+    const int64_t lower  = from.GetMicroseconds();
+    const int64_t upper  = until.GetMicroseconds();
+    const size_t count   = publicationDates_.size();
+    const int64_t* dates = publicationDates_.data();
+    size_t total         = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += static_cast<size_t>((dates[i] >= lower) & (dates[i] < upper));
+    }
+    return total;
+}
+
+size_t EpisodeStore::FindEnclosures(const EnclosureType type, const uint64_t minimumFileSize, std::vector<uint32_t>& enclosures) const
+{
+    const uint8_t wanted  = static_cast<uint8_t>(type);
+    const size_t count    = enclosureFileSizes_.size();
+    const size_t first    = enclosures.size();
+    const uint64_t* sizes = enclosureFileSizes_.data();
+    const uint8_t* types  = enclosureTypes_.data();
+
+    // Write every candidate and advance only on a match, which keeps the loop free of branches
+    enclosures.resize(first + count);
+    uint32_t* target = enclosures.data() + first;
+    size_t found     = 0;
+    for (size_t i = 0; i < count; ++i) {
+        target[found] = static_cast<uint32_t>(i);
+        found += static_cast<size_t>((types[i] == wanted) & (sizes[i] >= minimumFileSize));
+    }
+    enclosures.resize(first + found);
+    return found;
+}
+} // namespace ultralove::p3::model
@@ -0,0 +1,198 @@
+///
+// \file modelepisodestore.h
+// \brief P3 Model Episode Store
+// \details Columnar copy of the scalar episode and enclosure fields of a catalog
+//
+
+#ifndef __P3_MODEL_EPISODE_STORE_H_INCL__
+#define __P3_MODEL_EPISODE_STORE_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelenclosuretype.h"
+#include "modelepisode.h"
+#include "modelepisodetype.h"
+#include "modelpodcast.h"
+#include "runtimetimespan.h"
+#include "runtimetimestamp.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Position of an episode in the podcasts of an EpisodeStore
+struct EpisodeLocation
+{
+    /// \brief Index of the podcast in the order the podcasts were added
+    uint32_t podcast;
+
+    /// \brief Index into Podcast::seasons
+    uint32_t season;
+
+    /// \brief Index into Season::episodes
+    uint32_t episode;
+};
+
+/// \brief Columnar episode store
+/// \details Keeps the hot scalar fields of every episode of a set of podcasts in contiguous arrays,
+/// one row per episode, so catalog-wide scans run over dense memory instead of chasing pointers
+/// through podcasts, seasons and episodes. Each row maps back to the full Episode through its
+/// EpisodeLocation. Enclosures have their own rows; the enclosures of episode row r are the
+/// enclosure rows GetEnclosureOffsets()[r] up to GetEnclosureOffsets()[r + 1].
+///
+/// Publication dates are stored as microseconds since the epoch in UTC and durations as
+/// nanoseconds. The store refers to the podcasts it was given, which must outlive it; after seasons
+/// or episodes were added to or removed from one of them, call Rebuild(). A store is not
+/// thread-safe, concurrent reads without writes are fine.
+class EpisodeStore
+{
+public:
+    /// \brief Create an empty store
+    EpisodeStore() = default;
+
+    /// \brief Destroy the store
+    virtual ~EpisodeStore() = default;
+
+    EpisodeStore(const EpisodeStore&)            = delete;
+    EpisodeStore& operator=(const EpisodeStore&) = delete;
+
+    /// \brief Add the episodes of a podcast
+    /// \param podcast Podcast to add, must outlive the store
+    /// \return Index of the podcast as used by EpisodeLocation::podcast
+    uint32_t AddPodcast(const Podcast& podcast);
+
+    /// \brief Re-read all rows from the podcasts that were added
+    void Rebuild();
+
+    /// \brief Remove all podcasts and rows
+    void Clear() noexcept;
+
+    /// \brief Get the number of episode rows
+    /// \return Number of episodes of all podcasts
+    size_t GetRowCount() const noexcept
+    {
+        return locations_.size();
+    }
+
+    /// \brief Get the number of enclosure rows
+    /// \return Number of enclosures of all episodes
+    size_t GetEnclosureCount() const noexcept
+    {
+        return enclosureFileSizes_.size();
+    }
+
+    /// \brief Get the podcast of an EpisodeLocation::podcast index
+    /// \param podcast Podcast index
+    /// \return Podcast
+    const Podcast& GetPodcast(const uint32_t podcast) const noexcept
+    {
+        return *podcasts_[podcast];
+    }
+
+    /// \brief Get the location of a row
+    /// \param row Episode row
+    /// \return Location of the episode
+    const EpisodeLocation& GetLocation(const size_t row) const noexcept
+    {
+        return locations_[row];
+    }
+
+    /// \brief Get the full episode of a row
+    /// \param row Episode row
+    /// \return Episode
+    const Episode& GetEpisode(const size_t row) const noexcept
+    {
+        const EpisodeLocation& location = locations_[row];
+        return podcasts_[location.podcast]->seasons[location.season].episodes[location.episode];
+    }
+
+    /// \brief Episode::episodeNumber column
+    std::span<const uint32_t> GetEpisodeNumbers() const noexcept
+    {
+        return episodeNumbers_;
+    }
+
+    /// \brief Episode::type column, as EpisodeType values
+    std::span<const uint8_t> GetTypes() const noexcept
+    {
+        return types_;
+    }
+
+    /// \brief Episode::publicationDate column, microseconds since the epoch in UTC
+    std::span<const int64_t> GetPublicationDates() const noexcept
+    {
+        return publicationDates_;
+    }
+
+    /// \brief Episode::duration column, nanoseconds
+    std::span<const int64_t> GetDurations() const noexcept
+    {
+        return durations_;
+    }
+
+    /// \brief First enclosure row of every episode row, followed by the enclosure count
+    std::span<const uint32_t> GetEnclosureOffsets() const noexcept
+    {
+        return enclosureOffsets_;
+    }
+
+    /// \brief Enclosure::fileSize column
+    std::span<const uint64_t> GetEnclosureFileSizes() const noexcept
+    {
+        return enclosureFileSizes_;
+    }
+
+    /// \brief Enclosure::type column, as EnclosureType values
+    std::span<const uint8_t> GetEnclosureTypes() const noexcept
+    {
+        return enclosureTypes_;
+    }
+
+    /// \brief Episode row of every enclosure row
+    std::span<const uint32_t> GetEnclosureRows() const noexcept
+    {
+        return enclosureRows_;
+    }
+
+    /// \brief Sum the durations of all episodes published in a period
+    /// \param from Start of the period, inclusive
+    /// \param until End of the period, exclusive
+    /// \return Total duration
+    runtime::Timespan SumDuration(const runtime::Timestamp& from, const runtime::Timestamp& until) const noexcept;
+
+    /// \brief Count the episodes published in a period
+    /// \param from Start of the period, inclusive
+    /// \param until End of the period, exclusive
+    /// \return Number of episodes
+    size_t CountPublished(const runtime::Timestamp& from, const runtime::Timestamp& until) const noexcept;
+
+    /// \brief Find enclosures by type and minimum file size
+    /// \param type Enclosure type
+    /// \param minimumFileSize Smallest file size to include in bytes
+    /// \param enclosures Receives the matching enclosure rows in ascending order
+    /// \return Number of rows appended
+    size_t FindEnclosures(const EnclosureType type, const uint64_t minimumFileSize, std::vector<uint32_t>& enclosures) const;
+
+private:
+    void AddRows(const uint32_t podcast);
+
+    std::vector<const Podcast*> podcasts_;
+    std::vector<EpisodeLocation> locations_;
+    std::vector<uint32_t> episodeNumbers_;
+    std::vector<uint8_t> types_;
+    std::vector<int64_t> publicationDates_;
+    std::vector<int64_t> durations_;
+    std::vector<uint32_t> enclosureOffsets_ = {0};
+    std::vector<uint64_t> enclosureFileSizes_;
+    std::vector<uint8_t> enclosureTypes_;
+    std::vector<uint32_t> enclosureRows_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_EPISODE_STORE_H_INCL__
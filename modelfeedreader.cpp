@@ -0,0 +1,613 @@
+///
+// \file modelfeedreader.cpp
+// \brief P3 Model Feed Reader implementation
+// \details Mapping of RSS 2.0, iTunes, Podcasting 2.0 and Atom elements to the object model
+//
+
+#include "modelfeedreader.h"
+
+#include "modelparsing.h"
+#include "runtimemappedfile.h"
+
+#include <cstring>
+
+namespace ultralove::p3::model {
+namespace {
+using namespace parsing;
+
+// Elements known to the reader; RSS and Atom share names where their meaning is the same
+enum class Field
+{
+    UNKNOWN,
+    AUTHOR,
+    CONTENT,
+    CONTENT_ENCODED,
+    COPYRIGHT,
+    DESCRIPTION,
+    EMAIL,
+    ENCLOSURE,
+    ENTRY,
+    GUID,
+    ICON,
+    ID,
+    IMAGE,
+    ITEM,
+    ITUNES_AUTHOR,
+    ITUNES_CATEGORY,
+    ITUNES_DURATION,
+    ITUNES_EMAIL,
+    ITUNES_EPISODE,
+    ITUNES_EPISODE_TYPE,
+    ITUNES_IMAGE,
+    ITUNES_NAME,
+    ITUNES_OWNER,
+    ITUNES_SEASON,
+    ITUNES_SUBTITLE,
+    ITUNES_SUMMARY,
+    LANGUAGE,
+    LAST_BUILD_DATE,
+    LINK,
+    LOGO,
+    MANAGING_EDITOR,
+    NAME,
+    PODCAST_EPISODE,
+    PODCAST_GUID,
+    PODCAST_PERSON,
+    PODCAST_SEASON,
+    PUB_DATE,
+    PUBLISHED,
+    RIGHTS,
+    SUBTITLE,
+    SUMMARY,
+    TITLE,
+    UPDATED,
+    URL,
+    WEBMASTER
+};
+
+constexpr FieldName<Field> FIELD_NAMES[] = {{"author", Field::AUTHOR}, {"content", Field::CONTENT}, {"content:encoded", Field::CONTENT_ENCODED},
+    {"copyright", Field::COPYRIGHT}, {"description", Field::DESCRIPTION}, {"email", Field::EMAIL}, {"enclosure", Field::ENCLOSURE},
+    {"entry", Field::ENTRY}, {"guid", Field::GUID}, {"icon", Field::ICON}, {"id", Field::ID}, {"image", Field::IMAGE}, {"item", Field::ITEM},
+    {"itunes:author", Field::ITUNES_AUTHOR}, {"itunes:category", Field::ITUNES_CATEGORY}, {"itunes:duration", Field::ITUNES_DURATION},
+    {"itunes:email", Field::ITUNES_EMAIL}, {"itunes:episode", Field::ITUNES_EPISODE}, {"itunes:episodeType", Field::ITUNES_EPISODE_TYPE},
+    {"itunes:image", Field::ITUNES_IMAGE}, {"itunes:name", Field::ITUNES_NAME}, {"itunes:owner", Field::ITUNES_OWNER},
+    {"itunes:season", Field::ITUNES_SEASON}, {"itunes:subtitle", Field::ITUNES_SUBTITLE}, {"itunes:summary", Field::ITUNES_SUMMARY},
+    {"language", Field::LANGUAGE}, {"lastBuildDate", Field::LAST_BUILD_DATE}, {"link", Field::LINK}, {"logo", Field::LOGO},
+    {"managingEditor", Field::MANAGING_EDITOR}, {"name", Field::NAME}, {"podcast:episode", Field::PODCAST_EPISODE},
+    {"podcast:guid", Field::PODCAST_GUID}, {"podcast:person", Field::PODCAST_PERSON}, {"podcast:season", Field::PODCAST_SEASON},
+    {"pubDate", Field::PUB_DATE}, {"published", Field::PUBLISHED}, {"rights", Field::RIGHTS}, {"subtitle", Field::SUBTITLE},
+    {"summary", Field::SUMMARY}, {"title", Field::TITLE}, {"updated", Field::UPDATED}, {"url", Field::URL}, {"webMaster", Field::WEBMASTER}};
+
+constexpr NameTable FIELDS(FIELD_NAMES);
+
+Field Classify(const std::string_view name) noexcept
+{
+    return FIELDS.Find(name, Field::UNKNOWN);
+}
+} // namespace
+
+FeedReader::FeedReader(runtime::Arena& arena) : arena_(arena) {}
+
+bool FeedReader::ReadFile(const char* path, Podcast& podcast)
+{
+    // All strings end up inline or in the arena, so the mapping is released right after reading
+    runtime::MappedFile file;
+    if (file.Open(path) == false) {
+        return false;
+    }
+    return Read(file.GetView(), podcast);
+}
+
+bool FeedReader::Read(const std::string_view document, Podcast& podcast)
+{
+    podcast = Podcast{};
+    contributors_.clear();
+
+    runtime::XmlReader reader(document);
+    if (reader.Next() != runtime::XmlToken::START_ELEMENT) {
+        return false;
+    }
+
+    // Atom puts the channel fields on the root element, RSS wraps them in <channel>
+    if (reader.GetName() == "feed") {
+        return ReadChannel(reader, podcast);
+    }
+    if (reader.GetName() != "rss") {
+        return false;
+    }
+    bool found = false;
+    for (;;) {
+        const runtime::XmlToken token = reader.Next();
+        if (token == runtime::XmlToken::START_ELEMENT) {
+            if ((reader.GetName() == "channel") && (found == false)) {
+                if (ReadChannel(reader, podcast) == false) {
+                    return false;
+                }
+                found = true;
+            }
+            else if (reader.Skip() == false) {
+                return false;
+            }
+        }
+        else if (token == runtime::XmlToken::END_ELEMENT) {
+            return found;
+        }
+        else if (token != runtime::XmlToken::TEXT) {
+            return false;
+        }
+    }
+}
+
+bool FeedReader::ReadChannel(runtime::XmlReader& reader, Podcast& podcast)
+{
+    const size_t depth = reader.GetDepth();
+    runtime::XmlValue value;
+    for (;;) {
+        const runtime::XmlToken token = reader.Next();
+        if ((token == runtime::XmlToken::END_ELEMENT) && (reader.GetDepth() == depth)) {
+            return true;
+        }
+        if ((token == runtime::XmlToken::END) || (token == runtime::XmlToken::INVALID)) {
+            return false;
+        }
+        if (token != runtime::XmlToken::START_ELEMENT) {
+            continue;
+        }
+
+        bool good = true;
+        switch (Classify(reader.GetName())) {
+        case Field::ITEM:
+        case Field::ENTRY:
+            good = ReadItem(reader, podcast);
+            break;
+        case Field::TITLE:
+            good          = ReadText(reader, value);
+            podcast.title = MakeString(value);
+            break;
+        case Field::LINK:
+            // Atom links carry the target in href and may point to anything; only the page counts
+            if (const auto href = reader.GetAttribute("href")) {
+                const auto rel = reader.GetAttribute("rel");
+                if ((rel.has_value() == false) || (rel->raw == "alternate")) {
+                    podcast.link = MakeString(*href);
+                }
+                good = reader.Skip();
+            }
+            else {
+                good         = ReadText(reader, value);
+                podcast.link = MakeString(value);
+            }
+            break;
+        case Field::DESCRIPTION:
+            good                = ReadText(reader, value);
+            podcast.description = MakeString(value);
+            break;
+        case Field::SUBTITLE:
+        case Field::ITUNES_SUBTITLE:
+            good             = ReadText(reader, value);
+            podcast.subtitle = MakeString(value);
+            break;
+        case Field::SUMMARY:
+        case Field::ITUNES_SUMMARY:
+            good            = ReadText(reader, value);
+            podcast.summary = MakeString(value);
+            break;
+        case Field::LANGUAGE:
+            good             = ReadText(reader, value);
+            podcast.language = MakeInterned(value);
+            break;
+        case Field::COPYRIGHT:
+        case Field::RIGHTS:
+            good              = ReadText(reader, value);
+            podcast.copyright = MakeString(value);
+            break;
+        case Field::MANAGING_EDITOR:
+            good                   = ReadText(reader, value);
+            podcast.managingEditor = MakeString(value);
+            break;
+        case Field::WEBMASTER:
+            good              = ReadText(reader, value);
+            podcast.webmaster = MakeString(value);
+            break;
+        case Field::PUB_DATE:
+        case Field::PUBLISHED:
+            good                    = ReadText(reader, value);
+            podcast.publicationDate = ParseDate(Decode(value));
+            break;
+        case Field::LAST_BUILD_DATE:
+        case Field::UPDATED:
+            good                  = ReadText(reader, value);
+            podcast.lastBuildDate = ParseDate(Decode(value));
+            break;
+        case Field::ID:
+        case Field::PODCAST_GUID:
+            good       = ReadText(reader, value);
+            podcast.id = ParseGuid(Decode(value));
+            break;
+        case Field::ITUNES_AUTHOR:
+            good                   = ReadText(reader, value);
+            podcast.publisher.name = MakeString(value);
+            break;
+        case Field::AUTHOR:
+        case Field::ITUNES_OWNER:
+            // Name and email of the owner or Atom author describe the publisher
+            for (runtime::XmlToken child = reader.Next(); good && ((child != runtime::XmlToken::END_ELEMENT) || (reader.GetDepth() > depth + 1));
+                 child                   = reader.Next()) {
+                if ((child == runtime::XmlToken::END) || (child == runtime::XmlToken::INVALID)) {
+                    return false;
+                }
+                if (child != runtime::XmlToken::START_ELEMENT) {
+                    continue;
+                }
+                const Field field = Classify(reader.GetName());
+                if ((field == Field::NAME) || (field == Field::ITUNES_NAME)) {
+                    good = ReadText(reader, value);
+                    if (podcast.publisher.name.IsEmpty()) {
+                        podcast.publisher.name = MakeString(value);
+                    }
+                }
+                else if ((field == Field::EMAIL) || (field == Field::ITUNES_EMAIL)) {
+                    good                    = ReadText(reader, value);
+                    podcast.publisher.email = MakeString(value);
+                }
+                else {
+                    good = reader.Skip();
+                }
+            }
+            break;
+        case Field::ITUNES_IMAGE:
+            if (const auto href = reader.GetAttribute("href")) {
+                podcast.coverArt.uri  = MakeString(*href);
+                podcast.coverArt.type = PictureTypeFromUri(podcast.coverArt.uri.GetView());
+            }
+            good = reader.Skip();
+            break;
+        case Field::IMAGE:
+            // RSS <image><url>, only used when there is no itunes:image
+            for (runtime::XmlToken child = reader.Next(); good && ((child != runtime::XmlToken::END_ELEMENT) || (reader.GetDepth() > depth + 1));
+                 child                   = reader.Next()) {
+                if ((child == runtime::XmlToken::END) || (child == runtime::XmlToken::INVALID)) {
+                    return false;
+                }
+                if (child != runtime::XmlToken::START_ELEMENT) {
+                    continue;
+                }
+                if (Classify(reader.GetName()) == Field::URL) {
+                    good = ReadText(reader, value);
+                    if (podcast.coverArt.uri.IsEmpty()) {
+                        podcast.coverArt.uri  = MakeString(value);
+                        podcast.coverArt.type = PictureTypeFromUri(podcast.coverArt.uri.GetView());
+                    }
+                }
+                else {
+                    good = reader.Skip();
+                }
+            }
+            break;
+        case Field::LOGO:
+        case Field::ICON:
+            good = ReadText(reader, value);
+            if (podcast.coverArt.uri.IsEmpty()) {
+                podcast.coverArt.uri  = MakeString(value);
+                podcast.coverArt.type = PictureTypeFromUri(podcast.coverArt.uri.GetView());
+            }
+            break;
+        case Field::ITUNES_CATEGORY:
+            good = ReadCategories(reader, podcast.categories);
+            break;
+        case Field::PODCAST_PERSON:
+            good = ReadPerson(reader, podcast.contributors);
+            break;
+        default:
+            good = reader.Skip();
+            break;
+        }
+        if (good == false) {
+            return false;
+        }
+    }
+}
+
+bool FeedReader::ReadItem(runtime::XmlReader& reader, Podcast& podcast)
+{
+    const size_t depth = reader.GetDepth();
+    Episode episode{};
+    uint32_t seasonNumber = 0;
+    runtime::String seasonTitle;
+    runtime::XmlValue value;
+    for (;;) {
+        const runtime::XmlToken token = reader.Next();
+        if ((token == runtime::XmlToken::END_ELEMENT) && (reader.GetDepth() == depth)) {
+            break;
+        }
+        if ((token == runtime::XmlToken::END) || (token == runtime::XmlToken::INVALID)) {
+            return false;
+        }
+        if (token != runtime::XmlToken::START_ELEMENT) {
+            continue;
+        }
+
+        bool good = true;
+        switch (Classify(reader.GetName())) {
+        case Field::TITLE:
+            good          = ReadText(reader, value);
+            episode.title = MakeString(value);
+            break;
+        case Field::DESCRIPTION:
+            good                = ReadText(reader, value);
+            episode.description = MakeString(value);
+            break;
+        case Field::CONTENT_ENCODED:
+        case Field::CONTENT:
+            // Full show notes, used when the feed has no shorter description
+            good = ReadText(reader, value);
+            if (episode.description.IsEmpty()) {
+                episode.description = MakeString(value);
+            }
+            break;
+        case Field::SUBTITLE:
+        case Field::ITUNES_SUBTITLE:
+            good             = ReadText(reader, value);
+            episode.subtitle = MakeString(value);
+            break;
+        case Field::SUMMARY:
+        case Field::ITUNES_SUMMARY:
+            good            = ReadText(reader, value);
+            episode.summary = MakeString(value);
+            break;
+        case Field::GUID:
+        case Field::ID:
+            good       = ReadText(reader, value);
+            episode.id = ParseGuid(Decode(value));
+            break;
+        case Field::PUB_DATE:
+        case Field::PUBLISHED:
+            good                    = ReadText(reader, value);
+            episode.publicationDate = ParseDate(Decode(value));
+            break;
+        case Field::UPDATED:
+            good = ReadText(reader, value);
+            if (episode.publicationDate == runtime::Timestamp()) {
+                episode.publicationDate = ParseDate(Decode(value));
+            }
+            break;
+        case Field::ENCLOSURE:
+            if (const auto url = reader.GetAttribute("url")) {
+                AddEnclosure(reader, *url, episode);
+            }
+            good = reader.Skip();
+            break;
+        case Field::LINK:
+            if (const auto href = reader.GetAttribute("href")) {
+                const auto rel = reader.GetAttribute("rel");
+                if (rel.has_value() && (rel->raw == "enclosure")) {
+                    AddEnclosure(reader, *href, episode);
+                }
+            }
+            good = reader.Skip();
+            break;
+        case Field::ITUNES_DURATION:
+            good             = ReadText(reader, value);
+            episode.duration = runtime::Timespan::Parse(Decode(value)).value_or(runtime::Timespan());
+            break;
+        case Field::ITUNES_EPISODE:
+        case Field::PODCAST_EPISODE:
+            good                  = ReadText(reader, value);
+            episode.episodeNumber = ParseNumber<uint32_t>(Decode(value));
+            break;
+        case Field::ITUNES_SEASON:
+            good         = ReadText(reader, value);
+            seasonNumber = ParseNumber<uint32_t>(Decode(value));
+            break;
+        case Field::PODCAST_SEASON:
+            if (const auto name = reader.GetAttribute("name")) {
+                seasonTitle = MakeString(*name);
+            }
+            good         = ReadText(reader, value);
+            seasonNumber = ParseNumber<uint32_t>(Decode(value));
+            break;
+        case Field::ITUNES_EPISODE_TYPE:
+            good         = ReadText(reader, value);
+            episode.type = EpisodeTypeFromName(Decode(value));
+            break;
+        case Field::ITUNES_IMAGE:
+            if (const auto href = reader.GetAttribute("href")) {
+                episode.coverArt.uri  = MakeString(*href);
+                episode.coverArt.type = PictureTypeFromUri(episode.coverArt.uri.GetView());
+            }
+            good = reader.Skip();
+            break;
+        case Field::PODCAST_PERSON:
+            good = ReadPerson(reader, episode.contributors);
+            break;
+        default:
+            good = reader.Skip();
+            break;
+        }
+        if (good == false) {
+            return false;
+        }
+    }
+
+    Season& season = GetSeason(podcast, seasonNumber);
+    if (season.title.IsEmpty() && (seasonTitle.IsEmpty() == false)) {
+        season.title = std::move(seasonTitle);
+    }
+    season.episodes.push_back(std::move(episode));
+    return true;
+}
+
+bool FeedReader::ReadText(runtime::XmlReader& reader, runtime::XmlValue& value)
+{
+    // Almost every element holds exactly one text or CDATA token, which is used without copying;
+    // only mixed content is assembled in the text buffer
+    const size_t depth = reader.GetDepth();
+    value              = runtime::XmlValue();
+    bool assembled     = false;
+    for (;;) {
+        const runtime::XmlToken token = reader.Next();
+        if (token == runtime::XmlToken::TEXT) {
+            const runtime::XmlValue& text = reader.GetText();
+            if (Trim(text.raw).empty() && (text.encoded == false)) {
+                continue;
+            }
+            if (Trim(value.raw).empty()) {
+                value     = text;
+                assembled = false;
+                continue;
+            }
+            if (assembled == false) {
+                const std::string_view first = Decode(value);
+                text_.assign(first.data(), first.size());
+                assembled = true;
+            }
+            const std::string_view next = Decode(text);
+            text_.append(next.data(), next.size());
+            value = runtime::XmlValue{text_, false};
+        }
+        else if (token == runtime::XmlToken::START_ELEMENT) {
+            if (reader.Skip() == false) {
+                return false;
+            }
+        }
+        else if ((token == runtime::XmlToken::END_ELEMENT) && (reader.GetDepth() == depth)) {
+            value.raw = Trim(value.raw);
+            return true;
+        }
+        else if ((token == runtime::XmlToken::END) || (token == runtime::XmlToken::INVALID)) {
+            return false;
+        }
+    }
+}
+
+bool FeedReader::ReadCategories(runtime::XmlReader& reader, std::vector<runtime::String>& categories)
+{
+    // Subcategories are nested inside their parent and added after it
+    const size_t depth = reader.GetDepth();
+    if (const auto text = reader.GetAttribute("text")) {
+        categories.push_back(MakeInterned(*text));
+    }
+    for (;;) {
+        const runtime::XmlToken token = reader.Next();
+        if ((token == runtime::XmlToken::END_ELEMENT) && (reader.GetDepth() == depth)) {
+            return true;
+        }
+        if ((token == runtime::XmlToken::END) || (token == runtime::XmlToken::INVALID)) {
+            return false;
+        }
+        if (token == runtime::XmlToken::START_ELEMENT) {
+            const bool good = (Classify(reader.GetName()) == Field::ITUNES_CATEGORY) ? ReadCategories(reader, categories) : reader.Skip();
+            if (good == false) {
+                return false;
+            }
+        }
+    }
+}
+
+bool FeedReader::ReadPerson(runtime::XmlReader& reader, std::vector<Contribution>& contributions)
+{
+    Contribution contribution;
+    const auto role = reader.GetAttribute("role");
+    contribution.type = role.has_value() ? MakeInterned(*role) : runtime::String::Intern("host");
+    const auto href   = reader.GetAttribute("href");
+    const auto image  = reader.GetAttribute("img");
+
+    // Attribute views point into the document and stay valid while the text is read
+    runtime::XmlValue name;
+    if ((ReadText(reader, name) == false)) {
+        return false;
+    }
+    if (name.raw.empty()) {
+        return true;
+    }
+
+    // Persons share a contributor when they share its identifier; a link alone identifies a person,
+    // so the name is only decoded without one and the two never need the decode buffer at once
+    const std::string_view link = href.has_value() ? Trim(Decode(*href)) : std::string_view();
+    const runtime::Guid id      = (link.empty() == false) ? MakeContributorId(std::string_view(), link) : MakeContributorId(Decode(name), link);
+    const auto existing         = contributors_.find(id);
+    if (existing != contributors_.end()) {
+        contribution.contributor = existing->second;
+    }
+    else {
+        Contributor contributor{};
+        contributor.name = MakeString(name);
+        if (href.has_value()) {
+            contributor.url = MakeString(*href);
+        }
+        contributor.id = id;
+        if (image.has_value()) {
+            contributor.image.uri  = MakeString(*image);
+            contributor.image.type = PictureTypeFromUri(contributor.image.uri.GetView());
+        }
+        contribution.contributor = EntityHandle<Contributor>::Make(std::move(contributor));
+        contributors_.emplace(id, contribution.contributor);
+    }
+    contributions.push_back(std::move(contribution));
+    return true;
+}
+
+void FeedReader::AddEnclosure(const runtime::XmlReader& reader, const runtime::XmlValue& url, Episode& episode)
+{
+    Enclosure enclosure{};
+    enclosure.uri = MakeString(url);
+    if (const auto length = reader.GetAttribute("length")) {
+        enclosure.fileSize = ParseNumber<uint64_t>(Trim(Decode(*length)));
+    }
+    if (const auto type = reader.GetAttribute("type")) {
+        enclosure.mimeType = MakeInterned(*type);
+    }
+    enclosure.type = EnclosureTypeFromMime(enclosure.mimeType.GetView());
+    episode.enclosures.push_back(std::move(enclosure));
+}
+
+Season& FeedReader::GetSeason(Podcast& podcast, const uint32_t seasonNumber)
+{
+    // Feeds list episodes of one season together, so the last season is almost always the match
+    for (size_t i = podcast.seasons.size(); i > 0; --i) {
+        if (podcast.seasons[i - 1].seasonNumber == seasonNumber) {
+            return podcast.seasons[i - 1];
+        }
+    }
+    Season season{};
+    season.seasonNumber = seasonNumber;
+    podcast.seasons.push_back(std::move(season));
+    return podcast.seasons.back();
+}
+
+runtime::String FeedReader::MakeString(const runtime::XmlValue& value)
+{
+    const std::string_view raw = value.raw;
+    if (value.encoded == false) {
+        return runtime::String(raw, arena_);
+    }
+    if (raw.size() <= runtime::String::INLINE_CAPACITY) {
+        char decoded[runtime::String::INLINE_CAPACITY];
+        return runtime::String(std::string_view(decoded, runtime::XmlReader::Decode(raw, decoded)));
+    }
+
+    // Decoding never grows the value, so it goes straight into its final place in the arena
+    char* target        = static_cast<char*>(arena_.Allocate(raw.size() + 1, 1));
+    const size_t length = runtime::XmlReader::Decode(raw, target);
+    target[length]      = '\0';
+    if (length <= runtime::String::INLINE_CAPACITY) {
+        return runtime::String(std::string_view(target, length));
+    }
+    return runtime::String::Reference(std::string_view(target, length));
+}
+
+runtime::String FeedReader::MakeInterned(const runtime::XmlValue& value)
+{
+    return runtime::String::Intern(Trim(Decode(value)));
+}
+
+std::string_view FeedReader::Decode(const runtime::XmlValue& value)
+{
+    if (value.encoded == false) {
+        return value.raw;
+    }
+    decoded_.resize(value.raw.size());
+    decoded_.resize(runtime::XmlReader::Decode(value.raw, decoded_.data()));
+    return decoded_;
+}
+} // namespace ultralove::p3::model
@@ -0,0 +1,92 @@
+///
+// \file modelfeedreader.h
+// \brief P3 Model Feed Reader
+// \details Streams an RSS 2.0 or Atom feed into a Podcast
+//
+
+#ifndef __P3_MODEL_FEED_READER_H_INCL__
+#define __P3_MODEL_FEED_READER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelcontribution.h"
+#include "modelcontributor.h"
+#include "modelentityhandle.h"
+#include "modelepisode.h"
+#include "modelpodcast.h"
+#include "runtimearena.h"
+#include "runtimeguid.h"
+#include "runtimestring.h"
+#include "runtimexmlreader.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief RSS and Atom feed reader
+/// \details Fills a Podcast from a feed with a single pass of a runtime::XmlReader; no document tree
+/// is built. Values that fit inline are stored inline, longer values are copied into the arena
+/// passed to the constructor, and entity references are decoded straight into their final storage.
+/// The Podcast therefore refers to the arena, which must outlive it, but not to the document, so a
+/// mapped file can be closed right after reading. Languages, categories, MIME types and roles are
+/// interned.
+///
+/// Elements are recognized by their conventional prefixes (itunes:, podcast:, content:). Items are
+/// grouped into seasons by itunes:season or podcast:season, items without a season go into season 0.
+/// enclosure becomes an Enclosure whose EnclosureType is derived from the MIME type, itunes:image
+/// a Picture and podcast:person a Contribution. Identifiers are taken from guid, podcast:guid or Atom
+/// id when they hold a UUID; any other text, usually a permalink, and persons, by their href or else
+/// their name, get name-based UUIDv5 identifiers, so reading a feed again yields the same
+/// identifiers. Persons with the same identifier share one Contributor. A reader is not thread-safe;
+/// use one reader per thread.
+class FeedReader
+{
+public:
+    /// \brief Create a feed reader
+    /// \param arena Arena receiving long strings, must outlive all podcasts read
+    explicit FeedReader(runtime::Arena& arena);
+
+    /// \brief Destroy the feed reader
+    virtual ~FeedReader() = default;
+
+    FeedReader(const FeedReader&)            = delete;
+    FeedReader& operator=(const FeedReader&) = delete;
+
+    /// \brief Read a feed from memory
+    /// \param document Complete feed document
+    /// \param podcast Podcast to replace with the contents of the feed
+    /// \return True if the document is a well-formed RSS or Atom feed
+    bool Read(const std::string_view document, Podcast& podcast);
+
+    /// \brief Read a feed from a file through a read-only memory mapping
+    /// \param path Path of the feed file
+    /// \param podcast Podcast to replace with the contents of the feed
+    /// \return True if the file could be mapped and is a well-formed RSS or Atom feed
+    bool ReadFile(const char* path, Podcast& podcast);
+
+private:
+    bool ReadChannel(runtime::XmlReader& reader, Podcast& podcast);
+    bool ReadItem(runtime::XmlReader& reader, Podcast& podcast);
+    bool ReadText(runtime::XmlReader& reader, runtime::XmlValue& value);
+    bool ReadCategories(runtime::XmlReader& reader, std::vector<runtime::String>& categories);
+    bool ReadPerson(runtime::XmlReader& reader, std::vector<Contribution>& contributions);
+    void AddEnclosure(const runtime::XmlReader& reader, const runtime::XmlValue& url, Episode& episode);
+    Season& GetSeason(Podcast& podcast, const uint32_t seasonNumber);
+    runtime::String MakeString(const runtime::XmlValue& value);
+    runtime::String MakeInterned(const runtime::XmlValue& value);
+    std::string_view Decode(const runtime::XmlValue& value);
+
+    runtime::Arena& arena_;
+    std::string text_;
+    std::string decoded_;
+    std::unordered_map<runtime::Guid, EntityHandle<Contributor>> contributors_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_FEED_READER_H_INCL__
@@ -0,0 +1,134 @@
+///
+// \file modelfeedwindow.cpp
+// \brief P3 Model Feed Windows implementation
+// \details Cursor text form, ordering and window selection
+//
+
+#include "modelfeedwindow.h"
+
+#include "modelepisode.h"
+#include "modelseason.h"
+
+#include <algorithm>
+#include <charconv>
+
+namespace ultralove::p3::model {
+size_t FeedCursor::Format(char* buffer, const size_t size) const noexcept
+{
+    if ((buffer == nullptr) || (size < TEXT_LENGTH)) {
+        return 0;
+    }
+    const auto result = std::to_chars(buffer, buffer + size, publicationDate.GetMicroseconds());
+    char* current     = result.ptr;
+    *current++        = '.';
+    return static_cast<size_t>(current - buffer) + episode.Format(current, size - static_cast<size_t>(current - buffer));
+}
+
+std::optional<FeedCursor> FeedCursor::Parse(const std::string_view text) noexcept
+{
+    const size_t separator = text.find('.');
+    if (separator == std::string_view::npos) {
+        return std::nullopt;
+    }
+    int64_t microseconds = 0;
+    const auto result    = std::from_chars(text.data(), text.data() + separator, microseconds);
+    if ((result.ec != std::errc()) || (result.ptr != text.data() + separator) || (runtime::Timestamp::IsInRange(microseconds) == false)) {
+        return std::nullopt;
+    }
+    const std::optional<runtime::Guid> episode = runtime::Guid::Parse(text.substr(separator + 1));
+    if (episode.has_value() == false) {
+        return std::nullopt;
+    }
+    return FeedCursor{runtime::Timestamp::FromMicroseconds(microseconds), *episode};
+}
+
+void PublicationOrder::Build(const Podcast& podcast)
+{
+    entries_.clear();
+    entries_.reserve(CountEpisodes(podcast));
+    for (size_t season = 0; season < podcast.seasons.size(); ++season) {
+        const std::vector<Episode>& episodes = podcast.seasons[season].episodes;
+        for (size_t position = 0; position < episodes.size(); ++position) {
+            entries_.push_back(
+                {episodes[position].publicationDate.GetMicroseconds(), episodes[position].id, static_cast<uint32_t>(season), static_cast<uint32_t>(position)});
+        }
+    }
+
+    // Newest first; episodes that share date and identifier keep their model order
+    std::sort(entries_.begin(), entries_.end(), [](const Entry& lhs, const Entry& rhs) {
+        if (lhs.publicationDate != rhs.publicationDate) {
+            return lhs.publicationDate > rhs.publicationDate;
+        }
+        if (lhs.episode != rhs.episode) {
+            return lhs.episode > rhs.episode;
+        }
+        return (lhs.season != rhs.season) ? (lhs.season < rhs.season) : (lhs.position < rhs.position);
+    });
+    podcast_          = podcast.id;
+    modificationDate_ = podcast.modificationDate;
+    built_            = true;
+}
+
+bool PublicationOrder::Update(const Podcast& podcast)
+{
+    if (IsCurrent(podcast)) {
+        return false;
+    }
+    Build(podcast);
+    return true;
+}
+
+bool PublicationOrder::IsCurrent(const Podcast& podcast) const noexcept
+{
+    return built_ && (podcast.id == podcast_) && (podcast.modificationDate == modificationDate_) && (CountEpisodes(podcast) == entries_.size());
+}
+
+void PublicationOrder::Clear() noexcept
+{
+    entries_.clear();
+    podcast_          = runtime::Guid();
+    modificationDate_ = runtime::Timestamp();
+    built_            = false;
+}
+
+PublicationOrder::Range PublicationOrder::Select(const FeedWindow& window) const noexcept
+{
+    // Number of leading entries the predicate holds for, entries_ is partitioned by all of them
+    const auto count = [this](const auto& predicate) {
+        return static_cast<size_t>(std::partition_point(entries_.begin(), entries_.end(), predicate) - entries_.begin());
+    };
+
+    const runtime::Timestamp epoch;
+    Range range;
+    range.end = entries_.size();
+    if (window.until != epoch) {
+        const int64_t until = window.until.GetMicroseconds();
+        range.top           = count([until](const Entry& entry) { return entry.publicationDate >= until; });
+    }
+    if (window.from != epoch) {
+        const int64_t from = window.from.GetMicroseconds();
+        range.end          = count([from](const Entry& entry) { return entry.publicationDate >= from; });
+    }
+    range.end   = std::max(range.end, range.top);
+    range.first = range.top;
+    if (window.after.has_value()) {
+        const int64_t date          = window.after->publicationDate.GetMicroseconds();
+        const runtime::Guid& cursor = window.after->episode;
+        const size_t after          = count([date, &cursor](const Entry& entry) {
+            return (entry.publicationDate > date) || ((entry.publicationDate == date) && (entry.episode >= cursor));
+        });
+        range.first                 = std::clamp(after, range.top, range.end);
+    }
+    range.last = ((window.count == 0) || (range.end - range.first <= window.count)) ? range.end : (range.first + window.count);
+    return range;
+}
+
+size_t PublicationOrder::CountEpisodes(const Podcast& podcast) noexcept
+{
+    size_t count = 0;
+    for (const Season& season : podcast.seasons) {
+        count += season.episodes.size();
+    }
+    return count;
+}
+} // namespace ultralove::p3::model
@@ -0,0 +1,196 @@
+///
+// \file modelfeedwindow.h
+// \brief P3 Model Feed Windows
+// \details Episode ordering and windows for paged feeds
+//
+
+#ifndef __P3_MODEL_FEED_WINDOW_H_INCL__
+#define __P3_MODEL_FEED_WINDOW_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelpodcast.h"
+#include "runtimeguid.h"
+#include "runtimetimestamp.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+class FeedWriter;
+
+/// \brief Position in an episode ordering
+/// \details Identifies the last item of a page by publication date and episode identifier. A page
+/// that continues after a cursor starts with the next older episode, whether or not the episode of
+/// the cursor still exists. The text form is URL-safe, e.g.
+/// "1704067200000000.3f2504e0-4f89-11d3-9a0c-0305e82c3301".
+struct FeedCursor
+{
+    /// \brief Maximum length of the text form
+    static constexpr size_t TEXT_LENGTH = 20 + 1 + runtime::Guid::TEXT_LENGTH;
+
+    /// \brief Publication date of the last item of the page
+    runtime::Timestamp publicationDate;
+
+    /// \brief Identifier of the last item of the page
+    runtime::Guid episode;
+
+    /// \brief Format the cursor
+    /// \param buffer Target buffer
+    /// \param size Size of the target buffer, at least TEXT_LENGTH
+    /// \return Number of characters written, 0 if the buffer is too small
+    size_t Format(char* buffer, const size_t size) const noexcept;
+
+    /// \brief Parse a cursor in the form written by Format()
+    /// \param text Text to parse
+    /// \return Cursor, empty if the text is malformed or its instant is out of the range of Timestamp
+    static std::optional<FeedCursor> Parse(const std::string_view text) noexcept;
+};
+
+/// \brief Selection of the items of one feed document
+/// \details The episodes of a podcast are ordered newest first. A window selects up to count of them,
+/// limited to the period [from, until) and, for pages after the first, to the episodes older than
+/// a cursor. Timestamps at the epoch leave that end of the period open.
+struct FeedWindow
+{
+    /// \brief Number of items of a page unless told otherwise
+    static constexpr size_t DEFAULT_PAGE_SIZE = 50;
+
+    /// \brief Maximum number of items, 0 for all items of the period
+    size_t count = DEFAULT_PAGE_SIZE;
+
+    /// \brief Start of the period, inclusive
+    runtime::Timestamp from;
+
+    /// \brief End of the period, exclusive
+    runtime::Timestamp until;
+
+    /// \brief Continue after this position, empty for the first page
+    std::optional<FeedCursor> after;
+
+    /// \brief Address of the first page, empty to write no page links
+    /// \details The other pages are addressed by appending an "after" query parameter holding
+    /// their cursor. The address is written as given and must outlive the write.
+    std::string_view url;
+
+    /// \brief Select the newest episodes
+    /// \param count Maximum number of items
+    /// \return Window
+    static FeedWindow Newest(const size_t count) noexcept
+    {
+        FeedWindow window;
+        window.count = count;
+        return window;
+    }
+
+    /// \brief Select the episodes published in a period
+    /// \param from Start of the period, inclusive
+    /// \param until End of the period, exclusive
+    /// \param count Maximum number of items, 0 for all
+    /// \return Window
+    static FeedWindow Published(const runtime::Timestamp& from, const runtime::Timestamp& until, const size_t count = 0) noexcept
+    {
+        FeedWindow window;
+        window.count = count;
+        window.from  = from;
+        window.until = until;
+        return window;
+    }
+
+    /// \brief Select the page following a cursor
+    /// \param url Address of the first page
+    /// \param after Cursor of the previous page, empty for the first page
+    /// \param count Number of items per page
+    /// \return Window
+    static FeedWindow Page(const std::string_view url, const std::optional<FeedCursor>& after, const size_t count = DEFAULT_PAGE_SIZE) noexcept
+    {
+        FeedWindow window;
+        window.count = count;
+        window.after = after;
+        window.url   = url;
+        return window;
+    }
+};
+
+/// \brief Publication order of the episodes of one podcast
+/// \details Holds the position of every episode in Podcast::seasons[].episodes[] sorted newest
+/// first by publication date and identifier, so a window is found by binary search and only its
+/// items are visited; the episodes themselves are neither copied nor sorted. Build the order once
+/// and call Update() whenever the podcast may have changed: it rebuilds only if the modification
+/// date of the podcast moved, see modelmodification.h, or the number of episodes differs.
+///
+/// An order that is not modified may be shared by writers on several threads.
+class PublicationOrder
+{
+public:
+    /// \brief Create an empty order
+    PublicationOrder() = default;
+
+    /// \brief Destroy the order
+    virtual ~PublicationOrder() = default;
+
+    PublicationOrder(const PublicationOrder&)            = delete;
+    PublicationOrder& operator=(const PublicationOrder&) = delete;
+
+    /// \brief Order the episodes of a podcast
+    /// \param podcast Podcast to order
+    void Build(const Podcast& podcast);
+
+    /// \brief Order the episodes of a podcast again if it changed since the last build
+    /// \param podcast Podcast to order
+    /// \return True if the order was rebuilt
+    bool Update(const Podcast& podcast);
+
+    /// \brief Check whether the order was built from the current state of a podcast
+    /// \param podcast Podcast to check
+    /// \return True if the podcast did not change since the last build
+    bool IsCurrent(const Podcast& podcast) const noexcept;
+
+    /// \brief Drop the order
+    void Clear() noexcept;
+
+    /// \brief Get the number of ordered episodes
+    /// \return Number of episodes
+    size_t GetCount() const noexcept
+    {
+        return entries_.size();
+    }
+
+private:
+    friend class FeedWriter;
+
+    struct Entry
+    {
+        int64_t publicationDate;
+        runtime::Guid episode;
+        uint32_t season;
+        uint32_t position;
+    };
+
+    // Positions in entries_: the period spans [top, end), the items of the window [first, last)
+    struct Range
+    {
+        size_t top   = 0;
+        size_t first = 0;
+        size_t last  = 0;
+        size_t end   = 0;
+    };
+
+    Range Select(const FeedWindow& window) const noexcept;
+    static size_t CountEpisodes(const Podcast& podcast) noexcept;
+
+    std::vector<Entry> entries_;
+    runtime::Guid podcast_;
+    runtime::Timestamp modificationDate_;
+    bool built_ = false;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_FEED_WINDOW_H_INCL__
@@ -0,0 +1,438 @@
+///
+// \file modelfeedwriter.cpp
+// \brief P3 Model Feed Writer implementation
+// \details Mapping of the object model to RSS 2.0, iTunes and Podcasting 2.0 elements
+//
+
+#include "modelfeedwriter.h"
+
+#include "model.h"
+
+namespace ultralove::p3::model {
+namespace {
+constexpr std::string_view NAMESPACE_ITUNES  = "http://www.itunes.com/dtds/podcast-1.0.dtd";
+constexpr std::string_view NAMESPACE_PODCAST = "https://podcastindex.org/namespace/1.0";
+constexpr std::string_view NAMESPACE_ATOM    = "http://www.w3.org/2005/Atom";
+
+constexpr std::string_view EpisodeTypeName(const EpisodeType type) noexcept
+{
+    switch (type) {
+    case EpisodeType::TRAILER:
+        return "trailer";
+    case EpisodeType::BONUS:
+        return "bonus";
+    default:
+        return "full";
+    }
+}
+
+// Used when an enclosure does not carry its own MIME type
+constexpr std::string_view EnclosureMimeType(const EnclosureType type) noexcept
+{
+    switch (type) {
+    case EnclosureType::MP4:
+        return "video/mp4";
+    case EnclosureType::OGG:
+        return "audio/ogg";
+    case EnclosureType::OPUS:
+        return "audio/opus";
+    default:
+        return "audio/mpeg";
+    }
+}
+
+std::string_view MimeType(const Enclosure& enclosure) noexcept
+{
+    return enclosure.mimeType.IsEmpty() ? EnclosureMimeType(enclosure.type) : enclosure.mimeType.GetView();
+}
+
+constexpr bool IsSet(const runtime::Timestamp& timestamp) noexcept
+{
+    return timestamp != runtime::Timestamp();
+}
+} // namespace
+
+FeedWriter::FeedWriter(runtime::OutputSink& sink, const size_t bufferSize) : writer_(sink, bufferSize) {}
+
+bool FeedWriter::Write(const Podcast& podcast)
+{
+    WriteHead(podcast);
+    for (const Season& season : podcast.seasons) {
+        for (const Episode& episode : season.episodes) {
+            WriteItem(season, episode);
+        }
+    }
+    return WriteTail();
+}
+
+bool FeedWriter::Write(const Podcast& podcast, FeedItemCache& cache)
+{
+    cache.Begin();
+    WriteHead(podcast);
+    for (const Season& season : podcast.seasons) {
+        for (const Episode& episode : season.episodes) {
+            if (episode.id.IsNil()) {
+                WriteItem(season, episode);
+            }
+            else {
+                writer_.AppendFragment(cache.Render(season, episode));
+            }
+        }
+    }
+    cache.End();
+    return WriteTail();
+}
+
+bool FeedWriter::Write(const Podcast& podcast, const PublicationOrder& order, const FeedWindow& window)
+{
+    const PublicationOrder::Range range = order.Select(window);
+    WriteHead(podcast, window.url.empty() == false);
+    if (window.url.empty() == false) {
+        WritePageLinks(order, range, window);
+    }
+    for (size_t index = range.first; index < range.last; ++index) {
+        const PublicationOrder::Entry& entry = order.entries_[index];
+        if (entry.season < podcast.seasons.size()) {
+            const Season& season = podcast.seasons[entry.season];
+            if (entry.position < season.episodes.size()) {
+                WriteItem(season, season.episodes[entry.position]);
+            }
+        }
+    }
+    return WriteTail();
+}
+
+bool FeedWriter::WriteItems(const Season& season, std::span<const Episode> episodes)
+{
+    writer_.BeginFragment(2);
+    for (const Episode& episode : episodes) {
+        WriteItem(season, episode);
+    }
+    return writer_.Flush();
+}
+
+bool FeedWriter::Write(const Podcast& podcast, std::span<const std::string> items)
+{
+    WriteHead(podcast);
+    for (const std::string& fragment : items) {
+        if (fragment.empty() == false) {
+            writer_.AppendFragment(fragment);
+        }
+    }
+    return WriteTail();
+}
+
+void FeedWriter::WriteHead(const Podcast& podcast, const bool paged)
+{
+    writer_.Declaration();
+    writer_.OpenElement("rss");
+    writer_.Attribute("version", "2.0");
+    if (paged) {
+        writer_.Attribute("xmlns:atom", NAMESPACE_ATOM);
+    }
+    writer_.Attribute("xmlns:itunes", NAMESPACE_ITUNES);
+    writer_.Attribute("xmlns:podcast", NAMESPACE_PODCAST);
+    writer_.OpenElement("channel");
+    WriteChannel(podcast);
+}
+
+bool FeedWriter::WriteTail()
+{
+    writer_.CloseElement("channel");
+    writer_.CloseElement("rss");
+    writer_.Raw("\n");
+    return writer_.Flush();
+}
+
+void FeedWriter::WriteChannel(const Podcast& podcast)
+{
+    writer_.TextElement("title", podcast.title.GetView());
+    WriteOptional("link", podcast.link);
+    writer_.TextElement("description", podcast.description.GetView());
+    WriteOptional("language", podcast.language);
+    WriteOptional("copyright", podcast.copyright);
+    WriteOptional("managingEditor", podcast.managingEditor);
+    WriteOptional("webMaster", podcast.webmaster);
+    WriteTimestamp("pubDate", podcast.publicationDate);
+    WriteTimestamp("lastBuildDate", podcast.lastBuildDate);
+    writer_.OpenElement("generator");
+    writer_.Text(Model::GetLibraryName().GetView());
+    writer_.Raw(" ");
+    writer_.Text(Model::GetVersion().GetView());
+    writer_.CloseElement("generator");
+
+    WriteOptional("itunes:subtitle", podcast.subtitle);
+    WriteOptional("itunes:summary", podcast.summary);
+    WriteOptional("itunes:author", podcast.publisher.name);
+    if ((podcast.publisher.name.IsEmpty() == false) || (podcast.publisher.email.IsEmpty() == false)) {
+        writer_.OpenElement("itunes:owner");
+        WriteOptional("itunes:name", podcast.publisher.name);
+        WriteOptional("itunes:email", podcast.publisher.email);
+        writer_.CloseElement("itunes:owner");
+    }
+    WriteImage(podcast.coverArt);
+    for (const runtime::String& category : podcast.categories) {
+        writer_.OpenElement("itunes:category");
+        writer_.Attribute("text", category.GetView());
+        writer_.CloseElement("itunes:category");
+    }
+    WriteKeywords(podcast.tags);
+    WriteGuid("podcast:guid", podcast.id, false);
+    WriteContributions(podcast.contributors);
+}
+
+void FeedWriter::WritePageLinks(const PublicationOrder& order, const PublicationOrder::Range& range, const FeedWindow& window)
+{
+    // A page is addressed by the last item of the page before it, the first page by the plain URL
+    const auto cursor = [&order, &range](const size_t first) {
+        return (first > range.top) ? &order.entries_[first - 1] : nullptr;
+    };
+    WritePageLink("self", window.url, cursor(range.first));
+    WritePageLink("first", window.url, nullptr);
+    if ((range.first > range.top) && (window.count > 0)) {
+        WritePageLink("previous", window.url, cursor((range.first - range.top > window.count) ? (range.first - window.count) : range.top));
+    }
+    if (range.last < range.end) {
+        WritePageLink("next", window.url, cursor(range.last));
+    }
+}
+
+void FeedWriter::WritePageLink(const std::string_view relation, const std::string_view url, const PublicationOrder::Entry* last)
+{
+    link_.assign(url);
+    if (last != nullptr) {
+        char text[FeedCursor::TEXT_LENGTH];
+        const size_t length = FeedCursor{runtime::Timestamp::FromMicroseconds(last->publicationDate), last->episode}.Format(text, sizeof(text));
+        link_.append((url.find('?') == std::string_view::npos) ? "?after=" : "&after=");
+        link_.append(text, length);
+    }
+    writer_.OpenElement("atom:link");
+    writer_.Attribute("rel", relation);
+    writer_.Attribute("href", link_);
+    writer_.Attribute("type", "application/rss+xml");
+    writer_.CloseElement("atom:link");
+}
+
+void FeedWriter::WriteItem(const Season& season, const Episode& episode)
+{
+    writer_.OpenElement("item");
+    writer_.TextElement("title", episode.title.GetView());
+    WriteOptional("description", episode.description);
+    WriteGuid("guid", episode.id, true);
+    WriteTimestamp("pubDate", episode.publicationDate);
+    if (episode.enclosures.empty() == false) {
+        WriteEnclosure(episode.enclosures.front());
+    }
+
+    WriteOptional("itunes:subtitle", episode.subtitle);
+    WriteOptional("itunes:summary", episode.summary);
+    writer_.TextElement("itunes:episodeType", EpisodeTypeName(episode.type));
+    if (episode.duration > runtime::Timespan()) {
+        char duration[runtime::Timespan::FORMAT_MAX_LENGTH];
+        const size_t length = episode.duration.FormatClock(duration, sizeof(duration));
+        writer_.OpenElement("itunes:duration");
+        writer_.Raw(std::string_view(duration, length));
+        writer_.CloseElement("itunes:duration");
+    }
+    if (season.seasonNumber > 0) {
+        writer_.OpenElement("itunes:season");
+        writer_.Text(season.seasonNumber);
+        writer_.CloseElement("itunes:season");
+    }
+    if (episode.episodeNumber > 0) {
+        writer_.OpenElement("itunes:episode");
+        writer_.Text(episode.episodeNumber);
+        writer_.CloseElement("itunes:episode");
+    }
+    WriteImage(episode.coverArt);
+    WriteKeywords(episode.tags);
+
+    if (season.seasonNumber > 0) {
+        writer_.OpenElement("podcast:season");
+        if (season.title.IsEmpty() == false) {
+            writer_.Attribute("name", season.title.GetView());
+        }
+        writer_.Text(season.seasonNumber);
+        writer_.CloseElement("podcast:season");
+    }
+    if (episode.episodeNumber > 0) {
+        writer_.OpenElement("podcast:episode");
+        writer_.Text(episode.episodeNumber);
+        writer_.CloseElement("podcast:episode");
+    }
+    for (size_t i = 1; i < episode.enclosures.size(); ++i) {
+        WriteAlternateEnclosure(episode.enclosures[i]);
+    }
+    WriteContributions(episode.contributors);
+    writer_.CloseElement("item");
+}
+
+void FeedWriter::WriteEnclosure(const Enclosure& enclosure)
+{
+    writer_.OpenElement("enclosure");
+    writer_.Attribute("url", enclosure.uri.GetView());
+    writer_.Attribute("length", enclosure.fileSize);
+    writer_.Attribute("type", MimeType(enclosure));
+    writer_.CloseElement("enclosure");
+}
+
+void FeedWriter::WriteAlternateEnclosure(const Enclosure& enclosure)
+{
+    writer_.OpenElement("podcast:alternateEnclosure");
+    writer_.Attribute("type", MimeType(enclosure));
+    writer_.Attribute("length", enclosure.fileSize);
+    writer_.OpenElement("podcast:source");
+    writer_.Attribute("uri", enclosure.uri.GetView());
+    writer_.CloseElement("podcast:source");
+    writer_.CloseElement("podcast:alternateEnclosure");
+}
+
+void FeedWriter::WriteImage(const Picture& picture)
+{
+    if (picture.uri.IsEmpty()) {
+        return;
+    }
+    writer_.OpenElement("itunes:image");
+    writer_.Attribute("href", picture.uri.GetView());
+    writer_.CloseElement("itunes:image");
+}
+
+void FeedWriter::WriteContributions(const std::vector<Contribution>& contributions)
+{
+    for (const Contribution& contribution : contributions) {
+        const Contributor* contributor = contribution.contributor.Get();
+        if ((contributor == nullptr) || contributor->name.IsEmpty()) {
+            continue;
+        }
+        writer_.OpenElement("podcast:person");
+        if (contribution.type.IsEmpty() == false) {
+            writer_.Attribute("role", contribution.type.GetView());
+        }
+        if (contributor->url.IsEmpty() == false) {
+            writer_.Attribute("href", contributor->url.GetView());
+        }
+        if (contributor->image.uri.IsEmpty() == false) {
+            writer_.Attribute("img", contributor->image.uri.GetView());
+        }
+        writer_.Text(contributor->name.GetView());
+        writer_.CloseElement("podcast:person");
+    }
+}
+
+void FeedWriter::WriteKeywords(const std::vector<TagReference>& tags)
+{
+    bool open = false;
+    for (const TagReference& reference : tags) {
+        const Tag* tag = reference.tag.Get();
+        if ((tag == nullptr) || tag->name.IsEmpty()) {
+            continue;
+        }
+        if (open == false) {
+            writer_.OpenElement("itunes:keywords");
+            open = true;
+        }
+        else {
+            writer_.Raw(",");
+        }
+        writer_.Text(tag->name.GetView());
+    }
+    if (open) {
+        writer_.CloseElement("itunes:keywords");
+    }
+}
+
+void FeedWriter::WriteTimestamp(const std::string_view name, const runtime::Timestamp& timestamp)
+{
+    if (IsSet(timestamp) == false) {
+        return;
+    }
+    char text[runtime::Timestamp::RFC822_LENGTH];
+    const size_t length = timestamp.FormatRfc822(text, sizeof(text));
+    if (length > 0) {
+        writer_.OpenElement(name);
+        writer_.Raw(std::string_view(text, length));
+        writer_.CloseElement(name);
+    }
+}
+
+void FeedWriter::WriteGuid(const std::string_view name, const runtime::Guid& guid, const bool permaLinkAttribute)
+{
+    if (guid.IsNil()) {
+        return;
+    }
+    char text[runtime::Guid::TEXT_LENGTH];
+    const size_t length = guid.Format(text, sizeof(text));
+    writer_.OpenElement(name);
+    if (permaLinkAttribute) {
+        writer_.Attribute("isPermaLink", "false");
+    }
+    writer_.Raw(std::string_view(text, length));
+    writer_.CloseElement(name);
+}
+
+void FeedWriter::WriteOptional(const std::string_view name, const runtime::String& value)
+{
+    if (value.IsEmpty() == false) {
+        writer_.TextElement(name, value.GetView());
+    }
+}
+FeedItemCache::FeedItemCache() : sink_(fragment_), writer_(new FeedWriter(sink_, runtime::XmlWriter::DEFAULT_BUFFER_SIZE)) {}
+
+void FeedItemCache::Clear() noexcept
+{
+    items_.clear();
+    rendered_ = 0;
+}
+
+void FeedItemCache::Begin()
+{
+    ++generation_;
+    rendered_ = 0;
+}
+
+std::string_view FeedItemCache::Render(const Season& season, const Episode& episode)
+{
+    // Everything an item is rendered from. The season date also moves when any of its episodes
+    // changes, so the season fields used by items are taken by value; references carry a presence
+    // flag, so a missing target never feeds the hasher the same bytes as a present one
+    runtime::Hasher hasher;
+    hasher.Update(static_cast<uint64_t>(episode.modificationDate.GetMicroseconds()));
+    hasher.Update(static_cast<uint64_t>(season.seasonNumber));
+    hasher.Update(season.title.GetView());
+    hasher.Update(static_cast<uint64_t>(episode.contributors.size()));
+    for (const Contribution& contribution : episode.contributors) {
+        hasher.Update(static_cast<uint64_t>(contribution.contributor ? 1 : 0));
+        if (contribution.contributor) {
+            hasher.Update(static_cast<uint64_t>(contribution.contributor->modificationDate.GetMicroseconds()));
+        }
+    }
+    hasher.Update(static_cast<uint64_t>(episode.tags.size()));
+    for (const TagReference& reference : episode.tags) {
+        hasher.Update(static_cast<uint64_t>(reference.tag ? 1 : 0));
+        if (reference.tag) {
+            hasher.Update(static_cast<uint64_t>(reference.tag->modificationDate.GetMicroseconds()));
+        }
+    }
+    const runtime::Hash128 stamp = hasher.Finish();
+
+    Item& item      = items_[episode.id];
+    item.generation = generation_;
+    if ((item.bytes.empty() == false) && (item.stamp == stamp)) {
+        return item.bytes;
+    }
+
+    fragment_.clear();
+    writer_->WriteItems(season, std::span<const Episode>(&episode, 1));
+    item.bytes.assign(fragment_);
+    item.stamp = stamp;
+    ++rendered_;
+    return item.bytes;
+}
+
+void FeedItemCache::End()
+{
+    std::erase_if(items_, [this](const auto& entry) {
+        return entry.second.generation != generation_;
+    });
+}
+} // namespace ultralove::p3::model
@@ -0,0 +1,193 @@
+///
+// \file modelfeedwriter.h
+// \brief P3 Model Feed Writer
+// \details Streams a Podcast as RSS 2.0 feed with iTunes and Podcasting 2.0 extensions
+//
+
+#ifndef __P3_MODEL_FEED_WRITER_H_INCL__
+#define __P3_MODEL_FEED_WRITER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelcontribution.h"
+#include "modelenclosure.h"
+#include "modelepisode.h"
+#include "modelfeedwindow.h"
+#include "modelpicture.h"
+#include "modelpodcast.h"
+#include "modelseason.h"
+#include "modeltagreference.h"
+#include "runtimeoutputsink.h"
+#include "runtimexmlwriter.h"
+#include "runtimeguid.h"
+#include "runtimehasher.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+class FeedItemCache;
+
+/// \brief RSS feed writer
+/// \details Walks Podcast, Season, Episode, Enclosure, Contribution and TagReference and streams the
+/// feed through a runtime::XmlWriter into an OutputSink. Nothing but the fixed output buffer is
+/// allocated, so a feed with thousands of episodes is written in constant memory.
+///
+/// Items are written in model order, season by season. Empty strings, nil identifiers, zero
+/// durations and timestamps at the epoch are treated as absent and not written. The first
+/// enclosure of an episode becomes the RSS enclosure, further enclosures are written as
+/// podcast:alternateEnclosure. Contributions become podcast:person, tag names are joined into
+/// itunes:keywords.
+class FeedWriter
+{
+public:
+    /// \brief Create a feed writer
+    /// \param sink Destination of the feed, must outlive the writer
+    /// \param bufferSize Size of the output buffer
+    explicit FeedWriter(runtime::OutputSink& sink, const size_t bufferSize = runtime::XmlWriter::DEFAULT_BUFFER_SIZE);
+
+    /// \brief Destroy the feed writer
+    virtual ~FeedWriter() = default;
+
+    FeedWriter(const FeedWriter&)            = delete;
+    FeedWriter& operator=(const FeedWriter&) = delete;
+
+    /// \brief Write a complete feed and flush it to the sink
+    /// \param podcast Podcast to write
+    /// \return True if the sink accepted the whole feed
+    bool Write(const Podcast& podcast);
+
+    /// \brief Write a complete feed, reusing the items that did not change since the last call
+    /// \details Items are taken from the cache unless the modification date of the episode, its
+    /// season or one of its contributors or tags moved, see modelmodification.h. The output is the
+    /// same as Write() produces. Episodes with a nil identifier are always written.
+    /// \param podcast Podcast to write
+    /// \param cache Item cache of this podcast, updated with the items written
+    /// \return True if the sink accepted the whole feed
+    bool Write(const Podcast& podcast, FeedItemCache& cache);
+
+    /// \brief Write the items of a window, newest first, and flush the feed to the sink
+    /// \details Only the episodes inside the window are visited. If the window carries the address of
+    /// the first page, the channel gets RFC 5005 atom:link elements: "self" and "first" always,
+    /// "previous" and "next" where there are more items of the period before or after this page.
+    /// The order must be current, see PublicationOrder::Update(); entries that no longer point to an
+    /// episode are skipped.
+    /// \param podcast Podcast to write
+    /// \param order Publication order of the podcast
+    /// \param window Items to write
+    /// \return True if the sink accepted the whole feed
+    bool Write(const Podcast& podcast, const PublicationOrder& order, const FeedWindow& window);
+
+    /// \brief Write items as a fragment of a feed and flush them to the sink
+    /// \details The items are laid out as inside rss and channel, so their bytes can be spliced into a
+    /// feed by Write(const Podcast&, std::span<const std::string>). Fragments of different seasons
+    /// can be rendered by different writers in parallel.
+    /// \param season Season the episodes belong to
+    /// \param episodes Episodes to write, in feed order
+    /// \return True if the sink accepted all items
+    bool WriteItems(const Season& season, std::span<const Episode> episodes);
+
+    /// \brief Write a complete feed around items rendered by WriteItems() and flush it to the sink
+    /// \details The fragments are inserted verbatim in the given order. With the fragments of all
+    /// seasons in model order, the output is the same as Write() produces.
+    /// \param podcast Podcast to write the channel of
+    /// \param items Fragments written by WriteItems()
+    /// \return True if the sink accepted the whole feed
+    bool Write(const Podcast& podcast, std::span<const std::string> items);
+
+    /// \brief Get the number of bytes produced so far
+    /// \return Byte count over all feeds written by this writer
+    uint64_t GetBytesWritten() const noexcept
+    {
+        return writer_.GetBytesWritten();
+    }
+
+private:
+    void WriteHead(const Podcast& podcast, const bool paged = false);
+    bool WriteTail();
+    void WriteChannel(const Podcast& podcast);
+    void WritePageLinks(const PublicationOrder& order, const PublicationOrder::Range& range, const FeedWindow& window);
+    void WritePageLink(const std::string_view relation, const std::string_view url, const PublicationOrder::Entry* last);
+    void WriteItem(const Season& season, const Episode& episode);
+    void WriteEnclosure(const Enclosure& enclosure);
+    void WriteAlternateEnclosure(const Enclosure& enclosure);
+    void WriteImage(const Picture& picture);
+    void WriteContributions(const std::vector<Contribution>& contributions);
+    void WriteKeywords(const std::vector<TagReference>& tags);
+    void WriteTimestamp(const std::string_view name, const runtime::Timestamp& timestamp);
+    void WriteGuid(const std::string_view name, const runtime::Guid& guid, const bool permaLinkAttribute);
+    void WriteOptional(const std::string_view name, const runtime::String& value);
+
+    runtime::XmlWriter writer_;
+    std::string link_;
+};
+
+/// \brief Rendered feed items of one podcast
+/// \details Keeps the bytes of every <item> written by FeedWriter::Write(const Podcast&, FeedItemCache&)
+/// together with a 128-bit stamp of the modification dates they were rendered from. An item is
+/// rendered again unless its stamp matches; two different inputs sharing a stamp would serve stale
+/// bytes, which the 128-bit hash makes negligible but not impossible. Items of episodes that no
+/// longer exist are dropped after each write. Use one cache per podcast; a cache is not thread-safe.
+class FeedItemCache
+{
+public:
+    /// \brief Create an empty cache
+    FeedItemCache();
+
+    /// \brief Destroy the cache
+    virtual ~FeedItemCache() = default;
+
+    FeedItemCache(const FeedItemCache&)            = delete;
+    FeedItemCache& operator=(const FeedItemCache&) = delete;
+
+    /// \brief Drop all items
+    void Clear() noexcept;
+
+    /// \brief Get the number of cached items
+    /// \return Number of items
+    size_t GetCount() const noexcept
+    {
+        return items_.size();
+    }
+
+    /// \brief Get the number of items rendered by the last write, the others came from the cache
+    /// \return Number of items
+    size_t GetRenderedCount() const noexcept
+    {
+        return rendered_;
+    }
+
+private:
+    friend class FeedWriter;
+
+    struct Item
+    {
+        runtime::Hash128 stamp{};
+        uint64_t generation = 0;
+        std::string bytes;
+    };
+
+    void Begin();
+    std::string_view Render(const Season& season, const Episode& episode);
+    void End();
+
+    std::string fragment_;
+    runtime::StringOutputSink sink_;
+    std::unique_ptr<FeedWriter> writer_;
+    std::unordered_map<runtime::Guid, Item> items_;
+    uint64_t generation_ = 0;
+    size_t rendered_     = 0;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_FEED_WRITER_H_INCL__
@@ -0,0 +1,1079 @@
+///
+// \file modeljsonfeedreader.cpp
+// \brief P3 Model JSON Feed Reader implementation
+// \details Mapping of native, Podcast Index and JSON Feed members to the object model
+//
+
+#include "modeljsonfeedreader.h"
+
+#include "modelparsing.h"
+#include "runtimemappedfile.h"
+
+#include <utility>
+
+namespace ultralove::p3::model {
+// Members known to the reader; native names and their Podcast Index and JSON Feed counterparts
+enum class JsonFeedField : uint8_t
+{
+    UNKNOWN,
+    ADDRESS,
+    ARTWORK,
+    ATTACHMENTS,
+    AUTHOR,
+    AUTHORS,
+    AVATAR,
+    BIO,
+    CATEGORIES,
+    COMMENT,
+    CONTENT_HTML,
+    CONTENT_TEXT,
+    CONTRIBUTOR,
+    CONTRIBUTORS,
+    COPYRIGHT,
+    COVER_ART,
+    CREATION_DATE,
+    CREATOR,
+    DATE_MODIFIED,
+    DATE_PUBLISHED,
+    DESCRIPTION,
+    DURATION,
+    DURATION_IN_SECONDS,
+    EMAIL,
+    ENCLOSURE_LENGTH,
+    ENCLOSURE_TYPE,
+    ENCLOSURE_URL,
+    ENCLOSURES,
+    END_TIME,
+    EPISODE,
+    EPISODE_NUMBER,
+    EPISODE_TYPE,
+    EPISODES,
+    FEED,
+    FILE_SIZE,
+    GUID,
+    HEIGHT,
+    HOME_PAGE_URL,
+    HREF,
+    ICON,
+    ID,
+    IMAGE,
+    IMG,
+    ITEMS,
+    LANGUAGE,
+    LAST_BUILD_DATE,
+    LAST_UPDATE_TIME,
+    LATITUDE,
+    LICENSE,
+    LINK,
+    LONGITUDE,
+    MANAGING_EDITOR,
+    MIME_TYPE,
+    MODIFICATION_DATE,
+    NAME,
+    NOTES,
+    OWNER_NAME,
+    PERSONS,
+    PODCAST_GUID,
+    PRESENCE,
+    PUBLICATION_DATE,
+    PUBLISHER,
+    ROLE,
+    SEASON,
+    SEASON_NUMBER,
+    SEASONS,
+    SIZE_IN_BYTES,
+    START_TIME,
+    SUBTITLE,
+    SUMMARY,
+    TAG,
+    TAGS,
+    TEXT,
+    TITLE,
+    TYPE,
+    TYPE_ID,
+    URI,
+    URL,
+    WEBMASTER,
+    WEIGHT,
+    WIDTH
+};
+
+namespace {
+using namespace parsing;
+using Field = JsonFeedField;
+using Token = runtime::JsonToken;
+
+constexpr FieldName<Field> FIELD_NAMES[] = {{"address", Field::ADDRESS}, {"artwork", Field::ARTWORK}, {"attachments", Field::ATTACHMENTS},
+    {"author", Field::AUTHOR}, {"authors", Field::AUTHORS}, {"avatar", Field::AVATAR}, {"bio", Field::BIO}, {"categories", Field::CATEGORIES},
+    {"comment", Field::COMMENT}, {"content_html", Field::CONTENT_HTML}, {"content_text", Field::CONTENT_TEXT}, {"contributor", Field::CONTRIBUTOR},
+    {"contributors", Field::CONTRIBUTORS}, {"copyright", Field::COPYRIGHT}, {"coverArt", Field::COVER_ART}, {"creationDate", Field::CREATION_DATE},
+    {"creator", Field::CREATOR}, {"date_modified", Field::DATE_MODIFIED}, {"date_published", Field::DATE_PUBLISHED},
+    {"datePublished", Field::DATE_PUBLISHED}, {"description", Field::DESCRIPTION}, {"duration", Field::DURATION},
+    {"duration_in_seconds", Field::DURATION_IN_SECONDS}, {"email", Field::EMAIL}, {"enclosureLength", Field::ENCLOSURE_LENGTH},
+    {"enclosureType", Field::ENCLOSURE_TYPE}, {"enclosureUrl", Field::ENCLOSURE_URL}, {"enclosures", Field::ENCLOSURES}, {"endTime", Field::END_TIME},
+    {"episode", Field::EPISODE}, {"episodeNumber", Field::EPISODE_NUMBER}, {"episodeType", Field::EPISODE_TYPE}, {"episodes", Field::EPISODES},
+    {"feed", Field::FEED}, {"fileSize", Field::FILE_SIZE}, {"guid", Field::GUID}, {"height", Field::HEIGHT}, {"home_page_url", Field::HOME_PAGE_URL},
+    {"href", Field::HREF}, {"icon", Field::ICON}, {"id", Field::ID}, {"image", Field::IMAGE}, {"img", Field::IMG}, {"items", Field::ITEMS},
+    {"language", Field::LANGUAGE}, {"lastBuildDate", Field::LAST_BUILD_DATE}, {"lastUpdateTime", Field::LAST_UPDATE_TIME},
+    {"latitude", Field::LATITUDE}, {"license", Field::LICENSE}, {"link", Field::LINK}, {"longitude", Field::LONGITUDE},
+    {"managingEditor", Field::MANAGING_EDITOR}, {"mime_type", Field::MIME_TYPE}, {"mimeType", Field::MIME_TYPE},
+    {"modificationDate", Field::MODIFICATION_DATE}, {"name", Field::NAME}, {"notes", Field::NOTES}, {"ownerName", Field::OWNER_NAME},
+    {"persons", Field::PERSONS}, {"podcastGuid", Field::PODCAST_GUID}, {"presence", Field::PRESENCE}, {"publicationDate", Field::PUBLICATION_DATE},
+    {"publisher", Field::PUBLISHER}, {"role", Field::ROLE}, {"season", Field::SEASON}, {"seasonNumber", Field::SEASON_NUMBER},
+    {"seasons", Field::SEASONS}, {"size_in_bytes", Field::SIZE_IN_BYTES}, {"startTime", Field::START_TIME}, {"subtitle", Field::SUBTITLE},
+    {"summary", Field::SUMMARY}, {"tag", Field::TAG}, {"tags", Field::TAGS}, {"text", Field::TEXT}, {"title", Field::TITLE}, {"type", Field::TYPE},
+    {"typeId", Field::TYPE_ID}, {"uri", Field::URI}, {"url", Field::URL}, {"webmaster", Field::WEBMASTER}, {"weight", Field::WEIGHT},
+    {"width", Field::WIDTH}};
+
+constexpr NameTable FIELDS(FIELD_NAMES);
+
+Field Classify(const std::string_view name) noexcept
+{
+    return FIELDS.Find(name, Field::UNKNOWN);
+}
+
+Field Classify(const runtime::JsonValue& key) noexcept
+{
+    // Known names are short and plain; escaped keys are decoded on the stack
+    if (key.encoded == false) {
+        return Classify(key.raw);
+    }
+    char decoded[32];
+    if (key.raw.size() > sizeof(decoded)) {
+        return Field::UNKNOWN;
+    }
+    return Classify(std::string_view(decoded, runtime::JsonReader::Decode(key.raw, decoded)));
+}
+
+EnclosureType EnclosureTypeFromName(const std::string_view name) noexcept
+{
+    if (EqualsIgnoreCase(name, "mp4")) {
+        return EnclosureType::MP4;
+    }
+    if (EqualsIgnoreCase(name, "ogg")) {
+        return EnclosureType::OGG;
+    }
+    if (EqualsIgnoreCase(name, "opus")) {
+        return EnclosureType::OPUS;
+    }
+    return EnclosureType::MP3;
+}
+
+// Name space of numeric Podcast Index identifiers, UUIDv5 of "https://podcastindex.org/" in the URL
+// name space
+constexpr runtime::Guid PODCAST_INDEX_NAMESPACE{0xd6dc513b244955c6ull, 0x9bb358b04075476dull};
+
+// Hands out the registered instance of an entity unless the document carries a newer one, which is
+// registered in its place; without a registry the entity is shared by this document only
+template<typename T>
+EntityHandle<T> Share(EntityRegistry<T>* registry, T entity)
+{
+    if (registry == nullptr) {
+        return EntityHandle<T>::Make(std::move(entity));
+    }
+    EntityHandle<T> registered = registry->Find(entity.id);
+    if (registered && (registered->modificationDate >= entity.modificationDate)) {
+        return registered;
+    }
+    return registry->Register(std::move(entity));
+}
+
+// Calls handler for every member of the object just begun; handler is called on the KEY token and
+// consumes the value
+template<typename Handler>
+bool ReadMembers(runtime::JsonReader& reader, const Handler& handler)
+{
+    for (;;) {
+        const Token token = reader.Next();
+        if (token == Token::END_OBJECT) {
+            return true;
+        }
+        if ((token != Token::KEY) || (handler(Classify(reader.GetValue())) == false)) {
+            return false;
+        }
+    }
+}
+
+// Reads the next value with read if it is an object, other values are skipped
+template<typename Read>
+bool ReadObjectValue(runtime::JsonReader& reader, const Read& read)
+{
+    const Token token = reader.Next();
+    return (token == Token::BEGIN_OBJECT) ? read() : SkipValue(reader, token);
+}
+
+// Calls element with the first token of every element of the next value if it is an array
+template<typename Element>
+bool ReadArrayValue(runtime::JsonReader& reader, const Element& element)
+{
+    const Token token = reader.Next();
+    if (token != Token::BEGIN_ARRAY) {
+        return SkipValue(reader, token);
+    }
+    for (;;) {
+        const Token next = reader.Next();
+        if (next == Token::END_ARRAY) {
+            return true;
+        }
+        if ((next == Token::END) || (next == Token::INVALID) || (element(next) == false)) {
+            return false;
+        }
+    }
+}
+
+// Reads every object of the next value with read if it is an array, other elements are skipped
+template<typename Read>
+bool ReadObjects(runtime::JsonReader& reader, const Read& read)
+{
+    return ReadArrayValue(reader, [&reader, &read](const Token token) {
+        return (token == Token::BEGIN_OBJECT) ? read() : SkipValue(reader, token);
+    });
+}
+} // namespace
+
+JsonFeedReader::JsonFeedReader(runtime::Arena& arena) : arena_(arena) {}
+
+JsonFeedReader::JsonFeedReader(runtime::Arena& arena, EntityRegistry<Contributor>& contributors, EntityRegistry<Tag>& tags) :
+    arena_(arena), contributorRegistry_(&contributors), tagRegistry_(&tags)
+{
+}
+
+template<typename T, typename Reader>
+bool JsonFeedReader::ReadDocument(const std::string_view document, T& target, const Reader& read)
+{
+    target = T{};
+    contributors_.clear();
+    tags_.clear();
+    numericIds_.clear();
+
+    runtime::JsonReader reader(document);
+    if (reader.Next() != Token::BEGIN_OBJECT) {
+        return false;
+    }
+    return read(reader, target) && (reader.Next() == Token::END);
+}
+
+bool JsonFeedReader::Read(const std::string_view document, Podcast& podcast)
+{
+    return ReadDocument(document, podcast, [this](runtime::JsonReader& reader, Podcast& target) {
+        return ReadPodcast(reader, target);
+    });
+}
+
+bool JsonFeedReader::ReadFile(const char* path, Podcast& podcast)
+{
+    // All strings end up inline or in the arena, so the mapping is released right after reading
+    runtime::MappedFile file;
+    if (file.Open(path) == false) {
+        return false;
+    }
+    return Read(file.GetView(), podcast);
+}
+
+bool JsonFeedReader::Read(const std::string_view document, Season& season)
+{
+    return ReadDocument(document, season, [this](runtime::JsonReader& reader, Season& target) {
+        return ReadSeason(reader, target);
+    });
+}
+
+bool JsonFeedReader::Read(const std::string_view document, Episode& episode)
+{
+    return ReadDocument(document, episode, [this](runtime::JsonReader& reader, Episode& target) {
+        uint32_t seasonNumber = 0;
+        return ReadEpisode(reader, target, seasonNumber);
+    });
+}
+
+bool JsonFeedReader::Read(const std::string_view document, Contributor& contributor)
+{
+    return ReadDocument(document, contributor, [this](runtime::JsonReader& reader, Contributor& target) {
+        return ReadContributor(reader, target);
+    });
+}
+
+bool JsonFeedReader::Read(const std::string_view document, Enclosure& enclosure)
+{
+    return ReadDocument(document, enclosure, [this](runtime::JsonReader& reader, Enclosure& target) {
+        runtime::Timespan duration;
+        return ReadEnclosure(reader, target, duration);
+    });
+}
+
+bool JsonFeedReader::Read(const std::string_view document, Tag& tag)
+{
+    return ReadDocument(document, tag, [this](runtime::JsonReader& reader, Tag& target) {
+        return ReadTag(reader, target);
+    });
+}
+
+bool JsonFeedReader::Read(const std::string_view document, ChapterTag& tag)
+{
+    return ReadDocument(document, tag, [this](runtime::JsonReader& reader, ChapterTag& target) {
+        return ReadMembers(reader, [this, &reader, &target](const Field field) {
+            switch (field) {
+            case Field::START_TIME:
+                return ReadTimespan(reader, target.startTime);
+            case Field::END_TIME:
+                return ReadTimespan(reader, target.endTime);
+            default:
+                return ReadTagField(reader, field, target);
+            }
+        });
+    });
+}
+
+bool JsonFeedReader::Read(const std::string_view document, LocationTag& tag)
+{
+    return ReadDocument(document, tag, [this](runtime::JsonReader& reader, LocationTag& target) {
+        return ReadMembers(reader, [this, &reader, &target](const Field field) {
+            switch (field) {
+            case Field::ADDRESS:
+                return ReadString(reader, target.address);
+            case Field::LATITUDE:
+                return ReadDouble(reader, target.latitude);
+            case Field::LONGITUDE:
+                return ReadDouble(reader, target.longitude);
+            default:
+                return ReadTagField(reader, field, target);
+            }
+        });
+    });
+}
+
+bool JsonFeedReader::Read(const std::string_view document, TranscriptTag& tag)
+{
+    return ReadDocument(document, tag, [this](runtime::JsonReader& reader, TranscriptTag& target) {
+        return ReadMembers(reader, [this, &reader, &target](const Field field) {
+            switch (field) {
+            case Field::TEXT:
+                return ReadString(reader, target.text);
+            case Field::START_TIME:
+                return ReadTimespan(reader, target.startTime);
+            case Field::END_TIME:
+                return ReadTimespan(reader, target.endTime);
+            default:
+                return ReadTagField(reader, field, target);
+            }
+        });
+    });
+}
+
+bool JsonFeedReader::ReadPodcast(runtime::JsonReader& reader, Podcast& podcast)
+{
+    return ReadMembers(reader, [this, &reader, &podcast](const Field field) {
+        switch (field) {
+        case Field::FEED:
+            // Podcast Index wraps the feed into the response
+            return ReadObjectValue(reader, [this, &reader, &podcast] {
+                return ReadPodcast(reader, podcast);
+            });
+        case Field::GUID:
+        case Field::PODCAST_GUID:
+            return ReadGuid(reader, podcast.id);
+        case Field::TITLE:
+            return ReadString(reader, podcast.title);
+        case Field::SUBTITLE:
+            return ReadString(reader, podcast.subtitle);
+        case Field::DESCRIPTION:
+            return ReadString(reader, podcast.description);
+        case Field::SUMMARY:
+            return ReadString(reader, podcast.summary);
+        case Field::LANGUAGE:
+            return ReadInterned(reader, podcast.language);
+        case Field::CATEGORIES:
+            return ReadCategories(reader, podcast.categories);
+        case Field::PUBLICATION_DATE:
+        case Field::DATE_PUBLISHED:
+            return ReadTimestamp(reader, podcast.publicationDate);
+        case Field::LAST_BUILD_DATE:
+        case Field::LAST_UPDATE_TIME:
+            return ReadTimestamp(reader, podcast.lastBuildDate);
+        case Field::MANAGING_EDITOR:
+            return ReadString(reader, podcast.managingEditor);
+        case Field::WEBMASTER:
+            return ReadString(reader, podcast.webmaster);
+        case Field::COPYRIGHT:
+            return ReadString(reader, podcast.copyright);
+        case Field::LINK:
+        case Field::HOME_PAGE_URL:
+            return ReadString(reader, podcast.link);
+        case Field::PUBLISHER:
+            return ReadObjectValue(reader, [this, &reader, &podcast] {
+                return ReadPublisher(reader, podcast.publisher);
+            });
+        case Field::AUTHOR:
+        case Field::OWNER_NAME:
+            return ReadString(reader, podcast.publisher.name);
+        case Field::COVER_ART:
+        case Field::IMAGE:
+        case Field::ARTWORK:
+        case Field::ICON:
+            return ReadPicture(reader, podcast.coverArt);
+        case Field::TAGS:
+            return ReadTagReferences(reader, podcast.tags);
+        case Field::CONTRIBUTORS:
+            return ReadContributions(reader, podcast.contributors);
+        case Field::AUTHORS:
+        case Field::PERSONS:
+            return ReadPersons(reader, podcast.contributors);
+        case Field::SEASONS:
+            return ReadObjects(reader, [this, &reader, &podcast] {
+                Season season{};
+                if (ReadSeason(reader, season) == false) {
+                    return false;
+                }
+                podcast.seasons.push_back(std::move(season));
+                return true;
+            });
+        case Field::ITEMS:
+        case Field::EPISODES:
+            return ReadEpisodes(reader, podcast);
+        default:
+            return ReadFabricField(reader, field, podcast);
+        }
+    });
+}
+
+bool JsonFeedReader::ReadSeason(runtime::JsonReader& reader, Season& season)
+{
+    return ReadMembers(reader, [this, &reader, &season](const Field field) {
+        switch (field) {
+        case Field::SEASON_NUMBER:
+        case Field::SEASON:
+            return ReadUnsigned(reader, season.seasonNumber);
+        case Field::TITLE:
+            return ReadString(reader, season.title);
+        case Field::DESCRIPTION:
+            return ReadString(reader, season.description);
+        case Field::PUBLICATION_DATE:
+        case Field::DATE_PUBLISHED:
+            return ReadTimestamp(reader, season.publicationDate);
+        case Field::COVER_ART:
+        case Field::IMAGE:
+            return ReadPicture(reader, season.coverArt);
+        case Field::TAGS:
+            return ReadTagReferences(reader, season.tags);
+        case Field::CONTRIBUTORS:
+            return ReadContributions(reader, season.contributors);
+        case Field::AUTHORS:
+        case Field::PERSONS:
+            return ReadPersons(reader, season.contributors);
+        case Field::EPISODES:
+        case Field::ITEMS:
+            return ReadObjects(reader, [this, &reader, &season] {
+                Episode episode{};
+                uint32_t seasonNumber = 0;
+                if (ReadEpisode(reader, episode, seasonNumber) == false) {
+                    return false;
+                }
+                season.episodes.push_back(std::move(episode));
+                return true;
+            });
+        default:
+            return ReadFabricField(reader, field, season);
+        }
+    });
+}
+
+bool JsonFeedReader::ReadEpisode(runtime::JsonReader& reader, Episode& episode, uint32_t& seasonNumber)
+{
+    // Podcast Index describes the enclosure with flat members, which go into the first enclosure
+    const auto flatEnclosure = [&episode]() -> Enclosure& {
+        if (episode.enclosures.empty()) {
+            episode.enclosures.push_back(Enclosure{});
+        }
+        return episode.enclosures.front();
+    };
+    runtime::String content;
+    const bool good = ReadMembers(reader, [this, &reader, &episode, &seasonNumber, &flatEnclosure, &content](const Field field) {
+        std::string_view name;
+        switch (field) {
+        case Field::GUID:
+            return ReadGuid(reader, episode.id);
+        case Field::EPISODE_NUMBER:
+        case Field::EPISODE:
+            return ReadUnsigned(reader, episode.episodeNumber);
+        case Field::SEASON_NUMBER:
+        case Field::SEASON:
+            return ReadUnsigned(reader, seasonNumber);
+        case Field::TITLE:
+            return ReadString(reader, episode.title);
+        case Field::SUBTITLE:
+            return ReadString(reader, episode.subtitle);
+        case Field::DESCRIPTION:
+            return ReadString(reader, episode.description);
+        case Field::CONTENT_HTML:
+        case Field::CONTENT_TEXT:
+            return ReadString(reader, content);
+        case Field::SUMMARY:
+            return ReadString(reader, episode.summary);
+        case Field::TYPE:
+        case Field::EPISODE_TYPE:
+            if (ReadName(reader, name) == false) {
+                return false;
+            }
+            episode.type = EpisodeTypeFromName(name);
+            return true;
+        case Field::PUBLICATION_DATE:
+        case Field::DATE_PUBLISHED:
+            return ReadTimestamp(reader, episode.publicationDate);
+        case Field::DURATION:
+            return ReadTimespan(reader, episode.duration);
+        case Field::COVER_ART:
+        case Field::IMAGE:
+            return ReadPicture(reader, episode.coverArt);
+        case Field::ENCLOSURES:
+            return ReadEnclosures(reader, episode.enclosures);
+        case Field::ATTACHMENTS:
+            return ReadAttachments(reader, episode);
+        case Field::ENCLOSURE_URL:
+            return ReadString(reader, flatEnclosure().uri);
+        case Field::ENCLOSURE_TYPE: {
+            Enclosure& enclosure = flatEnclosure();
+            if (ReadInterned(reader, enclosure.mimeType) == false) {
+                return false;
+            }
+            enclosure.type = EnclosureTypeFromMime(enclosure.mimeType.GetView());
+            return true;
+        }
+        case Field::ENCLOSURE_LENGTH:
+            return ReadUnsigned(reader, flatEnclosure().fileSize);
+        case Field::TAGS:
+            return ReadTagReferences(reader, episode.tags);
+        case Field::CONTRIBUTORS:
+            return ReadContributions(reader, episode.contributors);
+        case Field::AUTHORS:
+        case Field::PERSONS:
+            return ReadPersons(reader, episode.contributors);
+        default:
+            return ReadFabricField(reader, field, episode);
+        }
+    });
+
+    // Full show notes, used when there is no shorter description
+    if (episode.description.IsEmpty()) {
+        episode.description = std::move(content);
+    }
+    return good;
+}
+
+bool JsonFeedReader::ReadEpisodes(runtime::JsonReader& reader, Podcast& podcast)
+{
+    return ReadObjects(reader, [this, &reader, &podcast] {
+        Episode episode{};
+        uint32_t seasonNumber = 0;
+        if (ReadEpisode(reader, episode, seasonNumber) == false) {
+            return false;
+        }
+        GetSeason(podcast, seasonNumber).episodes.push_back(std::move(episode));
+        return true;
+    });
+}
+
+bool JsonFeedReader::ReadContributor(runtime::JsonReader& reader, Contributor& contributor)
+{
+    return ReadMembers(reader, [this, &reader, &contributor](const Field field) {
+        switch (field) {
+        case Field::NAME:
+            return ReadString(reader, contributor.name);
+        case Field::EMAIL:
+            return ReadString(reader, contributor.email);
+        case Field::URL:
+        case Field::HREF:
+            return ReadString(reader, contributor.url);
+        case Field::ROLE:
+            return ReadInterned(reader, contributor.role);
+        case Field::BIO:
+            return ReadString(reader, contributor.bio);
+        case Field::IMAGE:
+        case Field::AVATAR:
+        case Field::IMG:
+            return ReadPicture(reader, contributor.image);
+        case Field::PRESENCE:
+            return ReadPresence(reader, contributor.presence);
+        default:
+            return ReadFabricField(reader, field, contributor);
+        }
+    });
+}
+
+bool JsonFeedReader::ReadPublisher(runtime::JsonReader& reader, Publisher& publisher)
+{
+    return ReadMembers(reader, [this, &reader, &publisher](const Field field) {
+        switch (field) {
+        case Field::NAME:
+            return ReadString(reader, publisher.name);
+        case Field::EMAIL:
+            return ReadString(reader, publisher.email);
+        case Field::URL:
+            return ReadString(reader, publisher.url);
+        case Field::DESCRIPTION:
+            return ReadString(reader, publisher.description);
+        default:
+            return ReadFabricField(reader, field, publisher);
+        }
+    });
+}
+
+bool JsonFeedReader::ReadPicture(runtime::JsonReader& reader, Picture& picture)
+{
+    // Pictures are objects natively and plain URLs in Podcast Index and JSON Feed
+    const Token token = reader.Next();
+    if (token == Token::STRING) {
+        picture.uri  = MakeString(reader.GetValue());
+        picture.type = PictureTypeFromUri(picture.uri.GetView());
+        return true;
+    }
+    if (token != Token::BEGIN_OBJECT) {
+        return SkipValue(reader, token);
+    }
+    bool typed      = false;
+    const bool good = ReadMembers(reader, [this, &reader, &picture, &typed](const Field field) {
+        std::string_view name;
+        switch (field) {
+        case Field::URI:
+        case Field::URL:
+            return ReadString(reader, picture.uri);
+        case Field::AUTHOR:
+            return ReadString(reader, picture.author);
+        case Field::LICENSE:
+            return ReadString(reader, picture.license);
+        case Field::COPYRIGHT:
+            return ReadString(reader, picture.copyright);
+        case Field::TYPE:
+            if (ReadName(reader, name) == false) {
+                return false;
+            }
+            picture.type = EqualsIgnoreCase(name, "png") ? PictureType::PNG : PictureType::JPG;
+            typed        = (name.empty() == false);
+            return true;
+        case Field::WIDTH:
+            return ReadUnsigned(reader, picture.width);
+        case Field::HEIGHT:
+            return ReadUnsigned(reader, picture.height);
+        default:
+            return reader.Skip();
+        }
+    });
+    if (typed == false) {
+        picture.type = PictureTypeFromUri(picture.uri.GetView());
+    }
+    return good;
+}
+
+bool JsonFeedReader::ReadEnclosure(runtime::JsonReader& reader, Enclosure& enclosure, runtime::Timespan& duration)
+{
+    bool typed      = false;
+    const bool good = ReadMembers(reader, [this, &reader, &enclosure, &duration, &typed](const Field field) {
+        std::string_view name;
+        switch (field) {
+        case Field::URI:
+        case Field::URL:
+            return ReadString(reader, enclosure.uri);
+        case Field::AUTHOR:
+            return ReadString(reader, enclosure.author);
+        case Field::LICENSE:
+            return ReadString(reader, enclosure.license);
+        case Field::COPYRIGHT:
+            return ReadString(reader, enclosure.copyright);
+        case Field::TYPE:
+            if (ReadName(reader, name) == false) {
+                return false;
+            }
+            enclosure.type = EnclosureTypeFromName(name);
+            typed          = (name.empty() == false);
+            return true;
+        case Field::MIME_TYPE:
+            return ReadInterned(reader, enclosure.mimeType);
+        case Field::FILE_SIZE:
+        case Field::SIZE_IN_BYTES:
+            return ReadUnsigned(reader, enclosure.fileSize);
+        case Field::DURATION_IN_SECONDS:
+            return ReadTimespan(reader, duration);
+        default:
+            return reader.Skip();
+        }
+    });
+    if (typed == false) {
+        enclosure.type = EnclosureTypeFromMime(enclosure.mimeType.GetView());
+    }
+    return good;
+}
+
+bool JsonFeedReader::ReadEnclosures(runtime::JsonReader& reader, std::vector<Enclosure>& enclosures)
+{
+    return ReadObjects(reader, [this, &reader, &enclosures] {
+        Enclosure enclosure{};
+        runtime::Timespan duration;
+        if (ReadEnclosure(reader, enclosure, duration) == false) {
+            return false;
+        }
+        enclosures.push_back(std::move(enclosure));
+        return true;
+    });
+}
+
+bool JsonFeedReader::ReadAttachments(runtime::JsonReader& reader, Episode& episode)
+{
+    // JSON Feed has no episode duration, the first attachment that carries one provides it
+    return ReadObjects(reader, [this, &reader, &episode] {
+        Enclosure enclosure{};
+        runtime::Timespan duration;
+        if (ReadEnclosure(reader, enclosure, duration) == false) {
+            return false;
+        }
+        if (episode.duration.IsZero()) {
+            episode.duration = duration;
+        }
+        episode.enclosures.push_back(std::move(enclosure));
+        return true;
+    });
+}
+
+bool JsonFeedReader::ReadTag(runtime::JsonReader& reader, Tag& tag)
+{
+    return ReadMembers(reader, [this, &reader, &tag](const Field field) {
+        return ReadTagField(reader, field, tag);
+    });
+}
+
+bool JsonFeedReader::ReadTagField(runtime::JsonReader& reader, const JsonFeedField field, Tag& tag)
+{
+    switch (field) {
+    case Field::NAME:
+        return ReadString(reader, tag.name);
+    case Field::DESCRIPTION:
+        return ReadString(reader, tag.description);
+    case Field::CREATOR:
+        return ReadObjectValue(reader, [this, &reader, &tag] {
+            return ReadContributorHandle(reader, tag.creator);
+        });
+    default:
+        return ReadFabricField(reader, field, tag);
+    }
+}
+
+bool JsonFeedReader::ReadFabricField(runtime::JsonReader& reader, const JsonFeedField field, Fabric& fabric)
+{
+    switch (field) {
+    case Field::ID:
+        return ReadGuid(reader, fabric.id);
+    case Field::TYPE_ID:
+        return ReadGuid(reader, fabric.typeId);
+    case Field::CREATION_DATE:
+        return ReadTimestamp(reader, fabric.creationDate);
+    case Field::MODIFICATION_DATE:
+    case Field::DATE_MODIFIED:
+        return ReadTimestamp(reader, fabric.modificationDate);
+    case Field::COMMENT:
+        return ReadString(reader, fabric.comment);
+    default:
+        return reader.Skip();
+    }
+}
+
+bool JsonFeedReader::ReadContributions(runtime::JsonReader& reader, std::vector<Contribution>& contributions)
+{
+    return ReadObjects(reader, [this, &reader, &contributions] {
+        Contribution contribution;
+        const bool good = ReadMembers(reader, [this, &reader, &contribution](const Field field) {
+            switch (field) {
+            case Field::CONTRIBUTOR:
+                return ReadObjectValue(reader, [this, &reader, &contribution] {
+                    return ReadContributorHandle(reader, contribution.contributor);
+                });
+            case Field::TYPE:
+                return ReadInterned(reader, contribution.type);
+            case Field::NOTES:
+                return ReadString(reader, contribution.notes);
+            default:
+                return reader.Skip();
+            }
+        });
+        if (good && contribution.contributor) {
+            contributions.push_back(std::move(contribution));
+        }
+        return good;
+    });
+}
+
+bool JsonFeedReader::ReadPersons(runtime::JsonReader& reader, std::vector<Contribution>& contributions)
+{
+    // JSON Feed authors and Podcast Index persons describe the person and the role in one object
+    return ReadObjects(reader, [this, &reader, &contributions] {
+        Contributor contributor{};
+        if (ReadContributor(reader, contributor) == false) {
+            return false;
+        }
+        if (contributor.id.IsNil() && contributor.name.IsEmpty()) {
+            return true;
+        }
+        Contribution contribution;
+        contribution.type        = contributor.role.IsEmpty() ? runtime::String::Intern("host") : contributor.role;
+        contribution.contributor = ShareContributor(std::move(contributor));
+        contributions.push_back(std::move(contribution));
+        return true;
+    });
+}
+
+bool JsonFeedReader::ReadTagReferences(runtime::JsonReader& reader, std::vector<TagReference>& tags)
+{
+    return ReadArrayValue(reader, [this, &reader, &tags](const Token token) {
+        if (token == Token::STRING) {
+            // JSON Feed tags are plain names
+            Tag tag{};
+            tag.name = MakeString(reader.GetValue());
+            if (tag.name.IsEmpty() == false) {
+                tags.push_back(TagReference{ShareTag(std::move(tag)), 1.0});
+            }
+            return true;
+        }
+        if (token != Token::BEGIN_OBJECT) {
+            return SkipValue(reader, token);
+        }
+        TagReference reference{};
+        const bool good = ReadMembers(reader, [this, &reader, &reference](const Field field) {
+            switch (field) {
+            case Field::TAG:
+                return ReadObjectValue(reader, [this, &reader, &reference] {
+                    return ReadTagHandle(reader, reference.tag);
+                });
+            case Field::WEIGHT:
+                return ReadDouble(reader, reference.weight);
+            default:
+                return reader.Skip();
+            }
+        });
+        if (good && reference.tag) {
+            tags.push_back(std::move(reference));
+        }
+        return good;
+    });
+}
+
+bool JsonFeedReader::ReadPresence(runtime::JsonReader& reader, std::vector<ContributorPresence>& presence)
+{
+    return ReadObjects(reader, [this, &reader, &presence] {
+        ContributorPresence interval{};
+        const bool good = ReadMembers(reader, [this, &reader, &interval](const Field field) {
+            switch (field) {
+            case Field::START_TIME:
+                return ReadTimespan(reader, interval.startTime);
+            case Field::END_TIME:
+                return ReadTimespan(reader, interval.endTime);
+            default:
+                return reader.Skip();
+            }
+        });
+        presence.push_back(interval);
+        return good;
+    });
+}
+
+bool JsonFeedReader::ReadCategories(runtime::JsonReader& reader, std::vector<runtime::String>& categories)
+{
+    // Natively an array of names, Podcast Index maps category identifiers to names
+    const Token token = reader.Next();
+    if (token == Token::BEGIN_ARRAY) {
+        for (Token next = reader.Next(); next != Token::END_ARRAY; next = reader.Next()) {
+            if (next == Token::STRING) {
+                categories.push_back(runtime::String::Intern(Trim(Decode(reader.GetValue()))));
+            }
+            else if (SkipValue(reader, next) == false) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (token == Token::BEGIN_OBJECT) {
+        return ReadMembers(reader, [this, &reader, &categories](const Field) {
+            const Token value = reader.Next();
+            if (value == Token::STRING) {
+                categories.push_back(runtime::String::Intern(Trim(Decode(reader.GetValue()))));
+                return true;
+            }
+            return SkipValue(reader, value);
+        });
+    }
+    return SkipValue(reader, token);
+}
+
+bool JsonFeedReader::ReadContributorHandle(runtime::JsonReader& reader, EntityHandle<Contributor>& handle)
+{
+    Contributor contributor{};
+    if (ReadContributor(reader, contributor) == false) {
+        return false;
+    }
+    handle = ShareContributor(std::move(contributor));
+    return true;
+}
+
+bool JsonFeedReader::ReadTagHandle(runtime::JsonReader& reader, EntityHandle<Tag>& handle)
+{
+    Tag tag{};
+    if (ReadTag(reader, tag) == false) {
+        return false;
+    }
+    handle = ShareTag(std::move(tag));
+    return true;
+}
+
+bool JsonFeedReader::ReadString(runtime::JsonReader& reader, runtime::String& value)
+{
+    const Token token = reader.Next();
+    if (token == Token::STRING) {
+        value = MakeString(reader.GetValue());
+        return true;
+    }
+    return SkipValue(reader, token);
+}
+
+bool JsonFeedReader::ReadInterned(runtime::JsonReader& reader, runtime::String& value)
+{
+    const Token token = reader.Next();
+    if (token == Token::STRING) {
+        value = runtime::String::Intern(Trim(Decode(reader.GetValue())));
+        return true;
+    }
+    return SkipValue(reader, token);
+}
+
+bool JsonFeedReader::ReadName(runtime::JsonReader& reader, std::string_view& name)
+{
+    const Token token = reader.Next();
+    name              = (token == Token::STRING) ? Trim(Decode(reader.GetValue())) : std::string_view();
+    return SkipValue(reader, token);
+}
+
+bool JsonFeedReader::ReadGuid(runtime::JsonReader& reader, runtime::Guid& value)
+{
+    // A UUID replaces an identifier derived from another member, other text one derived from a
+    // number, and numbers only fill a nil identifier
+    const Token token = reader.Next();
+    if (token == Token::STRING) {
+        const std::string_view text = Trim(Decode(reader.GetValue()));
+        if (const auto uuid = ParseUuid(text)) {
+            value = *uuid;
+        }
+        else if (value.IsNil() || numericIds_.contains(value)) {
+            value = ParseGuid(text);
+        }
+        return true;
+    }
+    if (token == Token::NUMBER) {
+        if (value.IsNil()) {
+            value = runtime::Guid::FromName(PODCAST_INDEX_NAMESPACE, reader.GetValue().raw);
+            numericIds_.insert(value);
+        }
+        return true;
+    }
+    return SkipValue(reader, token);
+}
+
+bool JsonFeedReader::ReadTimestamp(runtime::JsonReader& reader, runtime::Timestamp& value)
+{
+    const Token token = reader.Next();
+    if (token == Token::STRING) {
+        value = ParseDate(Trim(Decode(reader.GetValue())));
+        return true;
+    }
+    if (token == Token::NUMBER) {
+        value = runtime::Timestamp::FromSeconds(ParseNumber<int64_t>(reader.GetValue().raw));
+        return true;
+    }
+    return SkipValue(reader, token);
+}
+
+bool JsonFeedReader::ReadTimespan(runtime::JsonReader& reader, runtime::Timespan& value)
+{
+    const Token token = reader.Next();
+    if (token == Token::NUMBER) {
+        value = ParseSeconds(reader.GetValue().raw).value_or(runtime::Timespan());
+        return true;
+    }
+    if (token == Token::STRING) {
+        value = runtime::Timespan::Parse(Trim(Decode(reader.GetValue()))).value_or(runtime::Timespan());
+        return true;
+    }
+    return SkipValue(reader, token);
+}
+
+bool JsonFeedReader::ReadDouble(runtime::JsonReader& reader, double& value)
+{
+    const Token token = reader.Next();
+    if (token == Token::NUMBER) {
+        value = ParseNumber<double>(reader.GetValue().raw);
+        return true;
+    }
+    return SkipValue(reader, token);
+}
+
+template<typename T>
+bool JsonFeedReader::ReadUnsigned(runtime::JsonReader& reader, T& value)
+{
+    // Podcast Index sends some numbers as strings
+    const Token token = reader.Next();
+    if (token == Token::NUMBER) {
+        value = ParseNumber<T>(reader.GetValue().raw);
+        return true;
+    }
+    if (token == Token::STRING) {
+        value = ParseNumber<T>(Trim(Decode(reader.GetValue())));
+        return true;
+    }
+    return SkipValue(reader, token);
+}
+
+EntityHandle<Contributor> JsonFeedReader::ShareContributor(Contributor contributor)
+{
+    if (contributor.id.IsNil()) {
+        contributor.id = MakeContributorId(contributor.name.GetView(), contributor.url.GetView());
+    }
+    const auto existing = contributors_.find(contributor.id);
+    if (existing != contributors_.end()) {
+        return existing->second;
+    }
+    EntityHandle<Contributor> handle = Share(contributorRegistry_, std::move(contributor));
+    contributors_.emplace(handle->id, handle);
+    return handle;
+}
+
+EntityHandle<Tag> JsonFeedReader::ShareTag(Tag tag)
+{
+    if (tag.id.IsNil()) {
+        tag.id = MakeTagId(tag.name.GetView());
+    }
+    const auto existing = tags_.find(tag.id);
+    if (existing != tags_.end()) {
+        return existing->second;
+    }
+    EntityHandle<Tag> handle = Share(tagRegistry_, std::move(tag));
+    tags_.emplace(handle->id, handle);
+    return handle;
+}
+
+Season& JsonFeedReader::GetSeason(Podcast& podcast, const uint32_t seasonNumber)
+{
+    // Episode lists are usually ordered by season, so the last season is almost always the match
+    for (size_t i = podcast.seasons.size(); i > 0; --i) {
+        if (podcast.seasons[i - 1].seasonNumber == seasonNumber) {
+            return podcast.seasons[i - 1];
+        }
+    }
+    Season season{};
+    season.seasonNumber = seasonNumber;
+    podcast.seasons.push_back(std::move(season));
+    return podcast.seasons.back();
+}
+
+runtime::String JsonFeedReader::MakeString(const runtime::JsonValue& value)
+{
+    return parsing::MakeString(value, arena_);
+}
+
+std::string_view JsonFeedReader::Decode(const runtime::JsonValue& value)
+{
+    return parsing::Decode(value, decoded_);
+}
+} // namespace ultralove::p3::model
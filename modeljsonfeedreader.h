@@ -0,0 +1,204 @@
+///
+// \file modeljsonfeedreader.h
+// \brief P3 Model JSON Feed Reader
+// \details Reads podcasts and their parts from JSON without building a document tree
+//
+
+#ifndef __P3_MODEL_JSON_FEED_READER_H_INCL__
+#define __P3_MODEL_JSON_FEED_READER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelchaptertag.h"
+#include "modelcontribution.h"
+#include "modelcontributor.h"
+#include "modelenclosure.h"
+#include "modelentityhandle.h"
+#include "modelentityregistry.h"
+#include "modelepisode.h"
+#include "modellocationtag.h"
+#include "modelpicture.h"
+#include "modelpodcast.h"
+#include "modelpublisher.h"
+#include "modelseason.h"
+#include "modeltag.h"
+#include "modeltagreference.h"
+#include "modeltranscripttag.h"
+#include "runtimearena.h"
+#include "runtimeguid.h"
+#include "runtimejsonreader.h"
+#include "runtimestring.h"
+#include "runtimetimespan.h"
+#include "runtimetimestamp.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+// Member names known to JsonFeedReader, defined in modeljsonfeedreader.cpp
+enum class JsonFeedField : uint8_t;
+
+/// \brief JSON reader for podcasts, seasons, episodes, contributors, enclosures and tags
+/// \details Reads the documents written by JsonFeedWriter with a single pass of an on-demand
+/// runtime::JsonReader: a member is only converted when the reader knows it, everything else is
+/// skipped by bracket matching without being looked at. Strings are stored like FeedReader stores
+/// them, inline or in the arena passed to the constructor, and escape sequences are decoded straight
+/// into their final storage; languages, categories, MIME types and roles are interned.
+///
+/// Besides the native member names the reader understands the common members of Podcast Index
+/// API responses and JSON Feed 1.1 documents: a podcast may carry a flat "items" or "episodes"
+/// array that is grouped into seasons by "season" as FeedReader does, "attachments" and the
+/// enclosureUrl/enclosureType/enclosureLength members become enclosures, "authors" and "persons"
+/// become contributions, plain strings in "tags" become tags, and dates may be ISO 8601 or
+/// RFC 822 strings or Unix times. A {"feed": {...}} envelope is unwrapped.
+///
+/// Identifiers that are no UUID get name-based UUIDv5 identifiers, so a document yields the same
+/// identifiers every time it is read: strings as in FeedReader, numeric Podcast Index identifiers
+/// in a name space of their own. A UUID takes precedence over any other identifier member of the
+/// same object and a string over a number. Contributors without an identifier are identified by
+/// their url or name like FeedReader persons, tags by their name.
+///
+/// Contributors and tags are shared per document: an object whose identifier was seen before
+/// refers to the first one, so references written by JsonFeedWriter as {"id": ...} resolve. A
+/// reader created with registries also shares them with everything else that uses the registries:
+/// an entity is taken from its registry unless the document carries a newer modification date, in
+/// which case the document's version is registered. Members of the wrong JSON type are ignored. A
+/// reader is not thread-safe; use one reader per thread, the registries may be shared.
+class JsonFeedReader
+{
+public:
+    /// \brief Create a reader
+    /// \param arena Arena receiving long strings, must outlive everything read
+    explicit JsonFeedReader(runtime::Arena& arena);
+
+    /// \brief Create a reader that shares contributors and tags through registries
+    /// \param arena Arena receiving long strings, must outlive everything read
+    /// \param contributors Registry of contributors, must outlive the reader
+    /// \param tags Registry of tags, must outlive the reader
+    JsonFeedReader(runtime::Arena& arena, EntityRegistry<Contributor>& contributors, EntityRegistry<Tag>& tags);
+
+    /// \brief Destroy the reader
+    virtual ~JsonFeedReader() = default;
+
+    JsonFeedReader(const JsonFeedReader&)            = delete;
+    JsonFeedReader& operator=(const JsonFeedReader&) = delete;
+
+    /// \brief Read a podcast
+    /// \param document Complete JSON document
+    /// \param podcast Podcast to replace
+    /// \return True if the document is a well-formed JSON object
+    bool Read(const std::string_view document, Podcast& podcast);
+
+    /// \brief Read a podcast from a file through a read-only memory mapping
+    /// \param path Path of the JSON file
+    /// \param podcast Podcast to replace
+    /// \return True if the file could be mapped and is a well-formed JSON object
+    bool ReadFile(const char* path, Podcast& podcast);
+
+    /// \brief Read a season
+    /// \param document Complete JSON document
+    /// \param season Season to replace
+    /// \return True if the document is a well-formed JSON object
+    bool Read(const std::string_view document, Season& season);
+
+    /// \brief Read an episode
+    /// \param document Complete JSON document
+    /// \param episode Episode to replace
+    /// \return True if the document is a well-formed JSON object
+    bool Read(const std::string_view document, Episode& episode);
+
+    /// \brief Read a contributor
+    /// \param document Complete JSON document
+    /// \param contributor Contributor to replace
+    /// \return True if the document is a well-formed JSON object
+    bool Read(const std::string_view document, Contributor& contributor);
+
+    /// \brief Read an enclosure
+    /// \param document Complete JSON document
+    /// \param enclosure Enclosure to replace
+    /// \return True if the document is a well-formed JSON object
+    bool Read(const std::string_view document, Enclosure& enclosure);
+
+    /// \brief Read a tag
+    /// \param document Complete JSON document
+    /// \param tag Tag to replace
+    /// \return True if the document is a well-formed JSON object
+    bool Read(const std::string_view document, Tag& tag);
+
+    /// \brief Read a chapter tag
+    /// \param document Complete JSON document
+    /// \param tag Chapter tag to replace
+    /// \return True if the document is a well-formed JSON object
+    bool Read(const std::string_view document, ChapterTag& tag);
+
+    /// \brief Read a location tag
+    /// \param document Complete JSON document
+    /// \param tag Location tag to replace
+    /// \return True if the document is a well-formed JSON object
+    bool Read(const std::string_view document, LocationTag& tag);
+
+    /// \brief Read a transcript tag
+    /// \param document Complete JSON document
+    /// \param tag Transcript tag to replace
+    /// \return True if the document is a well-formed JSON object
+    bool Read(const std::string_view document, TranscriptTag& tag);
+
+private:
+    template<typename T, typename Reader>
+    bool ReadDocument(const std::string_view document, T& target, const Reader& read);
+
+    bool ReadPodcast(runtime::JsonReader& reader, Podcast& podcast);
+    bool ReadSeason(runtime::JsonReader& reader, Season& season);
+    bool ReadEpisode(runtime::JsonReader& reader, Episode& episode, uint32_t& seasonNumber);
+    bool ReadEpisodes(runtime::JsonReader& reader, Podcast& podcast);
+    bool ReadContributor(runtime::JsonReader& reader, Contributor& contributor);
+    bool ReadPublisher(runtime::JsonReader& reader, Publisher& publisher);
+    bool ReadPicture(runtime::JsonReader& reader, Picture& picture);
+    bool ReadEnclosure(runtime::JsonReader& reader, Enclosure& enclosure, runtime::Timespan& duration);
+    bool ReadEnclosures(runtime::JsonReader& reader, std::vector<Enclosure>& enclosures);
+    bool ReadAttachments(runtime::JsonReader& reader, Episode& episode);
+    bool ReadTag(runtime::JsonReader& reader, Tag& tag);
+    bool ReadTagField(runtime::JsonReader& reader, const JsonFeedField field, Tag& tag);
+    bool ReadFabricField(runtime::JsonReader& reader, const JsonFeedField field, Fabric& fabric);
+    bool ReadContributions(runtime::JsonReader& reader, std::vector<Contribution>& contributions);
+    bool ReadPersons(runtime::JsonReader& reader, std::vector<Contribution>& contributions);
+    bool ReadTagReferences(runtime::JsonReader& reader, std::vector<TagReference>& tags);
+    bool ReadPresence(runtime::JsonReader& reader, std::vector<ContributorPresence>& presence);
+    bool ReadCategories(runtime::JsonReader& reader, std::vector<runtime::String>& categories);
+    bool ReadContributorHandle(runtime::JsonReader& reader, EntityHandle<Contributor>& handle);
+    bool ReadTagHandle(runtime::JsonReader& reader, EntityHandle<Tag>& handle);
+    bool ReadString(runtime::JsonReader& reader, runtime::String& value);
+    bool ReadInterned(runtime::JsonReader& reader, runtime::String& value);
+    bool ReadName(runtime::JsonReader& reader, std::string_view& name);
+    bool ReadGuid(runtime::JsonReader& reader, runtime::Guid& value);
+    bool ReadTimestamp(runtime::JsonReader& reader, runtime::Timestamp& value);
+    bool ReadTimespan(runtime::JsonReader& reader, runtime::Timespan& value);
+    bool ReadDouble(runtime::JsonReader& reader, double& value);
+    template<typename T>
+    bool ReadUnsigned(runtime::JsonReader& reader, T& value);
+    EntityHandle<Contributor> ShareContributor(Contributor contributor);
+    EntityHandle<Tag> ShareTag(Tag tag);
+    Season& GetSeason(Podcast& podcast, const uint32_t seasonNumber);
+    runtime::String MakeString(const runtime::JsonValue& value);
+    std::string_view Decode(const runtime::JsonValue& value);
+
+    runtime::Arena& arena_;
+    std::string decoded_;
+    EntityRegistry<Contributor>* contributorRegistry_ = nullptr;
+    EntityRegistry<Tag>* tagRegistry_                 = nullptr;
+    std::unordered_map<runtime::Guid, EntityHandle<Contributor>> contributors_;
+    std::unordered_map<runtime::Guid, EntityHandle<Tag>> tags_;
+    // Identifiers derived from numbers, which identifier strings replace
+    std::unordered_set<runtime::Guid> numericIds_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_JSON_FEED_READER_H_INCL__
@@ -0,0 +1,444 @@
+///
+// \file modeljsonfeedwriter.cpp
+// \brief P3 Model JSON Feed Writer implementation
+// \details Mapping of the object model to JSON members
+//
+
+#include "modeljsonfeedwriter.h"
+
+#include <charconv>
+
+namespace ultralove::p3::model {
+namespace {
+constexpr std::string_view EpisodeTypeName(const EpisodeType type) noexcept
+{
+    switch (type) {
+    case EpisodeType::TRAILER:
+        return "trailer";
+    case EpisodeType::BONUS:
+        return "bonus";
+    default:
+        return "full";
+    }
+}
+
+constexpr std::string_view EnclosureTypeName(const EnclosureType type) noexcept
+{
+    switch (type) {
+    case EnclosureType::MP4:
+        return "mp4";
+    case EnclosureType::OGG:
+        return "ogg";
+    case EnclosureType::OPUS:
+        return "opus";
+    default:
+        return "mp3";
+    }
+}
+
+constexpr std::string_view PictureTypeName(const PictureType type) noexcept
+{
+    return (type == PictureType::PNG) ? "png" : "jpg";
+}
+
+constexpr bool IsSet(const runtime::Timestamp& timestamp) noexcept
+{
+    return timestamp != runtime::Timestamp();
+}
+} // namespace
+
+JsonFeedWriter::JsonFeedWriter(runtime::OutputSink& sink, const size_t bufferSize) : writer_(sink, bufferSize) {}
+
+bool JsonFeedWriter::Write(const Podcast& podcast)
+{
+    writer_.BeginObject();
+    WriteFabricFields(podcast);
+    WriteString("title", podcast.title);
+    WriteString("subtitle", podcast.subtitle);
+    WriteString("description", podcast.description);
+    WriteString("summary", podcast.summary);
+    WriteString("language", podcast.language);
+    if (podcast.categories.empty() == false) {
+        writer_.Key("categories");
+        writer_.BeginArray();
+        for (const runtime::String& category : podcast.categories) {
+            writer_.Text(category.GetView());
+        }
+        writer_.EndArray();
+    }
+    WriteTimestamp("publicationDate", podcast.publicationDate);
+    WriteTimestamp("lastBuildDate", podcast.lastBuildDate);
+    WriteString("managingEditor", podcast.managingEditor);
+    WriteString("webmaster", podcast.webmaster);
+    WriteString("copyright", podcast.copyright);
+    WriteString("link", podcast.link);
+    WritePublisher(podcast.publisher);
+    WritePicture("coverArt", podcast.coverArt);
+    WriteTagReferences(podcast.tags);
+    WriteContributions(podcast.contributors);
+    if (podcast.seasons.empty() == false) {
+        writer_.Key("seasons");
+        writer_.BeginArray();
+        for (const Season& season : podcast.seasons) {
+            WriteSeason(season);
+        }
+        writer_.EndArray();
+    }
+    writer_.EndObject();
+    return Finish();
+}
+
+bool JsonFeedWriter::Write(const Season& season)
+{
+    WriteSeason(season);
+    return Finish();
+}
+
+bool JsonFeedWriter::Write(const Episode& episode)
+{
+    WriteEpisode(episode);
+    return Finish();
+}
+
+bool JsonFeedWriter::Write(const Contributor& contributor)
+{
+    WriteContributor(contributor);
+    return Finish();
+}
+
+bool JsonFeedWriter::Write(const Enclosure& enclosure)
+{
+    WriteEnclosure(enclosure);
+    return Finish();
+}
+
+bool JsonFeedWriter::Write(const Tag& tag)
+{
+    writer_.BeginObject();
+    WriteTagFields(tag);
+    writer_.EndObject();
+    return Finish();
+}
+
+bool JsonFeedWriter::Write(const ChapterTag& tag)
+{
+    writer_.BeginObject();
+    WriteTagFields(tag);
+    WriteTimespan("startTime", tag.startTime);
+    WriteTimespan("endTime", tag.endTime);
+    writer_.EndObject();
+    return Finish();
+}
+
+bool JsonFeedWriter::Write(const LocationTag& tag)
+{
+    writer_.BeginObject();
+    WriteTagFields(tag);
+    WriteString("address", tag.address);
+    writer_.Key("latitude");
+    writer_.Number(tag.latitude);
+    writer_.Key("longitude");
+    writer_.Number(tag.longitude);
+    writer_.EndObject();
+    return Finish();
+}
+
+bool JsonFeedWriter::Write(const TranscriptTag& tag)
+{
+    writer_.BeginObject();
+    WriteTagFields(tag);
+    WriteString("text", tag.text);
+    WriteTimespan("startTime", tag.startTime);
+    WriteTimespan("endTime", tag.endTime);
+    writer_.EndObject();
+    return Finish();
+}
+
+bool JsonFeedWriter::Finish()
+{
+    // References are only resolvable within the document they were written to
+    contributors_.clear();
+    tags_.clear();
+    return writer_.Flush();
+}
+
+void JsonFeedWriter::WriteSeason(const Season& season)
+{
+    writer_.BeginObject();
+    WriteFabricFields(season);
+    WriteUnsigned("seasonNumber", season.seasonNumber);
+    WriteString("title", season.title);
+    WriteString("description", season.description);
+    WriteTimestamp("publicationDate", season.publicationDate);
+    WritePicture("coverArt", season.coverArt);
+    WriteTagReferences(season.tags);
+    WriteContributions(season.contributors);
+    if (season.episodes.empty() == false) {
+        writer_.Key("episodes");
+        writer_.BeginArray();
+        for (const Episode& episode : season.episodes) {
+            WriteEpisode(episode);
+        }
+        writer_.EndArray();
+    }
+    writer_.EndObject();
+}
+
+void JsonFeedWriter::WriteEpisode(const Episode& episode)
+{
+    writer_.BeginObject();
+    WriteFabricFields(episode);
+    WriteUnsigned("episodeNumber", episode.episodeNumber);
+    WriteString("title", episode.title);
+    WriteString("subtitle", episode.subtitle);
+    WriteString("description", episode.description);
+    WriteString("summary", episode.summary);
+    writer_.Key("type");
+    writer_.Text(EpisodeTypeName(episode.type));
+    WriteTimestamp("publicationDate", episode.publicationDate);
+    WriteTimespan("duration", episode.duration);
+    WritePicture("coverArt", episode.coverArt);
+    if (episode.enclosures.empty() == false) {
+        writer_.Key("enclosures");
+        writer_.BeginArray();
+        for (const Enclosure& enclosure : episode.enclosures) {
+            WriteEnclosure(enclosure);
+        }
+        writer_.EndArray();
+    }
+    WriteTagReferences(episode.tags);
+    WriteContributions(episode.contributors);
+    writer_.EndObject();
+}
+
+void JsonFeedWriter::WriteContributor(const Contributor& contributor)
+{
+    writer_.BeginObject();
+    WriteFabricFields(contributor);
+    WriteString("name", contributor.name);
+    WriteString("email", contributor.email);
+    WriteString("url", contributor.url);
+    WriteString("role", contributor.role);
+    WriteString("bio", contributor.bio);
+    WritePicture("image", contributor.image);
+    if (contributor.presence.empty() == false) {
+        writer_.Key("presence");
+        writer_.BeginArray();
+        for (const ContributorPresence& presence : contributor.presence) {
+            writer_.BeginObject();
+            WriteTimespan("startTime", presence.startTime);
+            WriteTimespan("endTime", presence.endTime);
+            writer_.EndObject();
+        }
+        writer_.EndArray();
+    }
+    writer_.EndObject();
+}
+
+void JsonFeedWriter::WritePublisher(const Publisher& publisher)
+{
+    if (publisher.id.IsNil() && publisher.name.IsEmpty() && publisher.email.IsEmpty() && publisher.url.IsEmpty()) {
+        return;
+    }
+    writer_.Key("publisher");
+    writer_.BeginObject();
+    WriteFabricFields(publisher);
+    WriteString("name", publisher.name);
+    WriteString("email", publisher.email);
+    WriteString("url", publisher.url);
+    WriteString("description", publisher.description);
+    writer_.EndObject();
+}
+
+void JsonFeedWriter::WritePicture(const std::string_view name, const Picture& picture)
+{
+    if (picture.uri.IsEmpty()) {
+        return;
+    }
+    writer_.Key(name);
+    writer_.BeginObject();
+    WriteString("uri", picture.uri);
+    WriteString("author", picture.author);
+    WriteString("license", picture.license);
+    WriteString("copyright", picture.copyright);
+    writer_.Key("type");
+    writer_.Text(PictureTypeName(picture.type));
+    WriteUnsigned("width", picture.width);
+    WriteUnsigned("height", picture.height);
+    writer_.EndObject();
+}
+
+void JsonFeedWriter::WriteEnclosure(const Enclosure& enclosure)
+{
+    writer_.BeginObject();
+    WriteString("uri", enclosure.uri);
+    WriteString("author", enclosure.author);
+    WriteString("license", enclosure.license);
+    WriteString("copyright", enclosure.copyright);
+    writer_.Key("type");
+    writer_.Text(EnclosureTypeName(enclosure.type));
+    WriteString("mimeType", enclosure.mimeType);
+    WriteUnsigned("fileSize", enclosure.fileSize);
+    writer_.EndObject();
+}
+
+void JsonFeedWriter::WriteTag(const Tag& tag)
+{
+    writer_.BeginObject();
+    if (tag.id.IsNil() || tags_.insert(tag.id).second) {
+        WriteTagFields(tag);
+    }
+    else {
+        WriteGuid("id", tag.id);
+    }
+    writer_.EndObject();
+}
+
+void JsonFeedWriter::WriteTagFields(const Tag& tag)
+{
+    WriteFabricFields(tag);
+    WriteString("name", tag.name);
+    WriteString("description", tag.description);
+    if (tag.creator) {
+        writer_.Key("creator");
+        if (tag.creator->id.IsNil() || contributors_.insert(tag.creator->id).second) {
+            WriteContributor(*tag.creator);
+        }
+        else {
+            writer_.BeginObject();
+            WriteGuid("id", tag.creator->id);
+            writer_.EndObject();
+        }
+    }
+}
+
+void JsonFeedWriter::WriteFabricFields(const Fabric& fabric)
+{
+    WriteGuid("id", fabric.id);
+    WriteGuid("typeId", fabric.typeId);
+    WriteTimestamp("creationDate", fabric.creationDate);
+    WriteTimestamp("modificationDate", fabric.modificationDate);
+    WriteString("comment", fabric.comment);
+}
+
+void JsonFeedWriter::WriteContributions(const std::vector<Contribution>& contributions)
+{
+    if (contributions.empty()) {
+        return;
+    }
+    writer_.Key("contributors");
+    writer_.BeginArray();
+    for (const Contribution& contribution : contributions) {
+        writer_.BeginObject();
+        if (contribution.contributor) {
+            writer_.Key("contributor");
+            const Contributor& contributor = *contribution.contributor;
+            if (contributor.id.IsNil() || contributors_.insert(contributor.id).second) {
+                WriteContributor(contributor);
+            }
+            else {
+                writer_.BeginObject();
+                WriteGuid("id", contributor.id);
+                writer_.EndObject();
+            }
+        }
+        WriteString("type", contribution.type);
+        WriteString("notes", contribution.notes);
+        writer_.EndObject();
+    }
+    writer_.EndArray();
+}
+
+void JsonFeedWriter::WriteTagReferences(const std::vector<TagReference>& tags)
+{
+    if (tags.empty()) {
+        return;
+    }
+    writer_.Key("tags");
+    writer_.BeginArray();
+    for (const TagReference& reference : tags) {
+        writer_.BeginObject();
+        if (reference.tag) {
+            writer_.Key("tag");
+            WriteTag(*reference.tag);
+        }
+        writer_.Key("weight");
+        writer_.Number(reference.weight);
+        writer_.EndObject();
+    }
+    writer_.EndArray();
+}
+
+void JsonFeedWriter::WriteString(const std::string_view name, const runtime::String& value)
+{
+    if (value.IsEmpty() == false) {
+        writer_.Key(name);
+        writer_.Text(value.GetView());
+    }
+}
+
+void JsonFeedWriter::WriteGuid(const std::string_view name, const runtime::Guid& guid)
+{
+    if (guid.IsNil()) {
+        return;
+    }
+    char text[runtime::Guid::TEXT_LENGTH + 2];
+    text[0]             = '"';
+    const size_t length = guid.Format(text + 1, runtime::Guid::TEXT_LENGTH);
+    text[length + 1]    = '"';
+    writer_.Key(name);
+    writer_.Raw(std::string_view(text, length + 2));
+}
+
+void JsonFeedWriter::WriteTimestamp(const std::string_view name, const runtime::Timestamp& timestamp)
+{
+    if (IsSet(timestamp) == false) {
+        return;
+    }
+    char text[runtime::Timestamp::ISO8601_MAX_LENGTH + 2];
+    text[0]             = '"';
+    const size_t length = timestamp.FormatIso8601(text + 1, runtime::Timestamp::ISO8601_MAX_LENGTH);
+    if (length > 0) {
+        text[length + 1] = '"';
+        writer_.Key(name);
+        writer_.Raw(std::string_view(text, length + 2));
+    }
+}
+
+void JsonFeedWriter::WriteTimespan(const std::string_view name, const runtime::Timespan& timespan)
+{
+    if (timespan.IsZero()) {
+        return;
+    }
+
+    // Whole seconds, then the fraction without trailing zeros, so that nanoseconds round-trip
+    const int64_t nanoseconds = timespan.GetNanoseconds();
+    const uint64_t magnitude  = (nanoseconds < 0) ? (0 - static_cast<uint64_t>(nanoseconds)) : static_cast<uint64_t>(nanoseconds);
+    const uint64_t perSecond  = static_cast<uint64_t>(runtime::Timespan::NANOSECONDS_PER_SECOND);
+    char text[32];
+    size_t length = 0;
+    if (nanoseconds < 0) {
+        text[length++] = '-';
+    }
+    const auto result = std::to_chars(text + length, text + sizeof(text), magnitude / perSecond);
+    length            = static_cast<size_t>(result.ptr - text);
+    uint64_t fraction = magnitude % perSecond;
+    if (fraction > 0) {
+        text[length++] = '.';
+        for (uint64_t scale = perSecond / 10; (fraction > 0) && (scale > 0); scale /= 10) {
+            text[length++] = static_cast<char>('0' + fraction / scale);
+            fraction %= scale;
+        }
+    }
+    writer_.Key(name);
+    writer_.Raw(std::string_view(text, length));
+}
+
+void JsonFeedWriter::WriteUnsigned(const std::string_view name, const uint64_t value)
+{
+    if (value != 0) {
+        writer_.Key(name);
+        writer_.Unsigned(value);
+    }
+}
+} // namespace ultralove::p3::model
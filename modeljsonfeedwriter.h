@@ -0,0 +1,147 @@
+///
+// \file modeljsonfeedwriter.h
+// \brief P3 Model JSON Feed Writer
+// \details Streams podcasts and their parts as JSON
+//
+
+#ifndef __P3_MODEL_JSON_FEED_WRITER_H_INCL__
+#define __P3_MODEL_JSON_FEED_WRITER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelchaptertag.h"
+#include "modelcontribution.h"
+#include "modelcontributor.h"
+#include "modelenclosure.h"
+#include "modelepisode.h"
+#include "modelfabric.h"
+#include "modellocationtag.h"
+#include "modelpicture.h"
+#include "modelpodcast.h"
+#include "modelpublisher.h"
+#include "modelseason.h"
+#include "modeltag.h"
+#include "modeltagreference.h"
+#include "modeltranscripttag.h"
+#include "runtimeguid.h"
+#include "runtimejsonwriter.h"
+#include "runtimeoutputsink.h"
+#include "runtimestring.h"
+#include "runtimetimespan.h"
+#include "runtimetimestamp.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief JSON writer for podcasts, seasons, episodes, contributors, enclosures and tags
+/// \details Walks the object model and streams one JSON object per call through a
+/// runtime::JsonWriter into an OutputSink; no document tree and no intermediate strings are built.
+/// Members are named after the model fields, e.g. "publicationDate", and nested as the model is: a
+/// podcast holds "seasons", a season holds "episodes". Dates are ISO 8601 strings that keep their
+/// timezone offset, durations are seconds with up to nine decimals, identifiers are UUID strings and
+/// enumerations lower case names such as "full" or "mp3". Empty strings, nil identifiers, zero
+/// numbers and durations and timestamps at the epoch are treated as absent and not written.
+///
+/// A contributor or tag is written in full the first time it occurs in a document and as
+/// {"id": ...} afterwards; JsonFeedReader resolves these references. A writer is not thread-safe;
+/// use one writer per thread.
+class JsonFeedWriter
+{
+public:
+    /// \brief Create a writer
+    /// \param sink Destination of the documents, must outlive the writer
+    /// \param bufferSize Size of the output buffer
+    explicit JsonFeedWriter(runtime::OutputSink& sink, const size_t bufferSize = runtime::JsonWriter::DEFAULT_BUFFER_SIZE);
+
+    /// \brief Destroy the writer
+    virtual ~JsonFeedWriter() = default;
+
+    JsonFeedWriter(const JsonFeedWriter&)            = delete;
+    JsonFeedWriter& operator=(const JsonFeedWriter&) = delete;
+
+    /// \brief Write a podcast with its seasons and episodes and flush it to the sink
+    /// \param podcast Podcast to write
+    /// \return True if the sink accepted the whole document
+    bool Write(const Podcast& podcast);
+
+    /// \brief Write a season with its episodes and flush it to the sink
+    /// \param season Season to write
+    /// \return True if the sink accepted the whole document
+    bool Write(const Season& season);
+
+    /// \brief Write an episode and flush it to the sink
+    /// \param episode Episode to write
+    /// \return True if the sink accepted the whole document
+    bool Write(const Episode& episode);
+
+    /// \brief Write a contributor and flush it to the sink
+    /// \param contributor Contributor to write
+    /// \return True if the sink accepted the whole document
+    bool Write(const Contributor& contributor);
+
+    /// \brief Write an enclosure and flush it to the sink
+    /// \param enclosure Enclosure to write
+    /// \return True if the sink accepted the whole document
+    bool Write(const Enclosure& enclosure);
+
+    /// \brief Write a tag and flush it to the sink
+    /// \param tag Tag to write
+    /// \return True if the sink accepted the whole document
+    bool Write(const Tag& tag);
+
+    /// \brief Write a chapter tag and flush it to the sink
+    /// \param tag Chapter tag to write
+    /// \return True if the sink accepted the whole document
+    bool Write(const ChapterTag& tag);
+
+    /// \brief Write a location tag and flush it to the sink
+    /// \param tag Location tag to write
+    /// \return True if the sink accepted the whole document
+    bool Write(const LocationTag& tag);
+
+    /// \brief Write a transcript tag and flush it to the sink
+    /// \param tag Transcript tag to write
+    /// \return True if the sink accepted the whole document
+    bool Write(const TranscriptTag& tag);
+
+    /// \brief Get the number of bytes produced so far
+    /// \return Byte count over all documents written by this writer
+    uint64_t GetBytesWritten() const noexcept
+    {
+        return writer_.GetBytesWritten();
+    }
+
+private:
+    bool Finish();
+    void WriteSeason(const Season& season);
+    void WriteEpisode(const Episode& episode);
+    void WriteContributor(const Contributor& contributor);
+    void WritePublisher(const Publisher& publisher);
+    void WritePicture(const std::string_view name, const Picture& picture);
+    void WriteEnclosure(const Enclosure& enclosure);
+    void WriteTag(const Tag& tag);
+    void WriteTagFields(const Tag& tag);
+    void WriteFabricFields(const Fabric& fabric);
+    void WriteContributions(const std::vector<Contribution>& contributions);
+    void WriteTagReferences(const std::vector<TagReference>& tags);
+    void WriteString(const std::string_view name, const runtime::String& value);
+    void WriteGuid(const std::string_view name, const runtime::Guid& guid);
+    void WriteTimestamp(const std::string_view name, const runtime::Timestamp& timestamp);
+    void WriteTimespan(const std::string_view name, const runtime::Timespan& timespan);
+    void WriteUnsigned(const std::string_view name, const uint64_t value);
+
+    runtime::JsonWriter writer_;
+    std::unordered_set<runtime::Guid> contributors_;
+    std::unordered_set<runtime::Guid> tags_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_JSON_FEED_WRITER_H_INCL__
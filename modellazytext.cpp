@@ -0,0 +1,108 @@
+///
+// \file modellazytext.cpp
+// \brief P3 Model Lazy Text implementation
+// \details Dehydration and compression of the heavy text fields
+//
+
+#include "modellazytext.h"
+
+#include "modelseason.h"
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ultralove::p3::model {
+namespace {
+bool Spill(runtime::String& value, runtime::FileTextStore& store)
+{
+    if (value.IsLazy() || (value.GetLength() <= runtime::String::INLINE_CAPACITY)) {
+        return true;
+    }
+    runtime::String lazy;
+    if (store.Append(value.GetView(), lazy) == false) {
+        return false;
+    }
+    value = std::move(lazy);
+    return true;
+}
+
+void Shrink(runtime::String& value, runtime::DictionaryTextStore& store)
+{
+    if (value.IsLazy() || (value.GetLength() <= runtime::String::INLINE_CAPACITY)) {
+        return;
+    }
+    value = store.Compress(value.GetView());
+}
+
+void Sample(const runtime::String& value, std::vector<std::string_view>& samples)
+{
+    if (value.GetLength() > runtime::String::INLINE_CAPACITY) {
+        samples.push_back(value.GetView());
+    }
+}
+} // namespace
+
+bool LazyText::Dehydrate(Podcast& podcast, runtime::FileTextStore& store)
+{
+    for (Season& season : podcast.seasons) {
+        for (Episode& episode : season.episodes) {
+            if (Dehydrate(episode, store) == false) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool LazyText::Dehydrate(Episode& episode, runtime::FileTextStore& store)
+{
+    return Spill(episode.description, store) && Spill(episode.summary, store);
+}
+
+bool LazyText::Dehydrate(Contributor& contributor, runtime::FileTextStore& store)
+{
+    return Spill(contributor.bio, store);
+}
+
+bool LazyText::Dehydrate(TranscriptTag& tag, runtime::FileTextStore& store)
+{
+    return Spill(tag.text, store);
+}
+
+runtime::TextDictionary LazyText::Train(const Podcast& podcast, const size_t capacity)
+{
+    std::vector<std::string_view> samples;
+    Sample(podcast.description, samples);
+    Sample(podcast.summary, samples);
+    for (const Season& season : podcast.seasons) {
+        for (const Episode& episode : season.episodes) {
+            Sample(episode.description, samples);
+            Sample(episode.summary, samples);
+        }
+    }
+    return runtime::TextDictionary::Train(samples, capacity);
+}
+
+void LazyText::Compress(Podcast& podcast, runtime::DictionaryTextStore& store)
+{
+    Shrink(podcast.description, store);
+    Shrink(podcast.summary, store);
+    for (Season& season : podcast.seasons) {
+        for (Episode& episode : season.episodes) {
+            Compress(episode, store);
+        }
+    }
+}
+
+void LazyText::Compress(Episode& episode, runtime::DictionaryTextStore& store)
+{
+    Shrink(episode.description, store);
+    Shrink(episode.summary, store);
+}
+
+void LazyText::Compress(TranscriptTag& tag, runtime::DictionaryTextStore& store)
+{
+    Shrink(tag.text, store);
+}
+} // namespace ultralove::p3::model
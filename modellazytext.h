@@ -0,0 +1,98 @@
+///
+// \file modellazytext.h
+// \brief P3 Model Lazy Text
+// \details Moves the heavy text fields of the object model into a text store or compresses them
+//
+
+#ifndef __P3_MODEL_LAZY_TEXT_H_INCL__
+#define __P3_MODEL_LAZY_TEXT_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelcontributor.h"
+#include "modelepisode.h"
+#include "modelpodcast.h"
+#include "modeltranscripttag.h"
+#include "runtimestring.h"
+#include "runtimetextdictionary.h"
+#include "runtimetextstore.h"
+#include <cstddef>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Lazy text fields
+/// \details Episode::description, Episode::summary, Contributor::bio and TranscriptTag::text hold
+/// most of the bytes of a catalog but are only read when a feed or a detail view is built. Dehydrate()
+/// appends them to a runtime::FileTextStore and replaces them by lazy strings, which load the value
+/// through the bounded cache of the store on access, see runtimetextstore.h. Everything else stays
+/// resident. Values that fit inline, are empty or are lazy already are left alone. Heap strings are
+/// released right away, arena strings with their arena.
+///
+/// Shared contributors are read-only through their handles; dehydrate a contributor before it is
+/// passed to EntityRegistry::Register(). Lazy strings compare, hash and serialize like the values
+/// they stand for, so modification dates and content hashes are not affected.
+///
+/// Compress() keeps the values in memory instead, compressed with a dictionary trained on the
+/// podcast by Train() and held by a runtime::DictionaryTextStore; the store reports the compression
+/// ratio of everything compressed into it. Use one store per podcast.
+struct LazyText
+{
+    /// \brief Move the descriptions and summaries of all episodes of a podcast into a store
+    /// \param podcast Podcast to dehydrate
+    /// \param store Store created with FileTextStore::Create(), must outlive the podcast
+    /// \return True if all values were written, false if the store failed; values written before
+    /// the failure stay lazy
+    static bool Dehydrate(Podcast& podcast, runtime::FileTextStore& store);
+
+    /// \brief Move the description and summary of an episode into a store
+    /// \param episode Episode to dehydrate
+    /// \param store Store created with FileTextStore::Create(), must outlive the episode
+    /// \return True if all values were written
+    static bool Dehydrate(Episode& episode, runtime::FileTextStore& store);
+
+    /// \brief Move the biography of a contributor into a store
+    /// \param contributor Contributor to dehydrate
+    /// \param store Store created with FileTextStore::Create(), must outlive the contributor
+    /// \return True if the value was written
+    static bool Dehydrate(Contributor& contributor, runtime::FileTextStore& store);
+
+    /// \brief Move the text of a transcript tag into a store
+    /// \param tag Transcript tag to dehydrate
+    /// \param store Store created with FileTextStore::Create(), must outlive the tag
+    /// \return True if the value was written
+    static bool Dehydrate(TranscriptTag& tag, runtime::FileTextStore& store);
+
+    /// \brief Train a dictionary on the descriptions and summaries of a podcast and its episodes
+    /// \param podcast Podcast to sample
+    /// \param capacity Maximum size of the dictionary
+    /// \return Trained dictionary, empty if the values share nothing
+    static runtime::TextDictionary Train(const Podcast& podcast, const size_t capacity = runtime::TextDictionary::DEFAULT_CAPACITY);
+
+    /// \brief Compress the descriptions and summaries of a podcast and all its episodes
+    /// \param podcast Podcast to compress
+    /// \param store Store with a dictionary trained on the podcast, must outlive the podcast
+    static void Compress(Podcast& podcast, runtime::DictionaryTextStore& store);
+
+    /// \brief Compress the description and summary of an episode
+    /// \param episode Episode to compress
+    /// \param store Store of the podcast of the episode, must outlive the episode
+    static void Compress(Episode& episode, runtime::DictionaryTextStore& store);
+
+    /// \brief Compress the text of a transcript tag
+    /// \param tag Transcript tag to compress
+    /// \param store Store to compress into, must outlive the tag
+    static void Compress(TranscriptTag& tag, runtime::DictionaryTextStore& store);
+
+    // Deleted constructors and assignment operators - this is a utility struct
+    LazyText()                           = delete;
+    virtual ~LazyText()                  = delete;
+    LazyText(const LazyText&)            = delete;
+    LazyText& operator=(const LazyText&) = delete;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_LAZY_TEXT_H_INCL__
@@ -0,0 +1,200 @@
+///
+// \file modellocationindex.cpp
+// \brief P3 Model Location Index implementation
+// \details Sort-tile-recursive bulk loading and R-tree queries
+//
+
+#include "modellocationindex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace ultralove::p3::model {
+namespace {
+constexpr size_t NODE_CAPACITY      = 16;
+constexpr double EARTH_RADIUS       = 6371008.8; // Mean radius in meters
+constexpr double RADIANS_PER_DEGREE = std::numbers::pi / 180.0;
+
+double Haversine(const double latitude1, const double longitude1, const double latitude2, const double longitude2) noexcept
+{
+    const double phi1    = latitude1 * RADIANS_PER_DEGREE;
+    const double phi2    = latitude2 * RADIANS_PER_DEGREE;
+    const double dPhi    = phi2 - phi1;
+    const double dLambda = (longitude2 - longitude1) * RADIANS_PER_DEGREE;
+    const double a       = std::sin(dPhi / 2) * std::sin(dPhi / 2) + std::cos(phi1) * std::cos(phi2) * std::sin(dLambda / 2) * std::sin(dLambda / 2);
+    return 2.0 * EARTH_RADIUS * std::asin(std::min(1.0, std::sqrt(a)));
+}
+} // namespace
+
+void LocationIndex::Add(const runtime::Guid& episode, const EntityHandle<LocationTag>& location)
+{
+    if (location) {
+        entries_.push_back(Entry{episode, location});
+    }
+}
+
+void LocationIndex::Build()
+{
+    tree_.clear();
+    levels_.clear();
+    tree_.reserve(entries_.size());
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        tree_.push_back(Point{entries_[i].location->latitude, entries_[i].location->longitude, static_cast<uint32_t>(i)});
+    }
+    if (tree_.empty()) {
+        return;
+    }
+
+    // Sort into vertical slices by longitude, then every slice by latitude
+    const size_t leaves   = (tree_.size() + NODE_CAPACITY - 1) / NODE_CAPACITY;
+    const size_t slices   = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(leaves))));
+    const size_t perSlice = slices * NODE_CAPACITY;
+    std::sort(tree_.begin(), tree_.end(), [](const Point& lhs, const Point& rhs) {
+        return lhs.longitude < rhs.longitude;
+    });
+    for (size_t first = 0; first < tree_.size(); first += perSlice) {
+        const auto last = tree_.begin() + static_cast<ptrdiff_t>(std::min(first + perSlice, tree_.size()));
+        std::sort(tree_.begin() + static_cast<ptrdiff_t>(first), last, [](const Point& lhs, const Point& rhs) {
+            return lhs.latitude < rhs.latitude;
+        });
+    }
+
+    std::vector<Box> level;
+    level.reserve(leaves);
+    for (size_t first = 0; first < tree_.size(); first += NODE_CAPACITY) {
+        Box box{tree_[first].latitude, tree_[first].longitude, tree_[first].latitude, tree_[first].longitude};
+        for (size_t i = first + 1; i < std::min(first + NODE_CAPACITY, tree_.size()); ++i) {
+            box.south = std::min(box.south, tree_[i].latitude);
+            box.north = std::max(box.north, tree_[i].latitude);
+            box.west  = std::min(box.west, tree_[i].longitude);
+            box.east  = std::max(box.east, tree_[i].longitude);
+        }
+        level.push_back(box);
+    }
+    levels_.push_back(std::move(level));
+    while (levels_.back().size() > NODE_CAPACITY) {
+        const std::vector<Box>& children = levels_.back();
+        std::vector<Box> parents;
+        parents.reserve((children.size() + NODE_CAPACITY - 1) / NODE_CAPACITY);
+        for (size_t first = 0; first < children.size(); first += NODE_CAPACITY) {
+            Box box = children[first];
+            for (size_t i = first + 1; i < std::min(first + NODE_CAPACITY, children.size()); ++i) {
+                box.south = std::min(box.south, children[i].south);
+                box.north = std::max(box.north, children[i].north);
+                box.west  = std::min(box.west, children[i].west);
+                box.east  = std::max(box.east, children[i].east);
+            }
+            parents.push_back(box);
+        }
+        levels_.push_back(std::move(parents));
+    }
+}
+
+void LocationIndex::Clear() noexcept
+{
+    entries_.clear();
+    tree_.clear();
+    levels_.clear();
+}
+
+template<typename Visitor>
+void LocationIndex::Search(const Box& box, Visitor&& visitor) const
+{
+    const auto intersects = [&box](const Box& node) {
+        return (node.south <= box.north) && (node.north >= box.south) && (node.west <= box.east) && (node.east >= box.west);
+    };
+
+    std::vector<std::pair<size_t, size_t>> stack;
+    const std::vector<Box>& top = levels_.back();
+    for (size_t i = 0; i < top.size(); ++i) {
+        if (intersects(top[i])) {
+            stack.emplace_back(levels_.size() - 1, i);
+        }
+    }
+    while (stack.empty() == false) {
+        const auto [level, node] = stack.back();
+        stack.pop_back();
+        const size_t first = node * NODE_CAPACITY;
+        if (level == 0) {
+            for (size_t i = first; i < std::min(first + NODE_CAPACITY, tree_.size()); ++i) {
+                const Point& point = tree_[i];
+                if ((point.latitude >= box.south) && (point.latitude <= box.north) && (point.longitude >= box.west) &&
+                    (point.longitude <= box.east)) {
+                    visitor(point);
+                }
+            }
+            continue;
+        }
+        const std::vector<Box>& children = levels_[level - 1];
+        for (size_t i = first; i < std::min(first + NODE_CAPACITY, children.size()); ++i) {
+            if (intersects(children[i])) {
+                stack.emplace_back(level - 1, i);
+            }
+        }
+    }
+}
+
+size_t LocationIndex::FindWithin(const double latitude, const double longitude, const double radius, std::vector<LocationHit>& hits) const
+{
+    if (tree_.empty() || (radius < 0.0)) {
+        return 0;
+    }
+
+    // Bounding box of the circle; near a pole it spans all longitudes
+    const double angle = radius / EARTH_RADIUS / RADIANS_PER_DEGREE;
+    const double south = latitude - angle;
+    const double north = latitude + angle;
+    double west        = -180.0;
+    double east        = 180.0;
+    const bool polar   = (south <= -90.0) || (north >= 90.0);
+    const double ratio = polar ? 1.0 : std::sin(radius / EARTH_RADIUS) / std::cos(latitude * RADIANS_PER_DEGREE);
+    if (ratio < 1.0) {
+        const double delta = std::asin(ratio) / RADIANS_PER_DEGREE;
+        west               = longitude - delta;
+        east               = longitude + delta;
+    }
+
+    const size_t size  = hits.size();
+    const auto collect = [&](const Point& point) {
+        const double distance = Haversine(latitude, longitude, point.latitude, point.longitude);
+        if (distance <= radius) {
+            const Entry& entry = entries_[point.entry];
+            hits.push_back(LocationHit{entry.episode, entry.location, distance});
+        }
+    };
+    const Box box{std::max(south, -90.0), std::max(west, -180.0), std::min(north, 90.0), std::min(east, 180.0)};
+    Search(box, collect);
+    if (west < -180.0) {
+        Search(Box{box.south, west + 360.0, box.north, 180.0}, collect);
+    }
+    else if (east > 180.0) {
+        Search(Box{box.south, -180.0, box.north, east - 360.0}, collect);
+    }
+    std::sort(hits.begin() + static_cast<ptrdiff_t>(size), hits.end(), [](const LocationHit& lhs, const LocationHit& rhs) {
+        return lhs.distance < rhs.distance;
+    });
+    return hits.size() - size;
+}
+
+size_t LocationIndex::FindInBox(const double south, const double west, const double north, const double east, std::vector<LocationHit>& hits) const
+{
+    if (tree_.empty()) {
+        return 0;
+    }
+    const size_t size  = hits.size();
+    const auto collect = [&](const Point& point) {
+        const Entry& entry = entries_[point.entry];
+        hits.push_back(LocationHit{entry.episode, entry.location, 0.0});
+    };
+    if (west <= east) {
+        Search(Box{south, west, north, east}, collect);
+    }
+    else {
+        Search(Box{south, west, north, 180.0}, collect);
+        Search(Box{south, -180.0, north, east}, collect);
+    }
+    return hits.size() - size;
+}
+} // namespace ultralove::p3::model
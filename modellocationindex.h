@@ -0,0 +1,126 @@
+///
+// \file modellocationindex.h
+// \brief P3 Model Location Index
+// \details Spatial index over the location tags of a catalog
+//
+
+#ifndef __P3_MODEL_LOCATION_INDEX_H_INCL__
+#define __P3_MODEL_LOCATION_INDEX_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelentityhandle.h"
+#include "modellocationtag.h"
+#include "runtimeguid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Result of a location query
+struct LocationHit
+{
+    /// \brief Identifier of the episode the location belongs to
+    runtime::Guid episode;
+
+    /// \brief Matching location
+    EntityHandle<LocationTag> location;
+
+    /// \brief Great-circle distance from the query point in meters, 0 for box queries
+    double distance;
+};
+
+/// \brief Spatial index over location tags
+/// \details A static R-tree over LocationTag coordinates in degrees, bulk-loaded with the
+/// sort-tile-recursive method: locations are sorted into vertical slices by longitude, each slice
+/// is sorted by latitude, and runs of 16 locations become leaves. Inner levels group 16 consecutive
+/// nodes. All levels are flat arrays of bounding boxes.
+///
+/// Locations are collected with Add() and become visible to queries after Build(), which loads the
+/// whole tree at once; call Build() again after adding more locations. Radius queries search the
+/// bounding box of the circle and keep locations within the haversine distance. Boxes and circles
+/// that cross the antimeridian are supported. Concurrent queries are fine.
+class LocationIndex
+{
+public:
+    /// \brief Create an empty index
+    LocationIndex() = default;
+
+    /// \brief Destroy the index
+    virtual ~LocationIndex() = default;
+
+    LocationIndex(const LocationIndex&)            = delete;
+    LocationIndex& operator=(const LocationIndex&) = delete;
+
+    /// \brief Add a location
+    /// \param episode Identifier of the episode the location belongs to
+    /// \param location Location tag
+    void Add(const runtime::Guid& episode, const EntityHandle<LocationTag>& location);
+
+    /// \brief Bulk-load the tree from all locations added so far
+    void Build();
+
+    /// \brief Remove all locations
+    void Clear() noexcept;
+
+    /// \brief Get the number of locations visible to queries
+    /// \return Number of locations in the tree
+    size_t GetCount() const noexcept
+    {
+        return tree_.size();
+    }
+
+    /// \brief Find the locations within a distance of a point
+    /// \param latitude Latitude of the point in degrees
+    /// \param longitude Longitude of the point in degrees
+    /// \param radius Distance in meters
+    /// \param hits Receives the matching locations, nearest first
+    /// \return Number of hits appended
+    size_t FindWithin(const double latitude, const double longitude, const double radius, std::vector<LocationHit>& hits) const;
+
+    /// \brief Find the locations inside a bounding box
+    /// \param south Southern latitude in degrees
+    /// \param west Western longitude in degrees, greater than east for boxes crossing the antimeridian
+    /// \param north Northern latitude in degrees
+    /// \param east Eastern longitude in degrees
+    /// \param hits Receives the matching locations
+    /// \return Number of hits appended
+    size_t FindInBox(const double south, const double west, const double north, const double east, std::vector<LocationHit>& hits) const;
+
+private:
+    struct Box
+    {
+        double south;
+        double west;
+        double north;
+        double east;
+    };
+
+    struct Point
+    {
+        double latitude;
+        double longitude;
+        uint32_t entry;
+    };
+
+    struct Entry
+    {
+        runtime::Guid episode;
+        EntityHandle<LocationTag> location;
+    };
+
+    template<typename Visitor>
+    void Search(const Box& box, Visitor&& visitor) const;
+
+    std::vector<Entry> entries_;
+    std::vector<Point> tree_;
+    std::vector<std::vector<Box>> levels_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_LOCATION_INDEX_H_INCL__
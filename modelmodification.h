@@ -0,0 +1,103 @@
+///
+// \file modelmodification.h
+// \brief P3 Model Modification Tracking
+// \details Propagation of Fabric::modificationDate through the Podcast tree
+//
+
+#ifndef __P3_MODEL_MODIFICATION_H_INCL__
+#define __P3_MODEL_MODIFICATION_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelcontributor.h"
+#include "modelepisode.h"
+#include "modelfabric.h"
+#include "modelpodcast.h"
+#include "modelseason.h"
+#include "modeltag.h"
+#include "runtimetimespan.h"
+#include "runtimetimestamp.h"
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+// Fabric::modificationDate is the change marker of the model: an entity counts as modified when its
+// date moved. Changing a value inside an episode, including its contributions and tag references,
+// marks the episode, its season and its podcast. Shared contributors and tags are marked on their
+// own when they are updated in their EntityRegistry. The update publishes a new instance, which an
+// episode sees once its handles are refreshed, see EntityRegistry::Refresh(); consumers such as
+// FeedItemCache compare the dates of the shared entities as well, so the episode itself need not move.
+
+/// \brief Move the modification date of an entity forward
+/// \details The date moves by at least one microsecond, so two modifications within the same
+/// microsecond are still told apart.
+/// \param entity Modified entity
+/// \param now Modification time
+inline void Touch(Fabric& entity, const runtime::Timestamp& now) noexcept
+{
+    const runtime::Timestamp next = entity.modificationDate + runtime::Timespan::FromMicroseconds(1);
+    entity.modificationDate       = (now > next) ? now : next;
+}
+
+/// \brief Mark a podcast as modified
+/// \param podcast Modified podcast
+/// \param now Modification time
+inline void MarkModified(Podcast& podcast, const runtime::Timestamp& now = runtime::Timestamp::Now()) noexcept
+{
+    Touch(podcast, now);
+}
+
+/// \brief Mark a season as modified, together with its podcast
+/// \param podcast Podcast of the season
+/// \param season Modified season
+/// \param now Modification time
+inline void MarkModified(Podcast& podcast, Season& season, const runtime::Timestamp& now = runtime::Timestamp::Now()) noexcept
+{
+    Touch(season, now);
+    MarkModified(podcast, now);
+}
+
+/// \brief Mark an episode as modified, together with its season and podcast
+/// \details Use this as well after changing a Contribution or TagReference of the episode
+/// \param podcast Podcast of the episode
+/// \param season Season of the episode
+/// \param episode Modified episode
+/// \param now Modification time
+inline void MarkModified(Podcast& podcast, Season& season, Episode& episode, const runtime::Timestamp& now = runtime::Timestamp::Now()) noexcept
+{
+    Touch(episode, now);
+    MarkModified(podcast, season, now);
+}
+
+/// \brief Mark a shared contributor as modified
+/// \details Call this on the value passed to EntityRegistry::Register() when updating the contributor
+/// \param contributor Modified contributor
+/// \param now Modification time
+inline void MarkModified(Contributor& contributor, const runtime::Timestamp& now = runtime::Timestamp::Now()) noexcept
+{
+    Touch(contributor, now);
+}
+
+/// \brief Mark a shared tag as modified
+/// \details Call this on the value passed to EntityRegistry::Register() when updating the tag
+/// \param tag Modified tag
+/// \param now Modification time
+inline void MarkModified(Tag& tag, const runtime::Timestamp& now = runtime::Timestamp::Now()) noexcept
+{
+    Touch(tag, now);
+}
+
+/// \brief Check whether an entity was modified after a point in time
+/// \param entity Entity to check
+/// \param since Point in time, typically the time of the last regeneration
+/// \return True if the modification date is after since
+inline bool IsModifiedSince(const Fabric& entity, const runtime::Timestamp& since) noexcept
+{
+    return entity.modificationDate > since;
+}
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_MODIFICATION_H_INCL__
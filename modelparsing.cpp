@@ -0,0 +1,127 @@
+///
+// \file modelparsing.cpp
+// \brief P3 Model Parsing helpers implementation
+// \details Dates, identifiers, media types and JSON string values
+//
+
+#include "modelparsing.h"
+
+namespace ultralove::p3::model::parsing {
+runtime::Timestamp ParseDate(const std::string_view text) noexcept
+{
+    if (const auto rfc822 = runtime::Timestamp::ParseRfc822(text)) {
+        return *rfc822;
+    }
+    return runtime::Timestamp::ParseIso8601(text).value_or(runtime::Timestamp());
+}
+
+std::optional<runtime::Guid> ParseUuid(std::string_view text) noexcept
+{
+    text = Trim(text);
+    if (StartsWithIgnoreCase(text, "urn:uuid:")) {
+        text.remove_prefix(9);
+    }
+    return runtime::Guid::Parse(text);
+}
+
+runtime::Guid ParseGuid(std::string_view text) noexcept
+{
+    text = Trim(text);
+    if (text.empty()) {
+        return runtime::Guid{};
+    }
+    if (const auto uuid = ParseUuid(text)) {
+        return *uuid;
+    }
+    return runtime::Guid::FromName(runtime::Guid::NAMESPACE_URL, text);
+}
+
+runtime::Guid MakeContributorId(const std::string_view name, const std::string_view url) noexcept
+{
+    const std::string_view link = Trim(url);
+    if (link.empty() == false) {
+        return runtime::Guid::FromName(runtime::Guid::NAMESPACE_URL, link);
+    }
+    return runtime::Guid::FromName(CONTRIBUTOR_NAMESPACE, Trim(name));
+}
+
+runtime::Guid MakeTagId(const std::string_view name) noexcept
+{
+    return runtime::Guid::FromName(TAG_NAMESPACE, Trim(name));
+}
+
+EnclosureType EnclosureTypeFromMime(const std::string_view mimeType) noexcept
+{
+    // Codec parameters take precedence, Opus is usually shipped in an Ogg container
+    if (mimeType.find("opus") != std::string_view::npos) {
+        return EnclosureType::OPUS;
+    }
+    if (StartsWithIgnoreCase(mimeType, "audio/ogg") || StartsWithIgnoreCase(mimeType, "audio/vorbis") ||
+        StartsWithIgnoreCase(mimeType, "application/ogg")) {
+        return EnclosureType::OGG;
+    }
+    if (StartsWithIgnoreCase(mimeType, "video/") || StartsWithIgnoreCase(mimeType, "audio/mp4") ||
+        StartsWithIgnoreCase(mimeType, "audio/x-m4a") || StartsWithIgnoreCase(mimeType, "audio/aac")) {
+        return EnclosureType::MP4;
+    }
+    return EnclosureType::MP3;
+}
+
+PictureType PictureTypeFromUri(const std::string_view uri) noexcept
+{
+    const size_t query          = uri.find_first_of("?#");
+    const std::string_view path = uri.substr(0, query);
+    return ((path.size() >= 4) && EqualsIgnoreCase(path.substr(path.size() - 4), ".png")) ? PictureType::PNG : PictureType::JPG;
+}
+
+EpisodeType EpisodeTypeFromName(const std::string_view name) noexcept
+{
+    if (EqualsIgnoreCase(name, "trailer")) {
+        return EpisodeType::TRAILER;
+    }
+    if (EqualsIgnoreCase(name, "bonus")) {
+        return EpisodeType::BONUS;
+    }
+    return EpisodeType::FULL;
+}
+
+bool SkipValue(runtime::JsonReader& reader, const runtime::JsonToken token) noexcept
+{
+    using Token = runtime::JsonToken;
+    if ((token == Token::END) || (token == Token::INVALID)) {
+        return false;
+    }
+    return ((token == Token::BEGIN_OBJECT) || (token == Token::BEGIN_ARRAY)) ? reader.Skip() : true;
+}
+
+runtime::String MakeString(const runtime::JsonValue& value, runtime::Arena& arena)
+{
+    const std::string_view raw = value.raw;
+    if (value.encoded == false) {
+        return runtime::String(raw, arena);
+    }
+    if (raw.size() <= runtime::String::INLINE_CAPACITY) {
+        char decoded[runtime::String::INLINE_CAPACITY];
+        return runtime::String(std::string_view(decoded, runtime::JsonReader::Decode(raw, decoded)));
+    }
+
+    // Decoding never grows the value, so it goes straight into its final place in the arena
+    char* target        = static_cast<char*>(arena.Allocate(raw.size() + 1, 1));
+    const size_t length = runtime::JsonReader::Decode(raw, target);
+    target[length]      = '\0';
+    if (length <= runtime::String::INLINE_CAPACITY) {
+        return runtime::String(std::string_view(target, length));
+    }
+    return runtime::String::Reference(std::string_view(target, length));
+}
+
+std::string_view Decode(const runtime::JsonValue& value, std::string& buffer)
+{
+    if (value.encoded == false) {
+        return value.raw;
+    }
+    buffer.resize(value.raw.size());
+    buffer.resize(runtime::JsonReader::Decode(value.raw, buffer.data()));
+    return buffer;
+}
+} // namespace ultralove::p3::model::parsing
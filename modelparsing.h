@@ -0,0 +1,126 @@
+///
+// \file modelparsing.h
+// \brief P3 Model Parsing helpers
+// \details Numbers, dates, identifiers, media types and JSON values as the readers map them to the
+// object model
+//
+
+#ifndef __P3_MODEL_PARSING_H_INCL__
+#define __P3_MODEL_PARSING_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelenclosuretype.h"
+#include "modelepisodetype.h"
+#include "modelpicturetype.h"
+#include "runtimearena.h"
+#include "runtimeguid.h"
+#include "runtimejsonreader.h"
+#include "runtimeparsing.h"
+#include "runtimestring.h"
+#include "runtimetimestamp.h"
+#include <charconv>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Internal to the readers of the library and not included by model.h
+namespace ultralove::p3::model::parsing {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+using runtime::parsing::EqualsIgnoreCase;
+using runtime::parsing::FieldName;
+using runtime::parsing::IsSpace;
+using runtime::parsing::NameTable;
+using runtime::parsing::ParseSeconds;
+using runtime::parsing::StartsWithIgnoreCase;
+using runtime::parsing::Trim;
+
+/// \brief Parse a decimal number
+/// \tparam T Arithmetic type
+/// \param text Number
+/// \return Value, zero if the text does not start with a number
+template<typename T>
+T ParseNumber(const std::string_view text) noexcept
+{
+    T value{};
+    std::from_chars(text.data(), text.data() + text.size(), value);
+    return value;
+}
+
+/// \brief Name space of contributors known by name only, UUIDv5 of "urn:p3:contributor" in the URL
+/// name space
+inline constexpr runtime::Guid CONTRIBUTOR_NAMESPACE{0xd7e62fe57d145e2aull, 0xad86a23884943068ull};
+
+/// \brief Name space of tags known by name only, UUIDv5 of "urn:p3:tag" in the URL name space
+inline constexpr runtime::Guid TAG_NAMESPACE{0xd51952b2e9dc5029ull, 0xa09fdc2b1cb941b0ull};
+
+/// \brief Parse an RFC 822 or ISO 8601 date
+/// \param text Date
+/// \return Timestamp, the zero timestamp if the text is neither
+runtime::Timestamp ParseDate(const std::string_view text) noexcept;
+
+/// \brief Parse a UUID, with or without "urn:uuid:" prefix
+/// \param text Identifier
+/// \return Identifier, no value if the text is no UUID
+std::optional<runtime::Guid> ParseUuid(std::string_view text) noexcept;
+
+/// \brief Map an identifier from a document to a Guid
+/// \details A UUID, with or without "urn:uuid:" prefix, is taken as it is. Any other text, e.g. the
+/// permalink many feeds use as item guid, gets a name-based identifier in the URL name space, so the
+/// same document yields the same identifiers every time it is read.
+/// \param text Identifier
+/// \return Identifier, nil for empty text
+runtime::Guid ParseGuid(std::string_view text) noexcept;
+
+/// \brief Identify a contributor that carries no identifier of its own
+/// \param name Name of the contributor
+/// \param url Link of the contributor, may be empty
+/// \return Name-based identifier of the link, or of the name in CONTRIBUTOR_NAMESPACE without link
+runtime::Guid MakeContributorId(const std::string_view name, const std::string_view url) noexcept;
+
+/// \brief Identify a tag that carries no identifier of its own
+/// \param name Name of the tag
+/// \return Name-based identifier of the name in TAG_NAMESPACE
+runtime::Guid MakeTagId(const std::string_view name) noexcept;
+
+/// \brief Map a MIME type to an enclosure type
+/// \param mimeType MIME type, codec parameters are taken into account
+/// \return Enclosure type, MP3 for unknown types
+EnclosureType EnclosureTypeFromMime(const std::string_view mimeType) noexcept;
+
+/// \brief Map the extension of a picture URI to a picture type
+/// \param uri Picture URI
+/// \return PNG for ".png", JPG otherwise
+PictureType PictureTypeFromUri(const std::string_view uri) noexcept;
+
+/// \brief Map an iTunes episode type name to an episode type
+/// \param name "full", "trailer" or "bonus" in any case
+/// \return Episode type, FULL for unknown names
+EpisodeType EpisodeTypeFromName(const std::string_view name) noexcept;
+
+/// \brief Pass over a JSON value of a type the caller does not expect
+/// \param reader Reader positioned on the first token of the value
+/// \param token That token
+/// \return False at the end of the document or on an error
+bool SkipValue(runtime::JsonReader& reader, const runtime::JsonToken token) noexcept;
+
+/// \brief Make a string from a JSON string value
+/// \details Plain values go through runtime::String as usual. Escaped values are decoded straight
+/// into the arena, decoding never grows them.
+/// \param value String value
+/// \param arena Arena of the reader
+/// \return String
+runtime::String MakeString(const runtime::JsonValue& value, runtime::Arena& arena);
+
+/// \brief Decode a JSON string value for inspection
+/// \param value String value
+/// \param buffer Receives escaped values, reused from call to call
+/// \return Decoded text, valid until the next call with the same buffer or the end of the document
+std::string_view Decode(const runtime::JsonValue& value, std::string& buffer);
+} // namespace ultralove::p3::model::parsing
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_PARSING_H_INCL__
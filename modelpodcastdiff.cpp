@@ -0,0 +1,331 @@
+///
+// \file modelpodcastdiff.cpp
+// \brief P3 Model Podcast Diff implementation
+// \details Hash-guided comparison and patch application
+//
+
+#include "modelpodcastdiff.h"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace ultralove::p3::model {
+namespace {
+Podcast CopyFields(const Podcast& podcast)
+{
+    Podcast copy;
+    static_cast<Fabric&>(copy) = static_cast<const Fabric&>(podcast);
+    copy.title                 = podcast.title;
+    copy.subtitle              = podcast.subtitle;
+    copy.description           = podcast.description;
+    copy.summary               = podcast.summary;
+    copy.language              = podcast.language;
+    copy.categories            = podcast.categories;
+    copy.publicationDate       = podcast.publicationDate;
+    copy.lastBuildDate         = podcast.lastBuildDate;
+    copy.managingEditor        = podcast.managingEditor;
+    copy.webmaster             = podcast.webmaster;
+    copy.copyright             = podcast.copyright;
+    copy.link                  = podcast.link;
+    copy.publisher             = podcast.publisher;
+    copy.coverArt              = podcast.coverArt;
+    copy.tags                  = podcast.tags;
+    copy.contributors          = podcast.contributors;
+    return copy;
+}
+
+Season CopyFields(const Season& season)
+{
+    Season copy;
+    static_cast<Fabric&>(copy) = static_cast<const Fabric&>(season);
+    copy.seasonNumber          = season.seasonNumber;
+    copy.title                 = season.title;
+    copy.description           = season.description;
+    copy.publicationDate       = season.publicationDate;
+    copy.coverArt              = season.coverArt;
+    copy.tags                  = season.tags;
+    copy.contributors          = season.contributors;
+    return copy;
+}
+
+// Check that all seasons and episodes have distinct, non-nil identifiers
+bool HasUniqueIds(const Podcast& podcast)
+{
+    std::unordered_set<runtime::Guid> ids;
+    for (const Season& season : podcast.seasons) {
+        if (season.id.IsNil() || (ids.insert(season.id).second == false)) {
+            return false;
+        }
+        for (const Episode& episode : season.episodes) {
+            if (episode.id.IsNil() || (ids.insert(episode.id).second == false)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+struct SharedEntities
+{
+    std::unordered_map<runtime::Guid, const Contributor*> contributors;
+    std::unordered_map<runtime::Guid, const Tag*> tags;
+
+    void Add(const EntityHandle<Contributor>& contributor)
+    {
+        if (contributor) {
+            contributors.emplace(contributor->id, contributor.Get());
+        }
+    }
+
+    void Add(const std::vector<TagReference>& references, const std::vector<Contribution>& contributions)
+    {
+        for (const TagReference& reference : references) {
+            if (reference.tag) {
+                tags.emplace(reference.tag->id, reference.tag.Get());
+                Add(reference.tag->creator);
+            }
+        }
+        for (const Contribution& contribution : contributions) {
+            Add(contribution.contributor);
+        }
+    }
+
+    explicit SharedEntities(const Podcast& podcast)
+    {
+        Add(podcast.tags, podcast.contributors);
+        for (const Season& season : podcast.seasons) {
+            Add(season.tags, season.contributors);
+            for (const Episode& episode : season.episodes) {
+                Add(episode.tags, episode.contributors);
+            }
+        }
+    }
+};
+
+// Contributors and tags of a patch, held back from the replica's registries until the patched
+// podcast is known to hash to the target
+struct StagedEntities
+{
+    const EntityRegistry<Contributor>& contributorRegistry;
+    const EntityRegistry<Tag>& tagRegistry;
+    std::unordered_map<runtime::Guid, EntityHandle<Contributor>> contributors;
+    std::unordered_map<runtime::Guid, EntityHandle<Tag>> tags;
+
+    StagedEntities(const EntityRegistry<Contributor>& knownContributors, const EntityRegistry<Tag>& knownTags) :
+        contributorRegistry(knownContributors), tagRegistry(knownTags)
+    {
+    }
+
+    // Point a handle at the staged entity with the same identifier, or else at the one in the
+    // replica's registry; registry updates publish new instances, so this also applies to entities
+    // carried over unchanged
+    template<typename T>
+    static void Resolve(EntityHandle<T>& handle, const std::unordered_map<runtime::Guid, EntityHandle<T>>& staged,
+        const EntityRegistry<T>& registry)
+    {
+        if (handle.IsValid() == false) {
+            return;
+        }
+        const auto it = staged.find(handle->id);
+        if (it != staged.end()) {
+            handle = it->second;
+        }
+        else {
+            registry.Refresh(handle);
+        }
+    }
+
+    void Resolve(std::vector<TagReference>& references, std::vector<Contribution>& contributions) const
+    {
+        for (TagReference& reference : references) {
+            Resolve(reference.tag, tags, tagRegistry);
+        }
+        for (Contribution& contribution : contributions) {
+            Resolve(contribution.contributor, contributors, contributorRegistry);
+        }
+    }
+
+    void Add(const std::vector<Contributor>& patchContributors, const std::vector<Tag>& patchTags)
+    {
+        // Contributors first, the creators of the tags refer to them
+        for (const Contributor& contributor : patchContributors) {
+            contributors.insert_or_assign(contributor.id, EntityHandle<Contributor>::Make(contributor));
+        }
+        for (const Tag& tag : patchTags) {
+            Tag copy = tag;
+            Resolve(copy.creator, contributors, contributorRegistry);
+            tags.insert_or_assign(copy.id, EntityHandle<Tag>::Make(std::move(copy)));
+        }
+    }
+
+    void Register(EntityRegistry<Contributor>& targetContributors, EntityRegistry<Tag>& targetTags) const
+    {
+        for (const auto& [id, contributor] : contributors) {
+            targetContributors.Register(contributor);
+        }
+        for (const auto& [id, tag] : tags) {
+            targetTags.Register(tag);
+        }
+    }
+};
+} // namespace
+
+bool Diff(const Podcast& base, const Podcast& target, ContentHasher& hasher, PodcastPatch& patch)
+{
+    if ((HasUniqueIds(base) == false) || (HasUniqueIds(target) == false)) {
+        return false;
+    }
+
+    patch            = PodcastPatch{};
+    patch.baseHash   = hasher.Hash(base);
+    patch.targetHash = hasher.Hash(target);
+    if (patch.IsEmpty()) {
+        return true;
+    }
+
+    patch.podcast = CopyFields(target);
+
+    std::unordered_map<runtime::Guid, const Season*> baseSeasons;
+    std::unordered_map<runtime::Guid, const Episode*> baseEpisodes;
+    for (const Season& season : base.seasons) {
+        baseSeasons.emplace(season.id, &season);
+        for (const Episode& episode : season.episodes) {
+            baseEpisodes.emplace(episode.id, &episode);
+        }
+    }
+
+    patch.seasonOrder.reserve(target.seasons.size());
+    for (const Season& season : target.seasons) {
+        patch.seasonOrder.push_back(season.id);
+        const auto baseSeason = baseSeasons.find(season.id);
+        if ((baseSeason != baseSeasons.end()) && (hasher.Hash(*baseSeason->second) == hasher.Hash(season))) {
+            continue;
+        }
+        patch.seasons.push_back(CopyFields(season));
+
+        // Episodes that moved from another season unchanged are found in the order and need no upsert
+        EpisodeOrder order{season.id, {}};
+        order.episodes.reserve(season.episodes.size());
+        for (const Episode& episode : season.episodes) {
+            order.episodes.push_back(episode.id);
+            const auto baseEpisode = baseEpisodes.find(episode.id);
+            if ((baseEpisode == baseEpisodes.end()) || (hasher.Hash(*baseEpisode->second) != hasher.Hash(episode))) {
+                patch.episodes.push_back(EpisodeUpsert{season.id, episode});
+            }
+        }
+        patch.episodeOrders.push_back(std::move(order));
+    }
+
+    const SharedEntities baseShared(base);
+    const SharedEntities targetShared(target);
+    for (const auto& [id, contributor] : targetShared.contributors) {
+        const auto it = baseShared.contributors.find(id);
+        if ((it == baseShared.contributors.end()) || (hasher.Hash(*it->second) != hasher.Hash(*contributor))) {
+            patch.contributors.push_back(*contributor);
+        }
+    }
+    for (const auto& [id, tag] : targetShared.tags) {
+        const auto it = baseShared.tags.find(id);
+        if ((it == baseShared.tags.end()) || (hasher.Hash(*it->second) != hasher.Hash(*tag))) {
+            patch.tags.push_back(*tag);
+        }
+    }
+    return true;
+}
+
+bool Apply(Podcast& replica, const PodcastPatch& patch, EntityRegistry<Contributor>& contributors, EntityRegistry<Tag>& tags,
+    ContentHasher& hasher)
+{
+    if (hasher.Hash(replica) != patch.baseHash) {
+        return false;
+    }
+    if (patch.IsEmpty()) {
+        return true;
+    }
+
+    // Changed entities are registered only once the result is verified, so a failed patch leaves
+    // the registries as they were
+    StagedEntities staged(contributors, tags);
+    staged.Add(patch.contributors, patch.tags);
+
+    Podcast result = CopyFields(patch.podcast);
+    staged.Resolve(result.tags, result.contributors);
+
+    std::unordered_map<runtime::Guid, const Season*> oldSeasons;
+    std::unordered_map<runtime::Guid, const Episode*> oldEpisodes;
+    for (const Season& season : replica.seasons) {
+        oldSeasons.emplace(season.id, &season);
+        for (const Episode& episode : season.episodes) {
+            oldEpisodes.emplace(episode.id, &episode);
+        }
+    }
+    std::unordered_map<runtime::Guid, const Season*> patchSeasons;
+    for (const Season& season : patch.seasons) {
+        patchSeasons.emplace(season.id, &season);
+    }
+    std::unordered_map<runtime::Guid, const Episode*> patchEpisodes;
+    for (const EpisodeUpsert& upsert : patch.episodes) {
+        patchEpisodes.emplace(upsert.episode.id, &upsert.episode);
+    }
+    std::unordered_map<runtime::Guid, const EpisodeOrder*> orders;
+    for (const EpisodeOrder& order : patch.episodeOrders) {
+        orders.emplace(order.season, &order);
+    }
+
+    result.seasons.reserve(patch.seasonOrder.size());
+    for (const runtime::Guid& id : patch.seasonOrder) {
+        const auto patchSeason = patchSeasons.find(id);
+        const auto oldSeason   = oldSeasons.find(id);
+        if (patchSeason != patchSeasons.end()) {
+            result.seasons.push_back(CopyFields(*patchSeason->second));
+            staged.Resolve(result.seasons.back().tags, result.seasons.back().contributors);
+        }
+        else if (oldSeason != oldSeasons.end()) {
+            result.seasons.push_back(CopyFields(*oldSeason->second));
+            staged.Resolve(result.seasons.back().tags, result.seasons.back().contributors);
+        }
+        else {
+            return false;
+        }
+
+        Season& season   = result.seasons.back();
+        const auto order = orders.find(id);
+        if (order == orders.end()) {
+            if (oldSeason == oldSeasons.end()) {
+                return false;
+            }
+            season.episodes = oldSeason->second->episodes;
+            for (Episode& episode : season.episodes) {
+                staged.Resolve(episode.tags, episode.contributors);
+            }
+            continue;
+        }
+        season.episodes.reserve(order->second->episodes.size());
+        for (const runtime::Guid& episodeId : order->second->episodes) {
+            const auto patchEpisode = patchEpisodes.find(episodeId);
+            const auto oldEpisode   = oldEpisodes.find(episodeId);
+            if (patchEpisode != patchEpisodes.end()) {
+                season.episodes.push_back(*patchEpisode->second);
+                Episode& episode = season.episodes.back();
+                staged.Resolve(episode.tags, episode.contributors);
+            }
+            else if (oldEpisode != oldEpisodes.end()) {
+                season.episodes.push_back(*oldEpisode->second);
+                Episode& episode = season.episodes.back();
+                staged.Resolve(episode.tags, episode.contributors);
+            }
+            else {
+                return false;
+            }
+        }
+    }
+
+    if (hasher.Hash(result) != patch.targetHash) {
+        return false;
+    }
+    staged.Register(contributors, tags);
+    replica = std::move(result);
+    return true;
+}
+} // namespace ultralove::p3::model
@@ -0,0 +1,118 @@
+///
+// \file modelpodcastdiff.h
+// \brief P3 Model Podcast Diff
+// \details Minimal patches between two versions of a podcast
+//
+
+#ifndef __P3_MODEL_PODCAST_DIFF_H_INCL__
+#define __P3_MODEL_PODCAST_DIFF_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelcontenthash.h"
+#include "modelcontributor.h"
+#include "modelentityregistry.h"
+#include "modelepisode.h"
+#include "modelpodcast.h"
+#include "modelseason.h"
+#include "modeltag.h"
+#include "runtimeguid.h"
+#include "runtimehasher.h"
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Added or changed episode of a patch
+struct EpisodeUpsert
+{
+    /// \brief Identifier of the season the episode belongs to
+    runtime::Guid season;
+
+    /// \brief Episode values
+    Episode episode;
+};
+
+/// \brief New episode order of a season
+struct EpisodeOrder
+{
+    /// \brief Identifier of the season
+    runtime::Guid season;
+
+    /// \brief Identifiers of all episodes of the season in order
+    std::vector<runtime::Guid> episodes;
+};
+
+/// \brief Difference between two versions of a podcast
+/// \details Carries only entities whose content hash differs, together with the values of their
+/// parents so that modification dates follow the target. Removals are implied by the orders:
+/// seasons missing from seasonOrder and episodes missing from the order of their season are
+/// dropped. Seasons without an episode order keep their episodes.
+struct PodcastPatch
+{
+    /// \brief Content hash of the version the patch applies to
+    runtime::Hash128 baseHash;
+
+    /// \brief Content hash of the version the patch produces
+    runtime::Hash128 targetHash;
+
+    /// \brief Podcast values without seasons
+    Podcast podcast;
+
+    /// \brief Identifiers of all seasons in order
+    std::vector<runtime::Guid> seasonOrder;
+
+    /// \brief Added and changed seasons, without episodes
+    std::vector<Season> seasons;
+
+    /// \brief Added and changed episodes
+    std::vector<EpisodeUpsert> episodes;
+
+    /// \brief Episode orders of the seasons whose episodes changed
+    std::vector<EpisodeOrder> episodeOrders;
+
+    /// \brief Added and changed contributors
+    std::vector<Contributor> contributors;
+
+    /// \brief Added and changed tags
+    std::vector<Tag> tags;
+
+    /// \brief Check whether the patch changes anything
+    /// \return True if both versions have the same content
+    bool IsEmpty() const noexcept
+    {
+        return baseHash == targetHash;
+    }
+};
+
+/// \brief Compute the patch that turns one version of a podcast into another
+/// \details Subtrees with equal hashes are skipped, so the cost is dominated by hashing, which the
+/// hasher cache keeps proportional to the entities modified since the last call. Shared entities
+/// are compared through the handles of each version, so the base must refer to its own copies, for
+/// example a mirror of the replica that is kept current with Apply() and separate registries.
+/// \param base Version the replica has
+/// \param target Version the replica should get
+/// \param hasher Content hasher
+/// \param patch Receives the difference
+/// \return True on success, false if a season or episode has a nil or duplicate identifier
+bool Diff(const Podcast& base, const Podcast& target, ContentHasher& hasher, PodcastPatch& patch);
+
+/// \brief Apply a patch to a replica of a podcast
+/// \details The replica must hash to the base hash of the patch. All references are resolved by
+/// identifier against the changed contributors and tags of the patch and then against the replica's
+/// registries. Only if the result hashes to the target hash of the patch are the changed entities
+/// registered and the replica modified; otherwise neither the replica nor the registries change.
+/// \param replica Podcast to patch
+/// \param patch Patch from Diff()
+/// \param contributors Contributor registry of the replica
+/// \param tags Tag registry of the replica
+/// \param hasher Content hasher of the replica
+/// \return True if the patch was applied
+bool Apply(Podcast& replica, const PodcastPatch& patch, EntityRegistry<Contributor>& contributors, EntityRegistry<Tag>& tags,
+    ContentHasher& hasher);
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_PODCAST_DIFF_H_INCL__
@@ -0,0 +1,218 @@
+///
+// \file modelpodcastversion.cpp
+// \brief P3 Model Podcast Version implementation
+// \details Path copying and atomic publication
+//
+
+#include "modelpodcastversion.h"
+
+#include "modelmodification.h"
+
+#include <utility>
+
+namespace ultralove::p3::model {
+namespace {
+constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+size_t FindEpisodeIndex(const std::vector<std::shared_ptr<const Episode>>& episodes, const runtime::Guid& id) noexcept
+{
+    for (size_t i = 0; i < episodes.size(); ++i) {
+        if (episodes[i]->id == id) {
+            return i;
+        }
+    }
+    return NOT_FOUND;
+}
+} // namespace
+
+SeasonVersion::SeasonVersion(Season fields, std::vector<std::shared_ptr<const Episode>> episodes) :
+    fields_(std::move(fields)), episodes_(std::move(episodes))
+{
+    fields_.episodes.clear();
+}
+
+const Episode* SeasonVersion::FindEpisode(const runtime::Guid& id) const noexcept
+{
+    const size_t index = FindEpisodeIndex(episodes_, id);
+    return (index != NOT_FOUND) ? episodes_[index].get() : nullptr;
+}
+
+Season SeasonVersion::Materialize() const
+{
+    Season season = fields_;
+    season.episodes.reserve(episodes_.size());
+    for (const auto& episode : episodes_) {
+        season.episodes.push_back(*episode);
+    }
+    return season;
+}
+
+PodcastVersion::PodcastVersion(const uint64_t version, Podcast fields, std::vector<std::shared_ptr<const SeasonVersion>> seasons) :
+    version_(version), fields_(std::move(fields)), seasons_(std::move(seasons))
+{
+    fields_.seasons.clear();
+}
+
+std::shared_ptr<const PodcastVersion> PodcastVersion::Make(const Podcast& podcast)
+{
+    std::vector<std::shared_ptr<const SeasonVersion>> seasons;
+    seasons.reserve(podcast.seasons.size());
+    for (const Season& season : podcast.seasons) {
+        std::vector<std::shared_ptr<const Episode>> episodes;
+        episodes.reserve(season.episodes.size());
+        for (const Episode& episode : season.episodes) {
+            episodes.push_back(std::make_shared<const Episode>(episode));
+        }
+        Season fields = season;
+        fields.episodes.clear();
+        seasons.push_back(std::make_shared<const SeasonVersion>(std::move(fields), std::move(episodes)));
+    }
+    Podcast fields = podcast;
+    fields.seasons.clear();
+    return std::shared_ptr<const PodcastVersion>(new PodcastVersion(1, std::move(fields), std::move(seasons)));
+}
+
+const SeasonVersion* PodcastVersion::FindSeason(const runtime::Guid& id) const noexcept
+{
+    const size_t index = FindSeasonIndex(id);
+    return (index != NOT_FOUND) ? seasons_[index].get() : nullptr;
+}
+
+size_t PodcastVersion::FindSeasonIndex(const runtime::Guid& id) const noexcept
+{
+    for (size_t i = 0; i < seasons_.size(); ++i) {
+        if (seasons_[i]->fields_.id == id) {
+            return i;
+        }
+    }
+    return NOT_FOUND;
+}
+
+Podcast PodcastVersion::Materialize() const
+{
+    Podcast podcast = fields_;
+    podcast.seasons.reserve(seasons_.size());
+    for (const auto& season : seasons_) {
+        podcast.seasons.push_back(season->Materialize());
+    }
+    return podcast;
+}
+
+std::shared_ptr<const PodcastVersion> PodcastVersion::WithSeasons(
+    std::vector<std::shared_ptr<const SeasonVersion>> seasons, const runtime::Timestamp& now) const
+{
+    Podcast fields = fields_;
+    Touch(fields, now);
+    return std::shared_ptr<const PodcastVersion>(new PodcastVersion(version_ + 1, std::move(fields), std::move(seasons)));
+}
+
+std::shared_ptr<const PodcastVersion> PodcastVersion::WithFields(Podcast fields, const runtime::Timestamp& now) const
+{
+    fields.seasons.clear();
+    Touch(fields, now);
+    return std::shared_ptr<const PodcastVersion>(new PodcastVersion(version_ + 1, std::move(fields), seasons_));
+}
+
+std::shared_ptr<const PodcastVersion> PodcastVersion::WithSeason(Season season, const runtime::Timestamp& now) const
+{
+    std::vector<std::shared_ptr<const SeasonVersion>> seasons = seasons_;
+    const size_t index                                        = FindSeasonIndex(season.id);
+    std::vector<std::shared_ptr<const Episode>> episodes;
+    if (index != NOT_FOUND) {
+        episodes = seasons[index]->episodes_;
+    }
+    else {
+        episodes.reserve(season.episodes.size());
+        for (Episode& episode : season.episodes) {
+            episodes.push_back(std::make_shared<const Episode>(std::move(episode)));
+        }
+    }
+    Touch(season, now);
+    auto node = std::make_shared<const SeasonVersion>(std::move(season), std::move(episodes));
+    if (index != NOT_FOUND) {
+        seasons[index] = std::move(node);
+    }
+    else {
+        seasons.push_back(std::move(node));
+    }
+    return WithSeasons(std::move(seasons), now);
+}
+
+std::shared_ptr<const PodcastVersion> PodcastVersion::WithoutSeason(const runtime::Guid& id, const runtime::Timestamp& now) const
+{
+    const size_t index = FindSeasonIndex(id);
+    if (index == NOT_FOUND) {
+        return nullptr;
+    }
+    std::vector<std::shared_ptr<const SeasonVersion>> seasons = seasons_;
+    seasons.erase(seasons.begin() + static_cast<ptrdiff_t>(index));
+    return WithSeasons(std::move(seasons), now);
+}
+
+std::shared_ptr<const PodcastVersion> PodcastVersion::WithEpisode(const runtime::Guid& season, Episode episode, const runtime::Timestamp& now) const
+{
+    const size_t seasonIndex = FindSeasonIndex(season);
+    if (seasonIndex == NOT_FOUND) {
+        return nullptr;
+    }
+    const SeasonVersion& current = *seasons_[seasonIndex];
+
+    // Only the season's pointer array is copied, the other episodes are shared
+    std::vector<std::shared_ptr<const Episode>> episodes = current.episodes_;
+    const size_t episodeIndex                            = FindEpisodeIndex(episodes, episode.id);
+    Touch(episode, now);
+    auto node = std::make_shared<const Episode>(std::move(episode));
+    if (episodeIndex != NOT_FOUND) {
+        episodes[episodeIndex] = std::move(node);
+    }
+    else {
+        episodes.push_back(std::move(node));
+    }
+    Season fields = current.fields_;
+    Touch(fields, now);
+
+    std::vector<std::shared_ptr<const SeasonVersion>> seasons = seasons_;
+    seasons[seasonIndex] = std::make_shared<const SeasonVersion>(std::move(fields), std::move(episodes));
+    return WithSeasons(std::move(seasons), now);
+}
+
+std::shared_ptr<const PodcastVersion> PodcastVersion::WithoutEpisode(
+    const runtime::Guid& season, const runtime::Guid& episode, const runtime::Timestamp& now) const
+{
+    const size_t seasonIndex = FindSeasonIndex(season);
+    if (seasonIndex == NOT_FOUND) {
+        return nullptr;
+    }
+    const SeasonVersion& current = *seasons_[seasonIndex];
+    const size_t episodeIndex    = FindEpisodeIndex(current.episodes_, episode);
+    if (episodeIndex == NOT_FOUND) {
+        return nullptr;
+    }
+
+    std::vector<std::shared_ptr<const Episode>> episodes = current.episodes_;
+    episodes.erase(episodes.begin() + static_cast<ptrdiff_t>(episodeIndex));
+    Season fields = current.fields_;
+    Touch(fields, now);
+
+    std::vector<std::shared_ptr<const SeasonVersion>> seasons = seasons_;
+    seasons[seasonIndex] = std::make_shared<const SeasonVersion>(std::move(fields), std::move(episodes));
+    return WithSeasons(std::move(seasons), now);
+}
+
+VersionedPodcast::VersionedPodcast(const Podcast& podcast) : current_(PodcastVersion::Make(podcast)) {}
+
+bool VersionedPodcast::Update(const Change& change)
+{
+    std::shared_ptr<const PodcastVersion> current = current_.load(std::memory_order_acquire);
+    for (;;) {
+        std::shared_ptr<const PodcastVersion> next = change(*current);
+        if (next == nullptr) {
+            return false;
+        }
+        // On failure current is reloaded and the change is computed again on top of it
+        if (current_.compare_exchange_weak(current, std::move(next), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return true;
+        }
+    }
+}
+} // namespace ultralove::p3::model
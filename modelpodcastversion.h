@@ -0,0 +1,253 @@
+///
+// \file modelpodcastversion.h
+// \brief P3 Model Podcast Version
+// \details Immutable podcast versions with structural sharing for concurrent readers
+//
+
+#ifndef __P3_MODEL_PODCAST_VERSION_H_INCL__
+#define __P3_MODEL_PODCAST_VERSION_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelepisode.h"
+#include "modelpodcast.h"
+#include "modelseason.h"
+#include "runtimeguid.h"
+#include "runtimetimestamp.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Immutable season of a PodcastVersion
+/// \details Holds the values of a season and shared pointers to its episodes; versions that did
+/// not change an episode share it.
+class SeasonVersion
+{
+public:
+    /// \brief Create a season version
+    /// \param fields Season values, its episodes are ignored
+    /// \param episodes Episodes in order
+    SeasonVersion(Season fields, std::vector<std::shared_ptr<const Episode>> episodes);
+
+    /// \brief Destroy the season version
+    virtual ~SeasonVersion() = default;
+
+    SeasonVersion(const SeasonVersion&)            = delete;
+    SeasonVersion& operator=(const SeasonVersion&) = delete;
+
+    /// \brief Get the season values
+    /// \return Season without episodes
+    const Season& GetFields() const noexcept
+    {
+        return fields_;
+    }
+
+    /// \brief Get the number of episodes
+    /// \return Number of episodes
+    size_t GetEpisodeCount() const noexcept
+    {
+        return episodes_.size();
+    }
+
+    /// \brief Get an episode
+    /// \param index Position of the episode
+    /// \return Episode
+    const Episode& GetEpisode(const size_t index) const noexcept
+    {
+        return *episodes_[index];
+    }
+
+    /// \brief Get the shared pointer of an episode
+    /// \param index Position of the episode
+    /// \return Episode, shared with every version that contains it
+    const std::shared_ptr<const Episode>& GetSharedEpisode(const size_t index) const noexcept
+    {
+        return episodes_[index];
+    }
+
+    /// \brief Find an episode by identifier
+    /// \param id Identifier of the episode
+    /// \return Episode, nullptr if the season has no such episode
+    const Episode* FindEpisode(const runtime::Guid& id) const noexcept;
+
+    /// \brief Copy the season and its episodes into a mutable Season
+    /// \return Season
+    Season Materialize() const;
+
+private:
+    friend class PodcastVersion;
+
+    Season fields_;
+    std::vector<std::shared_ptr<const Episode>> episodes_;
+};
+
+/// \brief Immutable version of a podcast
+/// \details A persistent tree: the root holds the podcast values and shared pointers to
+/// SeasonVersion nodes, which hold shared pointers to episodes. The With and Without functions
+/// never modify a version; they return a new root that copies only the path to the change and
+/// shares every untouched season and episode with this version. The modification dates of the
+/// changed episode, its season and the podcast are moved forward as MarkModified() does, so
+/// FeedItemCache and ContentHasher pick the change up.
+///
+/// Versions are safe to read from any number of threads without synchronization.
+class PodcastVersion
+{
+public:
+    /// \brief Create the first version of a podcast
+    /// \param podcast Podcast to copy
+    /// \return Version 1 of the podcast
+    static std::shared_ptr<const PodcastVersion> Make(const Podcast& podcast);
+
+    /// \brief Destroy the version
+    virtual ~PodcastVersion() = default;
+
+    PodcastVersion(const PodcastVersion&)            = delete;
+    PodcastVersion& operator=(const PodcastVersion&) = delete;
+
+    /// \brief Get the version number
+    /// \return Number counting up from 1 with every change
+    uint64_t GetVersion() const noexcept
+    {
+        return version_;
+    }
+
+    /// \brief Get the podcast values
+    /// \return Podcast without seasons
+    const Podcast& GetFields() const noexcept
+    {
+        return fields_;
+    }
+
+    /// \brief Get the number of seasons
+    /// \return Number of seasons
+    size_t GetSeasonCount() const noexcept
+    {
+        return seasons_.size();
+    }
+
+    /// \brief Get a season
+    /// \param index Position of the season
+    /// \return Season
+    const SeasonVersion& GetSeason(const size_t index) const noexcept
+    {
+        return *seasons_[index];
+    }
+
+    /// \brief Get the shared pointer of a season
+    /// \param index Position of the season
+    /// \return Season, shared with every version that contains it unchanged
+    const std::shared_ptr<const SeasonVersion>& GetSharedSeason(const size_t index) const noexcept
+    {
+        return seasons_[index];
+    }
+
+    /// \brief Find a season by identifier
+    /// \param id Identifier of the season
+    /// \return Season, nullptr if the podcast has no such season
+    const SeasonVersion* FindSeason(const runtime::Guid& id) const noexcept;
+
+    /// \brief Copy the version into a mutable Podcast, e.g. for FeedWriter
+    /// \return Podcast
+    Podcast Materialize() const;
+
+    /// \brief Replace the podcast values
+    /// \param fields Podcast values, its seasons are ignored
+    /// \param now Modification time
+    /// \return New version
+    std::shared_ptr<const PodcastVersion> WithFields(Podcast fields, const runtime::Timestamp& now = runtime::Timestamp::Now()) const;
+
+    /// \brief Add a season or replace the values of the season with the same identifier
+    /// \details A replaced season keeps its episodes; a new season is appended with the episodes of
+    /// the argument.
+    /// \param season Season
+    /// \param now Modification time
+    /// \return New version
+    std::shared_ptr<const PodcastVersion> WithSeason(Season season, const runtime::Timestamp& now = runtime::Timestamp::Now()) const;
+
+    /// \brief Remove a season
+    /// \param id Identifier of the season
+    /// \param now Modification time
+    /// \return New version, nullptr if the podcast has no such season
+    std::shared_ptr<const PodcastVersion> WithoutSeason(const runtime::Guid& id, const runtime::Timestamp& now = runtime::Timestamp::Now()) const;
+
+    /// \brief Add an episode to a season or replace the episode with the same identifier
+    /// \param season Identifier of the season
+    /// \param episode Episode, appended if the season has no episode with its identifier
+    /// \param now Modification time
+    /// \return New version, nullptr if the podcast has no such season
+    std::shared_ptr<const PodcastVersion> WithEpisode(
+        const runtime::Guid& season, Episode episode, const runtime::Timestamp& now = runtime::Timestamp::Now()) const;
+
+    /// \brief Remove an episode from a season
+    /// \param season Identifier of the season
+    /// \param episode Identifier of the episode
+    /// \param now Modification time
+    /// \return New version, nullptr if the podcast has no such season or episode
+    std::shared_ptr<const PodcastVersion> WithoutEpisode(
+        const runtime::Guid& season, const runtime::Guid& episode, const runtime::Timestamp& now = runtime::Timestamp::Now()) const;
+
+private:
+    PodcastVersion(const uint64_t version, Podcast fields, std::vector<std::shared_ptr<const SeasonVersion>> seasons);
+
+    size_t FindSeasonIndex(const runtime::Guid& id) const noexcept;
+    std::shared_ptr<const PodcastVersion> WithSeasons(std::vector<std::shared_ptr<const SeasonVersion>> seasons, const runtime::Timestamp& now) const;
+
+    uint64_t version_;
+    Podcast fields_;
+    std::vector<std::shared_ptr<const SeasonVersion>> seasons_;
+};
+
+/// \brief Current version of a podcast, shared between one writer and many readers
+/// \details Readers take the current version with a single atomic load and keep it alive for as
+/// long as they hold the pointer. A writer computes the next version without any lock, so readers
+/// never wait while a change is built, and the writer never waits for readers to let go of older
+/// versions. A version is freed by whoever releases its last pointer. Concurrent writers are
+/// serialized by Update(), which retries a change that lost the race against another writer.
+///
+/// Acquire() is not wait-free: std::atomic<std::shared_ptr> is not lock-free on common standard
+/// libraries (libstdc++ guards the pointer with an internal spin lock while it takes a reference),
+/// so an Acquire() can briefly spin against another Acquire() or against the store that publishes
+/// a version.
+class VersionedPodcast
+{
+public:
+    /// \brief Function computing the next version from the current one
+    using Change = std::function<std::shared_ptr<const PodcastVersion>(const PodcastVersion& current)>;
+
+    /// \brief Create the head from the first version of a podcast
+    /// \param podcast Podcast to copy
+    explicit VersionedPodcast(const Podcast& podcast);
+
+    /// \brief Destroy the head; readers keep the versions they hold
+    virtual ~VersionedPodcast() = default;
+
+    VersionedPodcast(const VersionedPodcast&)            = delete;
+    VersionedPodcast& operator=(const VersionedPodcast&) = delete;
+
+    /// \brief Get the current version
+    /// \return Current version
+    std::shared_ptr<const PodcastVersion> Acquire() const noexcept
+    {
+        return current_.load(std::memory_order_acquire);
+    }
+
+    /// \brief Apply a change and publish the result
+    /// \param change Computes the next version, returns nullptr to cancel
+    /// \return True if a new version was published
+    bool Update(const Change& change);
+
+private:
+    std::atomic<std::shared_ptr<const PodcastVersion>> current_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_PODCAST_VERSION_H_INCL__
@@ -0,0 +1,347 @@
+///
+// \file modelsearchindex.cpp
+// \brief P3 Model Search Index implementation
+// \details Tokenizer, posting list encoding and BM25 ranking
+//
+
+#include "modelsearchindex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace ultralove::p3::model {
+namespace {
+// BM25 parameters, the usual defaults
+constexpr double BM25_K1 = 1.2;
+constexpr double BM25_B  = 0.75;
+
+// Position distance between two fields of a document, keeps phrases from spanning fields
+constexpr uint32_t FIELD_GAP = 8;
+
+constexpr bool IsWordCharacter(const unsigned char c) noexcept
+{
+    return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9')) || (c >= 0x80);
+}
+
+constexpr char FoldCase(const char c) noexcept
+{
+    return ((c >= 'A') && (c <= 'Z')) ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+// Calls visitor with every normalized word of text; the view passed is only valid during the call
+template<typename Visitor>
+void ForEachWord(const std::string_view text, std::string& word, Visitor&& visitor)
+{
+    size_t i = 0;
+    while (i < text.size()) {
+        while ((i < text.size()) && (IsWordCharacter(static_cast<unsigned char>(text[i])) == false)) {
+            ++i;
+        }
+        word.clear();
+        while ((i < text.size()) && IsWordCharacter(static_cast<unsigned char>(text[i]))) {
+            word.push_back(FoldCase(text[i]));
+            ++i;
+        }
+        if (word.empty() == false) {
+            visitor(std::string_view(word));
+        }
+    }
+}
+
+void WriteVarint(std::vector<uint8_t>& target, uint32_t value)
+{
+    while (value >= 0x80) {
+        target.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    target.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint32_t ReadVarint(const uint8_t*& current) noexcept
+{
+    uint32_t value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        const uint8_t byte = *current++;
+        value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+}
+
+// Reads one posting list: document delta, frequency and frequency position deltas per document
+class PostingCursor
+{
+public:
+    explicit PostingCursor(const std::vector<uint8_t>& data) noexcept : current_(data.data()), end_(data.data() + data.size()) {}
+
+    bool Next() noexcept
+    {
+        for (uint32_t i = 0; i < frequency_; ++i) {
+            ReadVarint(current_);
+        }
+        if (current_ == end_) {
+            return false;
+        }
+        document_ += ReadVarint(current_);
+        frequency_ = ReadVarint(current_);
+        return true;
+    }
+
+    bool Advance(const uint32_t target) noexcept
+    {
+        while (document_ < target) {
+            if (Next() == false) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void ReadPositions(std::vector<uint32_t>& positions) const
+    {
+        positions.clear();
+        const uint8_t* current = current_;
+        uint32_t position      = 0;
+        for (uint32_t i = 0; i < frequency_; ++i) {
+            position += ReadVarint(current);
+            positions.push_back(position);
+        }
+    }
+
+    uint32_t GetDocument() const noexcept
+    {
+        return document_;
+    }
+
+    uint32_t GetFrequency() const noexcept
+    {
+        return frequency_;
+    }
+
+private:
+    const uint8_t* current_;
+    const uint8_t* end_;
+    uint32_t document_  = 0;
+    uint32_t frequency_ = 0;
+};
+} // namespace
+
+void SearchIndex::AddPodcast(const Podcast& podcast)
+{
+    AddDocument(Document{SearchDocumentType::PODCAST, 0, podcast.id, podcast.id, {}},
+        {&podcast.title, &podcast.subtitle, &podcast.description, &podcast.summary});
+    for (const Season& season : podcast.seasons) {
+        AddDocument(Document{SearchDocumentType::SEASON, 0, podcast.id, season.id, {}}, {&season.title, &season.description});
+        for (const Episode& episode : season.episodes) {
+            AddDocument(Document{SearchDocumentType::EPISODE, 0, podcast.id, episode.id, {}},
+                {&episode.title, &episode.subtitle, &episode.description, &episode.summary});
+        }
+    }
+}
+
+void SearchIndex::AddTranscript(const runtime::Guid& podcast, const runtime::Guid& episode, const EntityHandle<TranscriptTag>& transcript)
+{
+    if (transcript) {
+        AddDocument(Document{SearchDocumentType::TRANSCRIPT, 0, podcast, episode, transcript}, {&transcript->text});
+    }
+}
+
+void SearchIndex::Clear() noexcept
+{
+    documents_.clear();
+    postings_.clear();
+    scratch_.clear();
+    totalLength_ = 0;
+}
+
+void SearchIndex::AddDocument(Document document, std::initializer_list<const runtime::String*> fields)
+{
+    // Collect the positions of every term first, a posting needs the frequency before the positions
+    for (auto& [term, positions] : scratch_) {
+        positions.clear();
+    }
+    std::string word;
+    uint32_t position = 0;
+    uint32_t length   = 0;
+    for (const runtime::String* field : fields) {
+        ForEachWord(field->GetView(), word, [&](const std::string_view term) {
+            auto it = scratch_.find(term);
+            if (it == scratch_.end()) {
+                it = scratch_.emplace(std::string(term), std::vector<uint32_t>()).first;
+            }
+            it->second.push_back(position++);
+            ++length;
+        });
+        position += FIELD_GAP;
+    }
+    if (length == 0) {
+        return;
+    }
+
+    const uint32_t number = static_cast<uint32_t>(documents_.size());
+    document.length       = length;
+    documents_.push_back(std::move(document));
+    totalLength_ += length;
+    for (const auto& [term, positions] : scratch_) {
+        if (positions.empty()) {
+            continue;
+        }
+        auto it = postings_.find(term);
+        if (it == postings_.end()) {
+            it = postings_.emplace(term, PostingList()).first;
+        }
+        PostingList& list = it->second;
+        WriteVarint(list.data, number - list.lastDocument);
+        WriteVarint(list.data, static_cast<uint32_t>(positions.size()));
+        uint32_t previous = 0;
+        for (const uint32_t current : positions) {
+            WriteVarint(list.data, current - previous);
+            previous = current;
+        }
+        list.lastDocument = number;
+        ++list.documentCount;
+    }
+
+    // Keep the scratch map from growing with the vocabulary of long documents
+    if (scratch_.size() > 4096) {
+        scratch_.clear();
+    }
+}
+
+size_t SearchIndex::Search(const std::string_view query, const size_t count, std::vector<SearchHit>& hits) const
+{
+    // Every clause is a phrase of one or more term slots, all clauses must match
+    std::vector<const PostingList*> terms;
+    std::vector<std::vector<size_t>> clauses;
+    std::string word;
+    bool missing = false;
+    size_t start = 0;
+    bool quoted  = false;
+    for (size_t i = 0; i <= query.size(); ++i) {
+        if ((i < query.size()) && (query[i] != '"')) {
+            continue;
+        }
+        if (quoted) {
+            clauses.emplace_back();
+        }
+        ForEachWord(query.substr(start, i - start), word, [&](const std::string_view term) {
+            const auto it = postings_.find(term);
+            if (it == postings_.end()) {
+                missing = true;
+                return;
+            }
+            const size_t slot = static_cast<size_t>(std::find(terms.begin(), terms.end(), &it->second) - terms.begin());
+            if (slot == terms.size()) {
+                terms.push_back(&it->second);
+            }
+            if (quoted == false) {
+                clauses.emplace_back();
+            }
+            clauses.back().push_back(slot);
+        });
+        quoted = !quoted;
+        start  = i + 1;
+    }
+    if (missing || terms.empty() || (count == 0)) {
+        return 0;
+    }
+
+    // Drive the intersection with the rarest term
+    std::vector<size_t> order(terms.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&terms](const size_t lhs, const size_t rhs) {
+        return terms[lhs]->documentCount < terms[rhs]->documentCount;
+    });
+    std::vector<PostingCursor> cursors;
+    std::vector<double> weights;
+    cursors.reserve(terms.size());
+    for (const PostingList* term : terms) {
+        cursors.emplace_back(term->data);
+        const double frequency = term->documentCount;
+        weights.push_back(std::log(1.0 + (static_cast<double>(documents_.size()) - frequency + 0.5) / (frequency + 0.5)));
+    }
+    const double averageLength = static_cast<double>(totalLength_) / static_cast<double>(documents_.size());
+
+    std::vector<std::pair<double, uint32_t>> matches;
+    std::vector<std::vector<uint32_t>> positions(terms.size());
+    bool more = true;
+    for (PostingCursor& cursor : cursors) {
+        more = more && cursor.Next();
+    }
+    PostingCursor& lead = cursors[order[0]];
+    while (more) {
+        // Leapfrog until all cursors agree on a document
+        uint32_t candidate = lead.GetDocument();
+        bool aligned       = true;
+        for (size_t i = 1; i < order.size(); ++i) {
+            PostingCursor& cursor = cursors[order[i]];
+            if (cursor.Advance(candidate) == false) {
+                more = false;
+                break;
+            }
+            if (cursor.GetDocument() > candidate) {
+                candidate = cursor.GetDocument();
+                aligned   = false;
+                break;
+            }
+        }
+        if (more == false) {
+            break;
+        }
+        if (aligned == false) {
+            more = lead.Advance(candidate);
+            continue;
+        }
+
+        bool phrases = true;
+        for (const std::vector<size_t>& clause : clauses) {
+            if (clause.size() < 2) {
+                continue;
+            }
+            for (const size_t slot : clause) {
+                cursors[slot].ReadPositions(positions[slot]);
+            }
+            bool found = false;
+            for (const uint32_t first : positions[clause[0]]) {
+                found = true;
+                for (size_t k = 1; (k < clause.size()) && found; ++k) {
+                    const std::vector<uint32_t>& next = positions[clause[k]];
+                    found                             = std::binary_search(next.begin(), next.end(), first + static_cast<uint32_t>(k));
+                }
+                if (found) {
+                    break;
+                }
+            }
+            if (found == false) {
+                phrases = false;
+                break;
+            }
+        }
+        if (phrases) {
+            const double length = documents_[candidate].length;
+            double score        = 0.0;
+            for (size_t i = 0; i < cursors.size(); ++i) {
+                const double frequency = cursors[i].GetFrequency();
+                score += weights[i] * frequency * (BM25_K1 + 1.0) / (frequency + BM25_K1 * (1.0 - BM25_B + BM25_B * length / averageLength));
+            }
+            matches.emplace_back(score, candidate);
+        }
+        more = lead.Next();
+    }
+
+    const size_t size = std::min(count, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + size, matches.end(), [](const auto& lhs, const auto& rhs) {
+        return (lhs.first > rhs.first) || ((lhs.first == rhs.first) && (lhs.second < rhs.second));
+    });
+    hits.reserve(hits.size() + size);
+    for (size_t i = 0; i < size; ++i) {
+        const Document& document = documents_[matches[i].second];
+        hits.push_back(SearchHit{document.type, document.podcast, document.entity, document.transcript, matches[i].first});
+    }
+    return size;
+}
+} // namespace ultralove::p3::model
@@ -0,0 +1,157 @@
+///
+// \file modelsearchindex.h
+// \brief P3 Model Search Index
+// \details Full-text index over podcast, season, episode and transcript text
+//
+
+#ifndef __P3_MODEL_SEARCH_INDEX_H_INCL__
+#define __P3_MODEL_SEARCH_INDEX_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelentityhandle.h"
+#include "modelepisode.h"
+#include "modelpodcast.h"
+#include "modelseason.h"
+#include "modeltranscripttag.h"
+#include "runtimeguid.h"
+#include "runtimestring.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Kind of entity a search hit refers to
+enum class SearchDocumentType
+{
+    PODCAST,   ///< Podcast title, subtitle, description or summary
+    SEASON,    ///< Season title or description
+    EPISODE,   ///< Episode title, subtitle, description or summary
+    TRANSCRIPT ///< Transcript segment text
+};
+
+/// \brief Result of a search
+struct SearchHit
+{
+    /// \brief Kind of the matching entity
+    SearchDocumentType type;
+
+    /// \brief Identifier of the podcast
+    runtime::Guid podcast;
+
+    /// \brief Identifier of the podcast, season or episode; the episode for transcript hits
+    runtime::Guid entity;
+
+    /// \brief Matching transcript segment for transcript hits, empty otherwise
+    EntityHandle<TranscriptTag> transcript;
+
+    /// \brief BM25 relevance, higher is better
+    double score;
+};
+
+/// \brief Full-text search index
+/// \details An in-memory inverted index over the title, subtitle, description and summary of
+/// podcasts, seasons and episodes and over transcript text. Text is split into words at every
+/// character that is not an ASCII letter or digit; bytes of multi-byte UTF-8 sequences belong to
+/// words, ASCII letters are folded to lower case. Every word is a term; each term has one posting
+/// list holding, per document, the document number, the term frequency and the word positions,
+/// all delta-encoded as variable-length integers.
+///
+/// A query matches documents that contain all of its words. Words in double quotes form a phrase
+/// and must appear next to each other in one field. Hits are ranked by BM25. Documents can only be
+/// added; to drop or change documents, Clear() and add them again. An index is not thread-safe,
+/// concurrent searches without additions are fine.
+class SearchIndex
+{
+public:
+    /// \brief Create an empty index
+    SearchIndex() = default;
+
+    /// \brief Destroy the index
+    virtual ~SearchIndex() = default;
+
+    SearchIndex(const SearchIndex&)            = delete;
+    SearchIndex& operator=(const SearchIndex&) = delete;
+
+    /// \brief Index a podcast with all seasons and episodes
+    /// \param podcast Podcast to index
+    void AddPodcast(const Podcast& podcast);
+
+    /// \brief Index a transcript segment
+    /// \param podcast Identifier of the podcast
+    /// \param episode Identifier of the episode the segment belongs to
+    /// \param transcript Transcript segment, returned by matching hits
+    void AddTranscript(const runtime::Guid& podcast, const runtime::Guid& episode, const EntityHandle<TranscriptTag>& transcript);
+
+    /// \brief Remove all documents
+    void Clear() noexcept;
+
+    /// \brief Get the number of indexed documents
+    /// \return Number of documents
+    size_t GetDocumentCount() const noexcept
+    {
+        return documents_.size();
+    }
+
+    /// \brief Get the number of distinct terms
+    /// \return Number of terms
+    size_t GetTermCount() const noexcept
+    {
+        return postings_.size();
+    }
+
+    /// \brief Search the index
+    /// \param query Words and quoted phrases that must all match
+    /// \param count Maximum number of hits
+    /// \param hits Receives the best hits, best first
+    /// \return Number of hits appended
+    size_t Search(const std::string_view query, const size_t count, std::vector<SearchHit>& hits) const;
+
+private:
+    struct Document
+    {
+        SearchDocumentType type;
+        uint32_t length;
+        runtime::Guid podcast;
+        runtime::Guid entity;
+        EntityHandle<TranscriptTag> transcript;
+    };
+
+    struct PostingList
+    {
+        std::vector<uint8_t> data;
+        uint32_t documentCount = 0;
+        uint32_t lastDocument  = 0;
+    };
+
+    // Heterogeneous lookup, so queries do not allocate a string per word
+    struct TermHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(const std::string_view term) const noexcept
+        {
+            return std::hash<std::string_view>()(term);
+        }
+    };
+
+    void AddDocument(Document document, std::initializer_list<const runtime::String*> fields);
+
+    std::vector<Document> documents_;
+    std::unordered_map<std::string, PostingList, TermHash, std::equal_to<>> postings_;
+    uint64_t totalLength_ = 0;
+    std::unordered_map<std::string, std::vector<uint32_t>, TermHash, std::equal_to<>> scratch_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_SEARCH_INDEX_H_INCL__
@@ -0,0 +1,691 @@
+///
+// \file modelsnapshot.cpp
+// \brief P3 Model Snapshot implementation
+// \details Snapshot layout, header checks, reference validation and compressed strings
+//
+
+#include "modelsnapshot.h"
+
+#include "modelcontribution.h"
+#include "modelcontributor.h"
+#include "modelenclosure.h"
+#include "modelepisode.h"
+#include "modelpicture.h"
+#include "modelpublisher.h"
+#include "modelseason.h"
+#include "modeltag.h"
+#include "modeltagreference.h"
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ultralove::p3::model {
+namespace {
+constexpr size_t RECORD_ALIGNMENT = 8;
+constexpr size_t MAX_SNAPSHOT_SIZE = UINT32_MAX;
+constexpr size_t WRITE_CHUNK_SIZE  = 1024 * 1024;
+constexpr size_t SIZE_ALIGNMENT    = alignof(uint32_t);
+
+// Decompresses the compressed strings of a snapshot in place; locators are the offsets of the strings
+class SnapshotTextStore : public runtime::TextStore
+{
+public:
+    SnapshotTextStore(const std::string_view data, const std::string_view dictionary) noexcept : data_(data), dictionary_(dictionary) {}
+
+protected:
+    bool Read(const uint64_t locator, char* buffer, const size_t length) override
+    {
+        if ((locator > UINT32_MAX) || (length >= SNAPSHOT_COMPRESSED_TEXT)) {
+            return false;
+        }
+        const SnapshotString value{static_cast<uint32_t>(locator), static_cast<uint32_t>(length) | SNAPSHOT_COMPRESSED_TEXT};
+        const std::optional<std::string_view> encoded = GetEncodedText(data_, value);
+        return encoded.has_value() && runtime::TextDictionary::Decompress(dictionary_, *encoded, buffer, length);
+    }
+
+private:
+    std::string_view data_;
+    std::string_view dictionary_;
+};
+
+// Lays out a snapshot in one growing buffer; records are assembled on the stack and copied into
+// their reserved place, because the buffer moves when it grows
+class Builder
+{
+public:
+    explicit Builder(const runtime::TextDictionary* dictionary = nullptr) noexcept : dictionary_(dictionary) {}
+
+    bool Build(const Podcast& podcast)
+    {
+        const uint32_t header = Reserve(sizeof(SnapshotHeader));
+        empty_                = Reserve(1, 1);
+
+        uint32_t dictionary = 0;
+        if (dictionary_ != nullptr) {
+            dictionary = Reserve(sizeof(SnapshotString));
+            Store(dictionary, MakeText(dictionary_->GetContent()));
+            report_.dictionaryBytes = dictionary_->GetSize();
+        }
+
+        SnapshotPodcastRecord record{};
+        const uint32_t offset = Reserve(sizeof(record));
+        record.fabric         = MakeFabric(podcast);
+        record.title          = MakeString(podcast.title);
+        record.subtitle       = MakeString(podcast.subtitle);
+        record.description    = MakeCompressed(podcast.description);
+        record.summary        = MakeCompressed(podcast.summary);
+        record.language       = MakeString(podcast.language);
+        record.categories     = ReserveArray<SnapshotString>(podcast.categories.size());
+        for (size_t i = 0; i < podcast.categories.size(); ++i) {
+            Store(record.categories.offset + i * sizeof(SnapshotString), MakeString(podcast.categories[i]));
+        }
+        record.publicationDate  = EncodeSnapshotTimestamp(podcast.publicationDate);
+        record.lastBuildDate    = EncodeSnapshotTimestamp(podcast.lastBuildDate);
+        record.managingEditor   = MakeString(podcast.managingEditor);
+        record.webmaster        = MakeString(podcast.webmaster);
+        record.copyright        = MakeString(podcast.copyright);
+        record.link             = MakeString(podcast.link);
+        record.publisher.fabric = MakeFabric(podcast.publisher);
+        record.publisher.name   = MakeString(podcast.publisher.name);
+        record.publisher.email  = MakeString(podcast.publisher.email);
+        record.publisher.url    = MakeString(podcast.publisher.url);
+        record.publisher.description = MakeString(podcast.publisher.description);
+        record.coverArt              = MakePicture(podcast.coverArt);
+        record.tags                  = MakeTagReferences(podcast.tags);
+        record.contributors          = MakeContributions(podcast.contributors);
+        record.seasons               = ReserveArray<SnapshotSeasonRecord>(podcast.seasons.size());
+        for (size_t i = 0; i < podcast.seasons.size(); ++i) {
+            Store(record.seasons.offset + i * sizeof(SnapshotSeasonRecord), MakeSeason(podcast.seasons[i]));
+        }
+        Store(offset, record);
+
+        // Tags go first, their creators may add contributors
+        SnapshotHeader headerRecord{};
+        headerRecord.tags = ReserveArray<SnapshotTagRecord>(tags_.size());
+        for (size_t i = 0; i < tags_.size(); ++i) {
+            Store(headerRecord.tags.offset + i * sizeof(SnapshotTagRecord), MakeTag(*tags_[i]));
+        }
+        headerRecord.contributors = ReserveArray<SnapshotContributorRecord>(contributors_.size());
+        for (size_t i = 0; i < contributors_.size(); ++i) {
+            Store(headerRecord.contributors.offset + i * sizeof(SnapshotContributorRecord), MakeContributor(*contributors_[i]));
+        }
+
+        std::memcpy(headerRecord.magic, SNAPSHOT_MAGIC, sizeof(headerRecord.magic));
+        headerRecord.version    = SNAPSHOT_VERSION;
+        headerRecord.byteOrder  = SNAPSHOT_BYTE_ORDER;
+        headerRecord.fileSize   = buffer_.size();
+        headerRecord.podcast    = offset;
+        headerRecord.dictionary = dictionary;
+        Store(header, headerRecord);
+        return overflow_ == false;
+    }
+
+    const std::vector<char>& GetBuffer() const noexcept
+    {
+        return buffer_;
+    }
+
+    const runtime::TextCompressionReport& GetReport() const noexcept
+    {
+        return report_;
+    }
+
+private:
+    uint32_t Reserve(const size_t size, const size_t alignment = RECORD_ALIGNMENT)
+    {
+        const size_t offset = (buffer_.size() + alignment - 1) & ~(alignment - 1);
+        if (offset + size > MAX_SNAPSHOT_SIZE) {
+            overflow_ = true;
+            return 0;
+        }
+        buffer_.resize(offset + size);
+        return static_cast<uint32_t>(offset);
+    }
+
+    template<typename T>
+    SnapshotArray ReserveArray(const size_t count)
+    {
+        if (count == 0) {
+            return SnapshotArray{};
+        }
+        const uint32_t offset = Reserve(count * sizeof(T));
+        return SnapshotArray{offset, static_cast<uint32_t>(count)};
+    }
+
+    template<typename T>
+    void Store(const size_t offset, const T& record)
+    {
+        if (overflow_ == false) {
+            std::memcpy(buffer_.data() + offset, &record, sizeof(record));
+        }
+    }
+
+    SnapshotString MakeString(const runtime::String& value)
+    {
+        return MakeText(value.GetView());
+    }
+
+    SnapshotString MakeText(const std::string_view text)
+    {
+        if (text.empty()) {
+            return SnapshotString{empty_, 0};
+        }
+        // Longer lengths would read as compressed
+        if (text.size() >= SNAPSHOT_COMPRESSED_TEXT) {
+            overflow_ = true;
+            return SnapshotString{empty_, 0};
+        }
+
+        // Interned and repeated values are stored once
+        const auto existing = strings_.find(text);
+        if (existing != strings_.end()) {
+            return SnapshotString{existing->second, static_cast<uint32_t>(text.size())};
+        }
+        const uint32_t offset = Reserve(text.size() + 1, 1);
+        if (overflow_) {
+            return SnapshotString{empty_, 0};
+        }
+        std::memcpy(buffer_.data() + offset, text.data(), text.size());
+        buffer_[offset + text.size()] = '\0';
+        strings_.emplace(text, offset);
+        return SnapshotString{offset, static_cast<uint32_t>(text.size())};
+    }
+
+    // Compressed like plain strings are stored once per distinct value, a value stored plain already
+    // is not compressed again
+    SnapshotString MakeCompressed(const runtime::String& value)
+    {
+        const std::string_view text = value.GetView();
+        if ((dictionary_ == nullptr) || (text.size() <= runtime::String::INLINE_CAPACITY) || (text.size() >= SNAPSHOT_COMPRESSED_TEXT) ||
+            strings_.contains(text)) {
+            return MakeString(value);
+        }
+        report_.values += 1;
+        report_.rawBytes += text.size();
+
+        const auto existing = compressed_.find(text);
+        if (existing != compressed_.end()) {
+            return SnapshotString{existing->second, static_cast<uint32_t>(text.size()) | SNAPSHOT_COMPRESSED_TEXT};
+        }
+        encoded_.clear();
+        dictionary_->Compress(text, encoded_);
+        if (sizeof(uint32_t) + encoded_.size() >= text.size() + 1) {
+            report_.storedBytes += text.size() + 1;
+            return MakeString(value);
+        }
+        const uint32_t offset = Reserve(sizeof(uint32_t) + encoded_.size(), SIZE_ALIGNMENT);
+        if (overflow_) {
+            return SnapshotString{empty_, 0};
+        }
+        const uint32_t size = static_cast<uint32_t>(encoded_.size());
+        std::memcpy(buffer_.data() + offset, &size, sizeof(size));
+        std::memcpy(buffer_.data() + offset + sizeof(size), encoded_.data(), encoded_.size());
+        compressed_.emplace(text, offset);
+        report_.storedBytes += sizeof(size) + encoded_.size();
+        return SnapshotString{offset, static_cast<uint32_t>(text.size()) | SNAPSHOT_COMPRESSED_TEXT};
+    }
+
+    SnapshotFabricRecord MakeFabric(const Fabric& fabric)
+    {
+        SnapshotFabricRecord record{};
+        record.idHigh           = fabric.id.high;
+        record.idLow            = fabric.id.low;
+        record.typeIdHigh       = fabric.typeId.high;
+        record.typeIdLow        = fabric.typeId.low;
+        record.creationDate     = EncodeSnapshotTimestamp(fabric.creationDate);
+        record.modificationDate = EncodeSnapshotTimestamp(fabric.modificationDate);
+        record.comment          = MakeString(fabric.comment);
+        return record;
+    }
+
+    SnapshotAssetRecord MakeAsset(const Asset& asset)
+    {
+        SnapshotAssetRecord record{};
+        record.uri       = MakeString(asset.uri);
+        record.author    = MakeString(asset.author);
+        record.license   = MakeString(asset.license);
+        record.copyright = MakeString(asset.copyright);
+        return record;
+    }
+
+    SnapshotPictureRecord MakePicture(const Picture& picture)
+    {
+        SnapshotPictureRecord record{};
+        record.asset  = MakeAsset(picture);
+        record.type   = static_cast<uint32_t>(picture.type);
+        record.width  = picture.width;
+        record.height = picture.height;
+        return record;
+    }
+
+    SnapshotSeasonRecord MakeSeason(const Season& season)
+    {
+        SnapshotSeasonRecord record{};
+        record.fabric          = MakeFabric(season);
+        record.seasonNumber    = season.seasonNumber;
+        record.title           = MakeString(season.title);
+        record.description     = MakeCompressed(season.description);
+        record.publicationDate = EncodeSnapshotTimestamp(season.publicationDate);
+        record.coverArt        = MakePicture(season.coverArt);
+        record.tags            = MakeTagReferences(season.tags);
+        record.contributors    = MakeContributions(season.contributors);
+        record.episodes        = ReserveArray<SnapshotEpisodeRecord>(season.episodes.size());
+        for (size_t i = 0; i < season.episodes.size(); ++i) {
+            Store(record.episodes.offset + i * sizeof(SnapshotEpisodeRecord), MakeEpisode(season.episodes[i]));
+        }
+        return record;
+    }
+
+    SnapshotEpisodeRecord MakeEpisode(const Episode& episode)
+    {
+        SnapshotEpisodeRecord record{};
+        record.fabric          = MakeFabric(episode);
+        record.episodeNumber   = episode.episodeNumber;
+        record.type            = static_cast<uint32_t>(episode.type);
+        record.title           = MakeString(episode.title);
+        record.subtitle        = MakeString(episode.subtitle);
+        record.description     = MakeCompressed(episode.description);
+        record.summary         = MakeCompressed(episode.summary);
+        record.publicationDate = EncodeSnapshotTimestamp(episode.publicationDate);
+        record.duration        = episode.duration.GetNanoseconds();
+        record.coverArt        = MakePicture(episode.coverArt);
+        record.enclosures      = ReserveArray<SnapshotEnclosureRecord>(episode.enclosures.size());
+        for (size_t i = 0; i < episode.enclosures.size(); ++i) {
+            const Enclosure& enclosure = episode.enclosures[i];
+            SnapshotEnclosureRecord enclosureRecord{};
+            enclosureRecord.asset    = MakeAsset(enclosure);
+            enclosureRecord.mimeType = MakeString(enclosure.mimeType);
+            enclosureRecord.fileSize = enclosure.fileSize;
+            enclosureRecord.type     = static_cast<uint32_t>(enclosure.type);
+            Store(record.enclosures.offset + i * sizeof(SnapshotEnclosureRecord), enclosureRecord);
+        }
+        record.tags         = MakeTagReferences(episode.tags);
+        record.contributors = MakeContributions(episode.contributors);
+        return record;
+    }
+
+    SnapshotArray MakeTagReferences(const std::vector<TagReference>& references)
+    {
+        const SnapshotArray array = ReserveArray<SnapshotTagReferenceRecord>(references.size());
+        for (size_t i = 0; i < references.size(); ++i) {
+            SnapshotTagReferenceRecord record{};
+            record.tag    = TagIndex(references[i].tag.Get());
+            record.weight = references[i].weight;
+            Store(array.offset + i * sizeof(SnapshotTagReferenceRecord), record);
+        }
+        return array;
+    }
+
+    SnapshotArray MakeContributions(const std::vector<Contribution>& contributions)
+    {
+        const SnapshotArray array = ReserveArray<SnapshotContributionRecord>(contributions.size());
+        for (size_t i = 0; i < contributions.size(); ++i) {
+            SnapshotContributionRecord record{};
+            record.contributor = ContributorIndex(contributions[i].contributor.Get());
+            record.type        = MakeString(contributions[i].type);
+            record.notes       = MakeString(contributions[i].notes);
+            Store(array.offset + i * sizeof(SnapshotContributionRecord), record);
+        }
+        return array;
+    }
+
+    SnapshotTagRecord MakeTag(const Tag& tag)
+    {
+        SnapshotTagRecord record{};
+        record.fabric      = MakeFabric(tag);
+        record.name        = MakeString(tag.name);
+        record.description = MakeString(tag.description);
+        record.creator     = ContributorIndex(tag.creator.Get());
+        return record;
+    }
+
+    SnapshotContributorRecord MakeContributor(const Contributor& contributor)
+    {
+        SnapshotContributorRecord record{};
+        record.fabric   = MakeFabric(contributor);
+        record.name     = MakeString(contributor.name);
+        record.email    = MakeString(contributor.email);
+        record.url      = MakeString(contributor.url);
+        record.role     = MakeString(contributor.role);
+        record.bio      = MakeString(contributor.bio);
+        record.image    = MakePicture(contributor.image);
+        record.presence = ReserveArray<SnapshotPresenceRecord>(contributor.presence.size());
+        for (size_t i = 0; i < contributor.presence.size(); ++i) {
+            const SnapshotPresenceRecord presence{contributor.presence[i].startTime.GetNanoseconds(), contributor.presence[i].endTime.GetNanoseconds()};
+            Store(record.presence.offset + i * sizeof(SnapshotPresenceRecord), presence);
+        }
+        return record;
+    }
+
+    // Shared entities are identified by their instance, exactly like EntityHandle compares them
+    uint32_t ContributorIndex(const Contributor* contributor)
+    {
+        if (contributor == nullptr) {
+            return SNAPSHOT_NO_INDEX;
+        }
+        const auto [it, inserted] = contributorIndexes_.try_emplace(contributor, static_cast<uint32_t>(contributors_.size()));
+        if (inserted) {
+            contributors_.push_back(contributor);
+        }
+        return it->second;
+    }
+
+    uint32_t TagIndex(const Tag* tag)
+    {
+        if (tag == nullptr) {
+            return SNAPSHOT_NO_INDEX;
+        }
+        const auto [it, inserted] = tagIndexes_.try_emplace(tag, static_cast<uint32_t>(tags_.size()));
+        if (inserted) {
+            tags_.push_back(tag);
+        }
+        return it->second;
+    }
+
+    const runtime::TextDictionary* dictionary_ = nullptr;
+    std::vector<char> buffer_;
+    std::unordered_map<std::string_view, uint32_t> strings_;
+    std::unordered_map<std::string_view, uint32_t> compressed_;
+    std::string encoded_;
+    runtime::TextCompressionReport report_;
+    std::unordered_map<const Contributor*, uint32_t> contributorIndexes_;
+    std::vector<const Contributor*> contributors_;
+    std::unordered_map<const Tag*, uint32_t> tagIndexes_;
+    std::vector<const Tag*> tags_;
+    uint32_t empty_ = 0;
+    bool overflow_  = false;
+};
+
+// Bounds checks used by Snapshot::Validate()
+class Validator
+{
+public:
+    explicit Validator(const std::string_view data) noexcept : data_(data), header_(*reinterpret_cast<const SnapshotHeader*>(data.data())) {}
+
+    bool Run() const noexcept
+    {
+        if ((CheckArray<SnapshotContributorRecord>(header_.contributors) == false) || (CheckArray<SnapshotTagRecord>(header_.tags) == false)) {
+            return false;
+        }
+        for (const SnapshotContributorRecord& contributor : Records<SnapshotContributorRecord>(header_.contributors)) {
+            if ((CheckFabric(contributor.fabric) && CheckString(contributor.name) && CheckString(contributor.email) &&
+                    CheckString(contributor.url) && CheckString(contributor.role) && CheckString(contributor.bio) &&
+                    CheckPicture(contributor.image) && CheckArray<SnapshotPresenceRecord>(contributor.presence)) == false) {
+                return false;
+            }
+        }
+        for (const SnapshotTagRecord& tag : Records<SnapshotTagRecord>(header_.tags)) {
+            if ((CheckFabric(tag.fabric) && CheckString(tag.name) && CheckString(tag.description) &&
+                    CheckIndex(tag.creator, header_.contributors)) == false) {
+                return false;
+            }
+        }
+
+        const SnapshotPodcastRecord& podcast = *reinterpret_cast<const SnapshotPodcastRecord*>(data_.data() + header_.podcast);
+        if ((CheckFabric(podcast.fabric) && CheckString(podcast.title) && CheckString(podcast.subtitle) &&
+                CheckString(podcast.description) && CheckString(podcast.summary) && CheckString(podcast.language) &&
+                CheckArray<SnapshotString>(podcast.categories) && CheckString(podcast.managingEditor) && CheckString(podcast.webmaster) &&
+                CheckString(podcast.copyright) && CheckString(podcast.link) && CheckFabric(podcast.publisher.fabric) &&
+                CheckString(podcast.publisher.name) && CheckString(podcast.publisher.email) && CheckString(podcast.publisher.url) &&
+                CheckString(podcast.publisher.description) && CheckPicture(podcast.coverArt) && CheckTagReferences(podcast.tags) &&
+                CheckContributions(podcast.contributors) && CheckArray<SnapshotSeasonRecord>(podcast.seasons)) == false) {
+            return false;
+        }
+        for (const SnapshotString& category : Records<SnapshotString>(podcast.categories)) {
+            if (CheckString(category) == false) {
+                return false;
+            }
+        }
+        for (const SnapshotSeasonRecord& season : Records<SnapshotSeasonRecord>(podcast.seasons)) {
+            if ((CheckFabric(season.fabric) && CheckString(season.title) && CheckString(season.description) && CheckPicture(season.coverArt) &&
+                    CheckTagReferences(season.tags) && CheckContributions(season.contributors) &&
+                    CheckArray<SnapshotEpisodeRecord>(season.episodes)) == false) {
+                return false;
+            }
+            for (const SnapshotEpisodeRecord& episode : Records<SnapshotEpisodeRecord>(season.episodes)) {
+                if (CheckEpisode(episode) == false) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    template<typename T>
+    struct Range
+    {
+        const T* first;
+        const T* last;
+
+        const T* begin() const noexcept
+        {
+            return first;
+        }
+
+        const T* end() const noexcept
+        {
+            return last;
+        }
+    };
+
+    template<typename T>
+    Range<T> Records(const SnapshotArray& array) const noexcept
+    {
+        const T* first = reinterpret_cast<const T*>(data_.data() + array.offset);
+        return Range<T>{first, first + array.count};
+    }
+
+    template<typename T>
+    bool CheckArray(const SnapshotArray& array) const noexcept
+    {
+        if (array.count == 0) {
+            return true;
+        }
+        return ((array.offset % RECORD_ALIGNMENT) == 0) && (array.offset <= data_.size()) &&
+               (array.count <= (data_.size() - array.offset) / sizeof(T));
+    }
+
+    // Compressed strings are checked for their bounds and the reach of the codec only, values that
+    // do not decode read as empty
+    bool CheckString(const SnapshotString& value) const noexcept
+    {
+        if ((header_.version >= 2) && ((value.length & SNAPSHOT_COMPRESSED_TEXT) != 0)) {
+            return GetEncodedText(data_, value).has_value();
+        }
+        return (value.offset < data_.size()) && (value.length < data_.size() - value.offset) && (data_[value.offset + value.length] == '\0');
+    }
+
+    bool CheckIndex(const uint32_t index, const SnapshotArray& table) const noexcept
+    {
+        return (index == SNAPSHOT_NO_INDEX) || (index < table.count);
+    }
+
+    bool CheckFabric(const SnapshotFabricRecord& fabric) const noexcept
+    {
+        return CheckString(fabric.comment);
+    }
+
+    bool CheckAsset(const SnapshotAssetRecord& asset) const noexcept
+    {
+        return CheckString(asset.uri) && CheckString(asset.author) && CheckString(asset.license) && CheckString(asset.copyright);
+    }
+
+    bool CheckPicture(const SnapshotPictureRecord& picture) const noexcept
+    {
+        return CheckAsset(picture.asset);
+    }
+
+    bool CheckTagReferences(const SnapshotArray& array) const noexcept
+    {
+        if (CheckArray<SnapshotTagReferenceRecord>(array) == false) {
+            return false;
+        }
+        for (const SnapshotTagReferenceRecord& reference : Records<SnapshotTagReferenceRecord>(array)) {
+            if (CheckIndex(reference.tag, header_.tags) == false) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool CheckContributions(const SnapshotArray& array) const noexcept
+    {
+        if (CheckArray<SnapshotContributionRecord>(array) == false) {
+            return false;
+        }
+        for (const SnapshotContributionRecord& contribution : Records<SnapshotContributionRecord>(array)) {
+            if ((CheckIndex(contribution.contributor, header_.contributors) && CheckString(contribution.type) &&
+                    CheckString(contribution.notes)) == false) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool CheckEpisode(const SnapshotEpisodeRecord& episode) const noexcept
+    {
+        if ((CheckFabric(episode.fabric) && CheckString(episode.title) && CheckString(episode.subtitle) && CheckString(episode.description) &&
+                CheckString(episode.summary) && CheckPicture(episode.coverArt) && CheckArray<SnapshotEnclosureRecord>(episode.enclosures) &&
+                CheckTagReferences(episode.tags) && CheckContributions(episode.contributors)) == false) {
+            return false;
+        }
+        for (const SnapshotEnclosureRecord& enclosure : Records<SnapshotEnclosureRecord>(episode.enclosures)) {
+            if ((CheckAsset(enclosure.asset) && CheckString(enclosure.mimeType)) == false) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string_view data_;
+    const SnapshotHeader& header_;
+};
+
+bool Flush(const std::vector<char>& buffer, runtime::OutputSink& sink)
+{
+    for (size_t offset = 0; offset < buffer.size(); offset += WRITE_CHUNK_SIZE) {
+        const size_t size = ((buffer.size() - offset) < WRITE_CHUNK_SIZE) ? (buffer.size() - offset) : WRITE_CHUNK_SIZE;
+        if (sink.Write(buffer.data() + offset, size) == false) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+bool Snapshot::Write(const Podcast& podcast, runtime::OutputSink& sink)
+{
+    Builder builder;
+    return builder.Build(podcast) && Flush(builder.GetBuffer(), sink);
+}
+
+bool Snapshot::Write(const Podcast& podcast, runtime::OutputSink& sink, const runtime::TextDictionary& dictionary, runtime::TextCompressionReport* report)
+{
+    Builder builder(&dictionary);
+    const bool built = builder.Build(podcast);
+    if (report != nullptr) {
+        *report = builder.GetReport();
+    }
+    return built && Flush(builder.GetBuffer(), sink);
+}
+
+bool Snapshot::Open(const char* path)
+{
+    Close();
+    if (file_.Open(path) == false) {
+        return false;
+    }
+    if (Attach(file_.GetView()) == false) {
+        file_.Close();
+        return false;
+    }
+    return true;
+}
+
+bool Snapshot::Attach(const std::string_view data)
+{
+    data_ = std::string_view();
+    base_ = SnapshotBase{};
+    text_.reset();
+    // Every snapshot holds a podcast record after its header, which also keeps the record bounds
+    // below from wrapping around
+    if ((data.size() < sizeof(SnapshotHeader) + sizeof(SnapshotPodcastRecord)) ||
+        ((reinterpret_cast<uintptr_t>(data.data()) % RECORD_ALIGNMENT) != 0)) {
+        return false;
+    }
+
+    const SnapshotHeader& header = *reinterpret_cast<const SnapshotHeader*>(data.data());
+    if ((std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) || (header.version < SNAPSHOT_MIN_VERSION) ||
+        (header.version > SNAPSHOT_VERSION) || (header.byteOrder != SNAPSHOT_BYTE_ORDER) || (header.fileSize != data.size()) ||
+        ((header.podcast % RECORD_ALIGNMENT) != 0) || (header.podcast > data.size() - sizeof(SnapshotPodcastRecord))) {
+        return false;
+    }
+
+    // The dictionary is checked here, compressed strings cannot be read without it
+    std::string_view dictionary;
+    if ((header.version >= 2) && (header.dictionary != 0)) {
+        if (((header.dictionary % RECORD_ALIGNMENT) != 0) || (header.dictionary > data.size() - sizeof(SnapshotString))) {
+            return false;
+        }
+        const SnapshotString& content = *reinterpret_cast<const SnapshotString*>(data.data() + header.dictionary);
+        if ((content.offset > data.size()) || (content.length > data.size() - content.offset)) {
+            return false;
+        }
+        dictionary = data.substr(content.offset, content.length);
+    }
+    if (header.version >= 2) {
+        text_ = std::make_unique<SnapshotTextStore>(data, dictionary);
+    }
+    data_ = data;
+    base_ = SnapshotBase{data_.data(), data_.size(), text_.get()};
+    return true;
+}
+
+void Snapshot::Close() noexcept
+{
+    data_ = std::string_view();
+    base_ = SnapshotBase{};
+    text_.reset();
+    file_.Close();
+}
+
+bool Snapshot::Validate() const noexcept
+{
+    return IsOpen() && Validator(data_).Run();
+}
+
+runtime::String Snapshot::MakeLazy(const std::string_view value, runtime::TextStore& store) const
+{
+    const bool inside = (value.data() >= data_.data()) && (value.data() + value.size() <= data_.data() + data_.size());
+    if ((value.size() <= runtime::String::INLINE_CAPACITY) || (inside == false)) {
+        return runtime::String(value);
+    }
+    return store.MakeLazy(static_cast<uint64_t>(value.data() - data_.data()), value.size());
+}
+
+void Snapshot::Trim()
+{
+    if (text_ != nullptr) {
+        text_->Trim();
+    }
+}
+
+PodcastView Snapshot::GetPodcast() const noexcept
+{
+    return PodcastView(&base_, reinterpret_cast<const SnapshotPodcastRecord*>(data_.data() + Header().podcast));
+}
+
+ViewList<ContributorView, SnapshotContributorRecord> Snapshot::GetContributors() const noexcept
+{
+    return ViewList<ContributorView, SnapshotContributorRecord>(&base_, Header().contributors);
+}
+
+ViewList<TagView, SnapshotTagRecord> Snapshot::GetTags() const noexcept
+{
+    return ViewList<TagView, SnapshotTagRecord>(&base_, Header().tags);
+}
+} // namespace ultralove::p3::model
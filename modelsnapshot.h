@@ -0,0 +1,142 @@
+///
+// \file modelsnapshot.h
+// \brief P3 Model Snapshot
+// \details Memory-mappable binary snapshot of a whole Podcast tree
+//
+
+#ifndef __P3_MODEL_SNAPSHOT_H_INCL__
+#define __P3_MODEL_SNAPSHOT_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelpodcast.h"
+#include "modelsnapshotformat.h"
+#include "modelsnapshotview.h"
+#include "runtimemappedfile.h"
+#include "runtimeoutputsink.h"
+#include "runtimestring.h"
+#include "runtimetextdictionary.h"
+#include "runtimetextstore.h"
+#include <memory>
+#include <string_view>
+
+namespace ultralove::p3::model {
+/// \brief Binary Podcast snapshot
+/// \details A snapshot stores a Podcast with all seasons, episodes, enclosures, contributions and
+/// tag references in a compact, versioned and position-independent format (see
+/// modelsnapshotformat.h). Opening a snapshot maps the file and checks its header; nothing is
+/// deserialized, all data is read in place through PodcastView and the views below it. Because the
+/// mapping is read-only and shared, any number of worker processes can open the same snapshot file
+/// and share its pages.
+///
+/// Snapshots written with a dictionary keep descriptions and summaries compressed; views decompress
+/// them on access into a text store owned by the snapshot, see GetTextStore() and Trim().
+class Snapshot
+{
+public:
+    /// \brief Create a closed snapshot
+    Snapshot() noexcept = default;
+
+    /// \brief Close the snapshot
+    virtual ~Snapshot() = default;
+
+    Snapshot(const Snapshot&)            = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    /// \brief Write a podcast as snapshot
+    /// \details Shared contributors and tags are written once. The snapshot is assembled in memory
+    /// and handed to the sink in chunks.
+    /// \param podcast Podcast to write
+    /// \param sink Destination of the snapshot
+    /// \return True if the sink accepted the whole snapshot; false if it did or the snapshot would exceed 4 GiB
+    static bool Write(const Podcast& podcast, runtime::OutputSink& sink);
+
+    /// \brief Write a podcast as snapshot with compressed descriptions and summaries
+    /// \details The dictionary is stored in the snapshot. Values that do not get smaller are stored
+    /// as they are.
+    /// \param podcast Podcast to write
+    /// \param sink Destination of the snapshot
+    /// \param dictionary Dictionary trained on the podcast, see LazyText::Train()
+    /// \param report Receives the compression figures of the descriptions and summaries, may be null
+    /// \return True if the sink accepted the whole snapshot; false if it did or the snapshot would exceed 4 GiB
+    static bool Write(const Podcast& podcast, runtime::OutputSink& sink, const runtime::TextDictionary& dictionary,
+        runtime::TextCompressionReport* report = nullptr);
+
+    /// \brief Map a snapshot file
+    /// \param path Path of the snapshot file
+    /// \return True if the file could be mapped and has a valid header
+    bool Open(const char* path);
+
+    /// \brief Use a snapshot that is already in memory
+    /// \param data Complete snapshot, 8-byte aligned, must stay valid until Close()
+    /// \return True if the data has a valid header
+    bool Attach(const std::string_view data);
+
+    /// \brief Close the snapshot, invalidating all views
+    void Close() noexcept;
+
+    /// \brief Check whether a snapshot is open
+    /// \return True between a successful Open() or Attach() and Close()
+    bool IsOpen() const noexcept
+    {
+        return data_.empty() == false;
+    }
+
+    /// \brief Check all references of the snapshot
+    /// \details Open() only checks the header, which is enough for snapshots written by Write(). This
+    /// walks every record once and makes sure that all offsets and indexes are in bounds and that the
+    /// decoded length of every compressed string is within reach of its encoded size, for snapshots
+    /// that come from an untrusted source. Views check compressed strings on access either way.
+    /// \return True if all references are in bounds
+    bool Validate() const noexcept;
+
+    /// \brief Create a lazy string for a string of the snapshot
+    /// \details The locator of the lazy string is the offset of the value in the snapshot, so the
+    /// store has to read the snapshot file, e.g. a runtime::FileTextStore opened on the same path.
+    /// The snapshot itself may be closed afterwards. Values that fit inline or do not lie in the
+    /// snapshot are copied instead.
+    /// \param value String returned by one of the views of this snapshot
+    /// \param store Store reading the snapshot file
+    /// \return Lazy string
+    runtime::String MakeLazy(const std::string_view value, runtime::TextStore& store) const;
+
+    /// \brief Evict decompressed strings from the cache of the snapshot
+    /// \details Invalidates the unpinned views of the evicted strings, see runtime::TextStore
+    void Trim();
+
+    /// \brief Get the text store that decompresses the strings of the snapshot
+    /// \details Threads that read compressed strings hold a runtime::TextStore::Pin on it
+    /// \return Text store, nullptr while the snapshot is closed or for format version 1
+    runtime::TextStore* GetTextStore() const noexcept
+    {
+        return text_.get();
+    }
+
+    /// \brief Get the podcast, the snapshot must be open
+    /// \return View of the podcast
+    PodcastView GetPodcast() const noexcept;
+
+    /// \brief Get the shared contributors, the snapshot must be open
+    /// \return Contributor table
+    ViewList<ContributorView, SnapshotContributorRecord> GetContributors() const noexcept;
+
+    /// \brief Get the shared tags, the snapshot must be open
+    /// \return Tag table
+    ViewList<TagView, SnapshotTagRecord> GetTags() const noexcept;
+
+private:
+    const SnapshotHeader& Header() const noexcept
+    {
+        return *reinterpret_cast<const SnapshotHeader*>(data_.data());
+    }
+
+    runtime::MappedFile file_;
+    std::string_view data_;
+    std::unique_ptr<runtime::TextStore> text_;
+    SnapshotBase base_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_SNAPSHOT_H_INCL__
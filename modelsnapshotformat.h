@@ -0,0 +1,266 @@
+///
+// \file modelsnapshotformat.h
+// \brief P3 Model Snapshot Format
+// \details On-disk records of the binary Podcast snapshot
+//
+
+#ifndef __P3_MODEL_SNAPSHOT_FORMAT_H_INCL__
+#define __P3_MODEL_SNAPSHOT_FORMAT_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "runtimeguid.h"
+#include "runtimetimespan.h"
+#include "runtimetimestamp.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+// Layout of a snapshot file, version 2:
+//
+//   SnapshotHeader at offset 0, followed by records and string characters in any order.
+//
+// All integers are stored in the byte order of the writer, which the header records. All references
+// are byte offsets from the start of the file, so a snapshot can be mapped at any address and shared
+// between processes. Records are 8-byte aligned. Strings are UTF-8, stored once per distinct value
+// and followed by a NUL character that is not counted in their length. Contributors and tags are
+// stored once in tables in the header and referenced by index, mirroring EntityRegistry sharing.
+// Timestamps are stored as microseconds since the epoch shifted left by 7 bits, with the timezone
+// offset in quarter hours as 7 bit two's complement in the low bits; timespans as nanoseconds.
+//
+// Version 2 adds compressed strings. A string whose length has SNAPSHOT_COMPRESSED_TEXT set refers
+// to a 4-byte aligned uint32 encoded size followed by the encoded value, see runtime::TextDictionary;
+// the other bits of the length are the decoded length. The dictionary is a string referenced by the
+// header, it is never compressed itself. Version 1 snapshots have no compressed strings and are read
+// unchanged.
+
+/// \brief Magic bytes at the start of every snapshot
+inline constexpr char SNAPSHOT_MAGIC[8] = {'P', '3', 'S', 'N', 'A', 'P', 'S', 'H'};
+
+/// \brief Format version written by Snapshot::Write()
+inline constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+/// \brief Oldest format version Snapshot::Open() accepts
+inline constexpr uint32_t SNAPSHOT_MIN_VERSION = 1;
+
+/// \brief Flag in SnapshotString::length marking a compressed string
+inline constexpr uint32_t SNAPSHOT_COMPRESSED_TEXT = 0x80000000;
+
+/// \brief Byte order mark, reads back as a different value on a host with the other byte order
+inline constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+/// \brief Index used for a missing entity reference
+inline constexpr uint32_t SNAPSHOT_NO_INDEX = UINT32_MAX;
+
+/// \brief Reference to a string
+struct SnapshotString
+{
+    uint32_t offset; ///< Offset of the first character
+    uint32_t length; ///< Length in bytes without the terminator
+};
+
+/// \brief Reference to a contiguous array of records
+struct SnapshotArray
+{
+    uint32_t offset; ///< Offset of the first record
+    uint32_t count;  ///< Number of records
+};
+
+/// \brief Common part of all entity records, see Fabric
+struct SnapshotFabricRecord
+{
+    uint64_t idHigh;
+    uint64_t idLow;
+    uint64_t typeIdHigh;
+    uint64_t typeIdLow;
+    int64_t creationDate;
+    int64_t modificationDate;
+    SnapshotString comment;
+};
+
+/// \brief Asset record, see Asset
+struct SnapshotAssetRecord
+{
+    SnapshotString uri;
+    SnapshotString author;
+    SnapshotString license;
+    SnapshotString copyright;
+};
+
+/// \brief Picture record, see Picture
+struct SnapshotPictureRecord
+{
+    SnapshotAssetRecord asset;
+    uint32_t type;
+    uint32_t width;
+    uint32_t height;
+    uint32_t reserved;
+};
+
+/// \brief Enclosure record, see Enclosure
+struct SnapshotEnclosureRecord
+{
+    SnapshotAssetRecord asset;
+    SnapshotString mimeType;
+    uint64_t fileSize;
+    uint32_t type;
+    uint32_t reserved;
+};
+
+/// \brief Contributor presence record, see ContributorPresence
+struct SnapshotPresenceRecord
+{
+    int64_t startTime;
+    int64_t endTime;
+};
+
+/// \brief Contributor record, see Contributor
+struct SnapshotContributorRecord
+{
+    SnapshotFabricRecord fabric;
+    SnapshotString name;
+    SnapshotString email;
+    SnapshotString url;
+    SnapshotString role;
+    SnapshotString bio;
+    SnapshotPictureRecord image;
+    SnapshotArray presence; ///< SnapshotPresenceRecord
+};
+
+/// \brief Contribution record, see Contribution
+struct SnapshotContributionRecord
+{
+    uint32_t contributor; ///< Index into the contributor table
+    uint32_t reserved;
+    SnapshotString type;
+    SnapshotString notes;
+};
+
+/// \brief Tag record, see Tag
+struct SnapshotTagRecord
+{
+    SnapshotFabricRecord fabric;
+    SnapshotString name;
+    SnapshotString description;
+    uint32_t creator; ///< Index into the contributor table
+    uint32_t reserved;
+};
+
+/// \brief Tag reference record, see TagReference
+struct SnapshotTagReferenceRecord
+{
+    uint32_t tag; ///< Index into the tag table
+    uint32_t reserved;
+    double weight;
+};
+
+/// \brief Publisher record, see Publisher
+struct SnapshotPublisherRecord
+{
+    SnapshotFabricRecord fabric;
+    SnapshotString name;
+    SnapshotString email;
+    SnapshotString url;
+    SnapshotString description;
+};
+
+/// \brief Episode record, see Episode
+struct SnapshotEpisodeRecord
+{
+    SnapshotFabricRecord fabric;
+    uint32_t episodeNumber;
+    uint32_t type;
+    SnapshotString title;
+    SnapshotString subtitle;
+    SnapshotString description;
+    SnapshotString summary;
+    int64_t publicationDate;
+    int64_t duration;
+    SnapshotPictureRecord coverArt;
+    SnapshotArray enclosures;   ///< SnapshotEnclosureRecord
+    SnapshotArray tags;         ///< SnapshotTagReferenceRecord
+    SnapshotArray contributors; ///< SnapshotContributionRecord
+};
+
+/// \brief Season record, see Season
+struct SnapshotSeasonRecord
+{
+    SnapshotFabricRecord fabric;
+    uint32_t seasonNumber;
+    uint32_t reserved;
+    SnapshotString title;
+    SnapshotString description;
+    int64_t publicationDate;
+    SnapshotPictureRecord coverArt;
+    SnapshotArray tags;         ///< SnapshotTagReferenceRecord
+    SnapshotArray contributors; ///< SnapshotContributionRecord
+    SnapshotArray episodes;     ///< SnapshotEpisodeRecord
+};
+
+/// \brief Podcast record, see Podcast
+struct SnapshotPodcastRecord
+{
+    SnapshotFabricRecord fabric;
+    SnapshotString title;
+    SnapshotString subtitle;
+    SnapshotString description;
+    SnapshotString summary;
+    SnapshotString language;
+    SnapshotArray categories; ///< SnapshotString
+    int64_t publicationDate;
+    int64_t lastBuildDate;
+    SnapshotString managingEditor;
+    SnapshotString webmaster;
+    SnapshotString copyright;
+    SnapshotString link;
+    SnapshotPublisherRecord publisher;
+    SnapshotPictureRecord coverArt;
+    SnapshotArray tags;         ///< SnapshotTagReferenceRecord
+    SnapshotArray contributors; ///< SnapshotContributionRecord
+    SnapshotArray seasons;      ///< SnapshotSeasonRecord
+};
+
+/// \brief Header at the start of every snapshot
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t fileSize;
+    uint32_t podcast;           ///< Offset of the SnapshotPodcastRecord
+    uint32_t dictionary;        ///< Offset of the SnapshotString of the compression dictionary, 0 if there is none
+    SnapshotArray contributors; ///< Contributor table, SnapshotContributorRecord
+    SnapshotArray tags;         ///< Tag table, SnapshotTagRecord
+};
+
+static_assert(std::is_trivially_copyable_v<SnapshotPodcastRecord> && std::is_standard_layout_v<SnapshotPodcastRecord>);
+static_assert(sizeof(SnapshotFabricRecord) == 56, "snapshot record layout changed");
+static_assert(sizeof(SnapshotPictureRecord) == 48, "snapshot record layout changed");
+static_assert(sizeof(SnapshotEpisodeRecord) == 184, "snapshot record layout changed");
+static_assert(sizeof(SnapshotHeader) == 48, "snapshot record layout changed");
+
+/// \brief Encode a timestamp for a snapshot record
+/// \param timestamp Timestamp to encode
+/// \return Encoded timestamp
+constexpr int64_t EncodeSnapshotTimestamp(const runtime::Timestamp& timestamp) noexcept
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(timestamp.GetMicroseconds()) << 7) | ((timestamp.GetOffsetMinutes() / 15) & 0x7f);
+}
+
+/// \brief Decode a timestamp from a snapshot record
+/// \param value Encoded timestamp
+/// \return Timestamp
+constexpr runtime::Timestamp DecodeSnapshotTimestamp(const int64_t value) noexcept
+{
+    const int quarterHours = static_cast<int>(static_cast<int64_t>(static_cast<uint64_t>(value) << 57) >> 57);
+    return runtime::Timestamp::FromMicroseconds(value >> 7, quarterHours * 15);
+}
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_SNAPSHOT_FORMAT_H_INCL__
@@ -0,0 +1,803 @@
+///
+// \file modelsnapshotview.h
+// \brief P3 Model Snapshot Views
+// \details Read-only accessors for the records of a binary Podcast snapshot
+//
+
+#ifndef __P3_MODEL_SNAPSHOT_VIEW_H_INCL__
+#define __P3_MODEL_SNAPSHOT_VIEW_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelenclosuretype.h"
+#include "modelepisodetype.h"
+#include "modelpicturetype.h"
+#include "modelsnapshotformat.h"
+#include "runtimeguid.h"
+#include "runtimetextdictionary.h"
+#include "runtimetextstore.h"
+#include "runtimetimespan.h"
+#include "runtimetimestamp.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <string_view>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Snapshot a view reads from
+/// \details Owned by the Snapshot, views keep a pointer to it
+struct SnapshotBase
+{
+    /// \brief Start of the snapshot
+    const char* data = nullptr;
+
+    /// \brief Size of the snapshot in bytes
+    size_t size = 0;
+
+    /// \brief Store that decompresses compressed strings, null for snapshots without any
+    runtime::TextStore* text = nullptr;
+};
+
+/// \brief Get the encoded bytes of a compressed string
+/// \details The encoded value must lie within the snapshot, and its decoded length must be within
+/// reach of the codec, runtime::TextDictionary::GetMaxDecodedLength(). Damaged lengths are thus
+/// rejected before anything is allocated for the value.
+/// \param data Snapshot
+/// \param value String with SNAPSHOT_COMPRESSED_TEXT set
+/// \return Encoded bytes, no value if the string is damaged
+inline std::optional<std::string_view> GetEncodedText(const std::string_view data, const SnapshotString& value) noexcept
+{
+    uint32_t size = 0;
+    if (((value.offset % alignof(uint32_t)) != 0) || (value.offset > data.size()) || (data.size() - value.offset < sizeof(size))) {
+        return std::nullopt;
+    }
+    std::memcpy(&size, data.data() + value.offset, sizeof(size));
+    if ((size > data.size() - value.offset - sizeof(size)) ||
+        ((value.length & ~SNAPSHOT_COMPRESSED_TEXT) > runtime::TextDictionary::GetMaxDecodedLength(size))) {
+        return std::nullopt;
+    }
+    return data.substr(value.offset + sizeof(size), size);
+}
+
+/// \brief Random-access list of views over an array of snapshot records
+/// \tparam View View type, constructible from the snapshot base and a record
+/// \tparam Record Record type of the array
+template<typename View, typename Record>
+class ViewList
+{
+public:
+    /// \brief Forward iterator over the views of a list
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = View;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = View;
+
+        Iterator() noexcept = default;
+        Iterator(const SnapshotBase* base, const Record* record) noexcept : base_(base), record_(record) {}
+
+        View operator*() const noexcept
+        {
+            return View(base_, record_);
+        }
+
+        Iterator& operator++() noexcept
+        {
+            ++record_;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator previous = *this;
+            ++record_;
+            return previous;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.record_ == rhs.record_;
+        }
+
+    private:
+        const SnapshotBase* base_ = nullptr;
+        const Record* record_     = nullptr;
+    };
+
+    /// \brief Create an empty list
+    ViewList() noexcept = default;
+
+    /// \brief Create a list over an array of records
+    /// \param base Snapshot of the list
+    /// \param array Array reference from a record
+    ViewList(const SnapshotBase* base, const SnapshotArray& array) noexcept :
+        base_(base), records_(reinterpret_cast<const Record*>(base->data + array.offset)), count_(array.count)
+    {
+    }
+
+    /// \brief Get the number of entries
+    size_t GetCount() const noexcept
+    {
+        return count_;
+    }
+
+    /// \brief Check whether the list is empty
+    bool IsEmpty() const noexcept
+    {
+        return count_ == 0;
+    }
+
+    /// \brief Get an entry
+    /// \param index Index of the entry, less than GetCount()
+    View operator[](const size_t index) const noexcept
+    {
+        return View(base_, records_ + index);
+    }
+
+    Iterator begin() const noexcept
+    {
+        return Iterator(base_, records_);
+    }
+
+    Iterator end() const noexcept
+    {
+        return Iterator(base_, records_ + count_);
+    }
+
+private:
+    const SnapshotBase* base_ = nullptr;
+    const Record* records_    = nullptr;
+    size_t count_             = 0;
+};
+
+/// \brief Common accessors of snapshot views
+/// \details Views are a few pointers wide, cheap to copy and valid as long as the Snapshot they
+/// came from is open. Strings are views into the snapshot and NUL-terminated, so they can be wrapped
+/// with runtime::String::Reference() without copying. Compressed strings are decompressed on access
+/// into the text store of the snapshot, Snapshot::GetTextStore(), whose pins and Snapshot::Trim()
+/// govern how long their views stay valid; they are empty if the string is damaged, see
+/// GetEncodedText(), or cannot be decompressed.
+class ViewBase
+{
+protected:
+    ViewBase(const SnapshotBase* base) noexcept : base_(base) {}
+
+    std::string_view Text(const SnapshotString& value) const noexcept
+    {
+        if (((value.length & SNAPSHOT_COMPRESSED_TEXT) != 0) && (base_->text != nullptr)) {
+            if (GetEncodedText(std::string_view(base_->data, base_->size), value).has_value() == false) {
+                return std::string_view("");
+            }
+            const std::string_view text = base_->text->MakeLazy(value.offset, value.length & ~SNAPSHOT_COMPRESSED_TEXT).GetView();
+            return (text.data() != nullptr) ? text : std::string_view("");
+        }
+        return std::string_view(base_->data + value.offset, value.length);
+    }
+
+    const SnapshotHeader& Header() const noexcept
+    {
+        return *reinterpret_cast<const SnapshotHeader*>(base_->data);
+    }
+
+    const SnapshotBase* base_ = nullptr;
+};
+
+/// \brief Snapshot view of the Fabric part of an entity
+class FabricView : public ViewBase
+{
+public:
+    /// \brief Get the unique identifier
+    runtime::Guid GetId() const noexcept
+    {
+        return runtime::Guid{fabric_->idHigh, fabric_->idLow};
+    }
+
+    /// \brief Get the type identifier
+    runtime::Guid GetTypeId() const noexcept
+    {
+        return runtime::Guid{fabric_->typeIdHigh, fabric_->typeIdLow};
+    }
+
+    /// \brief Get the creation date
+    runtime::Timestamp GetCreationDate() const noexcept
+    {
+        return DecodeSnapshotTimestamp(fabric_->creationDate);
+    }
+
+    /// \brief Get the modification date
+    runtime::Timestamp GetModificationDate() const noexcept
+    {
+        return DecodeSnapshotTimestamp(fabric_->modificationDate);
+    }
+
+    /// \brief Get the user comment
+    std::string_view GetComment() const noexcept
+    {
+        return Text(fabric_->comment);
+    }
+
+protected:
+    FabricView(const SnapshotBase* base, const SnapshotFabricRecord* fabric) noexcept : ViewBase(base), fabric_(fabric) {}
+
+    const SnapshotFabricRecord* fabric_ = nullptr;
+};
+
+/// \brief Snapshot view of a Picture
+class PictureView : public ViewBase
+{
+public:
+    PictureView(const SnapshotBase* base, const SnapshotPictureRecord* record) noexcept : ViewBase(base), record_(record) {}
+
+    /// \brief Get the picture URI
+    std::string_view GetUri() const noexcept
+    {
+        return Text(record_->asset.uri);
+    }
+
+    /// \brief Get the author name
+    std::string_view GetAuthor() const noexcept
+    {
+        return Text(record_->asset.author);
+    }
+
+    /// \brief Get the license information
+    std::string_view GetLicense() const noexcept
+    {
+        return Text(record_->asset.license);
+    }
+
+    /// \brief Get the copyright information
+    std::string_view GetCopyright() const noexcept
+    {
+        return Text(record_->asset.copyright);
+    }
+
+    /// \brief Get the picture format
+    PictureType GetType() const noexcept
+    {
+        return static_cast<PictureType>(record_->type);
+    }
+
+    /// \brief Get the width in pixels
+    uint32_t GetWidth() const noexcept
+    {
+        return record_->width;
+    }
+
+    /// \brief Get the height in pixels
+    uint32_t GetHeight() const noexcept
+    {
+        return record_->height;
+    }
+
+private:
+    const SnapshotPictureRecord* record_ = nullptr;
+};
+
+/// \brief Snapshot view of an Enclosure
+class EnclosureView : public ViewBase
+{
+public:
+    EnclosureView(const SnapshotBase* base, const SnapshotEnclosureRecord* record) noexcept : ViewBase(base), record_(record) {}
+
+    /// \brief Get the media URI
+    std::string_view GetUri() const noexcept
+    {
+        return Text(record_->asset.uri);
+    }
+
+    /// \brief Get the author name
+    std::string_view GetAuthor() const noexcept
+    {
+        return Text(record_->asset.author);
+    }
+
+    /// \brief Get the license information
+    std::string_view GetLicense() const noexcept
+    {
+        return Text(record_->asset.license);
+    }
+
+    /// \brief Get the copyright information
+    std::string_view GetCopyright() const noexcept
+    {
+        return Text(record_->asset.copyright);
+    }
+
+    /// \brief Get the enclosure format
+    EnclosureType GetType() const noexcept
+    {
+        return static_cast<EnclosureType>(record_->type);
+    }
+
+    /// \brief Get the MIME type
+    std::string_view GetMimeType() const noexcept
+    {
+        return Text(record_->mimeType);
+    }
+
+    /// \brief Get the file size in bytes
+    uint64_t GetFileSize() const noexcept
+    {
+        return record_->fileSize;
+    }
+
+private:
+    const SnapshotEnclosureRecord* record_ = nullptr;
+};
+
+/// \brief Snapshot view of a ContributorPresence
+class PresenceView
+{
+public:
+    PresenceView(const SnapshotBase*, const SnapshotPresenceRecord* record) noexcept : record_(record) {}
+
+    /// \brief Get the start time
+    runtime::Timespan GetStartTime() const noexcept
+    {
+        return runtime::Timespan::FromNanoseconds(record_->startTime);
+    }
+
+    /// \brief Get the end time
+    runtime::Timespan GetEndTime() const noexcept
+    {
+        return runtime::Timespan::FromNanoseconds(record_->endTime);
+    }
+
+private:
+    const SnapshotPresenceRecord* record_ = nullptr;
+};
+
+/// \brief Snapshot view of a Contributor
+class ContributorView : public FabricView
+{
+public:
+    ContributorView(const SnapshotBase* base, const SnapshotContributorRecord* record) noexcept : FabricView(base, &record->fabric), record_(record) {}
+
+    /// \brief Get the name
+    std::string_view GetName() const noexcept
+    {
+        return Text(record_->name);
+    }
+
+    /// \brief Get the email address
+    std::string_view GetEmail() const noexcept
+    {
+        return Text(record_->email);
+    }
+
+    /// \brief Get the website URL
+    std::string_view GetUrl() const noexcept
+    {
+        return Text(record_->url);
+    }
+
+    /// \brief Get the role description
+    std::string_view GetRole() const noexcept
+    {
+        return Text(record_->role);
+    }
+
+    /// \brief Get the bio
+    std::string_view GetBio() const noexcept
+    {
+        return Text(record_->bio);
+    }
+
+    /// \brief Get the image
+    PictureView GetImage() const noexcept
+    {
+        return PictureView(base_, &record_->image);
+    }
+
+    /// \brief Get the presence information
+    ViewList<PresenceView, SnapshotPresenceRecord> GetPresence() const noexcept
+    {
+        return ViewList<PresenceView, SnapshotPresenceRecord>(base_, record_->presence);
+    }
+
+private:
+    const SnapshotContributorRecord* record_ = nullptr;
+};
+
+/// \brief Snapshot view of a Contribution
+class ContributionView : public ViewBase
+{
+public:
+    ContributionView(const SnapshotBase* base, const SnapshotContributionRecord* record) noexcept : ViewBase(base), record_(record) {}
+
+    /// \brief Check whether the contribution refers to a contributor
+    bool HasContributor() const noexcept
+    {
+        return record_->contributor != SNAPSHOT_NO_INDEX;
+    }
+
+    /// \brief Get the contributor, only valid if HasContributor() is true
+    ContributorView GetContributor() const noexcept
+    {
+        return ViewList<ContributorView, SnapshotContributorRecord>(base_, Header().contributors)[record_->contributor];
+    }
+
+    /// \brief Get the contribution type
+    std::string_view GetType() const noexcept
+    {
+        return Text(record_->type);
+    }
+
+    /// \brief Get the contribution notes
+    std::string_view GetNotes() const noexcept
+    {
+        return Text(record_->notes);
+    }
+
+private:
+    const SnapshotContributionRecord* record_ = nullptr;
+};
+
+/// \brief Snapshot view of a Tag
+class TagView : public FabricView
+{
+public:
+    TagView(const SnapshotBase* base, const SnapshotTagRecord* record) noexcept : FabricView(base, &record->fabric), record_(record) {}
+
+    /// \brief Get the tag name
+    std::string_view GetName() const noexcept
+    {
+        return Text(record_->name);
+    }
+
+    /// \brief Get the tag description
+    std::string_view GetDescription() const noexcept
+    {
+        return Text(record_->description);
+    }
+
+    /// \brief Check whether the tag has a creator
+    bool HasCreator() const noexcept
+    {
+        return record_->creator != SNAPSHOT_NO_INDEX;
+    }
+
+    /// \brief Get the creator, only valid if HasCreator() is true
+    ContributorView GetCreator() const noexcept
+    {
+        return ViewList<ContributorView, SnapshotContributorRecord>(base_, Header().contributors)[record_->creator];
+    }
+
+private:
+    const SnapshotTagRecord* record_ = nullptr;
+};
+
+/// \brief Snapshot view of a TagReference
+class TagReferenceView : public ViewBase
+{
+public:
+    TagReferenceView(const SnapshotBase* base, const SnapshotTagReferenceRecord* record) noexcept : ViewBase(base), record_(record) {}
+
+    /// \brief Check whether the reference refers to a tag
+    bool HasTag() const noexcept
+    {
+        return record_->tag != SNAPSHOT_NO_INDEX;
+    }
+
+    /// \brief Get the tag, only valid if HasTag() is true
+    TagView GetTag() const noexcept
+    {
+        return ViewList<TagView, SnapshotTagRecord>(base_, Header().tags)[record_->tag];
+    }
+
+    /// \brief Get the weight
+    double GetWeight() const noexcept
+    {
+        return record_->weight;
+    }
+
+private:
+    const SnapshotTagReferenceRecord* record_ = nullptr;
+};
+
+/// \brief Snapshot view of a Publisher
+class PublisherView : public FabricView
+{
+public:
+    PublisherView(const SnapshotBase* base, const SnapshotPublisherRecord* record) noexcept : FabricView(base, &record->fabric), record_(record) {}
+
+    /// \brief Get the publisher name
+    std::string_view GetName() const noexcept
+    {
+        return Text(record_->name);
+    }
+
+    /// \brief Get the publisher email
+    std::string_view GetEmail() const noexcept
+    {
+        return Text(record_->email);
+    }
+
+    /// \brief Get the publisher website URL
+    std::string_view GetUrl() const noexcept
+    {
+        return Text(record_->url);
+    }
+
+    /// \brief Get the publisher description
+    std::string_view GetDescription() const noexcept
+    {
+        return Text(record_->description);
+    }
+
+private:
+    const SnapshotPublisherRecord* record_ = nullptr;
+};
+
+/// \brief Snapshot view of an Episode
+class EpisodeView : public FabricView
+{
+public:
+    EpisodeView(const SnapshotBase* base, const SnapshotEpisodeRecord* record) noexcept : FabricView(base, &record->fabric), record_(record) {}
+
+    /// \brief Get the episode number
+    uint32_t GetEpisodeNumber() const noexcept
+    {
+        return record_->episodeNumber;
+    }
+
+    /// \brief Get the episode title
+    std::string_view GetTitle() const noexcept
+    {
+        return Text(record_->title);
+    }
+
+    /// \brief Get the episode subtitle
+    std::string_view GetSubtitle() const noexcept
+    {
+        return Text(record_->subtitle);
+    }
+
+    /// \brief Get the episode description
+    std::string_view GetDescription() const noexcept
+    {
+        return Text(record_->description);
+    }
+
+    /// \brief Get the episode summary
+    std::string_view GetSummary() const noexcept
+    {
+        return Text(record_->summary);
+    }
+
+    /// \brief Get the episode type
+    EpisodeType GetType() const noexcept
+    {
+        return static_cast<EpisodeType>(record_->type);
+    }
+
+    /// \brief Get the publication date
+    runtime::Timestamp GetPublicationDate() const noexcept
+    {
+        return DecodeSnapshotTimestamp(record_->publicationDate);
+    }
+
+    /// \brief Get the duration
+    runtime::Timespan GetDuration() const noexcept
+    {
+        return runtime::Timespan::FromNanoseconds(record_->duration);
+    }
+
+    /// \brief Get the cover art
+    PictureView GetCoverArt() const noexcept
+    {
+        return PictureView(base_, &record_->coverArt);
+    }
+
+    /// \brief Get the media enclosures
+    ViewList<EnclosureView, SnapshotEnclosureRecord> GetEnclosures() const noexcept
+    {
+        return ViewList<EnclosureView, SnapshotEnclosureRecord>(base_, record_->enclosures);
+    }
+
+    /// \brief Get the associated tags
+    ViewList<TagReferenceView, SnapshotTagReferenceRecord> GetTags() const noexcept
+    {
+        return ViewList<TagReferenceView, SnapshotTagReferenceRecord>(base_, record_->tags);
+    }
+
+    /// \brief Get the contributors
+    ViewList<ContributionView, SnapshotContributionRecord> GetContributors() const noexcept
+    {
+        return ViewList<ContributionView, SnapshotContributionRecord>(base_, record_->contributors);
+    }
+
+private:
+    const SnapshotEpisodeRecord* record_ = nullptr;
+};
+
+/// \brief Snapshot view of a Season
+class SeasonView : public FabricView
+{
+public:
+    SeasonView(const SnapshotBase* base, const SnapshotSeasonRecord* record) noexcept : FabricView(base, &record->fabric), record_(record) {}
+
+    /// \brief Get the season number
+    uint32_t GetSeasonNumber() const noexcept
+    {
+        return record_->seasonNumber;
+    }
+
+    /// \brief Get the season title
+    std::string_view GetTitle() const noexcept
+    {
+        return Text(record_->title);
+    }
+
+    /// \brief Get the season description
+    std::string_view GetDescription() const noexcept
+    {
+        return Text(record_->description);
+    }
+
+    /// \brief Get the publication date
+    runtime::Timestamp GetPublicationDate() const noexcept
+    {
+        return DecodeSnapshotTimestamp(record_->publicationDate);
+    }
+
+    /// \brief Get the cover art
+    PictureView GetCoverArt() const noexcept
+    {
+        return PictureView(base_, &record_->coverArt);
+    }
+
+    /// \brief Get the associated tags
+    ViewList<TagReferenceView, SnapshotTagReferenceRecord> GetTags() const noexcept
+    {
+        return ViewList<TagReferenceView, SnapshotTagReferenceRecord>(base_, record_->tags);
+    }
+
+    /// \brief Get the contributors
+    ViewList<ContributionView, SnapshotContributionRecord> GetContributors() const noexcept
+    {
+        return ViewList<ContributionView, SnapshotContributionRecord>(base_, record_->contributors);
+    }
+
+    /// \brief Get the episodes in this season
+    ViewList<EpisodeView, SnapshotEpisodeRecord> GetEpisodes() const noexcept
+    {
+        return ViewList<EpisodeView, SnapshotEpisodeRecord>(base_, record_->episodes);
+    }
+
+private:
+    const SnapshotSeasonRecord* record_ = nullptr;
+};
+
+/// \brief Snapshot view of a Podcast
+class PodcastView : public FabricView
+{
+public:
+    PodcastView(const SnapshotBase* base, const SnapshotPodcastRecord* record) noexcept : FabricView(base, &record->fabric), record_(record) {}
+
+    /// \brief Get the podcast title
+    std::string_view GetTitle() const noexcept
+    {
+        return Text(record_->title);
+    }
+
+    /// \brief Get the podcast subtitle
+    std::string_view GetSubtitle() const noexcept
+    {
+        return Text(record_->subtitle);
+    }
+
+    /// \brief Get the podcast description
+    std::string_view GetDescription() const noexcept
+    {
+        return Text(record_->description);
+    }
+
+    /// \brief Get the podcast summary
+    std::string_view GetSummary() const noexcept
+    {
+        return Text(record_->summary);
+    }
+
+    /// \brief Get the podcast language
+    std::string_view GetLanguage() const noexcept
+    {
+        return Text(record_->language);
+    }
+
+    /// \brief Get the number of categories
+    size_t GetCategoryCount() const noexcept
+    {
+        return record_->categories.count;
+    }
+
+    /// \brief Get a category
+    /// \param index Index of the category, less than GetCategoryCount()
+    std::string_view GetCategory(const size_t index) const noexcept
+    {
+        return Text(reinterpret_cast<const SnapshotString*>(base_->data + record_->categories.offset)[index]);
+    }
+
+    /// \brief Get the publication date
+    runtime::Timestamp GetPublicationDate() const noexcept
+    {
+        return DecodeSnapshotTimestamp(record_->publicationDate);
+    }
+
+    /// \brief Get the last build date
+    runtime::Timestamp GetLastBuildDate() const noexcept
+    {
+        return DecodeSnapshotTimestamp(record_->lastBuildDate);
+    }
+
+    /// \brief Get the managing editor
+    std::string_view GetManagingEditor() const noexcept
+    {
+        return Text(record_->managingEditor);
+    }
+
+    /// \brief Get the webmaster
+    std::string_view GetWebmaster() const noexcept
+    {
+        return Text(record_->webmaster);
+    }
+
+    /// \brief Get the copyright information
+    std::string_view GetCopyright() const noexcept
+    {
+        return Text(record_->copyright);
+    }
+
+    /// \brief Get the website link
+    std::string_view GetLink() const noexcept
+    {
+        return Text(record_->link);
+    }
+
+    /// \brief Get the publisher
+    PublisherView GetPublisher() const noexcept
+    {
+        return PublisherView(base_, &record_->publisher);
+    }
+
+    /// \brief Get the cover art
+    PictureView GetCoverArt() const noexcept
+    {
+        return PictureView(base_, &record_->coverArt);
+    }
+
+    /// \brief Get the associated tags
+    ViewList<TagReferenceView, SnapshotTagReferenceRecord> GetTags() const noexcept
+    {
+        return ViewList<TagReferenceView, SnapshotTagReferenceRecord>(base_, record_->tags);
+    }
+
+    /// \brief Get the contributors
+    ViewList<ContributionView, SnapshotContributionRecord> GetContributors() const noexcept
+    {
+        return ViewList<ContributionView, SnapshotContributionRecord>(base_, record_->contributors);
+    }
+
+    /// \brief Get the seasons
+    ViewList<SeasonView, SnapshotSeasonRecord> GetSeasons() const noexcept
+    {
+        return ViewList<SeasonView, SnapshotSeasonRecord>(base_, record_->seasons);
+    }
+
+private:
+    const SnapshotPodcastRecord* record_ = nullptr;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_SNAPSHOT_VIEW_H_INCL__
@@ -10,6 +10,7 @@
 #pragma pack(push, 8)
 
 #include "modelcontributor.h"
+#include "modelentityhandle.h"
 #include "modelfabric.h"
 #include "runtimestring.h"
 
@@ -24,8 +25,8 @@ struct Tag : public Fabric
     /// \brief Tag description
     runtime::String description;
 
-    /// \brief Tag creator
-    Contributor creator;
+    /// \brief Tag creator, shared through an EntityRegistry<Contributor>
+    EntityHandle<Contributor> creator;
 };
 } // namespace ultralove::p3::model
 
@@ -9,6 +9,7 @@
 
 #pragma pack(push, 8)
 
+#include "modelentityhandle.h"
 #include "modeltag.h"
 
 namespace ultralove::p3::model {
@@ -16,8 +17,8 @@ namespace ultralove::p3::model {
 /// \details Reference to a tag with associated weight
 struct TagReference
 {
-    /// \brief Referenced tag
-    Tag tag;
+    /// \brief Referenced tag, shared through an EntityRegistry<Tag>
+    EntityHandle<Tag> tag;
 
     /// \brief Tag weight/relevance (0.0-1.0)
     double weight;
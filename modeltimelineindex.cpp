@@ -0,0 +1,141 @@
+///
+// \file modeltimelineindex.cpp
+// \brief P3 Model Timeline Index implementation
+// \details Implicit interval tree construction and stabbing queries
+//
+
+#include "modeltimelineindex.h"
+
+#include "modelcontribution.h"
+
+#include <algorithm>
+
+// The tree is laid over the entries sorted by start time: the entry at index i is a node at level k
+// when the lowest k bits of i are set and bit k is clear, its children are i - 2^(k-1) and
+// i + 2^(k-1). Leaves are the even indices. maximumEnd_ holds the largest end of every subtree.
+
+namespace ultralove::p3::model {
+namespace {
+// Subtrees this small are scanned linearly
+constexpr int SCAN_LEVEL = 3;
+} // namespace
+
+TimelineIndex::TimelineIndex(
+    const Episode& episode, const std::vector<EntityHandle<ChapterTag>>& chapters, const std::vector<EntityHandle<TranscriptTag>>& transcripts) :
+    chapters_(chapters), transcripts_(transcripts)
+{
+    for (size_t i = 0; i < chapters_.size(); ++i) {
+        if (chapters_[i] && (chapters_[i]->endTime > chapters_[i]->startTime)) {
+            entries_.push_back(TimelineEntry{chapters_[i]->startTime, chapters_[i]->endTime, TimelineEntryType::CHAPTER, static_cast<uint32_t>(i)});
+        }
+    }
+    for (size_t i = 0; i < transcripts_.size(); ++i) {
+        if (transcripts_[i] && (transcripts_[i]->endTime > transcripts_[i]->startTime)) {
+            entries_.push_back(
+                TimelineEntry{transcripts_[i]->startTime, transcripts_[i]->endTime, TimelineEntryType::TRANSCRIPT, static_cast<uint32_t>(i)});
+        }
+    }
+    for (const Contribution& contribution : episode.contributors) {
+        // A contributor with several roles is present only once
+        if ((contribution.contributor.IsValid() == false) ||
+            (std::find(presence_.begin(), presence_.end(), contribution.contributor) != presence_.end())) {
+            continue;
+        }
+        for (const ContributorPresence& presence : contribution.contributor->presence) {
+            if (presence.endTime > presence.startTime) {
+                entries_.push_back(
+                    TimelineEntry{presence.startTime, presence.endTime, TimelineEntryType::PRESENCE, static_cast<uint32_t>(presence_.size())});
+                presence_.push_back(contribution.contributor);
+            }
+        }
+    }
+
+    std::sort(entries_.begin(), entries_.end(), [](const TimelineEntry& lhs, const TimelineEntry& rhs) {
+        return lhs.startTime < rhs.startTime;
+    });
+
+    const size_t count = entries_.size();
+    if (count == 0) {
+        return;
+    }
+    maximumEnd_.resize(count);
+    size_t lastIndex = 0;
+    int64_t last     = 0;
+    for (size_t i = 0; i < count; i += 2) {
+        lastIndex      = i;
+        last           = entries_[i].endTime.GetNanoseconds();
+        maximumEnd_[i] = last;
+    }
+    int level = 1;
+    for (; (size_t(1) << level) <= count; ++level) {
+        const size_t half  = size_t(1) << (level - 1);
+        const size_t first = (half << 1) - 1;
+        const size_t step  = half << 2;
+        for (size_t i = first; i < count; i += step) {
+            const int64_t left  = maximumEnd_[i - half];
+            const int64_t right = ((i + half) < count) ? maximumEnd_[i + half] : last;
+            maximumEnd_[i]      = std::max({entries_[i].endTime.GetNanoseconds(), left, right});
+        }
+        // Track the rightmost node of this level, its right subtree may be missing
+        lastIndex = (((lastIndex >> level) & 1) != 0) ? (lastIndex - half) : (lastIndex + half);
+        if ((lastIndex < count) && (maximumEnd_[lastIndex] > last)) {
+            last = maximumEnd_[lastIndex];
+        }
+    }
+    level_ = level - 1;
+}
+
+size_t TimelineIndex::Find(const runtime::Timespan& time, std::vector<TimelineEntry>& entries) const
+{
+    return Find(time, time + runtime::Timespan::FromNanoseconds(1), entries);
+}
+
+size_t TimelineIndex::Find(const runtime::Timespan& from, const runtime::Timespan& until, std::vector<TimelineEntry>& entries) const
+{
+    struct Frame
+    {
+        int level;
+        size_t node;
+        bool visited;
+    };
+
+    if (level_ < 0) {
+        return 0;
+    }
+    const int64_t lower = from.GetNanoseconds();
+    const int64_t upper = until.GetNanoseconds();
+    const size_t count  = entries_.size();
+    const size_t size   = entries.size();
+
+    Frame stack[128];
+    size_t depth   = 0;
+    stack[depth++] = Frame{level_, (size_t(1) << level_) - 1, false};
+    while (depth > 0) {
+        const Frame frame = stack[--depth];
+        if (frame.level <= SCAN_LEVEL) {
+            const size_t first = (frame.node >> frame.level) << frame.level;
+            const size_t last  = std::min(first + (size_t(2) << frame.level) - 1, count);
+            for (size_t i = first; (i < last) && (entries_[i].startTime.GetNanoseconds() < upper); ++i) {
+                if (lower < entries_[i].endTime.GetNanoseconds()) {
+                    entries.push_back(entries_[i]);
+                }
+            }
+        }
+        else if (frame.visited == false) {
+            // Visit the left subtree first, it holds the earlier starts
+            const size_t left = frame.node - (size_t(1) << (frame.level - 1));
+            stack[depth++]    = Frame{frame.level, frame.node, true};
+            if ((left >= count) || (maximumEnd_[left] > lower)) {
+                stack[depth++] = Frame{frame.level - 1, left, false};
+            }
+        }
+        else if ((frame.node < count) && (entries_[frame.node].startTime.GetNanoseconds() < upper)) {
+            if (lower < entries_[frame.node].endTime.GetNanoseconds()) {
+                entries.push_back(entries_[frame.node]);
+            }
+            stack[depth++] = Frame{frame.level - 1, frame.node + (size_t(1) << (frame.level - 1)), false};
+        }
+    }
+    return entries.size() - size;
+}
+} // namespace ultralove::p3::model
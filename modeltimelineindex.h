@@ -0,0 +1,131 @@
+///
+// \file modeltimelineindex.h
+// \brief P3 Model Timeline Index
+// \details Interval index over the time-ranged tags of an episode
+//
+
+#ifndef __P3_MODEL_TIMELINE_INDEX_H_INCL__
+#define __P3_MODEL_TIMELINE_INDEX_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelchaptertag.h"
+#include "modelcontributor.h"
+#include "modelcontributorpresence.h"
+#include "modelentityhandle.h"
+#include "modelepisode.h"
+#include "modeltranscripttag.h"
+#include "runtimetimespan.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Kind of a timeline entry
+enum class TimelineEntryType
+{
+    CHAPTER,    ///< ChapterTag
+    TRANSCRIPT, ///< TranscriptTag
+    PRESENCE    ///< ContributorPresence of a contributor of the episode
+};
+
+/// \brief Time range of one tag or presence in a TimelineIndex
+struct TimelineEntry
+{
+    /// \brief Start of the range, inclusive
+    runtime::Timespan startTime;
+
+    /// \brief End of the range, exclusive
+    runtime::Timespan endTime;
+
+    /// \brief Kind of the entry
+    TimelineEntryType type;
+
+    /// \brief Index of the chapter, transcript segment or presence in the index
+    uint32_t item;
+};
+
+/// \brief Immutable interval index over the timeline of an episode
+/// \details Indexes the chapters, the transcript segments and the presence ranges of the
+/// contributors of one episode, and answers which of them are active at a point in time or overlap
+/// a time range in O(log n + k). Ranges are half-open, a range whose end is not after its start is
+/// never active. The index is an implicit interval tree: entries are sorted by start time once
+/// and every entry stores the largest end time of the subtree it roots, so the index is a single
+/// array without node pointers. It is built once, typically right after import; build a new index
+/// when the tags of the episode change. Concurrent queries are fine.
+class TimelineIndex
+{
+public:
+    /// \brief Create an empty index
+    TimelineIndex() = default;
+
+    /// \brief Index the timeline of an episode
+    /// \param episode Episode whose contributors' presence ranges are indexed
+    /// \param chapters Chapters of the episode
+    /// \param transcripts Transcript segments of the episode
+    TimelineIndex(const Episode& episode, const std::vector<EntityHandle<ChapterTag>>& chapters,
+        const std::vector<EntityHandle<TranscriptTag>>& transcripts);
+
+    /// \brief Destroy the index
+    virtual ~TimelineIndex() = default;
+
+    /// \brief Get the number of entries
+    /// \return Number of indexed ranges
+    size_t GetCount() const noexcept
+    {
+        return entries_.size();
+    }
+
+    /// \brief Find the entries active at a point in time
+    /// \param time Point in time
+    /// \param entries Receives the active entries, ordered by start time
+    /// \return Number of entries appended
+    size_t Find(const runtime::Timespan& time, std::vector<TimelineEntry>& entries) const;
+
+    /// \brief Find the entries overlapping a time range
+    /// \param from Start of the range, inclusive
+    /// \param until End of the range, exclusive
+    /// \param entries Receives the overlapping entries, ordered by start time
+    /// \return Number of entries appended
+    size_t Find(const runtime::Timespan& from, const runtime::Timespan& until, std::vector<TimelineEntry>& entries) const;
+
+    /// \brief Get the chapter of a CHAPTER entry
+    /// \param entry Entry returned by Find()
+    /// \return Chapter
+    const EntityHandle<ChapterTag>& GetChapter(const TimelineEntry& entry) const noexcept
+    {
+        return chapters_[entry.item];
+    }
+
+    /// \brief Get the transcript segment of a TRANSCRIPT entry
+    /// \param entry Entry returned by Find()
+    /// \return Transcript segment
+    const EntityHandle<TranscriptTag>& GetTranscript(const TimelineEntry& entry) const noexcept
+    {
+        return transcripts_[entry.item];
+    }
+
+    /// \brief Get the contributor of a PRESENCE entry
+    /// \param entry Entry returned by Find()
+    /// \return Contributor
+    const EntityHandle<Contributor>& GetContributor(const TimelineEntry& entry) const noexcept
+    {
+        return presence_[entry.item];
+    }
+
+private:
+    std::vector<TimelineEntry> entries_;
+    std::vector<int64_t> maximumEnd_;
+    int level_ = -1;
+    std::vector<EntityHandle<ChapterTag>> chapters_;
+    std::vector<EntityHandle<TranscriptTag>> transcripts_;
+    std::vector<EntityHandle<Contributor>> presence_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_TIMELINE_INDEX_H_INCL__
@@ -0,0 +1,31 @@
+///
+// \file modeltranscript.h
+// \brief P3 Model Transcript
+// \details Timed transcript of an episode with its speakers
+//
+
+#ifndef __P3_MODEL_TRANSCRIPT_H_INCL__
+#define __P3_MODEL_TRANSCRIPT_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelcontribution.h"
+#include "modeltranscripttag.h"
+#include <vector>
+
+namespace ultralove::p3::model {
+/// \brief Transcript
+/// \details Segments of an episode transcript and the speakers that appear in it
+struct Transcript
+{
+    /// \brief Segments in document order, each attributed to its speaker through Tag::creator
+    std::vector<TranscriptTag> segments;
+
+    /// \brief Speakers in order of their first segment, with the times they speak as presence
+    std::vector<Contribution> speakers;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_TRANSCRIPT_H_INCL__
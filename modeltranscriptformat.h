@@ -0,0 +1,24 @@
+///
+// \file modeltranscriptformat.h
+// \brief P3 Model Transcript Format
+// \details File formats of episode transcripts
+//
+
+#ifndef __P3_MODEL_TRANSCRIPT_FORMAT_H_INCL__
+#define __P3_MODEL_TRANSCRIPT_FORMAT_H_INCL__
+
+#pragma pack(push, 8)
+
+namespace ultralove::p3::model {
+/// \brief Transcript file formats, see the type attribute of podcast:transcript
+enum class TranscriptFormat
+{
+    WEBVTT, ///< WebVTT, text/vtt
+    SRT,    ///< SubRip, application/x-subrip
+    JSON    ///< Podcasting 2.0 JSON, application/json
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_TRANSCRIPT_FORMAT_H_INCL__
@@ -0,0 +1,514 @@
+///
+// \file modeltranscriptreader.cpp
+// \brief P3 Model Transcript Reader implementation
+// \details Cue scanning, cue text cleanup, JSON segments and speaker attribution
+//
+
+#include "modeltranscriptreader.h"
+
+#include "modelentityhandle.h"
+#include "modelparsing.h"
+#include "runtimeguid.h"
+#include "runtimemappedfile.h"
+
+#include <cstring>
+#include <utility>
+
+namespace ultralove::p3::model {
+namespace {
+using namespace parsing;
+using Token = runtime::JsonToken;
+
+constexpr uint32_t NO_SPEAKER = UINT32_MAX;
+
+enum class SegmentField
+{
+    OTHER,
+    SEGMENTS,
+    SPEAKER,
+    START_TIME,
+    END_TIME,
+    BODY
+};
+
+// A keyword that starts a line and is followed by the end of the line, a space or a tab
+bool StartsWithKeyword(const std::string_view line, const std::string_view keyword) noexcept
+{
+    return line.starts_with(keyword) && ((line.size() == keyword.size()) || (line[keyword.size()] == ' ') || (line[keyword.size()] == '\t'));
+}
+
+std::string_view SkipByteOrderMark(std::string_view document) noexcept
+{
+    if (document.starts_with("\xEF\xBB\xBF")) {
+        document.remove_prefix(3);
+    }
+    return document;
+}
+
+// Splits a document into lines, without their terminators
+class LineScanner
+{
+public:
+    explicit LineScanner(const std::string_view document) noexcept : current_(document.data()), end_(document.data() + document.size()) {}
+
+    bool Next(std::string_view& line) noexcept
+    {
+        if (current_ == end_) {
+            return false;
+        }
+        const char* first = current_;
+        const char* last  = static_cast<const char*>(std::memchr(current_, '\n', static_cast<size_t>(end_ - current_)));
+        if (last == nullptr) {
+            last     = end_;
+            current_ = end_;
+        }
+        else {
+            current_ = last + 1;
+        }
+        if ((last != first) && (last[-1] == '\r')) {
+            --last;
+        }
+        line = std::string_view(first, static_cast<size_t>(last - first));
+        return true;
+    }
+
+private:
+    const char* current_;
+    const char* end_;
+};
+
+bool IsBlank(const std::string_view line) noexcept
+{
+    for (const char c : line) {
+        if ((c != ' ') && (c != '\t')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// "00:01:02.500 --> 00:01:04.000 align:start", cue settings after the end time are ignored
+bool ParseTiming(const std::string_view line, runtime::Timespan& startTime, runtime::Timespan& endTime) noexcept
+{
+    const size_t arrow = line.find("-->");
+    if (arrow == std::string_view::npos) {
+        return false;
+    }
+    std::string_view end = Trim(line.substr(arrow + 3));
+    end                  = end.substr(0, end.find_first_of(" \t"));
+    const auto start     = runtime::Timespan::Parse(Trim(line.substr(0, arrow)));
+    const auto stop      = runtime::Timespan::Parse(end);
+    if ((start.has_value() == false) || (stop.has_value() == false)) {
+        return false;
+    }
+    startTime = *start;
+    endTime   = *stop;
+    return true;
+}
+
+// Decodes the character reference at the start of text, which starts with '&'. Cue text is
+// HTML, so the entities for the no-break space and the direction marks are known as well.
+size_t DecodeReference(const std::string_view text, char* target, size_t& consumed) noexcept
+{
+    const size_t semicolon = text.find(';', 1);
+    if ((semicolon == std::string_view::npos) || (semicolon > runtime::parsing::MAX_REFERENCE_LENGTH + 1)) {
+        return 0;
+    }
+    const std::string_view name = text.substr(1, semicolon - 1);
+    consumed                    = semicolon + 1;
+    if (name == "nbsp") {
+        return runtime::parsing::EncodeUtf8(0xA0, target);
+    }
+    if (name == "lrm") {
+        return runtime::parsing::EncodeUtf8(0x200E, target);
+    }
+    if (name == "rlm") {
+        return runtime::parsing::EncodeUtf8(0x200F, target);
+    }
+    return runtime::parsing::DecodeReference(name, target);
+}
+
+constexpr FieldName<SegmentField> SEGMENT_FIELD_NAMES[] = {{"body", SegmentField::BODY}, {"startTime", SegmentField::START_TIME},
+    {"endTime", SegmentField::END_TIME}, {"speaker", SegmentField::SPEAKER}, {"segments", SegmentField::SEGMENTS}};
+
+constexpr NameTable SEGMENT_FIELDS(SEGMENT_FIELD_NAMES);
+
+SegmentField Classify(const std::string_view key) noexcept
+{
+    return SEGMENT_FIELDS.Find(key, SegmentField::OTHER);
+}
+} // namespace
+
+TranscriptReader::TranscriptReader(runtime::Arena& arena) : arena_(arena) {}
+
+std::optional<TranscriptFormat> TranscriptReader::Detect(const std::string_view document) noexcept
+{
+    const std::string_view text = SkipByteOrderMark(document);
+    if (StartsWithKeyword(text.substr(0, text.find_first_of("\r\n")), "WEBVTT")) {
+        return TranscriptFormat::WEBVTT;
+    }
+    const std::string_view start = Trim(text.substr(0, 256));
+    if (start.starts_with('{')) {
+        return TranscriptFormat::JSON;
+    }
+    if (start.find("-->") != std::string_view::npos) {
+        return TranscriptFormat::SRT;
+    }
+    return std::nullopt;
+}
+
+std::optional<TranscriptFormat> TranscriptReader::FromMimeType(const std::string_view mimeType) noexcept
+{
+    const std::string_view type = Trim(mimeType.substr(0, mimeType.find(';')));
+    if (StartsWithIgnoreCase(type, "text/vtt")) {
+        return TranscriptFormat::WEBVTT;
+    }
+    if (StartsWithIgnoreCase(type, "application/x-subrip") || StartsWithIgnoreCase(type, "application/srt") ||
+        StartsWithIgnoreCase(type, "text/srt")) {
+        return TranscriptFormat::SRT;
+    }
+    if (StartsWithIgnoreCase(type, "application/json")) {
+        return TranscriptFormat::JSON;
+    }
+    return std::nullopt;
+}
+
+bool TranscriptReader::Read(const std::string_view document, Transcript& transcript)
+{
+    const std::optional<TranscriptFormat> format = Detect(document);
+    if (format.has_value() == false) {
+        transcript = Transcript{};
+        return false;
+    }
+    return Read(document, *format, transcript);
+}
+
+bool TranscriptReader::Read(const std::string_view document, const TranscriptFormat format, Transcript& transcript)
+{
+    transcript = Transcript{};
+    speakers_.clear();
+    segmentSpeakers_.clear();
+
+    bool good = false;
+    switch (format) {
+    case TranscriptFormat::WEBVTT:
+        good = ReadCues(document, true, transcript);
+        break;
+    case TranscriptFormat::SRT:
+        good = ReadCues(document, false, transcript);
+        break;
+    case TranscriptFormat::JSON:
+        good = ReadJson(document, transcript);
+        break;
+    }
+    Finish(transcript);
+    return good;
+}
+
+bool TranscriptReader::ReadFile(const char* path, Transcript& transcript)
+{
+    // All strings end up inline or in the arena, so the mapping is released right after reading
+    runtime::MappedFile file;
+    if (file.Open(path) == false) {
+        transcript = Transcript{};
+        return false;
+    }
+    return Read(file.GetView(), transcript);
+}
+
+bool TranscriptReader::ReadFile(const char* path, const TranscriptFormat format, Transcript& transcript)
+{
+    runtime::MappedFile file;
+    if (file.Open(path) == false) {
+        transcript = Transcript{};
+        return false;
+    }
+    return Read(file.GetView(), format, transcript);
+}
+
+bool TranscriptReader::ReadCues(std::string_view document, const bool webvtt, Transcript& transcript)
+{
+    LineScanner lines(SkipByteOrderMark(document));
+    std::string_view line;
+    if (webvtt) {
+        if ((lines.Next(line) == false) || (StartsWithKeyword(line, "WEBVTT") == false)) {
+            return false;
+        }
+        // The header block may carry metadata lines up to the first blank line
+        while (lines.Next(line) && (IsBlank(line) == false)) {
+        }
+    }
+
+    bool more = lines.Next(line);
+    while (more) {
+        if (IsBlank(line)) {
+            more = lines.Next(line);
+            continue;
+        }
+
+        // A block is a cue if its first or second line is a timing line; an SRT counter or a WebVTT
+        // cue identifier may precede it
+        bool cue = false;
+        runtime::Timespan startTime;
+        runtime::Timespan endTime;
+        const bool skipped = webvtt && (StartsWithKeyword(line, "NOTE") || StartsWithKeyword(line, "STYLE") || StartsWithKeyword(line, "REGION"));
+        if (skipped == false) {
+            cue = ParseTiming(line, startTime, endTime);
+            if ((cue == false) && (line.find("-->") == std::string_view::npos)) {
+                more = lines.Next(line);
+                if ((more == false) || IsBlank(line)) {
+                    continue;
+                }
+                cue = ParseTiming(line, startTime, endTime);
+            }
+        }
+
+        // The payload runs from the line after the timing line to the next blank line
+        const char* first = nullptr;
+        const char* last  = nullptr;
+        more              = lines.Next(line);
+        while (more && (IsBlank(line) == false)) {
+            if (first == nullptr) {
+                first = line.data();
+            }
+            last = line.data() + line.size();
+            more = lines.Next(line);
+        }
+        if (cue) {
+            std::string_view speaker;
+            const std::string_view payload = (first != nullptr) ? std::string_view(first, static_cast<size_t>(last - first)) : std::string_view();
+            runtime::String text           = MakeCueText(payload, webvtt, speaker);
+            AddSegment(transcript, startTime, endTime, std::move(text), speaker);
+        }
+    }
+    return true;
+}
+
+bool TranscriptReader::ReadJson(const std::string_view document, Transcript& transcript)
+{
+    runtime::JsonReader reader(document);
+    if (reader.Next() != Token::BEGIN_OBJECT) {
+        return false;
+    }
+    for (;;) {
+        Token token = reader.Next();
+        if (token == Token::END_OBJECT) {
+            break;
+        }
+        if (token != Token::KEY) {
+            return false;
+        }
+        if (Classify(Decode(reader.GetValue())) != SegmentField::SEGMENTS) {
+            if (reader.Skip() == false) {
+                return false;
+            }
+            continue;
+        }
+        token = reader.Next();
+        if (token != Token::BEGIN_ARRAY) {
+            if (SkipValue(reader, token) == false) {
+                return false;
+            }
+            continue;
+        }
+        for (token = reader.Next(); token != Token::END_ARRAY; token = reader.Next()) {
+            if (token == Token::BEGIN_OBJECT) {
+                if (ReadSegment(reader, transcript) == false) {
+                    return false;
+                }
+            }
+            else if (SkipValue(reader, token) == false) {
+                return false;
+            }
+        }
+    }
+    return reader.Next() == Token::END;
+}
+
+bool TranscriptReader::ReadSegment(runtime::JsonReader& reader, Transcript& transcript)
+{
+    runtime::Timespan startTime;
+    runtime::Timespan endTime;
+    runtime::String text;
+    // The speaker is looked up once the segment is complete; unless it is encoded, it is a view
+    // into the document
+    std::string_view speaker;
+    std::string decodedSpeaker;
+    for (;;) {
+        Token token = reader.Next();
+        if (token == Token::END_OBJECT) {
+            break;
+        }
+        if (token != Token::KEY) {
+            return false;
+        }
+        const SegmentField field = Classify(Decode(reader.GetValue()));
+        token                    = reader.Next();
+        switch (field) {
+        case SegmentField::BODY:
+            if (token == Token::STRING) {
+                text = MakeString(reader.GetValue());
+                continue;
+            }
+            break;
+        case SegmentField::SPEAKER:
+            if (token == Token::STRING) {
+                speaker = Trim(Decode(reader.GetValue()));
+                if (reader.GetValue().encoded) {
+                    decodedSpeaker.assign(speaker);
+                    speaker = decodedSpeaker;
+                }
+                continue;
+            }
+            break;
+        case SegmentField::START_TIME:
+        case SegmentField::END_TIME: {
+            runtime::Timespan& time = (field == SegmentField::START_TIME) ? startTime : endTime;
+            if (token == Token::NUMBER) {
+                time = ParseSeconds(reader.GetValue().raw).value_or(runtime::Timespan());
+                continue;
+            }
+            if (token == Token::STRING) {
+                time = runtime::Timespan::Parse(Trim(Decode(reader.GetValue()))).value_or(runtime::Timespan());
+                continue;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        if (SkipValue(reader, token) == false) {
+            return false;
+        }
+    }
+    AddSegment(transcript, startTime, endTime, std::move(text), speaker);
+    return true;
+}
+
+void TranscriptReader::AddSegment(Transcript& transcript, const runtime::Timespan startTime, const runtime::Timespan endTime, runtime::String text,
+    const std::string_view speaker)
+{
+    TranscriptTag& segment = transcript.segments.emplace_back();
+    segment.text           = std::move(text);
+    segment.startTime      = startTime;
+    segment.endTime        = endTime;
+
+    uint32_t index = NO_SPEAKER;
+    if (speaker.empty() == false) {
+        // Transcripts have a handful of speakers, a linear search beats hashing every segment
+        for (uint32_t i = 0; i < speakers_.size(); ++i) {
+            if (speakers_[i].name == speaker) {
+                index = i;
+                break;
+            }
+        }
+        if (index == NO_SPEAKER) {
+            index              = static_cast<uint32_t>(speakers_.size());
+            Contributor& added = speakers_.emplace_back();
+            added.name         = runtime::String(speaker, arena_);
+        }
+
+        std::vector<ContributorPresence>& presence = speakers_[index].presence;
+        if ((presence.empty() == false) && (startTime >= presence.back().startTime) && (startTime <= presence.back().endTime + PRESENCE_GAP)) {
+            if (endTime > presence.back().endTime) {
+                presence.back().endTime = endTime;
+            }
+        }
+        else {
+            presence.push_back(ContributorPresence{startTime, endTime});
+        }
+    }
+    segmentSpeakers_.push_back(index);
+}
+
+void TranscriptReader::Finish(Transcript& transcript)
+{
+    // Contributors are shared read-only, so they are handed out once their presence is complete
+    std::vector<EntityHandle<Contributor>> handles;
+    handles.reserve(speakers_.size());
+    transcript.speakers.reserve(speakers_.size());
+    for (Contributor& speaker : speakers_) {
+        speaker.id = MakeContributorId(speaker.name.GetView(), std::string_view());
+        handles.push_back(EntityHandle<Contributor>::Make(std::move(speaker)));
+        transcript.speakers.push_back(Contribution{handles.back(), runtime::String::Intern("speaker"), runtime::String()});
+    }
+    for (size_t i = 0; i < transcript.segments.size(); ++i) {
+        if (segmentSpeakers_[i] != NO_SPEAKER) {
+            transcript.segments[i].creator = handles[segmentSpeakers_[i]];
+        }
+    }
+    speakers_.clear();
+    segmentSpeakers_.clear();
+}
+
+runtime::String TranscriptReader::MakeCueText(const std::string_view payload, const bool webvtt, std::string_view& speaker)
+{
+    // Most cues are plain text, they are stored as they are, line breaks included
+    const bool markup = payload.find_first_of(webvtt ? "<&\r" : "<\r") != std::string_view::npos;
+    if (markup == false) {
+        return runtime::String(Trim(payload), arena_);
+    }
+
+    // Removing tags and decoding references never grows the text, so it goes straight into its
+    // final place in the arena
+    char* target  = static_cast<char*>(arena_.Allocate(payload.size() + 1, 1));
+    size_t length = 0;
+    for (size_t i = 0; i < payload.size();) {
+        const char c = payload[i];
+        if (c == '\r') {
+            ++i;
+            continue;
+        }
+        if (c == '<') {
+            const size_t close = payload.find('>', i + 1);
+            if (close != std::string_view::npos) {
+                // <v Name> or <v.class Name> names the voice, the first one is the speaker
+                const std::string_view tag = payload.substr(i + 1, close - i - 1);
+                if (speaker.empty() && (tag.size() > 2) && (tag[0] == 'v') && ((tag[1] == ' ') || (tag[1] == '.') || (tag[1] == '\t'))) {
+                    const size_t space = tag.find_first_of(" \t");
+                    if (space != std::string_view::npos) {
+                        speaker = Trim(tag.substr(space + 1));
+                    }
+                }
+                i = close + 1;
+                continue;
+            }
+        }
+        if ((c == '&') && webvtt) {
+            size_t consumed       = 0;
+            const size_t produced = DecodeReference(payload.substr(i), target + length, consumed);
+            if (produced > 0) {
+                length += produced;
+                i += consumed;
+                continue;
+            }
+        }
+        target[length++] = c;
+        ++i;
+    }
+
+    size_t offset = 0;
+    while ((offset < length) && IsSpace(target[offset])) {
+        ++offset;
+    }
+    while ((length > offset) && IsSpace(target[length - 1])) {
+        --length;
+    }
+    target[length]              = '\0';
+    const std::string_view text = std::string_view(target + offset, length - offset);
+    if (text.size() <= runtime::String::INLINE_CAPACITY) {
+        return runtime::String(text);
+    }
+    return runtime::String::Reference(text);
+}
+
+runtime::String TranscriptReader::MakeString(const runtime::JsonValue& value)
+{
+    return parsing::MakeString(value, arena_);
+}
+
+std::string_view TranscriptReader::Decode(const runtime::JsonValue& value)
+{
+    return parsing::Decode(value, decoded_);
+}
+} // namespace ultralove::p3::model
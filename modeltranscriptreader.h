@@ -0,0 +1,118 @@
+///
+// \file modeltranscriptreader.h
+// \brief P3 Model Transcript Reader
+// \details Reads WebVTT, SRT and Podcasting 2.0 JSON transcripts into TranscriptTag segments
+//
+
+#ifndef __P3_MODEL_TRANSCRIPT_READER_H_INCL__
+#define __P3_MODEL_TRANSCRIPT_READER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "modelcontributor.h"
+#include "modeltranscript.h"
+#include "modeltranscriptformat.h"
+#include "runtimearena.h"
+#include "runtimejsonreader.h"
+#include "runtimestring.h"
+#include "runtimetimespan.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ultralove::p3::model {
+// Alias runtime namespace for convenience
+namespace runtime = ultralove::p3::runtime;
+
+/// \brief Transcript reader
+/// \details Fills a Transcript with a single pass over the document, which is typically the view
+/// of a runtime::MappedFile. Every cue of a WebVTT or SRT file and every segment of a Podcasting 2.0
+/// JSON transcript becomes a TranscriptTag with its start time, end time and text. Text is stored
+/// like FeedReader stores it: inline, or in the arena passed to the constructor; cue markup is
+/// removed and escapes are decoded straight into the arena. Line breaks inside a cue are kept.
+///
+/// The speaker of a segment is the voice of a WebVTT <v> span or the "speaker" member of a JSON
+/// segment; SRT has no speakers. Every speaker becomes one Contributor per document, shared by all
+/// its segments through Tag::creator and listed in Transcript::speakers with the contribution type
+/// "speaker". Its identifier is derived from its name like that of a FeedReader person without
+/// href, so a speaker keeps its identifier from read to read and matches the person of the feed.
+/// Its presence holds the times it speaks; segments less than PRESENCE_GAP apart are merged into
+/// one interval. Cues without a valid timing line, NOTE, STYLE and REGION blocks are
+/// skipped. A reader is not thread-safe; use one reader per thread.
+class TranscriptReader
+{
+public:
+    /// \brief Largest pause between two segments of a speaker that still counts as one presence
+    static constexpr runtime::Timespan PRESENCE_GAP = runtime::Timespan::FromSeconds(1);
+
+    /// \brief Create a reader
+    /// \param arena Arena receiving long strings, must outlive everything read
+    explicit TranscriptReader(runtime::Arena& arena);
+
+    /// \brief Destroy the reader
+    virtual ~TranscriptReader() = default;
+
+    TranscriptReader(const TranscriptReader&)            = delete;
+    TranscriptReader& operator=(const TranscriptReader&) = delete;
+
+    /// \brief Detect the format of a transcript from its first characters
+    /// \param document Transcript document
+    /// \return Format, no value if the document looks like none of them
+    static std::optional<TranscriptFormat> Detect(const std::string_view document) noexcept;
+
+    /// \brief Get the format of a transcript from its MIME type
+    /// \param mimeType Type attribute of podcast:transcript, e.g. "text/vtt"
+    /// \return Format, no value for other types such as text/html
+    static std::optional<TranscriptFormat> FromMimeType(const std::string_view mimeType) noexcept;
+
+    /// \brief Read a transcript of a detected format
+    /// \param document Complete transcript document
+    /// \param transcript Transcript to replace
+    /// \return True if the format was detected and the document is well-formed
+    bool Read(const std::string_view document, Transcript& transcript);
+
+    /// \brief Read a transcript
+    /// \param document Complete transcript document
+    /// \param format Format of the document
+    /// \param transcript Transcript to replace
+    /// \return True if the document is well-formed; a WebVTT file needs its header, a JSON
+    /// transcript has to be an object
+    bool Read(const std::string_view document, const TranscriptFormat format, Transcript& transcript);
+
+    /// \brief Read a transcript of a detected format from a file through a read-only memory mapping
+    /// \param path Path of the transcript file
+    /// \param transcript Transcript to replace
+    /// \return True if the file could be mapped, the format was detected and the file is well-formed
+    bool ReadFile(const char* path, Transcript& transcript);
+
+    /// \brief Read a transcript from a file through a read-only memory mapping
+    /// \param path Path of the transcript file
+    /// \param format Format of the file
+    /// \param transcript Transcript to replace
+    /// \return True if the file could be mapped and is well-formed
+    bool ReadFile(const char* path, const TranscriptFormat format, Transcript& transcript);
+
+private:
+    bool ReadCues(std::string_view document, const bool webvtt, Transcript& transcript);
+    bool ReadJson(const std::string_view document, Transcript& transcript);
+    bool ReadSegment(runtime::JsonReader& reader, Transcript& transcript);
+    void AddSegment(Transcript& transcript, const runtime::Timespan startTime, const runtime::Timespan endTime, runtime::String text,
+        const std::string_view speaker);
+    void Finish(Transcript& transcript);
+    runtime::String MakeCueText(const std::string_view payload, const bool webvtt, std::string_view& speaker);
+    runtime::String MakeString(const runtime::JsonValue& value);
+    std::string_view Decode(const runtime::JsonValue& value);
+
+    runtime::Arena& arena_;
+    std::string decoded_;
+    std::vector<Contributor> speakers_;
+    // Index into speakers_ of every segment, UINT32_MAX for segments without a speaker
+    std::vector<uint32_t> segmentSpeakers_;
+};
+} // namespace ultralove::p3::model
+
+#pragma pack(pop)
+
+#endif // __P3_MODEL_TRANSCRIPT_READER_H_INCL__
@@ -0,0 +1,105 @@
+///
+// \file runtimearena.cpp
+// \brief Arena allocator implementation
+// \details Block management for the bump allocator
+//
+
+#include "runtimearena.h"
+
+#include <new>
+
+namespace ultralove::p3::runtime {
+namespace {
+// Block payload starts after the header, rounded up so that every block can serve max_align_t
+constexpr size_t BLOCK_HEADER_SIZE = (sizeof(void*) + sizeof(size_t) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+} // namespace
+
+Arena::Arena(const size_t blockSize) noexcept : blockSize_((blockSize < 256) ? 256 : blockSize) {}
+
+Arena::~Arena()
+{
+    Block* block = head_;
+    while (block != nullptr) {
+        Block* next = block->next;
+        ::operator delete(block);
+        block = next;
+    }
+}
+
+void Arena::Reset() noexcept
+{
+    if (head_ == nullptr) {
+        return;
+    }
+
+    // Keep one block of the regular size for reuse; dedicated blocks of large requests go back to the
+    // system, so one large import does not pin its peak memory for the lifetime of the arena
+    Block* kept  = nullptr;
+    Block* block = head_;
+    while (block != nullptr) {
+        Block* next = block->next;
+        if ((kept == nullptr) && (block->size == blockSize_)) {
+            kept = block;
+        }
+        else {
+            ::operator delete(block);
+        }
+        block = next;
+    }
+
+    bytesUsed_ = 0;
+    if (kept == nullptr) {
+        head_          = nullptr;
+        cursor_        = nullptr;
+        limit_         = nullptr;
+        bytesReserved_ = 0;
+        return;
+    }
+    kept->next     = nullptr;
+    head_          = kept;
+    cursor_        = reinterpret_cast<char*>(kept) + BLOCK_HEADER_SIZE;
+    limit_         = reinterpret_cast<char*>(kept) + kept->size;
+    bytesReserved_ = kept->size;
+}
+
+Arena::Block* Arena::NewBlock(const size_t size)
+{
+    Block* block = static_cast<Block*>(::operator new(size));
+    block->next  = nullptr;
+    block->size  = size;
+    bytesReserved_ += size;
+    return block;
+}
+
+void* Arena::AllocateSlow(const size_t size, const size_t alignment)
+{
+    const size_t required = BLOCK_HEADER_SIZE + size + alignment;
+
+    // Oversized requests get a dedicated block that is linked behind the current one, so the
+    // remaining space of the current block stays available for subsequent small allocations
+    if (required > blockSize_ / 4) {
+        Block* block = NewBlock(required);
+        if (head_ == nullptr) {
+            // There is no current block yet, the next small request starts one in front
+            head_ = block;
+        }
+        else {
+            block->next = head_->next;
+            head_->next = block;
+        }
+
+        const uintptr_t payload = reinterpret_cast<uintptr_t>(block) + BLOCK_HEADER_SIZE;
+        const uintptr_t aligned = (payload + (alignment - 1)) & ~static_cast<uintptr_t>(alignment - 1);
+        bytesUsed_ += size;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    Block* block = NewBlock(blockSize_);
+    block->next  = head_;
+    head_        = block;
+
+    cursor_ = reinterpret_cast<char*>(block) + BLOCK_HEADER_SIZE;
+    limit_  = reinterpret_cast<char*>(block) + block->size;
+    return Allocate(size, alignment);
+}
+} // namespace ultralove::p3::runtime
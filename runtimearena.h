@@ -0,0 +1,108 @@
+///
+// \file runtimearena.h
+// \brief Arena allocator for the P3 Model library
+// \details Bump allocator that serves many small, short-lived allocations from large blocks
+//
+
+#ifndef __P3_RUNTIME_ARENA_H_INCL__
+#define __P3_RUNTIME_ARENA_H_INCL__
+
+#pragma pack(push, 8)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace ultralove::p3::runtime {
+/// \brief Arena (region) allocator
+/// \details Hands out memory by bumping a cursor through large blocks. Individual allocations are
+/// never freed; all memory is released at once by Reset() or when the arena is destroyed. This makes
+/// allocating thousands of strings for a loaded catalog as cheap as a pointer increment.
+/// An arena is not thread-safe; use one arena per thread or per import job.
+class Arena
+{
+public:
+    /// \brief Default size of a block requested from the system
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    /// \brief Create an empty arena
+    /// \param blockSize Size of the blocks requested from the system
+    explicit Arena(const size_t blockSize = DEFAULT_BLOCK_SIZE) noexcept;
+
+    /// \brief Release all blocks owned by the arena
+    virtual ~Arena();
+
+    Arena(const Arena&)            = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /// \brief Allocate uninitialized memory from the arena
+    /// \param size Number of bytes to allocate
+    /// \param alignment Required alignment, must be a power of two
+    /// \return Pointer to the allocated memory, valid until Reset() or destruction
+    void* Allocate(const size_t size, const size_t alignment = alignof(std::max_align_t))
+    {
+        const uintptr_t cursor  = reinterpret_cast<uintptr_t>(cursor_);
+        const uintptr_t aligned = (cursor + (alignment - 1)) & ~static_cast<uintptr_t>(alignment - 1);
+        if ((cursor_ != nullptr) && (aligned + size <= reinterpret_cast<uintptr_t>(limit_))) {
+            cursor_ = reinterpret_cast<char*>(aligned + size);
+            bytesUsed_ += size;
+            return reinterpret_cast<void*>(aligned);
+        }
+        return AllocateSlow(size, alignment);
+    }
+
+    /// \brief Copy a character sequence into the arena and terminate it
+    /// \param value Characters to copy
+    /// \return NUL-terminated copy owned by the arena
+    const char* Copy(const std::string_view value)
+    {
+        char* target = static_cast<char*>(Allocate(value.size() + 1, 1));
+        if (value.empty() == false) {
+            std::memcpy(target, value.data(), value.size());
+        }
+        target[value.size()] = '\0';
+        return target;
+    }
+
+    /// \brief Release all allocations at once
+    /// \details One block of the regular size is kept for reuse, all other blocks, including the
+    /// dedicated blocks of large allocations, are returned to the system
+    void Reset() noexcept;
+
+    /// \brief Get the number of bytes handed out since creation or the last Reset()
+    /// \return Allocated byte count
+    size_t GetBytesUsed() const noexcept
+    {
+        return bytesUsed_;
+    }
+
+    /// \brief Get the number of bytes currently reserved from the system
+    /// \return Reserved byte count including block headers
+    size_t GetBytesReserved() const noexcept
+    {
+        return bytesReserved_;
+    }
+
+private:
+    struct Block
+    {
+        Block* next;
+        size_t size;
+    };
+
+    void* AllocateSlow(const size_t size, const size_t alignment);
+    Block* NewBlock(const size_t size);
+
+    Block* head_          = nullptr;
+    char* cursor_         = nullptr;
+    char* limit_          = nullptr;
+    size_t blockSize_     = DEFAULT_BLOCK_SIZE;
+    size_t bytesUsed_     = 0;
+    size_t bytesReserved_ = 0;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_ARENA_H_INCL__
@@ -0,0 +1,286 @@
+///
+// \file runtimeconcurrentmap.h
+// \brief Concurrent Guid map for the P3 Model library
+// \details Sharded hash map with copy-on-write buckets that readers search without the shard locks
+//
+
+#ifndef __P3_RUNTIME_CONCURRENT_MAP_H_INCL__
+#define __P3_RUNTIME_CONCURRENT_MAP_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "runtimeguid.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ultralove::p3::runtime {
+/// \brief Thread-safe map from Guid to values
+/// \details The keys are spread over a power-of-two number of shards by their hash. Every shard
+/// holds a table of buckets, and every bucket is an immutable array of entries behind an atomic
+/// shared pointer. Readers never take the shard mutex: Find() loads the table and the bucket and
+/// searches the bucket, so lookups run in parallel with each other and never wait while a writer
+/// copies a bucket or grows a table. Writers lock only their shard, copy the one bucket they change
+/// and publish the copy; a shard doubles its table once it holds two entries per bucket. Readers
+/// that still hold an old bucket or table keep it alive.
+///
+/// Lookups are not wait-free, though: std::atomic<std::shared_ptr> is not lock-free on common
+/// standard libraries (libstdc++ guards every such pointer with an internal spin lock while it takes
+/// a reference), so loads of the same table or bucket briefly contend with each other and with the
+/// store that publishes it.
+///
+/// Values are copied out by Find(), so V should be cheap to copy, typically a shared pointer to an
+/// immutable entity; an empty V marks a missing key.
+template<typename V>
+class ConcurrentMap
+{
+public:
+    /// \brief Default number of shards
+    static constexpr size_t DEFAULT_SHARD_COUNT = 64;
+
+    /// \brief Create an empty map
+    /// \param shardCount Number of shards, rounded up to a power of two
+    explicit ConcurrentMap(const size_t shardCount = DEFAULT_SHARD_COUNT) :
+        shardCount_(std::bit_ceil(std::max<size_t>(shardCount, 1))), shards_(new Shard[shardCount_])
+    {
+    }
+
+    /// \brief Destroy the map
+    virtual ~ConcurrentMap() = default;
+
+    ConcurrentMap(const ConcurrentMap&)            = delete;
+    ConcurrentMap& operator=(const ConcurrentMap&) = delete;
+
+    /// \brief Find the value of a key
+    /// \param key Key
+    /// \return Value, empty if the key is not in the map
+    V Find(const Guid& key) const
+    {
+        const size_t hash  = std::hash<Guid>{}(key);
+        const Shard& shard = shards_[hash & (shardCount_ - 1)];
+        const std::shared_ptr<const Table> table = shard.table.load(std::memory_order_acquire);
+        if (table == nullptr) {
+            return V();
+        }
+        const std::shared_ptr<const Bucket> bucket = table->buckets[table->Index(hash, shardCount_)].load(std::memory_order_acquire);
+        if (bucket != nullptr) {
+            for (const Entry& entry : *bucket) {
+                if (entry.key == key) {
+                    return entry.value;
+                }
+            }
+        }
+        return V();
+    }
+
+    /// \brief Insert or replace the value of a key
+    /// \param key Key
+    /// \param value Value
+    /// \return Previous value, empty if the key was not in the map
+    V Put(const Guid& key, V value)
+    {
+        const size_t hash = std::hash<Guid>{}(key);
+        Shard& shard      = shards_[hash & (shardCount_ - 1)];
+        const std::lock_guard<std::mutex> lock(shard.mutex);
+        return Store(shard, hash, key, std::move(value));
+    }
+
+    /// \brief Insert or replace the values of many keys
+    /// \details Every shard is locked once for all of its keys. With duplicate keys the last value wins.
+    /// \param entries Keys and values
+    void Put(std::span<const std::pair<Guid, V>> entries)
+    {
+        std::vector<std::pair<size_t, size_t>> order; // shard, position in entries
+        order.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            order.emplace_back(std::hash<Guid>{}(entries[i].first) & (shardCount_ - 1), i);
+        }
+        std::sort(order.begin(), order.end());
+        for (size_t first = 0; first < order.size();) {
+            Shard& shard = shards_[order[first].first];
+            const std::lock_guard<std::mutex> lock(shard.mutex);
+            size_t i = first;
+            for (; (i < order.size()) && (order[i].first == order[first].first); ++i) {
+                const auto& [key, value] = entries[order[i].second];
+                Store(shard, std::hash<Guid>{}(key), key, value);
+            }
+            first = i;
+        }
+    }
+
+    /// \brief Remove a key
+    /// \param key Key
+    /// \return Removed value, empty if the key was not in the map
+    V Remove(const Guid& key)
+    {
+        return RemoveIf(key, [](const V&) {
+            return true;
+        });
+    }
+
+    /// \brief Remove a key if its current value satisfies a condition
+    /// \details The predicate runs with the shard locked, so no writer can replace the value between
+    /// the check and the removal. It must not call back into the map.
+    /// \param key Key
+    /// \param predicate Called with the current value, returns true to remove it
+    /// \return Removed value, empty if the key was not in the map or the predicate kept it
+    template<typename Predicate>
+    V RemoveIf(const Guid& key, Predicate&& predicate)
+    {
+        const size_t hash = std::hash<Guid>{}(key);
+        Shard& shard      = shards_[hash & (shardCount_ - 1)];
+        const std::lock_guard<std::mutex> lock(shard.mutex);
+        const std::shared_ptr<const Table> table = shard.table.load(std::memory_order_relaxed);
+        if (table == nullptr) {
+            return V();
+        }
+        auto& slot                                 = table->buckets[table->Index(hash, shardCount_)];
+        const std::shared_ptr<const Bucket> bucket = slot.load(std::memory_order_relaxed);
+        if (bucket == nullptr) {
+            return V();
+        }
+        const auto it = std::find_if(bucket->begin(), bucket->end(), [&key](const Entry& entry) {
+            return entry.key == key;
+        });
+        if ((it == bucket->end()) || (predicate(std::as_const(it->value)) == false)) {
+            return V();
+        }
+        V previous = it->value;
+        if (bucket->size() == 1) {
+            slot.store(nullptr, std::memory_order_release);
+        }
+        else {
+            auto copy = std::make_shared<Bucket>();
+            copy->reserve(bucket->size() - 1);
+            std::copy_if(bucket->begin(), bucket->end(), std::back_inserter(*copy), [&key](const Entry& entry) {
+                return entry.key != key;
+            });
+            slot.store(std::move(copy), std::memory_order_release);
+        }
+        shard.count.fetch_sub(1, std::memory_order_relaxed);
+        return previous;
+    }
+
+    /// \brief Get the number of keys
+    /// \return Number of keys, a snapshot while writers are active
+    size_t GetCount() const noexcept
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < shardCount_; ++i) {
+            count += shards_[i].count.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+private:
+    // Smallest table of a shard
+    static constexpr size_t INITIAL_BUCKETS = 8;
+
+    // Entries per bucket on average before a table doubles
+    static constexpr size_t MAXIMUM_LOAD = 2;
+
+    struct Entry
+    {
+        Guid key;
+        V value;
+    };
+
+    using Bucket = std::vector<Entry>;
+
+    struct Table
+    {
+        explicit Table(const size_t count) : buckets(count) {}
+
+        // The low hash bits select the shard, the bucket is taken from the bits above them
+        size_t Index(const size_t hash, const size_t shardCount) const noexcept
+        {
+            return (hash / shardCount) & (buckets.size() - 1);
+        }
+
+        // The slots change in place, the table itself is only replaced when it grows
+        mutable std::vector<std::atomic<std::shared_ptr<const Bucket>>> buckets;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::atomic<std::shared_ptr<const Table>> table;
+        std::atomic<size_t> count{0};
+    };
+
+    // Called with the shard locked
+    V Store(Shard& shard, const size_t hash, const Guid& key, V value)
+    {
+        std::shared_ptr<const Table> table = shard.table.load(std::memory_order_relaxed);
+        if (table == nullptr) {
+            table = std::make_shared<const Table>(INITIAL_BUCKETS);
+            shard.table.store(table, std::memory_order_release);
+        }
+
+        auto& slot                                 = table->buckets[table->Index(hash, shardCount_)];
+        const std::shared_ptr<const Bucket> bucket = slot.load(std::memory_order_relaxed);
+        auto copy                                  = std::make_shared<Bucket>();
+        V previous                                 = V();
+        if (bucket != nullptr) {
+            copy->reserve(bucket->size() + 1);
+            copy->assign(bucket->begin(), bucket->end());
+        }
+        const auto it = std::find_if(copy->begin(), copy->end(), [&key](const Entry& entry) {
+            return entry.key == key;
+        });
+        const bool added = (it == copy->end());
+        if (added) {
+            copy->push_back(Entry{key, std::move(value)});
+        }
+        else {
+            previous = std::exchange(it->value, std::move(value));
+        }
+        slot.store(std::move(copy), std::memory_order_release);
+
+        if (added) {
+            const size_t count = shard.count.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (count > table->buckets.size() * MAXIMUM_LOAD) {
+                Grow(shard, *table);
+            }
+        }
+        return previous;
+    }
+
+    // Called with the shard locked
+    void Grow(Shard& shard, const Table& table)
+    {
+        std::vector<Bucket> buckets(table.buckets.size() * 2);
+        for (const auto& slot : table.buckets) {
+            const std::shared_ptr<const Bucket> bucket = slot.load(std::memory_order_relaxed);
+            if (bucket != nullptr) {
+                for (const Entry& entry : *bucket) {
+                    const size_t hash = std::hash<Guid>{}(entry.key);
+                    buckets[(hash / shardCount_) & (buckets.size() - 1)].push_back(entry);
+                }
+            }
+        }
+        auto grown = std::make_shared<Table>(buckets.size());
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            if (buckets[i].empty() == false) {
+                grown->buckets[i].store(std::make_shared<const Bucket>(std::move(buckets[i])), std::memory_order_relaxed);
+            }
+        }
+        shard.table.store(std::move(grown), std::memory_order_release);
+    }
+
+    size_t shardCount_;
+    std::unique_ptr<Shard[]> shards_;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_CONCURRENT_MAP_H_INCL__
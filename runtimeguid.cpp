@@ -0,0 +1,288 @@
+///
+// \file runtimeguid.cpp
+// \brief GUID utility implementation
+// \details Table-driven parsing, SWAR formatting, SHA-1 based UUIDv5 and lock-free UUIDv7 generation
+//
+
+#include "runtimeguid.h"
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+namespace ultralove::p3::runtime {
+namespace {
+// Positions of the dashes in the canonical text form
+constexpr size_t DASH_POSITIONS[4] = {8, 13, 18, 23};
+
+// Positions of the 32 hex digits in the canonical text form
+constexpr uint8_t DIGIT_POSITIONS[32] = {0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, 16, 17, 19, 20, 21, 22, 24, 25, 26, 27, 28, 29, 30, 31, 32,
+    33, 34, 35};
+
+// Nibble value of every byte, 0x10 marks a byte that is not a hex digit
+constexpr auto HEX_VALUES = [] {
+    struct Table
+    {
+        uint8_t values[256];
+    } table{};
+    for (unsigned i = 0; i < 256; ++i) {
+        table.values[i] = 0x10;
+    }
+    for (unsigned i = 0; i < 10; ++i) {
+        table.values['0' + i] = static_cast<uint8_t>(i);
+    }
+    for (unsigned i = 0; i < 6; ++i) {
+        table.values['a' + i] = static_cast<uint8_t>(10 + i);
+        table.values['A' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return table;
+}();
+
+// Spreads the eight nibbles of value into eight bytes and turns them into lower case hex digits,
+// the most significant nibble ends up in the first byte in memory
+void WriteHex32(char* target, const uint32_t value) noexcept
+{
+    uint64_t lanes = value;
+    lanes          = (lanes | (lanes << 16)) & 0x0000ffff0000ffffull;
+    lanes          = (lanes | (lanes << 8)) & 0x00ff00ff00ff00ffull;
+    lanes          = (lanes | (lanes << 4)) & 0x0f0f0f0f0f0f0f0full;
+
+    // Lanes above 9 overflow into bit 7 when 0x76 is added, those get the offset from '0' to 'a'
+    const uint64_t letters = ((lanes + 0x7676767676767676ull) >> 7) & 0x0101010101010101ull;
+    lanes += 0x3030303030303030ull + letters * ('a' - '0' - 10);
+    if constexpr (std::endian::native == std::endian::little) {
+        lanes = std::byteswap(lanes);
+    }
+    std::memcpy(target, &lanes, sizeof(lanes));
+}
+
+// SHA-1 as specified by FIPS 180-4, only as much of it as name-based identifiers need
+class Sha1
+{
+public:
+    void Update(const void* data, size_t size) noexcept
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        length_ += size;
+        while (size > 0) {
+            const size_t count = ((sizeof(block_) - used_) < size) ? (sizeof(block_) - used_) : size;
+            std::memcpy(block_ + used_, bytes, count);
+            used_ += count;
+            bytes += count;
+            size -= count;
+            if (used_ == sizeof(block_)) {
+                Compress();
+                used_ = 0;
+            }
+        }
+    }
+
+    // Pads the message and returns the first 16 bytes of the digest
+    void Finish(uint8_t (&digest)[16]) noexcept
+    {
+        const uint64_t bits = length_ * 8;
+        block_[used_++]     = 0x80;
+        if (used_ > sizeof(block_) - 8) {
+            std::memset(block_ + used_, 0, sizeof(block_) - used_);
+            Compress();
+            used_ = 0;
+        }
+        std::memset(block_ + used_, 0, sizeof(block_) - 8 - used_);
+        for (size_t i = 0; i < 8; ++i) {
+            block_[sizeof(block_) - 1 - i] = static_cast<uint8_t>(bits >> (i * 8));
+        }
+        Compress();
+        for (size_t i = 0; i < 16; ++i) {
+            digest[i] = static_cast<uint8_t>(state_[i / 4] >> (24 - (i % 4) * 8));
+        }
+    }
+
+private:
+    void Compress() noexcept
+    {
+        uint32_t words[80];
+        for (size_t i = 0; i < 16; ++i) {
+            words[i] = (static_cast<uint32_t>(block_[i * 4]) << 24) | (static_cast<uint32_t>(block_[i * 4 + 1]) << 16) |
+                       (static_cast<uint32_t>(block_[i * 4 + 2]) << 8) | block_[i * 4 + 3];
+        }
+        for (size_t i = 16; i < 80; ++i) {
+            words[i] = std::rotl(words[i - 3] ^ words[i - 8] ^ words[i - 14] ^ words[i - 16], 1);
+        }
+        uint32_t a = state_[0];
+        uint32_t b = state_[1];
+        uint32_t c = state_[2];
+        uint32_t d = state_[3];
+        uint32_t e = state_[4];
+        for (size_t i = 0; i < 80; ++i) {
+            uint32_t f = 0;
+            uint32_t k = 0;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5a827999;
+            }
+            else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ed9eba1;
+            }
+            else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8f1bbcdc;
+            }
+            else {
+                f = b ^ c ^ d;
+                k = 0xca62c1d6;
+            }
+            const uint32_t next = std::rotl(a, 5) + f + e + k + words[i];
+            e                   = d;
+            d                   = c;
+            c                   = std::rotl(b, 30);
+            b                   = a;
+            a                   = next;
+        }
+        state_[0] += a;
+        state_[1] += b;
+        state_[2] += c;
+        state_[3] += d;
+        state_[4] += e;
+    }
+
+    uint32_t state_[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+    uint8_t block_[64] = {};
+    size_t used_       = 0;
+    uint64_t length_   = 0;
+};
+
+// Small and fast generator for the random bits; one instance per thread, so no synchronization
+struct SplitMix64
+{
+    uint64_t state;
+
+    uint64_t Next() noexcept
+    {
+        uint64_t value = (state += 0x9e3779b97f4a7c15ull);
+        value          = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value          = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+};
+
+SplitMix64& ThreadGenerator() noexcept
+{
+    thread_local SplitMix64 generator = [] {
+        // The clock and a per-thread address keep threads apart even without an entropy source
+        uint64_t seed = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        seed ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&seed)) << 16;
+        try {
+            std::random_device device;
+            seed ^= (static_cast<uint64_t>(device()) << 32) | device();
+        }
+        catch (...) {
+        }
+        return SplitMix64{seed};
+    }();
+    return generator;
+}
+
+// Last issued 60-bit ordering key: 48-bit Unix milliseconds followed by a 12-bit counter
+std::atomic<uint64_t> g_lastKey{0};
+} // namespace
+
+Guid Guid::NewV7() noexcept
+{
+    SplitMix64& generator = ThreadGenerator();
+    const uint64_t random = generator.Next();
+    const uint64_t now    = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+    // A new millisecond starts the counter at a random value in its lower half, which leaves at least
+    // 2048 identifiers before the counter carries into the timestamp (RFC 9562 section 6.2, method 1)
+    const uint64_t fresh = ((now & 0xffffffffffffull) << 12) | (random >> 53);
+    uint64_t last        = g_lastKey.load(std::memory_order_relaxed);
+    uint64_t next        = 0;
+    do {
+        next = (fresh > last) ? fresh : last + 1;
+    } while (g_lastKey.compare_exchange_weak(last, next, std::memory_order_relaxed) == false);
+
+    const uint64_t high = ((next >> 12) << 16) | 0x7000 | (next & 0xfff);
+    const uint64_t low  = (generator.Next() & 0x3fffffffffffffffull) | 0x8000000000000000ull;
+    return Guid{high, low};
+}
+
+Guid Guid::FromName(const Guid& namespaceId, const std::string_view name) noexcept
+{
+    // The name space goes first, in network byte order
+    uint8_t bytes[16];
+    for (size_t i = 0; i < 8; ++i) {
+        bytes[i]     = static_cast<uint8_t>(namespaceId.high >> (56 - i * 8));
+        bytes[i + 8] = static_cast<uint8_t>(namespaceId.low >> (56 - i * 8));
+    }
+    Sha1 sha1;
+    sha1.Update(bytes, sizeof(bytes));
+    sha1.Update(name.data(), name.size());
+    sha1.Finish(bytes);
+
+    uint64_t high = 0;
+    uint64_t low  = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        high = (high << 8) | bytes[i];
+        low  = (low << 8) | bytes[i + 8];
+    }
+    high = (high & 0xffffffffffff0fffull) | 0x5000;
+    low  = (low & 0x3fffffffffffffffull) | 0x8000000000000000ull;
+    return Guid{high, low};
+}
+
+std::optional<Guid> Guid::Parse(const std::string_view text) noexcept
+{
+    const char* p = text.data();
+    if ((text.size() == TEXT_LENGTH + 2) && (text.front() == '{') && (text.back() == '}')) {
+        ++p;
+    }
+    else if (text.size() != TEXT_LENGTH) {
+        return std::nullopt;
+    }
+
+    if ((p[DASH_POSITIONS[0]] != '-') || (p[DASH_POSITIONS[1]] != '-') || (p[DASH_POSITIONS[2]] != '-') || (p[DASH_POSITIONS[3]] != '-')) {
+        return std::nullopt;
+    }
+
+    // All digits are decoded unconditionally; the error bit is collected once at the end
+    uint64_t halves[2] = {0, 0};
+    unsigned invalid   = 0;
+    for (size_t half = 0; half < 2; ++half) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < 16; ++i) {
+            const uint8_t nibble = HEX_VALUES.values[static_cast<uint8_t>(p[DIGIT_POSITIONS[half * 16 + i]])];
+            invalid |= nibble;
+            value = (value << 4) | (nibble & 0x0f);
+        }
+        halves[half] = value;
+    }
+    if ((invalid & 0x10) != 0) {
+        return std::nullopt;
+    }
+    return Guid{halves[0], halves[1]};
+}
+
+size_t Guid::Format(char* buffer, const size_t size) const noexcept
+{
+    if ((buffer == nullptr) || (size < TEXT_LENGTH)) {
+        return 0;
+    }
+
+    // Groups 2 and 3 as well as 4 and 5 are written as eight digits each and then split by moving
+    // the second half one position to the right
+    WriteHex32(buffer, static_cast<uint32_t>(high >> 32));
+    WriteHex32(buffer + 9, static_cast<uint32_t>(high));
+    std::memmove(buffer + 14, buffer + 13, 4);
+    WriteHex32(buffer + 19, static_cast<uint32_t>(low >> 32));
+    std::memmove(buffer + 24, buffer + 23, 4);
+    WriteHex32(buffer + 28, static_cast<uint32_t>(low));
+    for (const size_t position : DASH_POSITIONS) {
+        buffer[position] = '-';
+    }
+    return TEXT_LENGTH;
+}
+} // namespace ultralove::p3::runtime
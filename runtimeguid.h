@@ -1,7 +1,7 @@
 ///
 // \file runtimeguid.h
 // \brief GUID utility struct for the P3 Model library
-// \details Placeholder GUID struct for future implementation in podcast domain
+// \details 128-bit identifier with fast parsing, formatting, hashing, UUIDv5 and UUIDv7 generation
 //
 
 #ifndef __P3_RUNTIME_GUID_H_INCL__
@@ -9,21 +9,100 @@
 
 #pragma pack(push, 8)
 
+#include <compare>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
 
 namespace ultralove::p3::runtime {
 /// \brief Globally unique identifier struct for the P3 Model library
-/// \details Placeholder GUID struct for future implementation
-/// This will provide unique identification for podcast episodes, series, hosts, etc.
+/// \details 128-bit UUID as defined by RFC 9562, stored as two 64-bit halves in the order of the
+/// canonical text form: high holds the first 16 hex digits, low the last 16. Ordering compares high
+/// first, so identifiers created by NewV7() sort by creation time.
 struct Guid
 {
-    // Data members will be added in future implementation
-    // Planned: 128-bit UUID storage compliant with RFC 4122
+    /// \brief Length of the canonical text form "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"
+    static constexpr size_t TEXT_LENGTH = 36;
+
+    /// \brief Most significant 64 bits
     uint64_t high;
+
+    /// \brief Least significant 64 bits
     uint64_t low;
+
+    /// \brief Create a new time-ordered identifier (UUID version 7)
+    /// \details Thread-safe and lock-free. Identifiers created in one process are strictly
+    /// increasing, also across threads and within the same millisecond.
+    /// \return New identifier
+    static Guid NewV7() noexcept;
+
+    /// \brief Name space of URLs, RFC 9562 section 6.6
+    static const Guid NAMESPACE_URL;
+
+    /// \brief Create a name-based identifier (UUID version 5)
+    /// \details SHA-1 of the name space and the name as RFC 9562 section 5.5 specifies, so the same
+    /// name in the same name space gives the same identifier in every process and on every machine
+    /// \param namespaceId Name space, e.g. NAMESPACE_URL
+    /// \param name Name, e.g. a URL
+    /// \return Name-based identifier
+    static Guid FromName(const Guid& namespaceId, const std::string_view name) noexcept;
+
+    /// \brief Parse the canonical text form
+    /// \details Accepts upper and lower case hex digits, optionally enclosed in braces
+    /// \param text Text to parse, e.g. "0192f7a4-9c1e-7d2b-8a3f-5e6d7c8b9a01"
+    /// \return Parsed identifier, or no value if the text is malformed
+    static std::optional<Guid> Parse(const std::string_view text) noexcept;
+
+    /// \brief Format in the canonical lower case text form
+    /// \param buffer Target buffer, not terminated
+    /// \param size Size of the target buffer, at least TEXT_LENGTH
+    /// \return Number of characters written, 0 if the buffer is too small
+    size_t Format(char* buffer, const size_t size) const noexcept;
+
+    /// \brief Check whether this is the nil identifier
+    /// \return True if all bits are zero
+    constexpr bool IsNil() const noexcept
+    {
+        return (high | low) == 0;
+    }
+
+    /// \brief Get the UUID version
+    /// \return Version number from the version field, e.g. 4 or 7
+    constexpr unsigned GetVersion() const noexcept
+    {
+        return static_cast<unsigned>((high >> 12) & 0xf);
+    }
+
+    /// \brief Compare two identifiers for equality
+    friend constexpr bool operator==(const Guid&, const Guid&) = default;
+
+    /// \brief Order two identifiers by their 128-bit value
+    friend constexpr std::strong_ordering operator<=>(const Guid&, const Guid&) = default;
 };
+
+inline constexpr Guid Guid::NAMESPACE_URL{0x6ba7b8119dad11d1ull, 0x80b400c04fd430c8ull};
 } // namespace ultralove::p3::runtime
 
+/// \brief Hash support so runtime::Guid can be used as a key in unordered containers
+/// \details Mixes all 128 bits with the MurmurHash3 finalizer. Time-ordered identifiers share most
+/// of their high bits, so the halves must not simply be folded together.
+template<>
+struct std::hash<ultralove::p3::runtime::Guid>
+{
+    size_t operator()(const ultralove::p3::runtime::Guid& value) const noexcept
+    {
+        uint64_t hash = value.high ^ (value.low * 0x9e3779b97f4a7c15ull);
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ull;
+        hash ^= hash >> 33;
+        return static_cast<size_t>(hash);
+    }
+};
+
 #pragma pack(pop)
 
 #endif // __P3_RUNTIME_GUID_H_INCL__
@@ -0,0 +1,164 @@
+///
+// \file runtimehasher.cpp
+// \brief Content hashing implementation
+// \details Streaming MurmurHash3 x64 128
+//
+
+#include "runtimehasher.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace ultralove::p3::runtime {
+namespace {
+constexpr uint64_t C1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t C2 = 0x4cf5ad432745937fULL;
+
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+uint64_t Load64(const uint8_t* data) noexcept
+{
+    uint64_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    if constexpr (std::endian::native == std::endian::big) {
+        value = std::byteswap(value);
+    }
+    return value;
+}
+
+constexpr uint64_t Mix64(uint64_t value) noexcept
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+void WriteHex64(char* buffer, const uint64_t value) noexcept
+{
+    for (int i = 0; i < 16; ++i) {
+        buffer[i] = HEX_DIGITS[(value >> (60 - (i * 4))) & 0xf];
+    }
+}
+} // namespace
+
+size_t Hash128::Format(char* buffer, const size_t size) const noexcept
+{
+    if ((buffer == nullptr) || (size < TEXT_LENGTH)) {
+        return 0;
+    }
+    WriteHex64(buffer, high);
+    WriteHex64(buffer + 16, low);
+    return TEXT_LENGTH;
+}
+
+void Hasher::Block(const uint8_t* block) noexcept
+{
+    uint64_t k1 = Load64(block);
+    uint64_t k2 = Load64(block + 8);
+
+    k1 *= C1;
+    k1 = std::rotl(k1, 31);
+    k1 *= C2;
+    h1_ ^= k1;
+    h1_ = std::rotl(h1_, 27);
+    h1_ += h2_;
+    h1_ = h1_ * 5 + 0x52dce729;
+
+    k2 *= C2;
+    k2 = std::rotl(k2, 33);
+    k2 *= C1;
+    h2_ ^= k2;
+    h2_ = std::rotl(h2_, 31);
+    h2_ += h1_;
+    h2_ = h2_ * 5 + 0x38495ab5;
+}
+
+void Hasher::Update(const void* data, const size_t size) noexcept
+{
+    if (size == 0) {
+        return;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t remaining     = size;
+    length_ += size;
+
+    // Complete a partial block left over from the previous call first
+    if (tailSize_ > 0) {
+        const size_t count = std::min(sizeof(tail_) - tailSize_, remaining);
+        std::memcpy(tail_ + tailSize_, bytes, count);
+        tailSize_ += count;
+        bytes += count;
+        remaining -= count;
+        if (tailSize_ < sizeof(tail_)) {
+            return;
+        }
+        Block(tail_);
+        tailSize_ = 0;
+    }
+    for (; remaining >= sizeof(tail_); bytes += sizeof(tail_), remaining -= sizeof(tail_)) {
+        Block(bytes);
+    }
+    if (remaining > 0) {
+        std::memcpy(tail_, bytes, remaining);
+        tailSize_ = remaining;
+    }
+}
+
+void Hasher::Update(const uint64_t value) noexcept
+{
+    uint8_t bytes[8];
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        bytes[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+    Update(bytes, sizeof(bytes));
+}
+
+void Hasher::Update(const std::string_view value) noexcept
+{
+    Update(static_cast<uint64_t>(value.size()));
+    Update(value.data(), value.size());
+}
+
+void Hasher::Update(const Hash128& value) noexcept
+{
+    Update(value.high);
+    Update(value.low);
+}
+
+Hash128 Hasher::Finish() const noexcept
+{
+    uint64_t h1 = h1_;
+    uint64_t h2 = h2_;
+
+    if (tailSize_ > 0) {
+        uint8_t block[16] = {};
+        std::memcpy(block, tail_, tailSize_);
+        uint64_t k1 = Load64(block);
+        uint64_t k2 = Load64(block + 8);
+        if (tailSize_ > 8) {
+            k2 *= C2;
+            k2 = std::rotl(k2, 33);
+            k2 *= C1;
+            h2 ^= k2;
+        }
+        k1 *= C1;
+        k1 = std::rotl(k1, 31);
+        k1 *= C2;
+        h1 ^= k1;
+    }
+
+    h1 ^= length_;
+    h2 ^= length_;
+    h1 += h2;
+    h2 += h1;
+    h1 = Mix64(h1);
+    h2 = Mix64(h2);
+    h1 += h2;
+    h2 += h1;
+    return Hash128{h1, h2};
+}
+} // namespace ultralove::p3::runtime
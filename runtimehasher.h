@@ -0,0 +1,90 @@
+///
+// \file runtimehasher.h
+// \brief Content hashing for the P3 Model library
+// \details Stable streaming 128-bit hash for fingerprints and change detection
+//
+
+#ifndef __P3_RUNTIME_HASHER_H_INCL__
+#define __P3_RUNTIME_HASHER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace ultralove::p3::runtime {
+/// \brief 128-bit content hash
+struct Hash128
+{
+    /// \brief Length of the hex text form
+    static constexpr size_t TEXT_LENGTH = 32;
+
+    /// \brief Most significant 64 bits
+    uint64_t high;
+
+    /// \brief Least significant 64 bits
+    uint64_t low;
+
+    /// \brief Format as 32 lower case hex digits, e.g. for an ETag
+    /// \param buffer Target buffer, not terminated
+    /// \param size Size of the target buffer, at least TEXT_LENGTH
+    /// \return Number of characters written, 0 if the buffer is too small
+    size_t Format(char* buffer, const size_t size) const noexcept;
+
+    /// \brief Compare two hashes for equality
+    friend constexpr bool operator==(const Hash128&, const Hash128&) = default;
+
+    /// \brief Order two hashes by their 128-bit value
+    friend constexpr std::strong_ordering operator<=>(const Hash128&, const Hash128&) = default;
+};
+
+/// \brief Streaming 128-bit hasher
+/// \details MurmurHash3 x64 128 over the bytes passed to Update(). Integers are hashed in little
+/// endian byte order and strings are prefixed with their length, so hashes are the same on every
+/// platform and different field sequences do not collide by concatenation. Not suitable against
+/// adversarial collisions.
+class Hasher
+{
+public:
+    /// \brief Create a hasher
+    /// \param seed Seed, hashes with different seeds are unrelated
+    explicit Hasher(const uint64_t seed = 0) noexcept : h1_(seed), h2_(seed) {}
+
+    /// \brief Hash raw bytes
+    /// \param data Bytes
+    /// \param size Number of bytes
+    void Update(const void* data, const size_t size) noexcept;
+
+    /// \brief Hash an integer
+    /// \param value Value
+    void Update(const uint64_t value) noexcept;
+
+    /// \brief Hash a string together with its length
+    /// \param value String
+    void Update(const std::string_view value) noexcept;
+
+    /// \brief Hash another hash, e.g. of a child entity
+    /// \param value Hash
+    void Update(const Hash128& value) noexcept;
+
+    /// \brief Get the hash of everything passed so far
+    /// \details The hasher can be updated further afterwards
+    /// \return Hash
+    Hash128 Finish() const noexcept;
+
+private:
+    void Block(const uint8_t* block) noexcept;
+
+    uint64_t h1_;
+    uint64_t h2_;
+    uint64_t length_ = 0;
+    uint8_t tail_[16];
+    size_t tailSize_ = 0;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_HASHER_H_INCL__
@@ -0,0 +1,344 @@
+///
+// \file runtimejsonreader.cpp
+// \brief Streaming JSON reader implementation
+// \details Tokenizer, bracket-matching skip and escape decoding
+//
+
+#include "runtimejsonreader.h"
+#include "runtimeparsing.h"
+
+#include <cstring>
+
+namespace ultralove::p3::runtime {
+namespace {
+// Bytes Skip() has to look at, everything else is passed over
+constexpr auto STRUCTURAL = [] {
+    struct Table
+    {
+        bool structural[256];
+    } table{};
+    for (const char c : std::string_view("\"{}[]")) {
+        table.structural[static_cast<uint8_t>(c)] = true;
+    }
+    return table;
+}();
+
+// Bytes that can continue a number
+constexpr auto NUMBER_CHARACTERS = [] {
+    struct Table
+    {
+        bool number[256];
+    } table{};
+    for (const char c : std::string_view("0123456789+-.eE")) {
+        table.number[static_cast<uint8_t>(c)] = true;
+    }
+    return table;
+}();
+
+// Parses the four hex digits of a \u escape starting at offset, returns false if there are none
+bool ParseHex4(const std::string_view raw, const size_t offset, uint32_t& value) noexcept
+{
+    if (raw.size() - offset < 4) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = offset; i < offset + 4; ++i) {
+        const char c = raw[i];
+        uint32_t digit;
+        if ((c >= '0') && (c <= '9')) {
+            digit = static_cast<uint32_t>(c - '0');
+        }
+        else if (((c | 0x20) >= 'a') && ((c | 0x20) <= 'f')) {
+            digit = static_cast<uint32_t>((c | 0x20) - 'a' + 10);
+        }
+        else {
+            return false;
+        }
+        value = (value << 4) | digit;
+    }
+    return true;
+}
+
+using parsing::EncodeUtf8;
+using parsing::IsSpace;
+using parsing::StartsWith;
+} // namespace
+
+JsonReader::JsonReader(const std::string_view document) noexcept :
+    begin_(document.data()), current_(document.data()), end_(document.data() + document.size())
+{
+}
+
+JsonToken JsonReader::Next() noexcept
+{
+    if (failed_) {
+        return JsonToken::INVALID;
+    }
+    SkipSpace();
+    if (afterValue_) {
+        if (depth_ == 0) {
+            // Only whitespace may follow the root value
+            if (current_ != end_) {
+                return Fail();
+            }
+            tokenDepth_ = 0;
+            return token_ = JsonToken::END;
+        }
+        if (current_ == end_) {
+            return Fail();
+        }
+        const char c = *current_;
+        if ((c == '}') || (c == ']')) {
+            return Close(c);
+        }
+        if (c != ',') {
+            return Fail();
+        }
+        ++current_;
+        SkipSpace();
+        afterValue_ = false;
+        expectKey_  = objects_[depth_ - 1];
+    }
+    if (current_ == end_) {
+        return Fail();
+    }
+
+    const char c      = *current_;
+    const bool opened = opened_;
+    opened_           = false;
+    tokenDepth_       = depth_;
+    if (expectKey_) {
+        if ((c == '}') && opened) {
+            return Close(c);
+        }
+        if ((c != '"') || (ParseString() == false)) {
+            return Fail();
+        }
+        SkipSpace();
+        if ((current_ == end_) || (*current_ != ':')) {
+            return Fail();
+        }
+        ++current_;
+        expectKey_ = false;
+        return token_ = JsonToken::KEY;
+    }
+    if ((c == ']') && opened) {
+        return Close(c);
+    }
+
+    switch (c) {
+    case '{':
+        return Open(true);
+    case '[':
+        return Open(false);
+    case '"':
+        if (ParseString() == false) {
+            return Fail();
+        }
+        afterValue_ = true;
+        return token_ = JsonToken::STRING;
+    case 't':
+    case 'f':
+        boolean_ = (c == 't');
+        if (StartsWith(current_, end_, boolean_ ? "true" : "false") == false) {
+            return Fail();
+        }
+        current_ += boolean_ ? 4 : 5;
+        afterValue_ = true;
+        return token_ = JsonToken::BOOLEAN;
+    case 'n':
+        if (StartsWith(current_, end_, "null") == false) {
+            return Fail();
+        }
+        current_ += 4;
+        afterValue_ = true;
+        return token_ = JsonToken::NULL_VALUE;
+    default:
+        if ((c != '-') && ((c < '0') || (c > '9'))) {
+            return Fail();
+        }
+        const char* start = current_;
+        while ((current_ != end_) && NUMBER_CHARACTERS.number[static_cast<uint8_t>(*current_)]) {
+            ++current_;
+        }
+        value_      = JsonValue{std::string_view(start, static_cast<size_t>(current_ - start)), false};
+        afterValue_ = true;
+        return token_ = JsonToken::NUMBER;
+    }
+}
+
+bool JsonReader::Skip() noexcept
+{
+    if (failed_) {
+        return false;
+    }
+    if (token_ == JsonToken::KEY) {
+        const JsonToken value = Next();
+        if ((value == JsonToken::END) || (value == JsonToken::INVALID)) {
+            return false;
+        }
+        return Skip();
+    }
+    if ((token_ != JsonToken::BEGIN_OBJECT) && (token_ != JsonToken::BEGIN_ARRAY)) {
+        return true;
+    }
+
+    // Only quotes and brackets matter; strings are passed over as a whole so that brackets in them
+    // do not count
+    size_t level = 1;
+    while (current_ != end_) {
+        const char c = *current_;
+        if (STRUCTURAL.structural[static_cast<uint8_t>(c)] == false) {
+            ++current_;
+            continue;
+        }
+        if (c == '"') {
+            if (ParseString() == false) {
+                return false;
+            }
+            continue;
+        }
+        if ((c == '{') || (c == '[')) {
+            ++level;
+        }
+        else if (--level == 0) {
+            return Close(c) != JsonToken::INVALID;
+        }
+        ++current_;
+    }
+    Fail();
+    return false;
+}
+
+size_t JsonReader::Decode(const std::string_view raw, char* target) noexcept
+{
+    size_t length = 0;
+    for (size_t i = 0; i < raw.size(); ++i) {
+        const char c = raw[i];
+        if ((c != '\\') || (i + 1 == raw.size())) {
+            target[length++] = c;
+            continue;
+        }
+        const char escape = raw[i + 1];
+        char decoded      = 0;
+        switch (escape) {
+        case '"':
+        case '\\':
+        case '/':
+            decoded = escape;
+            break;
+        case 'b':
+            decoded = '\b';
+            break;
+        case 'f':
+            decoded = '\f';
+            break;
+        case 'n':
+            decoded = '\n';
+            break;
+        case 'r':
+            decoded = '\r';
+            break;
+        case 't':
+            decoded = '\t';
+            break;
+        case 'u': {
+            uint32_t codePoint = 0;
+            if (ParseHex4(raw, i + 2, codePoint) == false) {
+                target[length++] = c;
+                continue;
+            }
+            i += 5;
+            if ((codePoint >= 0xd800) && (codePoint <= 0xdbff)) {
+                uint32_t low = 0;
+                if ((i + 2 < raw.size()) && (raw[i + 1] == '\\') && (raw[i + 2] == 'u') && ParseHex4(raw, i + 3, low) && (low >= 0xdc00) &&
+                    (low <= 0xdfff)) {
+                    codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+                    i += 6;
+                }
+                else {
+                    codePoint = 0xfffd;
+                }
+            }
+            else if ((codePoint >= 0xdc00) && (codePoint <= 0xdfff)) {
+                codePoint = 0xfffd;
+            }
+            length += EncodeUtf8(codePoint, target + length);
+            continue;
+        }
+        default:
+            target[length++] = c;
+            continue;
+        }
+        target[length++] = decoded;
+        ++i;
+    }
+    return length;
+}
+
+JsonToken JsonReader::Open(const bool object) noexcept
+{
+    if (depth_ == MAX_DEPTH) {
+        return Fail();
+    }
+    objects_[depth_] = object;
+    ++depth_;
+    ++current_;
+    tokenDepth_ = depth_;
+    expectKey_  = object;
+    afterValue_ = false;
+    opened_     = true;
+    return token_ = object ? JsonToken::BEGIN_OBJECT : JsonToken::BEGIN_ARRAY;
+}
+
+JsonToken JsonReader::Close(const char c) noexcept
+{
+    if ((depth_ == 0) || ((c == '}') != objects_[depth_ - 1])) {
+        return Fail();
+    }
+    tokenDepth_ = depth_;
+    --depth_;
+    ++current_;
+    expectKey_  = false;
+    afterValue_ = true;
+    opened_     = false;
+    return token_ = (c == '}') ? JsonToken::END_OBJECT : JsonToken::END_ARRAY;
+}
+
+JsonToken JsonReader::Fail() noexcept
+{
+    failed_ = true;
+    return token_ = JsonToken::INVALID;
+}
+
+bool JsonReader::ParseString() noexcept
+{
+    // A quote ends the string unless it is preceded by an odd number of backslashes
+    const char* start = ++current_;
+    for (;;) {
+        const void* found = std::memchr(current_, '"', static_cast<size_t>(end_ - current_));
+        if (found == nullptr) {
+            Fail();
+            return false;
+        }
+        const char* quote = static_cast<const char*>(found);
+        size_t backslashes = 0;
+        for (const char* p = quote; (p != start) && (*(p - 1) == '\\'); --p) {
+            ++backslashes;
+        }
+        current_ = quote + 1;
+        if ((backslashes % 2) == 0) {
+            const std::string_view raw(start, static_cast<size_t>(quote - start));
+            value_ = JsonValue{raw, (raw.empty() == false) && (std::memchr(raw.data(), '\\', raw.size()) != nullptr)};
+            return true;
+        }
+    }
+}
+
+void JsonReader::SkipSpace() noexcept
+{
+    while ((current_ != end_) && IsSpace(*current_)) {
+        ++current_;
+    }
+}
+} // namespace ultralove::p3::runtime
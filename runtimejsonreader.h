@@ -0,0 +1,142 @@
+///
+// \file runtimejsonreader.h
+// \brief Streaming JSON reader for the P3 Model library
+// \details Zero-copy on-demand pull tokenizer over a JSON document in memory
+//
+
+#ifndef __P3_RUNTIME_JSON_READER_H_INCL__
+#define __P3_RUNTIME_JSON_READER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace ultralove::p3::runtime {
+/// \brief Token types reported by JsonReader
+enum class JsonToken : uint8_t
+{
+    BEGIN_OBJECT, ///< Start of an object
+    END_OBJECT,   ///< End of an object
+    BEGIN_ARRAY,  ///< Start of an array
+    END_ARRAY,    ///< End of an array
+    KEY,          ///< Member name of an object, its value is the next token
+    STRING,       ///< String value
+    NUMBER,       ///< Number value, its text is available
+    BOOLEAN,      ///< true or false
+    NULL_VALUE,   ///< null
+    END,          ///< End of the document
+    INVALID       ///< Malformed input, the reader stops here
+};
+
+/// \brief Raw JSON value
+/// \details Refers into the document. Strings are reported without their quotes; strings that
+/// contain escape sequences have to be decoded before use, see JsonReader::Decode(), all other
+/// values can be used as they are.
+struct JsonValue
+{
+    /// \brief Characters as they appear in the document
+    std::string_view raw;
+
+    /// \brief True if raw contains escape sequences that need decoding
+    bool encoded = false;
+};
+
+/// \brief Streaming JSON reader
+/// \details On-demand pull parser that reports one token per call to Next() without building a
+/// tree and without allocating; keys, strings and numbers are views into the document, which must
+/// outlive the reader. Nothing is converted until the caller asks for it, and Skip() passes over
+/// whole objects and arrays by matching brackets only, so members a caller does not need cost
+/// little more than a scan for quotes and brackets. Structure is checked as far as needed to
+/// tokenize the input; the contents of skipped values are not validated.
+class JsonReader
+{
+public:
+    /// \brief Maximum nesting depth of objects and arrays
+    static constexpr size_t MAX_DEPTH = 256;
+
+    /// \brief Create a reader
+    /// \param document Complete JSON document, e.g. the view of a MappedFile
+    explicit JsonReader(const std::string_view document) noexcept;
+
+    /// \brief Destroy the reader
+    virtual ~JsonReader() = default;
+
+    /// \brief Advance to the next token
+    /// \return Type of the token
+    JsonToken Next() noexcept;
+
+    /// \brief Skip the current value
+    /// \details On a BEGIN_OBJECT or BEGIN_ARRAY token the reader is positioned on the matching end
+    /// token afterwards; on a KEY token the value of the member is skipped; all other tokens are
+    /// complete values already.
+    /// \return False if the document ended or is malformed
+    bool Skip() noexcept;
+
+    /// \brief Get the current KEY, STRING or NUMBER token
+    /// \return Value, numbers are never encoded
+    const JsonValue& GetValue() const noexcept
+    {
+        return value_;
+    }
+
+    /// \brief Get the current BOOLEAN token
+    /// \return True for true
+    bool GetBoolean() const noexcept
+    {
+        return boolean_;
+    }
+
+    /// \brief Get the nesting depth of the current token
+    /// \details The root object or array has depth 1, begin and end token of a container report the
+    /// same depth, keys and values inside it report the depth of the container
+    /// \return Depth of the current token
+    size_t GetDepth() const noexcept
+    {
+        return tokenDepth_;
+    }
+
+    /// \brief Get the byte offset of the reader in the document
+    /// \return Offset of the end of the current token
+    size_t GetOffset() const noexcept
+    {
+        return static_cast<size_t>(current_ - begin_);
+    }
+
+    /// \brief Decode escape sequences
+    /// \details Handles the two-character escapes and \\u escapes including surrogate pairs, which
+    /// are converted to UTF-8; unpaired surrogates become U+FFFD, unknown escapes are copied
+    /// unchanged. The result is never longer than the input.
+    /// \param raw Encoded characters
+    /// \param target Buffer of at least raw.size() bytes, not terminated
+    /// \return Number of bytes written
+    static size_t Decode(const std::string_view raw, char* target) noexcept;
+
+private:
+    JsonToken Open(const bool object) noexcept;
+    JsonToken Close(const char c) noexcept;
+    JsonToken Fail() noexcept;
+    bool ParseString() noexcept;
+    void SkipSpace() noexcept;
+
+    const char* begin_   = nullptr;
+    const char* current_ = nullptr;
+    const char* end_     = nullptr;
+    JsonValue value_;
+    std::bitset<MAX_DEPTH> objects_;
+    size_t depth_      = 0;
+    size_t tokenDepth_ = 0;
+    JsonToken token_   = JsonToken::END;
+    bool boolean_      = false;
+    bool expectKey_    = false;
+    bool afterValue_   = false;
+    bool opened_       = false;
+    bool failed_       = false;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_JSON_READER_H_INCL__
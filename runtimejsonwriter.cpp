@@ -0,0 +1,203 @@
+///
+// \file runtimejsonwriter.cpp
+// \brief Streaming JSON writer implementation
+// \details Buffer management and table-driven escaping
+//
+
+#include "runtimejsonwriter.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace ultralove::p3::runtime {
+namespace {
+constexpr size_t MIN_BUFFER_SIZE = 256;
+
+// Quotes, backslashes and control characters must be escaped in strings
+constexpr auto ESCAPED = [] {
+    struct Table
+    {
+        bool escaped[256];
+    } table{};
+    for (unsigned c = 0; c < 0x20; ++c) {
+        table.escaped[c] = true;
+    }
+    table.escaped['"']  = true;
+    table.escaped['\\'] = true;
+    return table;
+}();
+
+constexpr std::string_view HEX_DIGITS = "0123456789abcdef";
+} // namespace
+
+JsonWriter::JsonWriter(OutputSink& sink, const size_t bufferSize) :
+    sink_(sink), buffer_(new char[(bufferSize < MIN_BUFFER_SIZE) ? MIN_BUFFER_SIZE : bufferSize]),
+    capacity_((bufferSize < MIN_BUFFER_SIZE) ? MIN_BUFFER_SIZE : bufferSize)
+{
+}
+
+void JsonWriter::BeginObject()
+{
+    Separate();
+    Append('{');
+    separate_ = false;
+}
+
+void JsonWriter::EndObject()
+{
+    Append('}');
+    separate_ = true;
+}
+
+void JsonWriter::BeginArray()
+{
+    Separate();
+    Append('[');
+    separate_ = false;
+}
+
+void JsonWriter::EndArray()
+{
+    Append(']');
+    separate_ = true;
+}
+
+void JsonWriter::Key(const std::string_view name)
+{
+    Separate();
+    Append('"');
+    Append(name);
+    Append(std::string_view("\":"));
+    separate_ = false;
+}
+
+void JsonWriter::Text(const std::string_view value)
+{
+    Separate();
+    Append('"');
+    AppendEscaped(value);
+    Append('"');
+}
+
+void JsonWriter::Unsigned(const uint64_t value)
+{
+    char digits[20];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    Raw(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+}
+
+void JsonWriter::Integer(const int64_t value)
+{
+    char digits[20];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    Raw(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+}
+
+void JsonWriter::Number(const double value)
+{
+    if (std::isfinite(value) == false) {
+        Null();
+        return;
+    }
+    char digits[32];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    Raw(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+}
+
+void JsonWriter::Boolean(const bool value)
+{
+    Raw(value ? std::string_view("true") : std::string_view("false"));
+}
+
+void JsonWriter::Null()
+{
+    Raw(std::string_view("null"));
+}
+
+void JsonWriter::Raw(const std::string_view value)
+{
+    Separate();
+    Append(value);
+}
+
+bool JsonWriter::Flush()
+{
+    if (used_ > 0) {
+        if (good_ && (sink_.Write(buffer_.get(), used_) == false)) {
+            good_ = false;
+        }
+        bytesFlushed_ += used_;
+        used_ = 0;
+    }
+    return good_;
+}
+
+void JsonWriter::Append(const char* data, const size_t size)
+{
+    if (size <= capacity_ - used_) {
+        std::memcpy(buffer_.get() + used_, data, size);
+        used_ += size;
+        return;
+    }
+    AppendSlow(data, size);
+}
+
+void JsonWriter::AppendSlow(const char* data, const size_t size)
+{
+    Flush();
+    if (size < capacity_) {
+        std::memcpy(buffer_.get(), data, size);
+        used_ = size;
+        return;
+    }
+
+    // Large values bypass the buffer
+    if (good_ && (sink_.Write(data, size) == false)) {
+        good_ = false;
+    }
+    bytesFlushed_ += size;
+}
+
+void JsonWriter::AppendEscaped(const std::string_view value)
+{
+    // Copy runs of plain characters in one piece, most values contain nothing to escape at all
+    const char* current = value.data();
+    const char* end     = current + value.size();
+    while (current != end) {
+        const char* run = current;
+        while ((current != end) && (ESCAPED.escaped[static_cast<uint8_t>(*current)] == false)) {
+            ++current;
+        }
+        if (current != run) {
+            Append(run, static_cast<size_t>(current - run));
+        }
+        if (current == end) {
+            break;
+        }
+        const uint8_t c = static_cast<uint8_t>(*current++);
+        switch (c) {
+        case '"':
+            Append(std::string_view("\\\""));
+            break;
+        case '\\':
+            Append(std::string_view("\\\\"));
+            break;
+        case '\n':
+            Append(std::string_view("\\n"));
+            break;
+        case '\r':
+            Append(std::string_view("\\r"));
+            break;
+        case '\t':
+            Append(std::string_view("\\t"));
+            break;
+        default: {
+            const char escape[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0f]};
+            Append(escape, sizeof(escape));
+            break;
+        }
+        }
+    }
+}
+} // namespace ultralove::p3::runtime
@@ -0,0 +1,147 @@
+///
+// \file runtimejsonwriter.h
+// \brief Streaming JSON writer for the P3 Model library
+// \details Buffered, allocation-free JSON serialization into an OutputSink
+//
+
+#ifndef __P3_RUNTIME_JSON_WRITER_H_INCL__
+#define __P3_RUNTIME_JSON_WRITER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "runtimeoutputsink.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace ultralove::p3::runtime {
+/// \brief Streaming JSON writer
+/// \details Writes objects, arrays and values straight into a fixed-size buffer that is handed to
+/// an OutputSink whenever it fills up; no document tree and no intermediate strings are built.
+/// Separators are inserted automatically and the output is compact, without any whitespace.
+/// Strings are escaped; bytes above 0x7f are written as they are, so UTF-8 passes through.
+///
+/// The writer does not check that objects and arrays are balanced or that members have keys;
+/// callers close every container they open. After the sink has reported an error all further
+/// output is discarded and IsGood() returns false.
+class JsonWriter
+{
+public:
+    /// \brief Default size of the output buffer
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+    /// \brief Create a writer
+    /// \param sink Destination of the output, must outlive the writer
+    /// \param bufferSize Size of the output buffer
+    explicit JsonWriter(OutputSink& sink, const size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /// \brief Destroy the writer without flushing pending output
+    virtual ~JsonWriter() = default;
+
+    JsonWriter(const JsonWriter&)            = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    /// \brief Start an object
+    void BeginObject();
+
+    /// \brief End the current object
+    void EndObject();
+
+    /// \brief Start an array
+    void BeginArray();
+
+    /// \brief End the current array
+    void EndArray();
+
+    /// \brief Write the name of the next member of the current object
+    /// \param name Member name, written without escaping
+    void Key(const std::string_view name);
+
+    /// \brief Write a string value
+    /// \param value Text, escaped
+    void Text(const std::string_view value);
+
+    /// \brief Write an unsigned integer value
+    /// \param value Number
+    void Unsigned(const uint64_t value);
+
+    /// \brief Write a signed integer value
+    /// \param value Number
+    void Integer(const int64_t value);
+
+    /// \brief Write a floating point value
+    /// \details Written in the shortest form that reads back to the same value; NaN and infinity
+    /// have no JSON representation and are written as null
+    /// \param value Number
+    void Number(const double value);
+
+    /// \brief Write a boolean value
+    /// \param value Boolean
+    void Boolean(const bool value);
+
+    /// \brief Write null
+    void Null();
+
+    /// \brief Write a preformatted value
+    /// \details For values that are known to be valid JSON, e.g. quoted dates and identifiers
+    /// \param value Characters written verbatim
+    void Raw(const std::string_view value);
+
+    /// \brief Hand all buffered output to the sink
+    /// \return True if all output so far reached the sink
+    bool Flush();
+
+    /// \brief Check whether all output so far was accepted by the sink
+    /// \return False after the sink has reported an error
+    bool IsGood() const noexcept
+    {
+        return good_;
+    }
+
+    /// \brief Get the number of bytes produced so far, including buffered bytes
+    /// \return Byte count
+    uint64_t GetBytesWritten() const noexcept
+    {
+        return bytesFlushed_ + used_;
+    }
+
+private:
+    void Append(const char* data, const size_t size);
+    void AppendSlow(const char* data, const size_t size);
+    void AppendEscaped(const std::string_view value);
+
+    void Append(const std::string_view value)
+    {
+        Append(value.data(), value.size());
+    }
+
+    void Append(const char c)
+    {
+        if (used_ == capacity_) {
+            Flush();
+        }
+        buffer_[used_++] = c;
+    }
+
+    void Separate()
+    {
+        if (separate_) {
+            Append(',');
+        }
+        separate_ = true;
+    }
+
+    OutputSink& sink_;
+    std::unique_ptr<char[]> buffer_;
+    size_t capacity_       = 0;
+    size_t used_           = 0;
+    uint64_t bytesFlushed_ = 0;
+    bool separate_         = false;
+    bool good_             = true;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_JSON_WRITER_H_INCL__
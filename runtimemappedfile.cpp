@@ -0,0 +1,139 @@
+///
+// \file runtimemappedfile.cpp
+// \brief Memory-mapped file implementation
+// \details Platform mapping calls for POSIX and Windows
+//
+
+#include "runtimemappedfile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ultralove::p3::runtime {
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+    data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)), open_(std::exchange(other.open_, false))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        Close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        open_ = std::exchange(other.open_, false);
+    }
+    return *this;
+}
+
+#if defined(_WIN32)
+bool MappedFile::Open(const char* path)
+{
+    Close();
+    if (path == nullptr) {
+        return false;
+    }
+
+    const HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size{};
+    if (::GetFileSizeEx(file, &size) == FALSE) {
+        ::CloseHandle(file);
+        return false;
+    }
+    if (size.QuadPart == 0) {
+        ::CloseHandle(file);
+        open_ = true;
+        return true;
+    }
+
+    // The view keeps the mapping object alive, so both handles can be closed right away
+    const HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (mapping == nullptr) {
+        return false;
+    }
+    const void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (view == nullptr) {
+        return false;
+    }
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<size_t>(size.QuadPart);
+    open_ = true;
+    return true;
+}
+
+void MappedFile::Close() noexcept
+{
+    if (data_ != nullptr) {
+        ::UnmapViewOfFile(data_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+#else
+bool MappedFile::Open(const char* path)
+{
+    Close();
+    if (path == nullptr) {
+        return false;
+    }
+
+    const int file = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        return false;
+    }
+    struct stat status{};
+    if ((::fstat(file, &status) != 0) || (S_ISREG(status.st_mode) == false)) {
+        ::close(file);
+        return false;
+    }
+    if (status.st_size == 0) {
+        ::close(file);
+        open_ = true;
+        return true;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void* view = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    ::madvise(view, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<size_t>(status.st_size);
+    open_ = true;
+    return true;
+}
+
+void MappedFile::Close() noexcept
+{
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+#endif
+} // namespace ultralove::p3::runtime
@@ -0,0 +1,79 @@
+///
+// \file runtimemappedfile.h
+// \brief Memory-mapped file for the P3 Model library
+// \details Read-only view of a whole file through the virtual memory system
+//
+
+#ifndef __P3_RUNTIME_MAPPED_FILE_H_INCL__
+#define __P3_RUNTIME_MAPPED_FILE_H_INCL__
+
+#pragma pack(push, 8)
+
+#include <cstddef>
+#include <string_view>
+
+namespace ultralove::p3::runtime {
+/// \brief Read-only memory-mapped file
+/// \details Maps a whole file into the address space, so parsers can work on it as one contiguous
+/// buffer without reading it into the heap first. Pages are loaded on first access and shared with
+/// every other process mapping the same file. The view is not NUL-terminated.
+class MappedFile
+{
+public:
+    /// \brief Create a closed mapping
+    MappedFile() noexcept = default;
+
+    /// \brief Unmap the file
+    virtual ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// \brief Take over the mapping of another instance
+    /// \param other Mapping to move from, closed afterwards
+    MappedFile(MappedFile&& other) noexcept;
+
+    /// \brief Take over the mapping of another instance
+    /// \param other Mapping to move from, closed afterwards
+    /// \return Reference to this mapping
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// \brief Map a file, closing any previous mapping
+    /// \param path Path of the file
+    /// \return True if the file could be mapped; empty files map successfully to an empty view
+    bool Open(const char* path);
+
+    /// \brief Unmap the file
+    void Close() noexcept;
+
+    /// \brief Check whether a file is mapped
+    /// \return True between a successful Open() and Close()
+    bool IsOpen() const noexcept
+    {
+        return open_;
+    }
+
+    /// \brief Get the mapped bytes
+    /// \return View of the whole file, valid until Close()
+    std::string_view GetView() const noexcept
+    {
+        return std::string_view(data_, size_);
+    }
+
+    /// \brief Get the size of the mapped file
+    /// \return Size in bytes
+    size_t GetSize() const noexcept
+    {
+        return size_;
+    }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_      = 0;
+    bool open_        = false;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_MAPPED_FILE_H_INCL__
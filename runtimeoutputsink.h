@@ -0,0 +1,86 @@
+///
+// \file runtimeoutputsink.h
+// \brief Output sink interface for the P3 Model library
+// \details Destination for chunked output produced by the writers of the library
+//
+
+#ifndef __P3_RUNTIME_OUTPUT_SINK_H_INCL__
+#define __P3_RUNTIME_OUTPUT_SINK_H_INCL__
+
+#pragma pack(push, 8)
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+namespace ultralove::p3::runtime {
+/// \brief Destination for chunked output
+/// \details Writers fill a fixed-size buffer and hand it to the sink whenever it is full, so the
+/// memory needed to produce a document does not depend on its size. Implementations forward the
+/// chunks to a file, a socket, a compressor or a growing buffer.
+class OutputSink
+{
+public:
+    /// \brief Consume a chunk of output
+    /// \param data Bytes to consume, only valid for the duration of the call
+    /// \param size Number of bytes
+    /// \return True on success, false stops the writer
+    virtual bool Write(const char* data, const size_t size) = 0;
+
+protected:
+    virtual ~OutputSink() = default;
+};
+
+/// \brief Output sink writing to a C stdio stream
+/// \details The stream is neither opened nor closed by the sink
+class FileOutputSink : public OutputSink
+{
+public:
+    /// \brief Create a sink for an open stream
+    /// \param file Stream opened for writing in binary mode
+    explicit FileOutputSink(std::FILE* file) noexcept : file_(file) {}
+
+    virtual ~FileOutputSink() = default;
+
+    /// \brief Write a chunk to the stream
+    /// \param data Bytes to write
+    /// \param size Number of bytes
+    /// \return True if all bytes were written
+    bool Write(const char* data, const size_t size) override
+    {
+        return (file_ != nullptr) && (std::fwrite(data, 1, size, file_) == size);
+    }
+
+private:
+    std::FILE* file_ = nullptr;
+};
+
+/// \brief Output sink appending to a string
+/// \details For small documents and fragments that are kept in memory
+class StringOutputSink : public OutputSink
+{
+public:
+    /// \brief Create a sink for a string
+    /// \param target String receiving the output, must outlive the sink
+    explicit StringOutputSink(std::string& target) noexcept : target_(&target) {}
+
+    virtual ~StringOutputSink() = default;
+
+    /// \brief Append a chunk to the string
+    /// \param data Bytes to append
+    /// \param size Number of bytes
+    /// \return True
+    bool Write(const char* data, const size_t size) override
+    {
+        target_->append(data, size);
+        return true;
+    }
+
+private:
+    std::string* target_;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_OUTPUT_SINK_H_INCL__
@@ -0,0 +1,110 @@
+///
+// \file runtimeparsing.cpp
+// \brief Parsing helpers implementation
+// \details Character references and JSON seconds
+//
+
+#include "runtimeparsing.h"
+
+#include <charconv>
+
+namespace ultralove::p3::runtime::parsing {
+size_t DecodeReference(const std::string_view name, char* target) noexcept
+{
+    if (name == "amp") {
+        *target = '&';
+        return 1;
+    }
+    if (name == "lt") {
+        *target = '<';
+        return 1;
+    }
+    if (name == "gt") {
+        *target = '>';
+        return 1;
+    }
+    if (name == "quot") {
+        *target = '"';
+        return 1;
+    }
+    if (name == "apos") {
+        *target = '\'';
+        return 1;
+    }
+    if ((name.size() < 2) || (name[0] != '#')) {
+        return 0;
+    }
+
+    const bool hex     = (name[1] == 'x') || (name[1] == 'X');
+    size_t index       = hex ? 2 : 1;
+    uint32_t codePoint = 0;
+    if (index == name.size()) {
+        return 0;
+    }
+    for (; index < name.size(); ++index) {
+        const char c   = name[index];
+        uint32_t digit = 0;
+        if ((c >= '0') && (c <= '9')) {
+            digit = static_cast<uint32_t>(c - '0');
+        }
+        else if (hex && ((c | 0x20) >= 'a') && ((c | 0x20) <= 'f')) {
+            digit = static_cast<uint32_t>((c | 0x20) - 'a' + 10);
+        }
+        else {
+            return 0;
+        }
+        codePoint = codePoint * (hex ? 16 : 10) + digit;
+        if (codePoint > MAX_CODE_POINT) {
+            return 0;
+        }
+    }
+    if ((codePoint == 0) || ((codePoint >= 0xd800) && (codePoint <= 0xdfff))) {
+        return 0;
+    }
+    // The shortest reference "&#9;" has four characters, so the encoding always fits in place
+    return EncodeUtf8(codePoint, target);
+}
+
+std::optional<Timespan> ParseSeconds(const std::string_view text) noexcept
+{
+    if (text.find_first_of("eE") != std::string_view::npos) {
+        double seconds         = 0;
+        const auto [end, code] = std::from_chars(text.data(), text.data() + text.size(), seconds);
+        // 2^63 nanoseconds and more do not convert; comparing this way round also rejects NaN
+        const double nanoseconds = seconds * 1e9;
+        if ((code != std::errc()) || (end != text.data() + text.size()) || ((nanoseconds > -9223372036854775808.0) == false) ||
+            ((nanoseconds < 9223372036854775808.0) == false)) {
+            return std::nullopt;
+        }
+        return Timespan::FromNanoseconds(static_cast<int64_t>(nanoseconds));
+    }
+    const bool negative           = (text.empty() == false) && (text.front() == '-');
+    const std::string_view number = negative ? text.substr(1) : text;
+    const size_t point            = number.find('.');
+    const std::string_view whole  = number.substr(0, point);
+    int64_t seconds               = 0;
+    const auto [end, code]        = std::from_chars(whole.data(), whole.data() + whole.size(), seconds);
+    if ((code != std::errc()) || (end != whole.data() + whole.size()) || (seconds < 0) || (seconds > Timespan::MAX_SECONDS)) {
+        return std::nullopt;
+    }
+    int64_t fraction = 0;
+    if (point != std::string_view::npos) {
+        // Every character after the point must be a digit, those beyond nanoseconds are dropped
+        if (point + 1 == number.size()) {
+            return std::nullopt;
+        }
+        int64_t scale = Timespan::NANOSECONDS_PER_SECOND / 10;
+        for (size_t i = point + 1; i < number.size(); ++i, scale /= 10) {
+            if ((number[i] < '0') || (number[i] > '9')) {
+                return std::nullopt;
+            }
+            fraction += (number[i] - '0') * scale;
+        }
+    }
+    if (seconds > (INT64_MAX - fraction) / Timespan::NANOSECONDS_PER_SECOND) {
+        return std::nullopt;
+    }
+    const int64_t nanoseconds = seconds * Timespan::NANOSECONDS_PER_SECOND + fraction;
+    return Timespan::FromNanoseconds(negative ? -nanoseconds : nanoseconds);
+}
+} // namespace ultralove::p3::runtime::parsing
@@ -0,0 +1,206 @@
+///
+// \file runtimeparsing.h
+// \brief Parsing helpers for the P3 Model library
+// \details Character classes, ASCII case folding, UTF-8 encoding, character references, JSON
+// seconds and compile-time name tables shared by the readers
+//
+
+#ifndef __P3_RUNTIME_PARSING_H_INCL__
+#define __P3_RUNTIME_PARSING_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "runtimetimespan.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+// Internal to the readers of the library and not included by model.h. The functions are small and
+// hot, so they are defined here to be inlined into the scanning loops of every reader.
+namespace ultralove::p3::runtime::parsing {
+/// \brief Largest code point written for a numeric character reference
+inline constexpr uint32_t MAX_CODE_POINT = 0x10ffff;
+
+/// \brief Longest character reference that is recognized without '&' and ';', e.g. "#x10FFFF"
+inline constexpr size_t MAX_REFERENCE_LENGTH = 8;
+
+/// \brief Check for XML and JSON whitespace
+/// \param c Character
+/// \return True for space, tab, carriage return and line feed
+constexpr bool IsSpace(const char c) noexcept
+{
+    return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+}
+
+/// \brief Remove leading and trailing whitespace
+/// \param value Text
+/// \return View of value without surrounding whitespace
+constexpr std::string_view Trim(std::string_view value) noexcept
+{
+    while ((value.empty() == false) && IsSpace(value.front())) {
+        value.remove_prefix(1);
+    }
+    while ((value.empty() == false) && IsSpace(value.back())) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+/// \brief Compare ASCII text ignoring case
+/// \param lhs Left-hand side
+/// \param rhs Right-hand side, usually a lower case literal
+/// \return True if both are equal apart from the case of ASCII letters
+constexpr bool EqualsIgnoreCase(const std::string_view lhs, const std::string_view rhs) noexcept
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if ((lhs[i] | 0x20) != (rhs[i] | 0x20)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// \brief Check for an ASCII prefix ignoring case
+/// \param value Text
+/// \param prefix Prefix, usually a lower case literal
+/// \return True if value starts with prefix apart from the case of ASCII letters
+constexpr bool StartsWithIgnoreCase(const std::string_view value, const std::string_view prefix) noexcept
+{
+    return (value.size() >= prefix.size()) && EqualsIgnoreCase(value.substr(0, prefix.size()), prefix);
+}
+
+/// \brief Check for a prefix at a position of a document
+/// \param current Position in the document
+/// \param end End of the document
+/// \param prefix Prefix
+/// \return True if the bytes at current match prefix
+inline bool StartsWith(const char* current, const char* end, const std::string_view prefix) noexcept
+{
+    return (static_cast<size_t>(end - current) >= prefix.size()) && (std::memcmp(current, prefix.data(), prefix.size()) == 0);
+}
+
+/// \brief Encode a code point as UTF-8
+/// \param codePoint Code point up to MAX_CODE_POINT
+/// \param target Receives one to four bytes
+/// \return Number of bytes written
+constexpr size_t EncodeUtf8(const uint32_t codePoint, char* target) noexcept
+{
+    if (codePoint < 0x80) {
+        target[0] = static_cast<char>(codePoint);
+        return 1;
+    }
+    if (codePoint < 0x800) {
+        target[0] = static_cast<char>(0xc0 | (codePoint >> 6));
+        target[1] = static_cast<char>(0x80 | (codePoint & 0x3f));
+        return 2;
+    }
+    if (codePoint < 0x10000) {
+        target[0] = static_cast<char>(0xe0 | (codePoint >> 12));
+        target[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+        target[2] = static_cast<char>(0x80 | (codePoint & 0x3f));
+        return 3;
+    }
+    target[0] = static_cast<char>(0xf0 | (codePoint >> 18));
+    target[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+    target[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+    target[3] = static_cast<char>(0x80 | (codePoint & 0x3f));
+    return 4;
+}
+
+/// \brief Decode a character reference
+/// \details Numeric references and the five predefined XML entities are decoded. The result is
+/// always shorter than the reference with its '&' and ';', so it can be written over the input.
+/// \param name Reference between '&' and ';', e.g. "amp" or "#x2014"
+/// \param target Receives up to four bytes
+/// \return Number of bytes written, 0 if the reference is unknown or invalid
+size_t DecodeReference(const std::string_view name, char* target) noexcept;
+
+/// \brief Parse a JSON number of seconds
+/// \details The fraction is taken digit by digit so that nanoseconds survive; numbers with an
+/// exponent fall back to floating point.
+/// \param text Number, e.g. "12.5" or "-3" or "1e3"
+/// \return Duration, no value if the text is not exactly one number or out of the range of Timespan
+std::optional<Timespan> ParseSeconds(const std::string_view text) noexcept;
+
+/// \brief FNV-1a hash of a name, usable at compile time
+/// \param name Name
+/// \return 32-bit hash
+constexpr uint32_t NameHash(const std::string_view name) noexcept
+{
+    uint32_t hash = 2166136261u;
+    for (const char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+/// \brief Name of a field recognized by a reader
+template<typename Field>
+struct FieldName
+{
+    std::string_view name;
+    Field field;
+};
+
+/// \brief Open-addressing table from element or member names to the fields of a reader
+/// \details Built at compile time from an array of FieldName with static storage duration, which
+/// the table refers to:
+///
+///     constexpr FieldName<Field> FIELD_NAMES[] = {{"title", Field::TITLE}, ...};
+///     constexpr NameTable FIELDS(FIELD_NAMES);
+///     const Field field = FIELDS.Find(name, Field::UNKNOWN);
+///
+/// \tparam Field Field enumeration of the reader
+/// \tparam COUNT Number of names
+/// \tparam SIZE Number of slots, a power of two larger than COUNT
+template<typename Field, size_t COUNT, size_t SIZE = 256>
+class NameTable
+{
+    static_assert((SIZE & (SIZE - 1)) == 0, "the slot count must be a power of two");
+    static_assert((COUNT < SIZE / 2) && (COUNT < UINT8_MAX), "the table must stay at most half full");
+
+public:
+    /// \brief Build the table
+    /// \param names Names and their fields, must outlive the table
+    constexpr explicit NameTable(const FieldName<Field> (&names)[COUNT]) noexcept : names_(names)
+    {
+        for (size_t i = 0; i < COUNT; ++i) {
+            size_t slot = NameHash(names[i].name) & (SIZE - 1);
+            while (slots_[slot] != 0) {
+                slot = (slot + 1) & (SIZE - 1);
+            }
+            slots_[slot] = static_cast<uint8_t>(i + 1);
+        }
+    }
+
+    /// \brief Look up a name
+    /// \param name Name, compared case-sensitively
+    /// \param unknown Field returned for names that are not in the table
+    /// \return Field of the name
+    Field Find(const std::string_view name, const Field unknown) const noexcept
+    {
+        size_t slot = NameHash(name) & (SIZE - 1);
+        while (slots_[slot] != 0) {
+            const FieldName<Field>& candidate = names_[slots_[slot] - 1];
+            if (candidate.name == name) {
+                return candidate.field;
+            }
+            slot = (slot + 1) & (SIZE - 1);
+        }
+        return unknown;
+    }
+
+private:
+    const FieldName<Field>* names_;
+    uint8_t slots_[SIZE] = {};
+};
+} // namespace ultralove::p3::runtime::parsing
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_PARSING_H_INCL__
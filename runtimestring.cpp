@@ -0,0 +1,51 @@
+///
+// \file runtimestring.cpp
+// \brief String utility implementation
+// \details Out-of-line allocation paths of runtime::String
+//
+
+#include "runtimestring.h"
+#include "runtimestringpool.h"
+#include "runtimetextstore.h"
+
+#include <stdexcept>
+
+namespace ultralove::p3::runtime {
+void String::CheckLength(const size_t length)
+{
+    // Lengths are stored in 32 bits to keep the string at 24 bytes
+    if (length > MAX_INDIRECT_LENGTH) {
+        throw std::length_error("runtime::String exceeds 4 GiB");
+    }
+}
+
+String String::Intern(const std::string_view value)
+{
+    return StringPool::Intern(value);
+}
+
+void String::AssignHeap(const std::string_view value)
+{
+    CheckLength(value.size());
+    char* data = new char[value.size() + 1];
+    std::memcpy(data, value.data(), value.size());
+    data[value.size()] = '\0';
+    StoreIndirect(StringStorage::HEAP, data, value.size());
+}
+
+std::string_view String::LoadLazy() const noexcept
+{
+    TextStore* store = nullptr;
+    uint64_t locator = 0;
+    std::memcpy(&store, storage_, sizeof(store));
+    std::memcpy(&locator, storage_ + LAZY_LOCATOR_INDEX, sizeof(locator));
+    return store->Hydrate(locator, LoadLength());
+}
+
+void String::Release() noexcept
+{
+    if (GetStorage() == StringStorage::HEAP) {
+        delete[] LoadData();
+    }
+}
+} // namespace ultralove::p3::runtime
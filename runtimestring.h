@@ -1,7 +1,7 @@
 ///
 // \file runtimestring.h
 // \brief String utility struct for the P3 Model library
-// \details Placeholder string struct for future implementation in podcast domain
+// \details Compact string with inline storage for short values and optional arena backing
 //
 
 #ifndef __P3_RUNTIME_STRING_H_INCL__
@@ -9,24 +9,377 @@
 
 #pragma pack(push, 8)
 
+#include "runtimearena.h"
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
 namespace ultralove::p3::runtime {
+/// \brief Storage classes of a String
+enum class StringStorage : uint8_t
+{
+    INLINE,   ///< Characters are stored inside the String object
+    HEAP,     ///< Characters are owned by the String on the heap
+    EXTERNAL, ///< Characters are owned by someone else (arena, mapped file), the String only refers to them
+    INTERNED, ///< Characters are owned by the StringPool and shared by all equal interned strings
+    LAZY      ///< Characters are loaded on access through the cache of a TextStore
+};
+
+struct StringPool;
+class TextStore;
+
 /// \brief Utility string struct for the P3 Model library
-/// \details Placeholder string struct for future implementation
-/// This will handle podcast-specific string data like titles, descriptions, etc.
-struct String
+/// \details Immutable UTF-8 string value in 24 bytes. Values of up to INLINE_CAPACITY bytes
+/// (language codes, MIME types, role names) are stored inline without any allocation. Longer values
+/// are either copied to the heap or, when an Arena is supplied, into the arena, in which case the
+/// String merely refers to them and the arena must outlive it. Low-cardinality values can be
+/// interned through Intern(), see StringPool. Rarely read values can be left in a TextStore, which
+/// creates lazy strings that only hold a locator and load their characters on access, see
+/// runtimetextstore.h. The characters are always NUL-terminated, so GetValue() can be handed to C
+/// APIs directly.
+class String
 {
-    /// \brief Get the string value (placeholder implementation)
-    /// \return Placeholder string value
-    const char* GetValue() const
+public:
+    /// \brief Maximum number of bytes stored inline without any allocation
+    static constexpr size_t INLINE_CAPACITY = 22;
+
+    /// \brief Create an empty string
+    String() noexcept
+    {
+        SetInline(0);
+    }
+
+    /// \brief Create a string from a NUL-terminated character sequence
+    /// \param value Characters to copy, nullptr is treated as an empty string
+    String(const char* value) : String(std::string_view((value != nullptr) ? value : ""))
+    {
+    }
+
+    /// \brief Create a string from a character sequence
+    /// \param value Characters to copy
+    String(const std::string_view value)
+    {
+        if (value.size() <= INLINE_CAPACITY) {
+            AssignInline(value);
+        }
+        else {
+            AssignHeap(value);
+        }
+    }
+
+    /// \brief Create a string whose characters are allocated from an arena
+    /// \details Values that fit inline are stored inline and do not touch the arena
+    /// \param value Characters to copy
+    /// \param arena Arena that receives long values, must outlive the string and all its copies
+    String(const std::string_view value, Arena& arena)
+    {
+        if (value.size() <= INLINE_CAPACITY) {
+            AssignInline(value);
+        }
+        else {
+            SetExternal(arena.Copy(value), value.size());
+        }
+    }
+
+    /// \brief Copy a string
+    /// \details Heap strings are deep-copied, all other storage classes are copied by value
+    /// \param other String to copy
+    String(const String& other)
+    {
+        if (other.GetStorage() == StringStorage::HEAP) {
+            AssignHeap(other.GetView());
+        }
+        else {
+            std::memcpy(storage_, other.storage_, sizeof(storage_));
+        }
+    }
+
+    /// \brief Move a string, leaving the source empty
+    /// \param other String to move from
+    String(String&& other) noexcept
+    {
+        std::memcpy(storage_, other.storage_, sizeof(storage_));
+        other.SetInline(0);
+    }
+
+    /// \brief Release owned characters
+    ~String()
+    {
+        Release();
+    }
+
+    /// \brief Copy-assign a string
+    /// \param other String to copy
+    /// \return Reference to this string
+    String& operator=(const String& other)
+    {
+        if (this != &other) {
+            String copy(other);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    /// \brief Move-assign a string, leaving the source empty
+    /// \param other String to move from
+    /// \return Reference to this string
+    String& operator=(String&& other) noexcept
+    {
+        if (this != &other) {
+            Release();
+            std::memcpy(storage_, other.storage_, sizeof(storage_));
+            other.SetInline(0);
+        }
+        return *this;
+    }
+
+    /// \brief Create a string that refers to characters owned by someone else
+    /// \details No characters are copied. The caller guarantees that the characters outlive the
+    /// string and that value.data()[value.size()] is a NUL character. Like every string that does
+    /// not store its characters inline, it throws std::length_error for values of 4 GiB and more.
+    /// \param value Characters to refer to
+    /// \return Non-owning string
+    static String Reference(const std::string_view value)
+    {
+        String result;
+        if (value.empty() == false) {
+            result.SetExternal(value.data(), value.size());
+        }
+        return result;
+    }
+
+    /// \brief Create an interned string
+    /// \details Equal interned strings share one buffer and compare by pointer. Falls back to an
+    /// ordinary string while the StringPool is not initialized.
+    /// \param value Characters to intern
+    /// \return Interned string
+    static String Intern(const std::string_view value);
+
+    /// \brief Get the string value
+    /// \return NUL-terminated UTF-8 characters, valid as long as the string is; for lazy strings as
+    /// described by TextStore, an empty string if the value cannot be loaded
+    const char* GetValue() const noexcept
+    {
+        const StringStorage storage = GetStorage();
+        if (storage == StringStorage::INLINE) {
+            return storage_;
+        }
+        if (storage == StringStorage::LAZY) {
+            const std::string_view value = LoadLazy();
+            return (value.data() != nullptr) ? value.data() : "";
+        }
+        return LoadData();
+    }
+
+    /// \brief Get the string value as a view
+    /// \return View of the characters, valid as long as the string is; for lazy strings as described
+    /// by TextStore, an empty view if the value cannot be loaded
+    std::string_view GetView() const noexcept
+    {
+        return (GetStorage() == StringStorage::LAZY) ? LoadLazy() : std::string_view(GetValue(), GetLength());
+    }
+
+    /// \brief Get the length of the string
+    /// \details Lazy strings know their length without loading the value
+    /// \return Number of bytes, not counting the terminator
+    size_t GetLength() const noexcept
+    {
+        if (GetStorage() == StringStorage::INLINE) {
+            return static_cast<size_t>(Control() & INLINE_LENGTH_MASK);
+        }
+        return LoadLength();
+    }
+
+    /// \brief Check whether the string is empty
+    /// \return True if the string has no characters
+    bool IsEmpty() const noexcept
+    {
+        return GetLength() == 0;
+    }
+
+    /// \brief Get the storage class of the string
+    /// \return Where the characters of this string live
+    StringStorage GetStorage() const noexcept
+    {
+        return static_cast<StringStorage>(Control() >> STORAGE_SHIFT);
+    }
+
+    /// \brief Check whether the string is interned
+    /// \return True if the characters are shared through the StringPool
+    bool IsInterned() const noexcept
+    {
+        return GetStorage() == StringStorage::INTERNED;
+    }
+
+    /// \brief Check whether the characters of the string are loaded on access
+    /// \return True if the string refers to a value of a TextStore
+    bool IsLazy() const noexcept
     {
-        return "";
+        return GetStorage() == StringStorage::LAZY;
     }
 
-    // Data members will be added in future implementation
-    // Planned: character data storage, length tracking, capacity management
+    /// \brief Exchange the contents of two strings
+    /// \param other String to swap with
+    void Swap(String& other) noexcept
+    {
+        char temp[sizeof(storage_)];
+        std::memcpy(temp, storage_, sizeof(storage_));
+        std::memcpy(storage_, other.storage_, sizeof(storage_));
+        std::memcpy(other.storage_, temp, sizeof(storage_));
+    }
+
+    /// \brief Compare two strings for equality
+    /// \param lhs Left-hand side
+    /// \param rhs Right-hand side
+    /// \return True if both strings contain the same characters
+    friend bool operator==(const String& lhs, const String& rhs) noexcept
+    {
+        // Interned values are unique, so two interned strings are equal exactly if they share a buffer
+        if (lhs.IsInterned() && rhs.IsInterned()) {
+            return lhs.LoadData() == rhs.LoadData();
+        }
+
+        // Lengths are known without loading lazy values; a lazy value that cannot be loaded compares
+        // as an empty view
+        return (lhs.GetLength() == rhs.GetLength()) && (lhs.GetView() == rhs.GetView());
+    }
+
+    /// \brief Compare a string with a character sequence for equality
+    /// \param lhs Left-hand side
+    /// \param rhs Right-hand side
+    /// \return True if both contain the same characters
+    friend bool operator==(const String& lhs, const std::string_view rhs) noexcept
+    {
+        return lhs.GetView() == rhs;
+    }
+
+    /// \brief Compare a string with a NUL-terminated character sequence for equality
+    /// \param lhs Left-hand side
+    /// \param rhs Right-hand side, nullptr compares equal to an empty string
+    /// \return True if both contain the same characters
+    friend bool operator==(const String& lhs, const char* rhs) noexcept
+    {
+        return lhs.GetView() == std::string_view((rhs != nullptr) ? rhs : "");
+    }
+
+    /// \brief Order two strings lexicographically by bytes
+    /// \param lhs Left-hand side
+    /// \param rhs Right-hand side
+    /// \return Ordering of the two strings
+    friend std::strong_ordering operator<=>(const String& lhs, const String& rhs) noexcept
+    {
+        return lhs.GetView() <=> rhs.GetView();
+    }
+
+private:
+    friend struct StringPool;
+    friend class TextStore;
+
+    // Layout of the 24 byte storage:
+    //   INLINE:            [0..22] characters and terminator, [23] control
+    //   LAZY:              [0..7] store pointer, [8..11] length, [12..19] locator, [20..22] unused, [23] control
+    //   all other classes: [0..7] data pointer, [8..11] length, [12..22] unused, [23] control
+    // The control byte holds the storage class in its upper three bits and the inline length in its
+    // lower five bits.
+    static constexpr size_t CONTROL_INDEX         = 23;
+    static constexpr uint8_t STORAGE_SHIFT        = 5;
+    static constexpr uint8_t INLINE_LENGTH_MASK   = 0x1f;
+    static constexpr size_t MAX_INDIRECT_LENGTH   = UINT32_MAX;
+    static constexpr size_t INDIRECT_LENGTH_INDEX = sizeof(const char*);
+    static constexpr size_t LAZY_LOCATOR_INDEX    = INDIRECT_LENGTH_INDEX + sizeof(uint32_t);
+
+    uint8_t Control() const noexcept
+    {
+        return static_cast<uint8_t>(storage_[CONTROL_INDEX]);
+    }
+
+    void SetControl(const StringStorage storage, const size_t inlineLength) noexcept
+    {
+        storage_[CONTROL_INDEX] = static_cast<char>((static_cast<uint8_t>(storage) << STORAGE_SHIFT) | static_cast<uint8_t>(inlineLength));
+    }
+
+    const char* LoadData() const noexcept
+    {
+        const char* data = nullptr;
+        std::memcpy(&data, storage_, sizeof(data));
+        return data;
+    }
+
+    size_t LoadLength() const noexcept
+    {
+        uint32_t length = 0;
+        std::memcpy(&length, storage_ + INDIRECT_LENGTH_INDEX, sizeof(length));
+        return length;
+    }
+
+    void StoreIndirect(const StringStorage storage, const char* data, const size_t length) noexcept
+    {
+        const uint32_t storedLength = static_cast<uint32_t>(length);
+        std::memcpy(storage_, &data, sizeof(data));
+        std::memcpy(storage_ + INDIRECT_LENGTH_INDEX, &storedLength, sizeof(storedLength));
+        SetControl(storage, 0);
+    }
+
+    void SetInline(const size_t length) noexcept
+    {
+        storage_[length] = '\0';
+        SetControl(StringStorage::INLINE, length);
+    }
+
+    void AssignInline(const std::string_view value) noexcept
+    {
+        if (value.empty() == false) {
+            std::memcpy(storage_, value.data(), value.size());
+        }
+        SetInline(value.size());
+    }
+
+    void SetExternal(const char* data, const size_t length)
+    {
+        CheckLength(length);
+        StoreIndirect(StringStorage::EXTERNAL, data, length);
+    }
+
+    static String MakeInterned(const char* data, const size_t length) noexcept
+    {
+        String result;
+        result.StoreIndirect(StringStorage::INTERNED, data, length);
+        return result;
+    }
+
+    static String MakeLazy(TextStore* store, const uint64_t locator, const size_t length)
+    {
+        CheckLength(length);
+        String result;
+        result.StoreIndirect(StringStorage::LAZY, reinterpret_cast<const char*>(store), length);
+        std::memcpy(result.storage_ + LAZY_LOCATOR_INDEX, &locator, sizeof(locator));
+        return result;
+    }
+
+    static void CheckLength(const size_t length);
+    std::string_view LoadLazy() const noexcept;
+    void AssignHeap(const std::string_view value);
+    void Release() noexcept;
+
+    alignas(8) char storage_[24];
 };
+
+static_assert(sizeof(String) == 24, "runtime::String must stay 24 bytes");
 } // namespace ultralove::p3::runtime
 
+/// \brief Hash support so runtime::String can be used as a key in unordered containers
+template<>
+struct std::hash<ultralove::p3::runtime::String>
+{
+    size_t operator()(const ultralove::p3::runtime::String& value) const noexcept
+    {
+        return std::hash<std::string_view>{}(value.GetView());
+    }
+};
+
 #pragma pack(pop)
 
 #endif // __P3_RUNTIME_STRING_H_INCL__
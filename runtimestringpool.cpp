@@ -0,0 +1,111 @@
+///
+// \file runtimestringpool.cpp
+// \brief String interning pool implementation
+// \details Sharded hash sets of arena-allocated values
+//
+
+#include "runtimestringpool.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
+namespace ultralove::p3::runtime {
+namespace {
+// Independent shards keep concurrent importers from serializing on a single lock
+constexpr size_t SHARD_COUNT = 16;
+
+struct PoolShard
+{
+    std::mutex mutex;
+    Arena arena;
+    std::unordered_set<std::string_view> values;
+};
+
+struct Pool
+{
+    std::array<PoolShard, SHARD_COUNT> shards;
+};
+
+// Held shared by every call that uses the pool and exclusively while it is created or destroyed, so
+// Shutdown() waits for calls in progress instead of pulling the pool out from under them
+std::shared_mutex g_lifetimeMutex;
+std::atomic<Pool*> g_pool{nullptr};
+} // namespace
+
+bool StringPool::Initialize()
+{
+    const std::unique_lock<std::shared_mutex> lock(g_lifetimeMutex);
+    if (g_pool.load(std::memory_order_acquire) == nullptr) {
+        g_pool.store(new Pool(), std::memory_order_release);
+    }
+    return true;
+}
+
+void StringPool::Shutdown()
+{
+    const std::unique_lock<std::shared_mutex> lock(g_lifetimeMutex);
+    delete g_pool.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+bool StringPool::IsInitialized() noexcept
+{
+    return g_pool.load(std::memory_order_acquire) != nullptr;
+}
+
+String StringPool::Intern(const std::string_view value)
+{
+    const std::shared_lock<std::shared_mutex> lifetime(g_lifetimeMutex);
+    Pool* pool = g_pool.load(std::memory_order_acquire);
+    if (pool == nullptr) {
+        return String(value);
+    }
+
+    const size_t hash = std::hash<std::string_view>{}(value);
+    PoolShard& shard  = pool->shards[hash % SHARD_COUNT];
+
+    const std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.values.find(value);
+    if (it == shard.values.end()) {
+        // The arena copy is NUL-terminated and never moves, so the set can key on views of it
+        const char* data = shard.arena.Copy(value);
+        it               = shard.values.emplace(data, value.size()).first;
+    }
+    return String::MakeInterned(it->data(), it->size());
+}
+
+size_t StringPool::GetCount()
+{
+    const std::shared_lock<std::shared_mutex> lifetime(g_lifetimeMutex);
+    Pool* pool = g_pool.load(std::memory_order_acquire);
+    if (pool == nullptr) {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (PoolShard& shard : pool->shards) {
+        const std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.values.size();
+    }
+    return count;
+}
+
+size_t StringPool::GetBytesUsed()
+{
+    const std::shared_lock<std::shared_mutex> lifetime(g_lifetimeMutex);
+    Pool* pool = g_pool.load(std::memory_order_acquire);
+    if (pool == nullptr) {
+        return 0;
+    }
+
+    size_t bytes = 0;
+    for (PoolShard& shard : pool->shards) {
+        const std::lock_guard<std::mutex> lock(shard.mutex);
+        bytes += shard.arena.GetBytesUsed();
+    }
+    return bytes;
+}
+} // namespace ultralove::p3::runtime
@@ -0,0 +1,62 @@
+///
+// \file runtimestringpool.h
+// \brief String interning pool for the P3 Model library
+// \details Process-wide pool that stores each distinct string value exactly once
+//
+
+#ifndef __P3_RUNTIME_STRING_POOL_H_INCL__
+#define __P3_RUNTIME_STRING_POOL_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "runtimestring.h"
+#include <cstddef>
+#include <string_view>
+
+namespace ultralove::p3::runtime {
+/// \brief Process-wide string interning pool
+/// \details Low-cardinality fields such as languages, categories, MIME types, contribution types and
+/// licenses repeat the same few hundred values across a whole catalog. Interning them stores every
+/// distinct value once; all interned strings with equal contents share one immutable buffer, so
+/// comparing two interned strings is a single pointer comparison.
+///
+/// The pool is created by Model::Initialize() and destroyed by Model::Shutdown(). Interned strings
+/// must not be used after Shutdown(). While the pool is not initialized, Intern() returns ordinary
+/// strings. All functions are thread-safe; Shutdown() waits for calls that use the pool to finish.
+struct StringPool
+{
+    /// \brief Create the process-wide pool
+    /// \return True if the pool is available, also when it already was
+    static bool Initialize();
+
+    /// \brief Destroy the process-wide pool and release all interned values
+    static void Shutdown();
+
+    /// \brief Check whether the pool is available
+    /// \return True between Initialize() and Shutdown()
+    static bool IsInitialized() noexcept;
+
+    /// \brief Intern a character sequence
+    /// \param value Characters to intern
+    /// \return Interned string sharing its buffer with all equal interned strings
+    static String Intern(const std::string_view value);
+
+    /// \brief Get the number of distinct values in the pool
+    /// \return Number of interned values
+    static size_t GetCount();
+
+    /// \brief Get the number of bytes used for interned characters
+    /// \return Byte count including terminators
+    static size_t GetBytesUsed();
+
+    // Deleted constructors and assignment operators - this is a utility struct
+    StringPool()                             = delete;
+    virtual ~StringPool()                    = delete;
+    StringPool(const StringPool&)            = delete;
+    StringPool& operator=(const StringPool&) = delete;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_STRING_POOL_H_INCL__
@@ -0,0 +1,227 @@
+///
+// \file runtimetaskpool.cpp
+// \brief Work-stealing thread pool implementation
+// \details Per-worker deques, stealing and helping joins
+//
+
+#include "runtimetaskpool.h"
+
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <utility>
+
+namespace ultralove::p3::runtime {
+struct TaskPool::Entry
+{
+    Task task;
+    TaskGroup* group;
+};
+
+struct TaskPool::Worker
+{
+    TaskContext context;
+    std::mutex mutex;
+    std::deque<Entry> entries;
+    std::thread thread;
+    uint64_t random;
+};
+
+namespace {
+// Worker running on the calling thread and the pool it belongs to
+thread_local void* t_pool   = nullptr;
+thread_local void* t_worker = nullptr;
+} // namespace
+
+TaskPool::TaskPool(const size_t concurrency)
+{
+    const size_t count = (concurrency > 0) ? concurrency : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+        workers_.back()->context.worker = i;
+        workers_.back()->context.pool   = this;
+        workers_.back()->random         = 0x9e3779b97f4a7c15ull * (i + 1);
+    }
+    // Start the threads only once all deques exist, they steal from each other right away
+    try {
+        for (const auto& worker : workers_) {
+            worker->thread = std::thread([this, &self = *worker] {
+                Main(self);
+            });
+        }
+    }
+    catch (...) {
+        // The destructor does not run, and a thread left joinable would terminate the process
+        Stop();
+        throw;
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    Stop();
+}
+
+void TaskPool::Run(TaskGroup& group, Task task)
+{
+    group.pending_.fetch_add(1);
+    Worker* worker = (t_pool == this) ? static_cast<Worker*>(t_worker) : workers_[next_.fetch_add(1) % workers_.size()].get();
+    {
+        const std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->entries.push_back(Entry{std::move(task), &group});
+    }
+    queued_.fetch_add(1);
+    Notify();
+}
+
+void TaskPool::Wait(TaskGroup& group)
+{
+    if (t_pool == this) {
+        // Help instead of blocking, the tasks of the group may sit in this worker's own deque
+        Worker& worker = *static_cast<Worker*>(t_worker);
+        while (group.pending_.load() > 0) {
+            if (Execute(worker)) {
+                continue;
+            }
+            // The rest of the group runs on other workers, sleep until it is done or new work arrives
+            std::unique_lock<std::mutex> lock(idleMutex_);
+            sleeping_.fetch_add(1);
+            idle_.wait(lock, [this, &group] {
+                return (queued_.load() > 0) || (group.pending_.load() == 0);
+            });
+            sleeping_.fetch_sub(1);
+        }
+    }
+    // The last task notifies while holding the mutex, taking it here keeps the group alive until then
+    std::unique_lock<std::mutex> lock(group.mutex_);
+    group.done_.wait(lock, [&group] {
+        return group.pending_.load() == 0;
+    });
+    if (group.exception_ != nullptr) {
+        std::rethrow_exception(std::exchange(group.exception_, nullptr));
+    }
+}
+
+void TaskPool::ResetArenas() noexcept
+{
+    for (const auto& worker : workers_) {
+        worker->context.arena.Reset();
+    }
+}
+
+TaskContext* TaskPool::GetCurrentContext() const noexcept
+{
+    return (t_pool == this) ? &static_cast<Worker*>(t_worker)->context : nullptr;
+}
+
+void TaskPool::Stop() noexcept
+{
+    {
+        const std::lock_guard<std::mutex> lock(idleMutex_);
+        stopping_ = true;
+    }
+    idle_.notify_all();
+    for (const auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void TaskPool::Main(Worker& worker)
+{
+    t_pool   = this;
+    t_worker = &worker;
+    for (;;) {
+        if (Execute(worker)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(idleMutex_);
+        sleeping_.fetch_add(1);
+        idle_.wait(lock, [this] {
+            return stopping_ || (queued_.load() > 0);
+        });
+        sleeping_.fetch_sub(1);
+        if (stopping_ && (queued_.load() == 0)) {
+            return;
+        }
+    }
+}
+
+bool TaskPool::Execute(Worker& worker)
+{
+    Entry entry;
+    bool found = false;
+    {
+        // Newest own task first, it is the most likely to be in the cache
+        const std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.entries.empty() == false) {
+            entry = std::move(worker.entries.back());
+            worker.entries.pop_back();
+            found = true;
+        }
+    }
+    if (found == false) {
+        // Oldest task of another worker, starting at a random victim
+        worker.random ^= worker.random << 13;
+        worker.random ^= worker.random >> 7;
+        worker.random ^= worker.random << 17;
+        const size_t count = workers_.size();
+        const size_t first = static_cast<size_t>(worker.random % count);
+        for (size_t i = 0; (i < count) && (found == false); ++i) {
+            Worker& victim = *workers_[(first + i) % count];
+            if (&victim == &worker) {
+                continue;
+            }
+            const std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.entries.empty() == false) {
+                entry = std::move(victim.entries.front());
+                victim.entries.pop_front();
+                found = true;
+            }
+        }
+    }
+    if (found == false) {
+        return false;
+    }
+    queued_.fetch_sub(1);
+
+    std::exception_ptr exception;
+    try {
+        entry.task(worker.context);
+    }
+    catch (...) {
+        exception = std::current_exception();
+    }
+    entry.task = nullptr;
+
+    TaskGroup& group = *entry.group;
+    bool done        = false;
+    {
+        const std::lock_guard<std::mutex> lock(group.mutex_);
+        if ((exception != nullptr) && (group.exception_ == nullptr)) {
+            group.exception_ = exception;
+        }
+        if (group.pending_.fetch_sub(1) == 1) {
+            group.done_.notify_all();
+            done = true;
+        }
+    }
+    // Workers joining a group sleep with the idle ones, see Wait(); the group may be gone by now
+    if (done && (sleeping_.load() > 0)) {
+        const std::lock_guard<std::mutex> lock(idleMutex_);
+        idle_.notify_all();
+    }
+    return true;
+}
+
+void TaskPool::Notify()
+{
+    // Pairs with the check of queued_ under idleMutex_ in Main(), so no wakeup is lost
+    if (sleeping_.load() > 0) {
+        const std::lock_guard<std::mutex> lock(idleMutex_);
+        idle_.notify_one();
+    }
+}
+} // namespace ultralove::p3::runtime
@@ -0,0 +1,143 @@
+///
+// \file runtimetaskpool.h
+// \brief Work-stealing thread pool for the P3 Model library
+// \details Fork-join task execution with per-worker arenas and output buffers
+//
+
+#ifndef __P3_RUNTIME_TASK_POOL_H_INCL__
+#define __P3_RUNTIME_TASK_POOL_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "runtimearena.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ultralove::p3::runtime {
+class TaskPool;
+
+/// \brief Per-thread state handed to every task
+/// \details Every worker owns one context. Tasks use its arena for allocations that must live until
+/// the owner of the pool resets the arenas, and its buffer as scratch output that keeps its capacity
+/// from task to task. A task that waits for other tasks may run them on the same worker in the
+/// meantime, so the buffer contents do not survive TaskPool::Wait().
+struct TaskContext
+{
+    /// \brief Index of the worker, 0 for a context outside of a pool
+    size_t worker = 0;
+
+    /// \brief Pool the task runs in, nullptr for a context outside of a pool
+    TaskPool* pool = nullptr;
+
+    /// \brief Arena of the worker
+    Arena arena;
+
+    /// \brief Output buffer of the worker
+    std::string buffer;
+};
+
+/// \brief Set of tasks that are waited for together
+/// \details A group must outlive all tasks added to it and must not be destroyed before
+/// TaskPool::Wait() returned.
+class TaskGroup
+{
+public:
+    /// \brief Create an empty group
+    TaskGroup() = default;
+
+    /// \brief Destroy the group
+    virtual ~TaskGroup() = default;
+
+    TaskGroup(const TaskGroup&)            = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+private:
+    friend class TaskPool;
+
+    std::atomic<size_t> pending_{0};
+    std::mutex mutex_;
+    std::condition_variable done_;
+    std::exception_ptr exception_;
+};
+
+/// \brief Work-stealing thread pool
+/// \details Every worker has its own task deque. Tasks added by a worker go to the back of its own
+/// deque and are taken from the back again, so nested work stays hot in the cache of the thread that
+/// created it; idle workers steal from the front of other deques, which holds the oldest and
+/// usually largest tasks. Tasks added from outside the pool are spread round-robin.
+///
+/// A worker that waits for a group keeps executing tasks until the group is done, so tasks can fork
+/// and join further tasks without blocking a thread; it only sleeps while the rest of the group runs
+/// elsewhere and there is nothing to take. A thread outside the pool that waits is blocked. An exception thrown by a task is rethrown by Wait(); further tasks of the group still
+/// run. Run() and Wait() are thread-safe.
+class TaskPool
+{
+public:
+    /// \brief Task signature
+    using Task = std::function<void(TaskContext&)>;
+
+    /// \brief Start the workers
+    /// \details Throws std::system_error if a worker thread cannot be started; the workers started so
+    /// far are stopped again.
+    /// \param concurrency Number of worker threads, 0 for one per hardware thread
+    explicit TaskPool(const size_t concurrency = 0);
+
+    /// \brief Run all remaining tasks and stop the workers
+    virtual ~TaskPool();
+
+    TaskPool(const TaskPool&)            = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /// \brief Get the number of worker threads
+    /// \return Number of workers
+    size_t GetConcurrency() const noexcept
+    {
+        return workers_.size();
+    }
+
+    /// \brief Add a task to a group
+    /// \param group Group to add the task to
+    /// \param task Task to run
+    void Run(TaskGroup& group, Task task);
+
+    /// \brief Wait until all tasks of a group are done
+    /// \param group Group to wait for
+    void Wait(TaskGroup& group);
+
+    /// \brief Reset the arenas of all workers
+    /// \details Invalidates everything allocated from them. Only call this while no task runs.
+    void ResetArenas() noexcept;
+
+    /// \brief Get the context of the calling worker
+    /// \return Context of the worker, nullptr if the calling thread is not a worker of this pool
+    TaskContext* GetCurrentContext() const noexcept;
+
+private:
+    struct Worker;
+    struct Entry;
+
+    void Stop() noexcept;
+    void Main(Worker& worker);
+    bool Execute(Worker& worker);
+    void Notify();
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> sleeping_{0};
+    std::atomic<size_t> next_{0};
+    std::mutex idleMutex_;
+    std::condition_variable idle_;
+    bool stopping_ = false;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_TASK_POOL_H_INCL__
@@ -0,0 +1,427 @@
+///
+// \file runtimetextdictionary.cpp
+// \brief Shared-dictionary text compression implementation
+// \details Dictionary training, sequence encoding and decoding, chunked storage
+//
+
+#include "runtimetextdictionary.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace ultralove::p3::runtime {
+namespace {
+// Encoded values are a series of sequences. A sequence starts with a token, literal count in the
+// upper and match length - MIN_MATCH in the lower four bits; a nibble of 15 is followed by further
+// bytes that are added to it, 255 meaning another byte follows. Then come the literals, then the
+// match distance as two bytes, low byte first, then the extension bytes of the match length. The
+// last sequence ends after its literals.
+constexpr size_t MIN_MATCH      = 4;
+constexpr size_t MAX_DISTANCE   = TextDictionary::MAX_CAPACITY;
+constexpr uint32_t NIBBLE_LIMIT = 15;
+
+constexpr unsigned DICTIONARY_HASH_BITS = 16;
+constexpr unsigned MIN_VALUE_HASH_BITS  = 8;
+constexpr unsigned MAX_VALUE_HASH_BITS  = 14;
+
+// Training looks at 8-byte substrings and picks passages of SEGMENT_SIZE bytes
+constexpr size_t TRAINING_SUBSTRING  = 8;
+constexpr size_t SEGMENT_SIZE        = 256;
+constexpr unsigned TRAINING_BITS     = 20;
+constexpr size_t MAX_TRAINING_BYTES  = 16 * 1024 * 1024;
+
+// Record header of DictionaryTextStore: encoded size, the top bit marks values kept as they are
+constexpr uint32_t RAW_RECORD = 0x80000000u;
+
+uint32_t Load32(const char* data) noexcept
+{
+    uint32_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint64_t Load64(const char* data) noexcept
+{
+    uint64_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+constexpr uint32_t Hash4(const uint32_t sequence, const unsigned bits) noexcept
+{
+    return (sequence * 2654435761u) >> (32 - bits);
+}
+
+// Number of equal bytes at the start of lhs and rhs, at most limit
+size_t CountEqual(const char* lhs, const char* rhs, const size_t limit) noexcept
+{
+    size_t count = 0;
+    while ((count + sizeof(uint64_t) <= limit) && (Load64(lhs + count) == Load64(rhs + count))) {
+        count += sizeof(uint64_t);
+    }
+    while ((count < limit) && (lhs[count] == rhs[count])) {
+        ++count;
+    }
+    return count;
+}
+
+void AppendLength(std::string& encoded, size_t length)
+{
+    while (length >= 255) {
+        encoded.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    encoded.push_back(static_cast<char>(length));
+}
+
+void AppendSequence(std::string& encoded, const std::string_view literals, const size_t matchLength, const size_t distance)
+{
+    const size_t literalCount = literals.size();
+    const size_t matchCode    = (matchLength == 0) ? 0 : (matchLength - MIN_MATCH);
+    const uint32_t token      = (std::min<size_t>(literalCount, NIBBLE_LIMIT) << 4) | std::min<size_t>(matchCode, NIBBLE_LIMIT);
+    encoded.push_back(static_cast<char>(token));
+    if (literalCount >= NIBBLE_LIMIT) {
+        AppendLength(encoded, literalCount - NIBBLE_LIMIT);
+    }
+    encoded.append(literals);
+    if (matchLength == 0) {
+        return;
+    }
+    encoded.push_back(static_cast<char>(distance & 0xff));
+    encoded.push_back(static_cast<char>(distance >> 8));
+    if (matchCode >= NIBBLE_LIMIT) {
+        AppendLength(encoded, matchCode - NIBBLE_LIMIT);
+    }
+}
+
+bool ReadLength(const uint8_t*& current, const uint8_t* end, size_t& length) noexcept
+{
+    uint8_t next = 255;
+    while (next == 255) {
+        if (current == end) {
+            return false;
+        }
+        next = *current++;
+        length += next;
+    }
+    return true;
+}
+} // namespace
+
+TextDictionary::TextDictionary() = default;
+
+TextDictionary::TextDictionary(const std::string_view content) :
+    content_((content.size() > MAX_CAPACITY) ? content.substr(content.size() - MAX_CAPACITY) : content)
+{
+    if (content_.size() < MIN_MATCH) {
+        return;
+    }
+    // Later positions overwrite earlier ones, they are closer to the value
+    positions_.assign(size_t{1} << DICTIONARY_HASH_BITS, 0);
+    for (size_t position = 0; position + MIN_MATCH <= content_.size(); ++position) {
+        positions_[Hash4(Load32(content_.data() + position), DICTIONARY_HASH_BITS)] = static_cast<uint32_t>(position + 1);
+    }
+}
+
+TextDictionary TextDictionary::Train(const std::vector<std::string_view>& samples, const size_t capacity)
+{
+    struct Counter
+    {
+        uint32_t count  = 0;
+        uint32_t sample = UINT32_MAX;
+    };
+    struct Segment
+    {
+        uint64_t score;
+        std::string_view text;
+    };
+    const auto hash = [](const char* data) {
+        return static_cast<size_t>((Load64(data) * 0x9e3779b97f4a7c15ull) >> (64 - TRAINING_BITS));
+    };
+
+    // Count in how many samples every substring occurs
+    std::vector<std::string_view> used;
+    size_t total = 0;
+    for (const std::string_view sample : samples) {
+        if ((sample.size() >= TRAINING_SUBSTRING) && (total + sample.size() <= MAX_TRAINING_BYTES)) {
+            used.push_back(sample);
+            total += sample.size();
+        }
+    }
+    std::vector<Counter> counters(size_t{1} << TRAINING_BITS);
+    for (size_t index = 0; index < used.size(); ++index) {
+        for (size_t position = 0; position + TRAINING_SUBSTRING <= used[index].size(); ++position) {
+            Counter& counter = counters[hash(used[index].data() + position)];
+            if (counter.sample != index) {
+                counter.sample = static_cast<uint32_t>(index);
+                ++counter.count;
+            }
+        }
+    }
+
+    // One passage per slice of the samples keeps the dictionary from collecting variations of the
+    // same passage; the substrings of a chosen passage stop counting for the following slices
+    const size_t limit    = std::min(capacity, MAX_CAPACITY);
+    const size_t epochs   = std::max<size_t>(1, limit / SEGMENT_SIZE);
+    const size_t epochLen = std::max<size_t>(1, total / epochs);
+    std::vector<Segment> segments;
+    std::vector<uint64_t> prefix;
+    Segment best{0, {}};
+    const auto choose = [&counters, &segments, &hash](Segment& segment) {
+        if (segment.score == 0) {
+            return;
+        }
+        for (size_t position = 0; position + TRAINING_SUBSTRING <= segment.text.size(); ++position) {
+            counters[hash(segment.text.data() + position)].count = 0;
+        }
+        segments.push_back(segment);
+        segment = Segment{0, {}};
+    };
+    size_t epoch = 0;
+    size_t start = 0;
+    for (const std::string_view sample : used) {
+        // A sample belongs to the slice its first byte falls into
+        const size_t sampleEpoch = std::min(epochs - 1, start / epochLen);
+        if (sampleEpoch != epoch) {
+            choose(best);
+            epoch = sampleEpoch;
+        }
+        start += sample.size();
+
+        const size_t window     = std::min(SEGMENT_SIZE, sample.size());
+        const size_t substrings = sample.size() - TRAINING_SUBSTRING + 1;
+        prefix.assign(substrings + 1, 0);
+        for (size_t position = 0; position < substrings; ++position) {
+            const uint32_t count = counters[hash(sample.data() + position)].count;
+            prefix[position + 1] = prefix[position] + ((count >= 2) ? count : 0);
+        }
+        const size_t windowSubstrings = window - TRAINING_SUBSTRING + 1;
+        for (size_t first = 0; first + window <= sample.size(); ++first) {
+            const uint64_t score = prefix[first + windowSubstrings] - prefix[first];
+            if (score > best.score) {
+                best = Segment{score, sample.substr(first, window)};
+            }
+        }
+    }
+    choose(best);
+
+    // The most valuable passages go last, closest to the value
+    std::stable_sort(segments.begin(), segments.end(), [](const Segment& lhs, const Segment& rhs) {
+        return lhs.score < rhs.score;
+    });
+    std::string content;
+    for (const Segment& segment : segments) {
+        content.append(segment.text);
+    }
+    if (content.size() > limit) {
+        content.erase(0, content.size() - limit);
+    }
+    return TextDictionary(content);
+}
+
+void TextDictionary::Compress(const std::string_view value, std::string& encoded) const
+{
+    const char* input         = value.data();
+    const size_t size         = value.size();
+    const size_t dictionary   = content_.size();
+    const bool hasDictionary  = positions_.empty() == false;
+
+    unsigned bits = MIN_VALUE_HASH_BITS;
+    while ((bits < MAX_VALUE_HASH_BITS) && ((size_t{1} << bits) < size)) {
+        ++bits;
+    }
+    std::vector<uint32_t> positions(size_t{1} << bits, 0);
+
+    size_t anchor   = 0;
+    size_t position = 0;
+    while (position + MIN_MATCH <= size) {
+        const uint32_t sequence = Load32(input + position);
+        size_t length           = 0;
+        size_t distance         = 0;
+
+        // Earlier in the value
+        uint32_t& slot = positions[Hash4(sequence, bits)];
+        if (slot != 0) {
+            const size_t candidate = slot - 1;
+            if ((position - candidate <= MAX_DISTANCE) && (Load32(input + candidate) == sequence)) {
+                length   = MIN_MATCH + CountEqual(input + candidate + MIN_MATCH, input + position + MIN_MATCH, size - position - MIN_MATCH);
+                distance = position - candidate;
+            }
+        }
+        slot = static_cast<uint32_t>(position + 1);
+
+        // In the dictionary; matches stop at its end
+        if (hasDictionary) {
+            const uint32_t entry = positions_[Hash4(sequence, DICTIONARY_HASH_BITS)];
+            if (entry != 0) {
+                const size_t candidate = entry - 1;
+                const size_t reach     = dictionary - candidate + position;
+                if ((reach <= MAX_DISTANCE) && (Load32(content_.data() + candidate) == sequence)) {
+                    const size_t limit = std::min(dictionary - candidate, size - position) - MIN_MATCH;
+                    const size_t found = MIN_MATCH + CountEqual(content_.data() + candidate + MIN_MATCH, input + position + MIN_MATCH, limit);
+                    if (found > length) {
+                        length   = found;
+                        distance = reach;
+                    }
+                }
+            }
+        }
+
+        if (length == 0) {
+            ++position;
+            continue;
+        }
+        AppendSequence(encoded, value.substr(anchor, position - anchor), length, distance);
+        for (size_t covered = position + 1; (covered < position + length) && (covered + MIN_MATCH <= size); ++covered) {
+            positions[Hash4(Load32(input + covered), bits)] = static_cast<uint32_t>(covered + 1);
+        }
+        position += length;
+        anchor = position;
+    }
+    AppendSequence(encoded, value.substr(anchor), 0, 0);
+}
+
+bool TextDictionary::Decompress(const std::string_view dictionary, const std::string_view encoded, char* buffer, const size_t length) noexcept
+{
+    if (length > GetMaxDecodedLength(encoded.size())) {
+        return false;
+    }
+
+    const uint8_t* current = reinterpret_cast<const uint8_t*>(encoded.data());
+    const uint8_t* end     = current + encoded.size();
+    char* output           = buffer;
+    char* outputEnd        = buffer + length;
+    while (current != end) {
+        const uint32_t token = *current++;
+        size_t literals      = token >> 4;
+        if ((literals == NIBBLE_LIMIT) && (ReadLength(current, end, literals) == false)) {
+            return false;
+        }
+        if ((literals > static_cast<size_t>(end - current)) || (literals > static_cast<size_t>(outputEnd - output))) {
+            return false;
+        }
+        std::memcpy(output, current, literals);
+        output += literals;
+        current += literals;
+        if (current == end) {
+            break;
+        }
+
+        if (end - current < 2) {
+            return false;
+        }
+        const size_t distance = static_cast<size_t>(current[0]) | (static_cast<size_t>(current[1]) << 8);
+        current += 2;
+        size_t match = token & NIBBLE_LIMIT;
+        if ((match == NIBBLE_LIMIT) && (ReadLength(current, end, match) == false)) {
+            return false;
+        }
+        match += MIN_MATCH;
+        const size_t produced = static_cast<size_t>(output - buffer);
+        if ((distance == 0) || (distance > produced + dictionary.size()) || (match > static_cast<size_t>(outputEnd - output))) {
+            return false;
+        }
+
+        // The part of the match in the dictionary, the rest continues at the start of the value
+        const char* source = output - distance;
+        if (distance > produced) {
+            const size_t start = dictionary.size() - (distance - produced);
+            const size_t count = std::min(match, dictionary.size() - start);
+            std::memcpy(output, dictionary.data() + start, count);
+            output += count;
+            match -= count;
+            source = buffer;
+        }
+        if (static_cast<size_t>(output - source) >= match) {
+            std::memcpy(output, source, match);
+            output += match;
+        }
+        else {
+            // Overlapping matches repeat the bytes just written
+            for (size_t i = 0; i < match; ++i) {
+                *output++ = source[i];
+            }
+        }
+    }
+    return output == outputEnd;
+}
+
+DictionaryTextStore::DictionaryTextStore(std::shared_ptr<const TextDictionary> dictionary, const size_t cacheCapacity) :
+    TextStore(cacheCapacity), dictionary_((dictionary != nullptr) ? std::move(dictionary) : std::make_shared<const TextDictionary>())
+{
+    report_.dictionaryBytes = dictionary_->GetSize();
+}
+
+String DictionaryTextStore::Compress(const std::string_view value)
+{
+    if (value.size() <= String::INLINE_CAPACITY) {
+        return String(value);
+    }
+
+    std::string encoded;
+    dictionary_->Compress(value, encoded);
+    const bool raw               = encoded.size() >= value.size();
+    const std::string_view bytes = raw ? value : std::string_view(encoded);
+    const size_t recordSize      = sizeof(uint32_t) + bytes.size();
+    if (bytes.size() >= RAW_RECORD) {
+        return String(value);
+    }
+
+    const std::lock_guard<std::mutex> lock(chunkMutex_);
+    if (chunks_.empty() || (chunks_.back().size - chunks_.back().used < recordSize)) {
+        Chunk chunk;
+        chunk.size = std::max(CHUNK_SIZE, recordSize);
+        chunk.data.reset(new char[chunk.size]);
+        chunks_.push_back(std::move(chunk));
+    }
+    Chunk& chunk           = chunks_.back();
+    const uint32_t header  = static_cast<uint32_t>(bytes.size()) | (raw ? RAW_RECORD : 0);
+    const uint64_t locator = (static_cast<uint64_t>(chunks_.size() - 1) << 32) | chunk.used;
+    std::memcpy(chunk.data.get() + chunk.used, &header, sizeof(header));
+    std::memcpy(chunk.data.get() + chunk.used + sizeof(header), bytes.data(), bytes.size());
+    chunk.used += recordSize;
+
+    ++report_.values;
+    report_.rawBytes += value.size();
+    report_.storedBytes += recordSize;
+    return MakeLazy(locator, value.size());
+}
+
+TextCompressionReport DictionaryTextStore::GetReport() const
+{
+    const std::lock_guard<std::mutex> lock(chunkMutex_);
+    return report_;
+}
+
+bool DictionaryTextStore::Read(const uint64_t locator, char* buffer, const size_t length)
+{
+    const size_t index  = static_cast<size_t>(locator >> 32);
+    const size_t offset = static_cast<size_t>(locator & 0xffffffffu);
+    const char* record  = nullptr;
+    size_t available    = 0;
+    {
+        const std::lock_guard<std::mutex> lock(chunkMutex_);
+        if ((index >= chunks_.size()) || (offset + sizeof(uint32_t) > chunks_[index].used)) {
+            return false;
+        }
+        record    = chunks_[index].data.get() + offset;
+        available = chunks_[index].used - offset - sizeof(uint32_t);
+    }
+
+    // Records are immutable once written
+    const uint32_t header = Load32(record);
+    const size_t size     = header & ~RAW_RECORD;
+    if (size > available) {
+        return false;
+    }
+    if ((header & RAW_RECORD) != 0) {
+        if (size != length) {
+            return false;
+        }
+        std::memcpy(buffer, record + sizeof(header), length);
+        return true;
+    }
+    return dictionary_->Decompress(std::string_view(record + sizeof(header), size), buffer, length);
+}
+} // namespace ultralove::p3::runtime
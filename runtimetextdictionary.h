@@ -0,0 +1,199 @@
+///
+// \file runtimetextdictionary.h
+// \brief Shared-dictionary text compression
+// \details Dictionary training, an LZ77 codec that refers into the dictionary and a compressed text store
+//
+
+#ifndef __P3_RUNTIME_TEXT_DICTIONARY_H_INCL__
+#define __P3_RUNTIME_TEXT_DICTIONARY_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "runtimestring.h"
+#include "runtimetextstore.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ultralove::p3::runtime {
+/// \brief Compression dictionary shared by the texts of one podcast
+/// \details Show notes of one podcast repeat the same sponsor reads, links and footers. A dictionary
+/// holds such passages once; Compress() encodes a value as LZ77 sequences whose matches may refer
+/// back into the dictionary as if it preceded the value, so a passage found in the dictionary costs
+/// a few bytes in every value. Decompression only copies literals and matches and is bounds-checked
+/// against the encoded and the decoded size, so damaged input fails instead of overrunning.
+///
+/// Matches reach at most MAX_CAPACITY bytes back, which also limits the size of a dictionary.
+/// Dictionaries are immutable after construction and can be used from several threads at once.
+class TextDictionary
+{
+public:
+    /// \brief Size of a dictionary trained unless told otherwise
+    static constexpr size_t DEFAULT_CAPACITY = 32 * 1024;
+
+    /// \brief Maximum size of a dictionary, the reach of a match
+    static constexpr size_t MAX_CAPACITY = 65535;
+
+    /// \brief Most bytes one encoded byte decodes to, reached by the length extensions of a match
+    static constexpr size_t MAX_EXPANSION = 255;
+
+    /// \brief Get the longest value an encoded size can decode to
+    /// \details Lets readers reject damaged lengths before they allocate a buffer for the value
+    /// \param encodedSize Size of the encoded value in bytes
+    /// \return Upper bound of the decoded length
+    static constexpr uint64_t GetMaxDecodedLength(const uint64_t encodedSize) noexcept
+    {
+        return encodedSize * MAX_EXPANSION;
+    }
+
+    /// \brief Create an empty dictionary, values are compressed on their own
+    TextDictionary();
+
+    /// \brief Create a dictionary from its content
+    /// \param content Dictionary bytes, only the last MAX_CAPACITY bytes are used
+    explicit TextDictionary(const std::string_view content);
+
+    /// \brief Destroy the dictionary
+    virtual ~TextDictionary() = default;
+
+    TextDictionary(const TextDictionary&)            = delete;
+    TextDictionary& operator=(const TextDictionary&) = delete;
+    TextDictionary(TextDictionary&&)                 = default;
+    TextDictionary& operator=(TextDictionary&&)      = default;
+
+    /// \brief Train a dictionary on sample values
+    /// \details Picks the passages whose 8-byte substrings occur in the most samples, one per slice
+    /// of the samples, and orders them so the most valuable passages are closest to the value.
+    /// Substrings that occur in a single sample are not considered.
+    /// \param samples Sample values, e.g. all episode descriptions of a podcast
+    /// \param capacity Maximum size of the dictionary, at most MAX_CAPACITY
+    /// \return Trained dictionary, empty if the samples share nothing
+    static TextDictionary Train(const std::vector<std::string_view>& samples, const size_t capacity = DEFAULT_CAPACITY);
+
+    /// \brief Get the content of the dictionary
+    /// \return Dictionary bytes
+    std::string_view GetContent() const noexcept
+    {
+        return content_;
+    }
+
+    /// \brief Get the size of the dictionary
+    /// \return Size in bytes
+    size_t GetSize() const noexcept
+    {
+        return content_.size();
+    }
+
+    /// \brief Compress a value
+    /// \param value Characters to compress
+    /// \param encoded Receives the encoded value, appended
+    void Compress(const std::string_view value, std::string& encoded) const;
+
+    /// \brief Decompress a value compressed with this dictionary
+    /// \param encoded Encoded value
+    /// \param buffer Receives exactly length bytes
+    /// \param length Length of the decoded value
+    /// \return True if the encoded value decodes to exactly length bytes
+    bool Decompress(const std::string_view encoded, char* buffer, const size_t length) const noexcept
+    {
+        return Decompress(content_, encoded, buffer, length);
+    }
+
+    /// \brief Decompress a value compressed with a dictionary of the given content
+    /// \param dictionary Content of the dictionary the value was compressed with
+    /// \param encoded Encoded value
+    /// \param buffer Receives exactly length bytes
+    /// \param length Length of the decoded value
+    /// \return True if the encoded value decodes to exactly length bytes
+    static bool Decompress(const std::string_view dictionary, const std::string_view encoded, char* buffer, const size_t length) noexcept;
+
+private:
+    std::string content_;
+    // Last position + 1 of every hashed 4-byte sequence of the content, 0 if there is none
+    std::vector<uint32_t> positions_;
+};
+
+/// \brief Compression figures of a DictionaryTextStore
+struct TextCompressionReport
+{
+    /// \brief Number of values stored
+    size_t values = 0;
+
+    /// \brief Bytes of the values before compression
+    uint64_t rawBytes = 0;
+
+    /// \brief Bytes of the stored values including their record headers
+    uint64_t storedBytes = 0;
+
+    /// \brief Bytes of the dictionary
+    uint64_t dictionaryBytes = 0;
+
+    /// \brief Get the compression ratio, counting the dictionary
+    /// \return Raw bytes per stored byte, 1 if nothing was stored
+    double GetRatio() const noexcept
+    {
+        const uint64_t stored = storedBytes + dictionaryBytes;
+        return ((values == 0) || (stored == 0)) ? 1.0 : static_cast<double>(rawBytes) / static_cast<double>(stored);
+    }
+};
+
+/// \brief In-memory text store of dictionary-compressed values
+/// \details Compress() encodes a value with the dictionary of the store, keeps the encoded bytes in
+/// large chunks and returns a lazy string; the value is decompressed on access into the cache of
+/// the store, see TextStore. Values that do not get smaller are kept as they are. Use one store per
+/// podcast with a dictionary trained on that podcast. All functions are thread-safe.
+class DictionaryTextStore : public TextStore
+{
+public:
+    /// \brief Size of the chunks encoded values are kept in
+    static constexpr size_t CHUNK_SIZE = 256 * 1024;
+
+    /// \brief Create a store
+    /// \param dictionary Dictionary of the store
+    /// \param cacheCapacity Number of bytes the cache of decompressed values holds at most
+    explicit DictionaryTextStore(std::shared_ptr<const TextDictionary> dictionary, const size_t cacheCapacity = DEFAULT_CACHE_CAPACITY);
+
+    /// \brief Destroy the store, all lazy strings of the store become invalid
+    ~DictionaryTextStore() override = default;
+
+    /// \brief Compress a value
+    /// \param value Characters to store
+    /// \return Lazy string of the value; values that fit inline are returned as ordinary strings
+    String Compress(const std::string_view value);
+
+    /// \brief Get the dictionary of the store
+    /// \return Dictionary
+    const TextDictionary& GetDictionary() const noexcept
+    {
+        return *dictionary_;
+    }
+
+    /// \brief Get the compression figures of all values stored so far
+    /// \return Report
+    TextCompressionReport GetReport() const;
+
+protected:
+    bool Read(const uint64_t locator, char* buffer, const size_t length) override;
+
+private:
+    struct Chunk
+    {
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+        size_t used = 0;
+    };
+
+    std::shared_ptr<const TextDictionary> dictionary_;
+    mutable std::mutex chunkMutex_;
+    std::vector<Chunk> chunks_;
+    TextCompressionReport report_;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_TEXT_DICTIONARY_H_INCL__
@@ -0,0 +1,361 @@
+///
+// \file runtimetextstore.cpp
+// \brief Text store implementation
+// \details Value cache and positional file reads for POSIX and Windows
+//
+
+#include "runtimetextstore.h"
+
+#include <cerrno>
+#include <new>
+#include <utility>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ultralove::p3::runtime {
+TextStore::Pin::Pin(TextStore& store) : store_(store)
+{
+    const std::lock_guard<std::mutex> lock(store_.mutex_);
+    epoch_ = store_.epoch_;
+    ++store_.pins_[epoch_];
+}
+
+TextStore::Pin::~Pin()
+{
+    const std::lock_guard<std::mutex> lock(store_.mutex_);
+    const auto pin = store_.pins_.find(epoch_);
+    if (--pin->second == 0) {
+        store_.pins_.erase(pin);
+    }
+    store_.Reclaim(0);
+}
+
+String TextStore::MakeLazy(const uint64_t locator, const size_t length)
+{
+    return (length == 0) ? String() : String::MakeLazy(this, locator, length);
+}
+
+void TextStore::Trim()
+{
+    Evict(GetCapacity());
+}
+
+void TextStore::Clear()
+{
+    Evict(0);
+}
+
+size_t TextStore::GetCachedBytes() const
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+size_t TextStore::GetRetiredBytes() const
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return retiredBytes_;
+}
+
+std::string_view TextStore::Hydrate(const uint64_t locator, const size_t length) noexcept
+{
+    try {
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            const auto found = values_.find(locator);
+            if ((found != values_.end()) && (found->second.length == length)) {
+                recency_.splice(recency_.begin(), recency_, found->second.position);
+                return std::string_view(found->second.data.get(), length);
+            }
+        }
+
+        // Read without holding the lock, another thread may load the same value meanwhile
+        std::unique_ptr<char[]> data(new char[length + 1]);
+        if (Read(locator, data.get(), length) == false) {
+            failures_.fetch_add(1, std::memory_order_relaxed);
+            return std::string_view();
+        }
+        data[length] = '\0';
+        loads_.fetch_add(1, std::memory_order_relaxed);
+
+        const std::lock_guard<std::mutex> lock(mutex_);
+        auto [value, inserted] = values_.try_emplace(locator);
+        if (inserted == false) {
+            if (value->second.length == length) {
+                recency_.splice(recency_.begin(), recency_, value->second.position);
+                return std::string_view(value->second.data.get(), length);
+            }
+            // Same locator with another length, the cached value may still be in use and is kept
+            // until it is evicted; this one is not cached
+            failures_.fetch_add(1, std::memory_order_relaxed);
+            return std::string_view();
+        }
+        recency_.push_front(locator);
+        value->second.data     = std::move(data);
+        value->second.length   = length;
+        value->second.position = recency_.begin();
+        bytes_ += length;
+        const std::string_view result(value->second.data.get(), length);
+
+        // Keep the cache within its capacity, but never evict the value just loaded; unpinned views of
+        // recently evicted values stay valid for another capacity of evictions
+        const size_t capacity = GetCapacity();
+        Retire(capacity, 1);
+        Reclaim(capacity);
+        return result;
+    }
+    catch (const std::bad_alloc&) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        return std::string_view();
+    }
+}
+
+void TextStore::Evict(const size_t capacity)
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    Retire(capacity, 0);
+    Reclaim(0);
+}
+
+void TextStore::Retire(const size_t capacity, const size_t keep)
+{
+    if (bytes_ <= capacity) {
+        return;
+    }
+
+    // All values evicted in one go share an epoch; pins taken from now on cannot have seen them
+    while ((bytes_ > capacity) && (recency_.size() > keep)) {
+        const auto value      = values_.find(recency_.back());
+        RetiredValue& retired = retired_.emplace_back();
+        retired.data          = std::move(value->second.data);
+        retired.length        = value->second.length;
+        retired.epoch         = epoch_;
+        bytes_ -= value->second.length;
+        retiredBytes_ += value->second.length;
+        values_.erase(value);
+        recency_.pop_back();
+    }
+    ++epoch_;
+}
+
+void TextStore::Reclaim(const size_t keep)
+{
+    // A pin protects the values retired in or after its epoch
+    const uint64_t oldest = pins_.empty() ? UINT64_MAX : pins_.begin()->first;
+    while ((retiredBytes_ > keep) && (retired_.empty() == false) && (retired_.front().epoch < oldest)) {
+        retiredBytes_ -= retired_.front().length;
+        retired_.pop_front();
+    }
+}
+
+FileTextStore::~FileTextStore()
+{
+    Close();
+}
+
+#if defined(_WIN32)
+bool FileTextStore::Open(const char* path)
+{
+    Close();
+    if (path == nullptr) {
+        return false;
+    }
+
+    const HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size{};
+    if (::GetFileSizeEx(file, &size) == FALSE) {
+        ::CloseHandle(file);
+        return false;
+    }
+    file_ = file;
+    size_.store(static_cast<uint64_t>(size.QuadPart), std::memory_order_release);
+    return true;
+}
+
+bool FileTextStore::Create(const char* path)
+{
+    Close();
+    if (path == nullptr) {
+        return false;
+    }
+
+    const HANDLE file = ::CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    file_     = file;
+    writable_ = true;
+    return true;
+}
+
+void FileTextStore::Close() noexcept
+{
+    if (file_ != nullptr) {
+        ::CloseHandle(static_cast<HANDLE>(file_));
+    }
+    file_ = nullptr;
+    size_.store(0, std::memory_order_release);
+    writable_ = false;
+    Clear();
+}
+
+bool FileTextStore::IsOpen() const noexcept
+{
+    return file_ != nullptr;
+}
+
+bool FileTextStore::Append(const std::string_view value, String& lazy)
+{
+    if ((file_ == nullptr) || (writable_ == false)) {
+        return false;
+    }
+
+    const std::lock_guard<std::mutex> lock(appendMutex_);
+    const uint64_t offset = size_.load(std::memory_order_relaxed);
+    size_t written        = 0;
+    while (written < value.size()) {
+        OVERLAPPED position{};
+        position.Offset     = static_cast<DWORD>(offset + written);
+        position.OffsetHigh = static_cast<DWORD>((offset + written) >> 32);
+        const DWORD chunk   = static_cast<DWORD>((value.size() - written < 0x40000000) ? (value.size() - written) : 0x40000000);
+        DWORD count         = 0;
+        if ((::WriteFile(static_cast<HANDLE>(file_), value.data() + written, chunk, &count, &position) == FALSE) || (count == 0)) {
+            return false;
+        }
+        written += count;
+    }
+    size_.store(offset + value.size(), std::memory_order_release);
+    lazy = MakeLazy(offset, value.size());
+    return true;
+}
+
+bool FileTextStore::Read(const uint64_t locator, char* buffer, const size_t length)
+{
+    if ((file_ == nullptr) || (locator > GetSize()) || (length > GetSize() - locator)) {
+        return false;
+    }
+
+    size_t read = 0;
+    while (read < length) {
+        OVERLAPPED position{};
+        position.Offset     = static_cast<DWORD>(locator + read);
+        position.OffsetHigh = static_cast<DWORD>((locator + read) >> 32);
+        const DWORD chunk   = static_cast<DWORD>((length - read < 0x40000000) ? (length - read) : 0x40000000);
+        DWORD count         = 0;
+        if ((::ReadFile(static_cast<HANDLE>(file_), buffer + read, chunk, &count, &position) == FALSE) || (count == 0)) {
+            return false;
+        }
+        read += count;
+    }
+    return true;
+}
+#else
+bool FileTextStore::Open(const char* path)
+{
+    Close();
+    if (path == nullptr) {
+        return false;
+    }
+
+    const int file = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        return false;
+    }
+    struct stat status{};
+    if ((::fstat(file, &status) != 0) || (S_ISREG(status.st_mode) == false)) {
+        ::close(file);
+        return false;
+    }
+    file_ = file;
+    size_.store(static_cast<uint64_t>(status.st_size), std::memory_order_release);
+    return true;
+}
+
+bool FileTextStore::Create(const char* path)
+{
+    Close();
+    if (path == nullptr) {
+        return false;
+    }
+
+    const int file = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (file < 0) {
+        return false;
+    }
+    file_     = file;
+    writable_ = true;
+    return true;
+}
+
+void FileTextStore::Close() noexcept
+{
+    if (file_ >= 0) {
+        ::close(file_);
+    }
+    file_ = -1;
+    size_.store(0, std::memory_order_release);
+    writable_ = false;
+    Clear();
+}
+
+bool FileTextStore::IsOpen() const noexcept
+{
+    return file_ >= 0;
+}
+
+bool FileTextStore::Append(const std::string_view value, String& lazy)
+{
+    if ((file_ < 0) || (writable_ == false)) {
+        return false;
+    }
+
+    const std::lock_guard<std::mutex> lock(appendMutex_);
+    const uint64_t offset = size_.load(std::memory_order_relaxed);
+    size_t written        = 0;
+    while (written < value.size()) {
+        const ssize_t count = ::pwrite(file_, value.data() + written, value.size() - written, static_cast<off_t>(offset + written));
+        if ((count < 0) && (errno == EINTR)) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        written += static_cast<size_t>(count);
+    }
+    size_.store(offset + value.size(), std::memory_order_release);
+    lazy = MakeLazy(offset, value.size());
+    return true;
+}
+
+bool FileTextStore::Read(const uint64_t locator, char* buffer, const size_t length)
+{
+    if ((file_ < 0) || (locator > GetSize()) || (length > GetSize() - locator)) {
+        return false;
+    }
+
+    size_t read = 0;
+    while (read < length) {
+        const ssize_t count = ::pread(file_, buffer + read, length - read, static_cast<off_t>(locator + read));
+        if ((count < 0) && (errno == EINTR)) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        read += static_cast<size_t>(count);
+    }
+    return true;
+}
+#endif
+} // namespace ultralove::p3::runtime
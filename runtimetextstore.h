@@ -0,0 +1,243 @@
+///
+// \file runtimetextstore.h
+// \brief Text stores for lazy strings
+// \details Backing stores that load rarely read string values on access through a bounded cache
+//
+
+#ifndef __P3_RUNTIME_TEXT_STORE_H_INCL__
+#define __P3_RUNTIME_TEXT_STORE_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "runtimestring.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace ultralove::p3::runtime {
+/// \brief Backing store of lazy strings
+/// \details A lazy string (StringStorage::LAZY) holds a pointer to its store, a 64-bit locator and
+/// its length instead of its characters. The first access to its characters or length loads the
+/// value through Read() into the cache of the store; later accesses, through any string with the
+/// same locator, are served from the cache. Every load evicts the least recently used values beyond
+/// the capacity of the cache, so the cache stays bounded without calls to Trim().
+///
+/// Evicted values are retired rather than freed, and views obtained from lazy strings stay valid
+/// as follows:
+/// - While the thread holds a Pin on the store, none of the values it viewed are freed, whatever
+///   other threads load, trim or clear. Retired values are freed once no pin older than their
+///   eviction is held.
+/// - Without a pin, a view stays valid until the next Trim(), Clear() or release of a Pin on the
+///   store, or until more than the capacity of the cache has been evicted after its value, whichever
+///   comes first. This is only safe while a single thread uses the store.
+/// Threads that share a store should read lazy strings under a Pin, e.g. one per request or build.
+/// The store holds at most twice its capacity plus the values protected by pins.
+///
+/// Derived classes decide what a locator means, e.g. a file offset. If a value cannot be read, the
+/// string reads as empty and the value is read again on the next access. The store must outlive all
+/// lazy strings created by it. Loading, pinning and trimming are thread-safe; Read() may be called
+/// from several threads at once.
+class TextStore
+{
+public:
+    /// \brief Default number of bytes kept in the cache
+    static constexpr size_t DEFAULT_CACHE_CAPACITY = 64 * 1024 * 1024;
+
+    /// \brief Keeps the values viewed by the current thread alive
+    /// \details Values evicted while the pin is held are freed only after it is released. Pins are
+    /// cheap but take the lock of the store, so hold one per unit of work rather than per access.
+    class Pin
+    {
+    public:
+        /// \brief Pin the values of a store
+        /// \param store Store, must outlive the pin
+        explicit Pin(TextStore& store);
+
+        /// \brief Release the pin and free the retired values no other pin protects
+        ~Pin();
+
+        Pin(const Pin&)            = delete;
+        Pin& operator=(const Pin&) = delete;
+
+    private:
+        TextStore& store_;
+        uint64_t epoch_ = 0;
+    };
+
+    /// \brief Create a store
+    /// \param cacheCapacity Number of bytes the cache holds at most
+    explicit TextStore(const size_t cacheCapacity = DEFAULT_CACHE_CAPACITY) noexcept : capacity_(cacheCapacity) {}
+
+    /// \brief Destroy the store and its cache
+    virtual ~TextStore() = default;
+
+    TextStore(const TextStore&)            = delete;
+    TextStore& operator=(const TextStore&) = delete;
+
+    /// \brief Create a lazy string
+    /// \param locator Location of the value in the store
+    /// \param length Length of the value in bytes
+    /// \return Lazy string, an empty ordinary string if length is 0
+    String MakeLazy(const uint64_t locator, const size_t length);
+
+    /// \brief Evict the least recently used values until the cache fits its capacity
+    /// \details Frees the retired values that no Pin protects, which invalidates their unpinned views
+    void Trim();
+
+    /// \brief Evict all values
+    /// \details Frees the retired values that no Pin protects, which invalidates their unpinned views
+    void Clear();
+
+    /// \brief Set the number of bytes the cache holds at most
+    /// \param cacheCapacity Capacity in bytes, takes effect with the next load or Trim()
+    void SetCapacity(const size_t cacheCapacity) noexcept
+    {
+        capacity_.store(cacheCapacity, std::memory_order_relaxed);
+    }
+
+    /// \brief Get the number of bytes the cache holds at most
+    /// \return Capacity in bytes
+    size_t GetCapacity() const noexcept
+    {
+        return capacity_.load(std::memory_order_relaxed);
+    }
+
+    /// \brief Get the number of bytes held by the cache
+    /// \return Byte count of all cached values
+    size_t GetCachedBytes() const;
+
+    /// \brief Get the number of bytes of evicted values that are not yet freed
+    /// \return Byte count of all retired values
+    size_t GetRetiredBytes() const;
+
+    /// \brief Get the number of values loaded through Read()
+    /// \return Number of successful reads
+    uint64_t GetLoadCount() const noexcept
+    {
+        return loads_.load(std::memory_order_relaxed);
+    }
+
+    /// \brief Get the number of values that could not be read
+    /// \return Number of failed reads
+    uint64_t GetFailureCount() const noexcept
+    {
+        return failures_.load(std::memory_order_relaxed);
+    }
+
+protected:
+    /// \brief Read a value
+    /// \param locator Location of the value, as passed to MakeLazy()
+    /// \param buffer Receives exactly length bytes
+    /// \param length Length of the value in bytes
+    /// \return True if the value was read completely
+    virtual bool Read(const uint64_t locator, char* buffer, const size_t length) = 0;
+
+private:
+    friend class String;
+
+    struct Value
+    {
+        std::unique_ptr<char[]> data;
+        size_t length = 0;
+        std::list<uint64_t>::iterator position;
+    };
+
+    struct RetiredValue
+    {
+        std::unique_ptr<char[]> data;
+        size_t length  = 0;
+        uint64_t epoch = 0;
+    };
+
+    std::string_view Hydrate(const uint64_t locator, const size_t length) noexcept;
+    void Evict(const size_t capacity);
+    // Called with the lock held
+    void Retire(const size_t capacity, const size_t keep);
+    void Reclaim(const size_t keep);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Value> values_;
+    // Locators of the cached values, most recently used first
+    std::list<uint64_t> recency_;
+    size_t bytes_ = 0;
+    // Evicted values in the order of their eviction, freed once no older pin is held
+    std::deque<RetiredValue> retired_;
+    size_t retiredBytes_ = 0;
+    // Epoch of the next eviction and number of pins held per epoch
+    uint64_t epoch_ = 0;
+    std::map<uint64_t, size_t> pins_;
+    std::atomic<size_t> capacity_;
+    std::atomic<uint64_t> loads_    = 0;
+    std::atomic<uint64_t> failures_ = 0;
+};
+
+/// \brief Text store in a local file
+/// \details Locators are byte offsets into the file, so a store opened on a snapshot file can load
+/// the strings of the snapshot, see Snapshot::MakeLazy(). A store created with Create() is a spill
+/// file: Append() writes a value to its end and returns a lazy string for it. Values are read with
+/// positional reads, nothing of the file is mapped or kept open in memory.
+class FileTextStore : public TextStore
+{
+public:
+    /// \brief Create a closed store
+    /// \param cacheCapacity Number of bytes the cache holds at most
+    explicit FileTextStore(const size_t cacheCapacity = DEFAULT_CACHE_CAPACITY) noexcept : TextStore(cacheCapacity) {}
+
+    /// \brief Close the store
+    ~FileTextStore() override;
+
+    /// \brief Open an existing file for reading, closing any previous file
+    /// \param path Path of the file
+    /// \return True if the file could be opened
+    bool Open(const char* path);
+
+    /// \brief Create or truncate a file for appending and reading, closing any previous file
+    /// \param path Path of the file
+    /// \return True if the file could be created
+    bool Create(const char* path);
+
+    /// \brief Close the file and clear the cache, all lazy strings of the store become unreadable
+    void Close() noexcept;
+
+    /// \brief Check whether a file is open
+    /// \return True between a successful Open() or Create() and Close()
+    bool IsOpen() const noexcept;
+
+    /// \brief Append a value to a file opened by Create()
+    /// \param value Characters to append
+    /// \param lazy Receives the lazy string of the value
+    /// \return True if the value was written completely
+    bool Append(const std::string_view value, String& lazy);
+
+    /// \brief Get the size of the file
+    /// \return Size in bytes when opened plus the bytes appended since
+    uint64_t GetSize() const noexcept
+    {
+        return size_.load(std::memory_order_acquire);
+    }
+
+protected:
+    bool Read(const uint64_t locator, char* buffer, const size_t length) override;
+
+private:
+#if defined(_WIN32)
+    void* file_ = nullptr;
+#else
+    int file_ = -1;
+#endif
+    std::mutex appendMutex_;
+    std::atomic<uint64_t> size_ = 0;
+    bool writable_              = false;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_TEXT_STORE_H_INCL__
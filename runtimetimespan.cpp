@@ -0,0 +1,179 @@
+///
+// \file runtimetimespan.cpp
+// \brief Timespan utility implementation
+// \details Clock-style parsing and formatting of durations
+//
+
+#include "runtimetimespan.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ultralove::p3::runtime {
+namespace {
+// Longest digit run accepted in a field, keeps the accumulator far away from overflow
+constexpr size_t MAX_FIELD_DIGITS = 12;
+
+constexpr unsigned Digit(const char c) noexcept
+{
+    return static_cast<unsigned>(c - '0');
+}
+
+// Parses "HH:MM:SS" at the start of text; all six digits are read before a single validity test
+bool ParseFixedClock(const char* text, int64_t& nanoseconds) noexcept
+{
+    const unsigned h1 = Digit(text[0]);
+    const unsigned h2 = Digit(text[1]);
+    const unsigned m1 = Digit(text[3]);
+    const unsigned m2 = Digit(text[4]);
+    const unsigned s1 = Digit(text[6]);
+    const unsigned s2 = Digit(text[7]);
+    if ((std::max({h1, h2, m2, s2}) > 9) || (m1 > 5) || (s1 > 5)) {
+        return false;
+    }
+    const int64_t seconds = (h1 * 10 + h2) * 3600 + (m1 * 10 + m2) * 60 + s1 * 10 + s2;
+    nanoseconds           = seconds * Timespan::NANOSECONDS_PER_SECOND;
+    return true;
+}
+
+char* WriteDigits(char* target, uint64_t value, const size_t minDigits) noexcept
+{
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + (value % 10));
+        value /= 10;
+    } while ((value != 0) || (count < minDigits));
+    while (count > 0) {
+        *target++ = digits[--count];
+    }
+    return target;
+}
+} // namespace
+
+std::optional<Timespan> Timespan::Parse(const std::string_view text) noexcept
+{
+    const char* p = text.data();
+
+    // Fast paths for the fixed layouts written by transcript and chapter tools
+    if ((text.size() == 8) && (p[2] == ':') && (p[5] == ':')) {
+        int64_t nanoseconds = 0;
+        if (ParseFixedClock(p, nanoseconds)) {
+            return FromNanoseconds(nanoseconds);
+        }
+        return std::nullopt;
+    }
+    if ((text.size() == 12) && (p[2] == ':') && (p[5] == ':') && ((p[8] == '.') || (p[8] == ','))) {
+        int64_t nanoseconds    = 0;
+        const unsigned f1      = Digit(p[9]);
+        const unsigned f2      = Digit(p[10]);
+        const unsigned f3      = Digit(p[11]);
+        if ((ParseFixedClock(p, nanoseconds) == false) || (std::max({f1, f2, f3}) > 9)) {
+            return std::nullopt;
+        }
+        return FromNanoseconds(nanoseconds + (f1 * 100 + f2 * 10 + f3) * NANOSECONDS_PER_MILLISECOND);
+    }
+
+    // General form: up to three colon separated fields and an optional fraction
+    const char* end      = p + text.size();
+    int64_t fields[3]    = {0, 0, 0};
+    size_t fieldCount    = 0;
+    int64_t value        = 0;
+    size_t digits        = 0;
+    int64_t fraction     = 0;
+    int64_t fractionUnit = NANOSECONDS_PER_SECOND;
+
+    for (; p != end; ++p) {
+        const unsigned digit = Digit(*p);
+        if (digit <= 9) {
+            value = value * 10 + digit;
+            if (++digits > MAX_FIELD_DIGITS) {
+                return std::nullopt;
+            }
+        }
+        else if ((*p == ':') && (digits > 0) && (fieldCount < 2)) {
+            fields[fieldCount++] = value;
+            value                = 0;
+            digits               = 0;
+        }
+        else if (((*p == '.') || (*p == ',')) && (digits > 0)) {
+            // Fraction runs to the end of the text, digits beyond nanoseconds are ignored
+            ++p;
+            if (p == end) {
+                return std::nullopt;
+            }
+            for (; p != end; ++p) {
+                const unsigned fractionDigit = Digit(*p);
+                if (fractionDigit > 9) {
+                    return std::nullopt;
+                }
+                fractionUnit /= 10;
+                fraction += fractionDigit * fractionUnit;
+            }
+            break;
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+    if (digits == 0) {
+        return std::nullopt;
+    }
+    fields[fieldCount++] = value;
+
+    // Only the leading field may exceed its clock range
+    int64_t seconds = fields[0];
+    for (size_t i = 1; i < fieldCount; ++i) {
+        if (fields[i] > 59) {
+            return std::nullopt;
+        }
+        seconds = seconds * 60 + fields[i];
+    }
+    // The fields are small enough to combine without overflow, the nanoseconds are not
+    if (seconds > (INT64_MAX - fraction) / NANOSECONDS_PER_SECOND) {
+        return std::nullopt;
+    }
+    return FromNanoseconds(seconds * NANOSECONDS_PER_SECOND + fraction);
+}
+
+size_t Timespan::Format(char* buffer, const size_t size, const char fractionSeparator) const noexcept
+{
+    if (size < FORMAT_MAX_LENGTH) {
+        return 0;
+    }
+
+    char* target = buffer;
+    uint64_t magnitude = static_cast<uint64_t>(nanoseconds_);
+    if (nanoseconds_ < 0) {
+        *target++ = '-';
+        magnitude = 0 - magnitude;
+    }
+
+    const uint64_t totalSeconds = magnitude / NANOSECONDS_PER_SECOND;
+    target                      = WriteDigits(target, totalSeconds / 3600, 2);
+    *target++                   = ':';
+    target                      = WriteDigits(target, (totalSeconds / 60) % 60, 2);
+    *target++                   = ':';
+    target                      = WriteDigits(target, totalSeconds % 60, 2);
+    if (fractionSeparator != '\0') {
+        *target++ = fractionSeparator;
+        target    = WriteDigits(target, (magnitude % NANOSECONDS_PER_SECOND) / NANOSECONDS_PER_MILLISECOND, 3);
+    }
+    return static_cast<size_t>(target - buffer);
+}
+
+size_t Timespan::FormatClock(char* buffer, const size_t size) const noexcept
+{
+    return Format(buffer, size, '\0');
+}
+
+size_t Timespan::FormatWebVtt(char* buffer, const size_t size) const noexcept
+{
+    return Format(buffer, size, '.');
+}
+
+size_t Timespan::FormatSrt(char* buffer, const size_t size) const noexcept
+{
+    return Format(buffer, size, ',');
+}
+} // namespace ultralove::p3::runtime
@@ -1,7 +1,7 @@
 ///
 // \file runtimetimespan.h
 // \brief Timespan utility struct for the P3 Model library
-// \details Placeholder timespan struct for future implementation in podcast domain
+// \details Nanosecond duration with clock-style parsing and formatting
 //
 
 #ifndef __P3_RUNTIME_TIMESPAN_H_INCL__
@@ -9,17 +9,202 @@
 
 #pragma pack(push, 8)
 
+#include <compare>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <string_view>
 
 namespace ultralove::p3::runtime {
 /// \brief Timespan struct for the P3 Model library
-/// \details Placeholder timespan struct for future implementation
-/// This will handle podcast duration data like episode lengths, ad break durations, etc.
-struct Timespan
+/// \details Signed duration with nanosecond precision stored in 8 bytes, covering about +/- 292
+/// years. Used for episode durations and for start and end times of chapters, transcript segments
+/// and contributor presence. All arithmetic is constexpr; parsing and formatting never allocate.
+class Timespan
 {
-    // Data members will be added in future implementation
-    // Planned: nanosecond precision duration storage, conversion utilities
+public:
+    /// \brief Maximum number of characters written by the Format functions
+    static constexpr size_t FORMAT_MAX_LENGTH = 20;
+
+    static constexpr int64_t NANOSECONDS_PER_MICROSECOND = 1000;
+    static constexpr int64_t NANOSECONDS_PER_MILLISECOND = 1000 * NANOSECONDS_PER_MICROSECOND;
+    static constexpr int64_t NANOSECONDS_PER_SECOND      = 1000 * NANOSECONDS_PER_MILLISECOND;
+    static constexpr int64_t NANOSECONDS_PER_MINUTE      = 60 * NANOSECONDS_PER_SECOND;
+    static constexpr int64_t NANOSECONDS_PER_HOUR        = 60 * NANOSECONDS_PER_MINUTE;
+
+    /// \brief Largest number of whole seconds a duration can hold
+    static constexpr int64_t MAX_SECONDS = INT64_MAX / NANOSECONDS_PER_SECOND;
+
+    /// \brief Create a zero duration
+    constexpr Timespan() noexcept = default;
+
+    /// \brief Create a duration from nanoseconds
+    static constexpr Timespan FromNanoseconds(const int64_t nanoseconds) noexcept
+    {
+        Timespan result;
+        result.nanoseconds_ = nanoseconds;
+        return result;
+    }
+
+    /// \brief Create a duration from microseconds
+    static constexpr Timespan FromMicroseconds(const int64_t microseconds) noexcept
+    {
+        return FromNanoseconds(microseconds * NANOSECONDS_PER_MICROSECOND);
+    }
+
+    /// \brief Create a duration from milliseconds
+    static constexpr Timespan FromMilliseconds(const int64_t milliseconds) noexcept
+    {
+        return FromNanoseconds(milliseconds * NANOSECONDS_PER_MILLISECOND);
+    }
+
+    /// \brief Create a duration from whole seconds
+    static constexpr Timespan FromSeconds(const int64_t seconds) noexcept
+    {
+        return FromNanoseconds(seconds * NANOSECONDS_PER_SECOND);
+    }
+
+    /// \brief Create a duration from minutes
+    static constexpr Timespan FromMinutes(const int64_t minutes) noexcept
+    {
+        return FromNanoseconds(minutes * NANOSECONDS_PER_MINUTE);
+    }
+
+    /// \brief Create a duration from hours
+    static constexpr Timespan FromHours(const int64_t hours) noexcept
+    {
+        return FromNanoseconds(hours * NANOSECONDS_PER_HOUR);
+    }
+
+    /// \brief Parse a clock-style or plain seconds duration
+    /// \details Accepts everything found in itunes:duration, WebVTT and SRT files: "SS", "MM:SS" and
+    /// "HH:MM:SS", each optionally followed by a fraction introduced by '.' or ','. The leading field
+    /// is unbounded, so "4200" and "70:00" are valid, up to MAX_SECONDS in total. Fractions are
+    /// truncated to nanoseconds.
+    /// \param text Text to parse, e.g. "01:02:03.456" or "00:00:05,250" or "3723"
+    /// \return Parsed duration, or no value if the text is malformed
+    static std::optional<Timespan> Parse(const std::string_view text) noexcept;
+
+    /// \brief Format as "HH:MM:SS" for itunes:duration
+    /// \details Hours are padded to two digits and may use more, e.g. "01:02:03" or "123:00:00";
+    /// fractions of a second are dropped
+    /// \param buffer Target buffer, not terminated
+    /// \param size Size of the target buffer, at least FORMAT_MAX_LENGTH
+    /// \return Number of characters written, 0 if the buffer is too small
+    size_t FormatClock(char* buffer, const size_t size) const noexcept;
+
+    /// \brief Format as WebVTT timestamp "HH:MM:SS.mmm"
+    /// \param buffer Target buffer, not terminated
+    /// \param size Size of the target buffer, at least FORMAT_MAX_LENGTH
+    /// \return Number of characters written, 0 if the buffer is too small
+    size_t FormatWebVtt(char* buffer, const size_t size) const noexcept;
+
+    /// \brief Format as SRT timestamp "HH:MM:SS,mmm"
+    /// \param buffer Target buffer, not terminated
+    /// \param size Size of the target buffer, at least FORMAT_MAX_LENGTH
+    /// \return Number of characters written, 0 if the buffer is too small
+    size_t FormatSrt(char* buffer, const size_t size) const noexcept;
+
+    /// \brief Get the duration in nanoseconds
+    constexpr int64_t GetNanoseconds() const noexcept
+    {
+        return nanoseconds_;
+    }
+
+    /// \brief Get the duration in whole microseconds, truncated towards zero
+    constexpr int64_t GetMicroseconds() const noexcept
+    {
+        return nanoseconds_ / NANOSECONDS_PER_MICROSECOND;
+    }
+
+    /// \brief Get the duration in whole milliseconds, truncated towards zero
+    constexpr int64_t GetMilliseconds() const noexcept
+    {
+        return nanoseconds_ / NANOSECONDS_PER_MILLISECOND;
+    }
+
+    /// \brief Get the duration in whole seconds, truncated towards zero
+    constexpr int64_t GetSeconds() const noexcept
+    {
+        return nanoseconds_ / NANOSECONDS_PER_SECOND;
+    }
+
+    /// \brief Get the duration in fractional seconds
+    constexpr double GetTotalSeconds() const noexcept
+    {
+        return static_cast<double>(nanoseconds_) / static_cast<double>(NANOSECONDS_PER_SECOND);
+    }
+
+    /// \brief Check whether the duration is zero
+    constexpr bool IsZero() const noexcept
+    {
+        return nanoseconds_ == 0;
+    }
+
+    constexpr Timespan operator-() const noexcept
+    {
+        return FromNanoseconds(-nanoseconds_);
+    }
+
+    constexpr Timespan& operator+=(const Timespan other) noexcept
+    {
+        nanoseconds_ += other.nanoseconds_;
+        return *this;
+    }
+
+    constexpr Timespan& operator-=(const Timespan other) noexcept
+    {
+        nanoseconds_ -= other.nanoseconds_;
+        return *this;
+    }
+
+    friend constexpr Timespan operator+(const Timespan lhs, const Timespan rhs) noexcept
+    {
+        return FromNanoseconds(lhs.nanoseconds_ + rhs.nanoseconds_);
+    }
+
+    friend constexpr Timespan operator-(const Timespan lhs, const Timespan rhs) noexcept
+    {
+        return FromNanoseconds(lhs.nanoseconds_ - rhs.nanoseconds_);
+    }
+
+    friend constexpr Timespan operator*(const Timespan lhs, const int64_t factor) noexcept
+    {
+        return FromNanoseconds(lhs.nanoseconds_ * factor);
+    }
+
+    friend constexpr Timespan operator*(const int64_t factor, const Timespan rhs) noexcept
+    {
+        return FromNanoseconds(rhs.nanoseconds_ * factor);
+    }
+
+    friend constexpr Timespan operator/(const Timespan lhs, const int64_t divisor) noexcept
+    {
+        return FromNanoseconds(lhs.nanoseconds_ / divisor);
+    }
+
+    /// \brief Get how many times a duration fits into another
+    friend constexpr int64_t operator/(const Timespan lhs, const Timespan rhs) noexcept
+    {
+        return lhs.nanoseconds_ / rhs.nanoseconds_;
+    }
+
+    friend constexpr Timespan operator%(const Timespan lhs, const Timespan rhs) noexcept
+    {
+        return FromNanoseconds(lhs.nanoseconds_ % rhs.nanoseconds_);
+    }
+
+    friend constexpr bool operator==(const Timespan&, const Timespan&) noexcept = default;
+
+    friend constexpr std::strong_ordering operator<=>(const Timespan&, const Timespan&) noexcept = default;
+
+private:
+    size_t Format(char* buffer, const size_t size, const char fractionSeparator) const noexcept;
+
+    int64_t nanoseconds_ = 0;
 };
+
+static_assert(sizeof(Timespan) == 8, "runtime::Timespan must stay 8 bytes");
 } // namespace ultralove::p3::runtime
 
 #pragma pack(pop)
@@ -0,0 +1,567 @@
+///
+// \file runtimetimestamp.cpp
+// \brief Timestamp utility implementation
+// \details Table-driven RFC 822 and ISO 8601 parsing and formatting
+//
+
+#include "runtimetimestamp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace ultralove::p3::runtime {
+namespace {
+constexpr int64_t MICROSECONDS_PER_SECOND = 1000000;
+constexpr int64_t SECONDS_PER_DAY         = 86400;
+
+// Two-digit decimal strings "00" to "99", indexed by value * 2
+constexpr char DIGIT_PAIRS[] = "00010203040506070809"
+                               "10111213141516171819"
+                               "20212223242526272829"
+                               "30313233343536373839"
+                               "40414243444546474849"
+                               "50515253545556575859"
+                               "60616263646566676869"
+                               "70717273747576777879"
+                               "80818283848586878889"
+                               "90919293949596979899";
+
+constexpr char MONTH_NAMES[12][4] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+constexpr char DAY_NAMES[7][4]    = {"Thu", "Fri", "Sat", "Sun", "Mon", "Tue", "Wed"}; // 1970-01-01 was a Thursday
+
+constexpr uint8_t DAYS_IN_MONTH[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+// Month and zone names are matched as lowercase three byte keys
+constexpr uint32_t NameKey(const char a, const char b, const char c) noexcept
+{
+    return (static_cast<uint32_t>(static_cast<uint8_t>(a) | 0x20) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(b) | 0x20) << 8) |
+           static_cast<uint32_t>(static_cast<uint8_t>(c) | 0x20);
+}
+
+constexpr uint32_t MONTH_KEYS[12] = {NameKey('j', 'a', 'n'), NameKey('f', 'e', 'b'), NameKey('m', 'a', 'r'), NameKey('a', 'p', 'r'),
+                                     NameKey('m', 'a', 'y'), NameKey('j', 'u', 'n'), NameKey('j', 'u', 'l'), NameKey('a', 'u', 'g'),
+                                     NameKey('s', 'e', 'p'), NameKey('o', 'c', 't'), NameKey('n', 'o', 'v'), NameKey('d', 'e', 'c')};
+
+struct ZoneName
+{
+    uint32_t key;
+    int offsetMinutes;
+};
+
+// Zone names from RFC 822 section 5.1; two letter names are padded with a space
+constexpr ZoneName ZONE_NAMES[] = {
+    {NameKey('u', 't', ' '), 0},
+    {NameKey('u', 't', 'c'), 0},
+    {NameKey('g', 'm', 't'), 0},
+    {NameKey('z', ' ', ' '), 0},
+    {NameKey('e', 's', 't'), -5 * 60},
+    {NameKey('e', 'd', 't'), -4 * 60},
+    {NameKey('c', 's', 't'), -6 * 60},
+    {NameKey('c', 'd', 't'), -5 * 60},
+    {NameKey('m', 's', 't'), -7 * 60},
+    {NameKey('m', 'd', 't'), -6 * 60},
+    {NameKey('p', 's', 't'), -8 * 60},
+    {NameKey('p', 'd', 't'), -7 * 60}};
+
+constexpr bool IsLeapYear(const int64_t year) noexcept
+{
+    return ((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0));
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant, "chrono-compatible low-level date algorithms")
+constexpr int64_t DaysFromCivil(int64_t year, const unsigned month, const unsigned day) noexcept
+{
+    year -= (month <= 2) ? 1 : 0;
+    const int64_t era  = ((year >= 0) ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * ((month > 2) ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+struct CivilDate
+{
+    int64_t year;
+    unsigned month;
+    unsigned day;
+};
+
+constexpr CivilDate CivilFromDays(int64_t days) noexcept
+{
+    days += 719468;
+    const int64_t era  = ((days >= 0) ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp  = (5 * doy + 2) / 153;
+    const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+    const unsigned mon = (mp < 10) ? mp + 3 : mp - 9;
+    return CivilDate{static_cast<int64_t>(yoe) + era * 400 + ((mon <= 2) ? 1 : 0), mon, day};
+}
+
+constexpr int64_t FloorDiv(const int64_t value, const int64_t divisor) noexcept
+{
+    return (value >= 0) ? (value / divisor) : -((-value + divisor - 1) / divisor);
+}
+
+// Minimal forward-only scanner over the input text
+struct Scanner
+{
+    const char* current;
+    const char* end;
+
+    bool AtEnd() const noexcept
+    {
+        return current == end;
+    }
+
+    char Peek() const noexcept
+    {
+        return (current != end) ? *current : '\0';
+    }
+
+    bool Accept(const char c) noexcept
+    {
+        if ((current != end) && (*current == c)) {
+            ++current;
+            return true;
+        }
+        return false;
+    }
+
+    size_t SkipSpaces() noexcept
+    {
+        const char* start = current;
+        while ((current != end) && ((*current == ' ') || (*current == '\t'))) {
+            ++current;
+        }
+        return static_cast<size_t>(current - start);
+    }
+
+    // Reads between minDigits and maxDigits decimal digits
+    bool Digits(const size_t minDigits, const size_t maxDigits, int& value, size_t* count = nullptr) noexcept
+    {
+        size_t digits = 0;
+        int result    = 0;
+        while ((current != end) && (digits < maxDigits)) {
+            const unsigned digit = static_cast<unsigned>(*current - '0');
+            if (digit > 9) {
+                break;
+            }
+            result = result * 10 + static_cast<int>(digit);
+            ++current;
+            ++digits;
+        }
+        if (count != nullptr) {
+            *count = digits;
+        }
+        value = result;
+        return digits >= minDigits;
+    }
+
+    size_t Letters() noexcept
+    {
+        const char* start = current;
+        while ((current != end) && ((static_cast<unsigned>((*current | 0x20) - 'a')) < 26)) {
+            ++current;
+        }
+        return static_cast<size_t>(current - start);
+    }
+};
+
+bool MakeTimestamp(const int64_t year, const int month, const int day, const int hour, const int minute, const int second,
+    const int64_t microseconds, const int offsetMinutes, Timestamp& result) noexcept
+{
+    if ((month < 1) || (month > 12) || (day < 1) || (hour > 23) || (minute > 59) || (second > 60)) {
+        return false;
+    }
+    const int maxDay = DAYS_IN_MONTH[month - 1] + (((month == 2) && IsLeapYear(year)) ? 1 : 0);
+    if ((day > maxDay) || ((offsetMinutes % 15) != 0) || (offsetMinutes < Timestamp::MIN_OFFSET_MINUTES) ||
+        (offsetMinutes > Timestamp::MAX_OFFSET_MINUTES)) {
+        return false;
+    }
+
+    // A leap second is folded into the following second; the parsers read at most four digit years,
+    // so the product cannot overflow, but it can leave the range of Timestamp
+    const int64_t days    = DaysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    const int64_t seconds = days * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second - offsetMinutes * 60;
+    const int64_t instant = seconds * MICROSECONDS_PER_SECOND + microseconds;
+    if (Timestamp::IsInRange(instant) == false) {
+        return false;
+    }
+    result = Timestamp::FromMicroseconds(instant, offsetMinutes);
+    return true;
+}
+
+// "hh:mm" or "hh:mm:ss"
+bool ParseClock(Scanner& scanner, int& hour, int& minute, int& second) noexcept
+{
+    second = 0;
+    if ((scanner.Digits(1, 2, hour) == false) || (scanner.Accept(':') == false) || (scanner.Digits(2, 2, minute) == false)) {
+        return false;
+    }
+    if (scanner.Accept(':')) {
+        return scanner.Digits(2, 2, second);
+    }
+    return true;
+}
+
+// "+hhmm", "+hh:mm" or "+hh" when allowShort
+bool ParseNumericOffset(Scanner& scanner, const bool allowShort, int& offsetMinutes) noexcept
+{
+    const char sign = scanner.Peek();
+    if ((sign != '+') && (sign != '-')) {
+        return false;
+    }
+    ++scanner.current;
+
+    int hours   = 0;
+    int minutes = 0;
+    if (scanner.Digits(2, 2, hours) == false) {
+        return false;
+    }
+    const bool colon    = scanner.Accept(':');
+    size_t minuteDigits = 0;
+    if (scanner.Digits(2, 2, minutes, &minuteDigits) == false) {
+        if ((allowShort == false) || colon || (minuteDigits > 0)) {
+            return false;
+        }
+        minutes = 0;
+    }
+    if (minutes > 59) {
+        return false;
+    }
+    offsetMinutes = ((sign == '-') ? -1 : 1) * (hours * 60 + minutes);
+    return true;
+}
+
+// Two ASCII digits at a fixed position, returns a value above 99 if either is not a digit
+constexpr unsigned FixedPair(const char* text) noexcept
+{
+    const unsigned tens = static_cast<unsigned>(text[0] - '0');
+    const unsigned ones = static_cast<unsigned>(text[1] - '0');
+    return ((tens > 9) || (ones > 9)) ? 100 : (tens * 10 + ones);
+}
+
+// Fast path for the layout almost all feeds use, "Www, DD Mon YYYY HH:MM:SS +hhmm" or with a three
+// letter zone name; anything else is left to the general parser
+bool ParseRfc822Canonical(const std::string_view text, Timestamp& result) noexcept
+{
+    if (((text.size() != 29) && (text.size() != 31)) || (text[3] != ',') || (text[4] != ' ') || (text[7] != ' ') || (text[11] != ' ') ||
+        (text[16] != ' ') || (text[19] != ':') || (text[22] != ':') || (text[25] != ' ')) {
+        return false;
+    }
+
+    const char* p           = text.data();
+    const uint32_t monthKey = NameKey(p[8], p[9], p[10]);
+    int month               = 0;
+    for (int i = 0; i < 12; ++i) {
+        month = (MONTH_KEYS[i] == monthKey) ? i + 1 : month;
+    }
+
+    int offsetMinutes = 0;
+    if (text.size() == 31) {
+        const unsigned hours   = FixedPair(p + 27);
+        const unsigned minutes = FixedPair(p + 29);
+        if (((p[26] != '+') && (p[26] != '-')) || (hours > 99) || (minutes > 59)) {
+            return false;
+        }
+        offsetMinutes = ((p[26] == '-') ? -1 : 1) * static_cast<int>(hours * 60 + minutes);
+    }
+    else {
+        const uint32_t zoneKey = NameKey(p[26], p[27], p[28]);
+        bool found             = false;
+        for (const ZoneName& zone : ZONE_NAMES) {
+            if (zone.key == zoneKey) {
+                offsetMinutes = zone.offsetMinutes;
+                found         = true;
+            }
+        }
+        if (found == false) {
+            return false;
+        }
+    }
+
+    const unsigned day       = FixedPair(p + 5);
+    const unsigned century   = FixedPair(p + 12);
+    const unsigned yearShort = FixedPair(p + 14);
+    const unsigned hour      = FixedPair(p + 17);
+    const unsigned minute    = FixedPair(p + 20);
+    const unsigned second    = FixedPair(p + 23);
+    if (std::max({day, century, yearShort, hour, minute, second}) > 99) {
+        return false;
+    }
+    return MakeTimestamp(century * 100 + yearShort, month, static_cast<int>(day), static_cast<int>(hour), static_cast<int>(minute),
+        static_cast<int>(second), 0, offsetMinutes, result);
+}
+
+char* WriteDigitPair(char* target, const unsigned value) noexcept
+{
+    std::memcpy(target, DIGIT_PAIRS + value * 2, 2);
+    return target + 2;
+}
+
+char* WriteYear(char* target, const unsigned year) noexcept
+{
+    target = WriteDigitPair(target, year / 100);
+    return WriteDigitPair(target, year % 100);
+}
+
+struct LocalTime
+{
+    CivilDate date;
+    unsigned weekday;
+    unsigned hour;
+    unsigned minute;
+    unsigned second;
+    unsigned microsecond;
+};
+
+bool ToLocalTime(const Timestamp& timestamp, LocalTime& local) noexcept
+{
+    const int64_t microseconds = timestamp.GetMicroseconds() + int64_t{timestamp.GetOffsetMinutes()} * 60 * MICROSECONDS_PER_SECOND;
+    const int64_t seconds      = FloorDiv(microseconds, MICROSECONDS_PER_SECOND);
+    const int64_t days         = FloorDiv(seconds, SECONDS_PER_DAY);
+    const int64_t secondOfDay  = seconds - days * SECONDS_PER_DAY;
+
+    local.date = CivilFromDays(days);
+    if ((local.date.year < 0) || (local.date.year > 9999)) {
+        return false;
+    }
+    local.weekday     = static_cast<unsigned>(((days % 7) + 7) % 7);
+    local.hour        = static_cast<unsigned>(secondOfDay / 3600);
+    local.minute      = static_cast<unsigned>((secondOfDay / 60) % 60);
+    local.second      = static_cast<unsigned>(secondOfDay % 60);
+    local.microsecond = static_cast<unsigned>(microseconds - seconds * MICROSECONDS_PER_SECOND);
+    return true;
+}
+} // namespace
+
+Timestamp Timestamp::Now() noexcept
+{
+    const auto now = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now());
+    return FromMicroseconds(now.time_since_epoch().count());
+}
+
+std::optional<Timestamp> Timestamp::ParseRfc822(const std::string_view text) noexcept
+{
+    Timestamp canonical;
+    if (ParseRfc822Canonical(text, canonical)) {
+        return canonical;
+    }
+
+    Scanner scanner{text.data(), text.data() + text.size()};
+    scanner.SkipSpaces();
+
+    // Optional day of week, not validated against the date; some feeds omit the comma
+    if (scanner.Letters() > 0) {
+        scanner.SkipSpaces();
+        scanner.Accept(',');
+        scanner.SkipSpaces();
+    }
+
+    int day = 0;
+    if ((scanner.Digits(1, 2, day) == false) || (scanner.SkipSpaces() == 0)) {
+        return std::nullopt;
+    }
+
+    // Month name, longer spellings such as "June" are tolerated
+    const char* monthName = scanner.current;
+    if (scanner.Letters() < 3) {
+        return std::nullopt;
+    }
+    const uint32_t monthKey = NameKey(monthName[0], monthName[1], monthName[2]);
+    int month               = 0;
+    for (int i = 0; i < 12; ++i) {
+        month = (MONTH_KEYS[i] == monthKey) ? i + 1 : month;
+    }
+    if ((month == 0) || (scanner.SkipSpaces() == 0)) {
+        return std::nullopt;
+    }
+
+    // Two digit years follow RFC 2822 section 4.3
+    int year            = 0;
+    size_t yearDigits   = 0;
+    if ((scanner.Digits(2, 4, year, &yearDigits) == false) || (yearDigits == 3) || (scanner.SkipSpaces() == 0)) {
+        return std::nullopt;
+    }
+    if (yearDigits == 2) {
+        year += (year < 50) ? 2000 : 1900;
+    }
+
+    int hour   = 0;
+    int minute = 0;
+    int second = 0;
+    if (ParseClock(scanner, hour, minute, second) == false) {
+        return std::nullopt;
+    }
+    scanner.SkipSpaces();
+
+    int offsetMinutes = 0;
+    if (scanner.AtEnd() == false) {
+        if ((scanner.Peek() == '+') || (scanner.Peek() == '-')) {
+            if (ParseNumericOffset(scanner, false, offsetMinutes) == false) {
+                return std::nullopt;
+            }
+        }
+        else {
+            const char* zoneName    = scanner.current;
+            const size_t zoneLength = scanner.Letters();
+            if ((zoneLength == 0) || (zoneLength > 3)) {
+                return std::nullopt;
+            }
+            const uint32_t zoneKey = NameKey(zoneName[0], (zoneLength > 1) ? zoneName[1] : ' ', (zoneLength > 2) ? zoneName[2] : ' ');
+            bool found             = false;
+            for (const ZoneName& zone : ZONE_NAMES) {
+                if (zone.key == zoneKey) {
+                    offsetMinutes = zone.offsetMinutes;
+                    found         = true;
+                }
+            }
+            if (found == false) {
+                return std::nullopt;
+            }
+        }
+        scanner.SkipSpaces();
+        if (scanner.AtEnd() == false) {
+            return std::nullopt;
+        }
+    }
+
+    Timestamp result;
+    if (MakeTimestamp(year, month, day, hour, minute, second, 0, offsetMinutes, result) == false) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::optional<Timestamp> Timestamp::ParseIso8601(const std::string_view text) noexcept
+{
+    Scanner scanner{text.data(), text.data() + text.size()};
+
+    int year  = 0;
+    int month = 0;
+    int day   = 0;
+    if ((scanner.Digits(4, 4, year) == false) || (scanner.Accept('-') == false) || (scanner.Digits(2, 2, month) == false) ||
+        (scanner.Accept('-') == false) || (scanner.Digits(2, 2, day) == false)) {
+        return std::nullopt;
+    }
+
+    int hour             = 0;
+    int minute           = 0;
+    int second           = 0;
+    int64_t microseconds = 0;
+    int offsetMinutes    = 0;
+    if ((scanner.Accept('T') || scanner.Accept('t') || scanner.Accept(' ')) && (scanner.AtEnd() == false)) {
+        if ((scanner.Digits(2, 2, hour) == false) || (scanner.Accept(':') == false) || (scanner.Digits(2, 2, minute) == false)) {
+            return std::nullopt;
+        }
+        if (scanner.Accept(':') && (scanner.Digits(2, 2, second) == false)) {
+            return std::nullopt;
+        }
+
+        // Fractional seconds, digits beyond microseconds are truncated
+        if (scanner.Accept('.') || scanner.Accept(',')) {
+            int64_t scale = 100000;
+            size_t digits = 0;
+            while ((scanner.AtEnd() == false) && (static_cast<unsigned>(scanner.Peek() - '0') <= 9)) {
+                microseconds += (scanner.Peek() - '0') * scale;
+                scale /= 10;
+                ++scanner.current;
+                ++digits;
+            }
+            if (digits == 0) {
+                return std::nullopt;
+            }
+        }
+
+        if (scanner.Accept('Z') || scanner.Accept('z')) {
+            offsetMinutes = 0;
+        }
+        else if ((scanner.AtEnd() == false) && (ParseNumericOffset(scanner, true, offsetMinutes) == false)) {
+            return std::nullopt;
+        }
+    }
+    if (scanner.AtEnd() == false) {
+        return std::nullopt;
+    }
+
+    Timestamp result;
+    if (MakeTimestamp(year, month, day, hour, minute, second, microseconds, offsetMinutes, result) == false) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+size_t Timestamp::FormatRfc822(char* buffer, const size_t size) const noexcept
+{
+    LocalTime local{};
+    if ((size < RFC822_LENGTH) || (ToLocalTime(*this, local) == false)) {
+        return 0;
+    }
+
+    char* target = buffer;
+    std::memcpy(target, DAY_NAMES[local.weekday], 3);
+    target[3] = ',';
+    target[4] = ' ';
+    target    = WriteDigitPair(target + 5, local.date.day);
+    *target++ = ' ';
+    std::memcpy(target, MONTH_NAMES[local.date.month - 1], 3);
+    target[3] = ' ';
+    target    = WriteYear(target + 4, static_cast<unsigned>(local.date.year));
+    *target++ = ' ';
+    target    = WriteDigitPair(target, local.hour);
+    *target++ = ':';
+    target    = WriteDigitPair(target, local.minute);
+    *target++ = ':';
+    target    = WriteDigitPair(target, local.second);
+    *target++ = ' ';
+
+    const int offset       = GetOffsetMinutes();
+    const unsigned absolute = static_cast<unsigned>((offset < 0) ? -offset : offset);
+    *target++              = (offset < 0) ? '-' : '+';
+    target                 = WriteDigitPair(target, absolute / 60);
+    target                 = WriteDigitPair(target, absolute % 60);
+    return static_cast<size_t>(target - buffer);
+}
+
+size_t Timestamp::FormatIso8601(char* buffer, const size_t size) const noexcept
+{
+    LocalTime local{};
+    if ((size < ISO8601_MAX_LENGTH) || (ToLocalTime(*this, local) == false)) {
+        return 0;
+    }
+
+    char* target = WriteYear(buffer, static_cast<unsigned>(local.date.year));
+    *target++    = '-';
+    target       = WriteDigitPair(target, local.date.month);
+    *target++    = '-';
+    target       = WriteDigitPair(target, local.date.day);
+    *target++    = 'T';
+    target       = WriteDigitPair(target, local.hour);
+    *target++    = ':';
+    target       = WriteDigitPair(target, local.minute);
+    *target++    = ':';
+    target       = WriteDigitPair(target, local.second);
+    if (local.microsecond != 0) {
+        *target++ = '.';
+        target    = WriteDigitPair(target, local.microsecond / 10000);
+        target    = WriteDigitPair(target, (local.microsecond / 100) % 100);
+        target    = WriteDigitPair(target, local.microsecond % 100);
+    }
+
+    const int offset = GetOffsetMinutes();
+    if (offset == 0) {
+        *target++ = 'Z';
+    }
+    else {
+        const unsigned absolute = static_cast<unsigned>((offset < 0) ? -offset : offset);
+        *target++               = (offset < 0) ? '-' : '+';
+        target                  = WriteDigitPair(target, absolute / 60);
+        *target++               = ':';
+        target                  = WriteDigitPair(target, absolute % 60);
+    }
+    return static_cast<size_t>(target - buffer);
+}
+} // namespace ultralove::p3::runtime
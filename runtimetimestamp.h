@@ -1,7 +1,7 @@
 ///
 // \file runtimetimestamp.h
 // \brief Timestamp utility struct for the P3 Model library
-// \details Placeholder timestamp struct for future implementation in podcast domain
+// \details Compact point in time with timezone offset and RFC 822 / ISO 8601 conversion
 //
 
 #ifndef __P3_RUNTIME_TIMESTAMP_H_INCL__
@@ -9,17 +9,186 @@
 
 #pragma pack(push, 8)
 
+#include "runtimetimespan.h"
+#include <compare>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <string_view>
 
 namespace ultralove::p3::runtime {
 /// \brief Timestamp struct for the P3 Model library
-/// \details Placeholder timestamp struct for future implementation
-/// This will handle podcast timing data like publish dates, recording times, etc.
-struct Timestamp
+/// \details Point in time stored in 8 bytes: microseconds since 1970-01-01T00:00:00Z together with
+/// the timezone offset it was expressed in. The offset is kept in quarter hours, which covers all
+/// timezones in use, and only affects formatting; comparisons look at the instant alone, so
+/// timestamps from feeds in different timezones sort correctly. The supported range is
+/// MIN_MICROSECONDS to MAX_MICROSECONDS, about 1970 +/- 2,283 years (years -313 to 4253); the
+/// parsers reject dates outside of it. A default constructed timestamp is the epoch in UTC.
+///
+/// Parsing and formatting never allocate and are driven by lookup tables, because every feed build
+/// formats every publication date.
+class Timestamp
 {
-    // Data members will be added in future implementation
-    // Planned: epoch-based time storage, timezone handling, precision timestamps
+public:
+    /// \brief Length of an RFC 822 date as produced by FormatRfc822(), e.g. "Wed, 02 Oct 2002 13:00:00 +0200"
+    static constexpr size_t RFC822_LENGTH = 31;
+
+    /// \brief Maximum length of an ISO 8601 date as produced by FormatIso8601(), e.g. "2002-10-02T13:00:00.250000+02:00"
+    static constexpr size_t ISO8601_MAX_LENGTH = 32;
+
+    /// \brief Smallest supported timezone offset in minutes
+    static constexpr int MIN_OFFSET_MINUTES = -16 * 60;
+
+    /// \brief Largest supported timezone offset in minutes
+    static constexpr int MAX_OFFSET_MINUTES = 15 * 60 + 45;
+
+    /// \brief Earliest representable instant in microseconds since the epoch, -2^56
+    static constexpr int64_t MIN_MICROSECONDS = -(int64_t{1} << 56);
+
+    /// \brief Latest representable instant in microseconds since the epoch, 2^56 - 1
+    static constexpr int64_t MAX_MICROSECONDS = (int64_t{1} << 56) - 1;
+
+    /// \brief Create the epoch in UTC
+    constexpr Timestamp() noexcept = default;
+
+    /// \brief Check whether an instant can be represented
+    /// \param microseconds Microseconds since 1970-01-01T00:00:00Z
+    /// \return True if microseconds is in MIN_MICROSECONDS..MAX_MICROSECONDS
+    static constexpr bool IsInRange(const int64_t microseconds) noexcept
+    {
+        return (microseconds >= MIN_MICROSECONDS) && (microseconds <= MAX_MICROSECONDS);
+    }
+
+    /// \brief Create a timestamp from microseconds since the epoch
+    /// \param microseconds Microseconds since 1970-01-01T00:00:00Z, clamped to MIN_MICROSECONDS..MAX_MICROSECONDS
+    /// \param offsetMinutes Timezone offset used for formatting, a multiple of 15 minutes
+    /// \return Timestamp
+    static constexpr Timestamp FromMicroseconds(const int64_t microseconds, const int offsetMinutes = 0) noexcept
+    {
+        const int64_t clamped = (microseconds < MIN_MICROSECONDS) ? MIN_MICROSECONDS
+                                : (microseconds > MAX_MICROSECONDS) ? MAX_MICROSECONDS
+                                                                    : microseconds;
+        Timestamp result;
+        result.value_ = static_cast<int64_t>(static_cast<uint64_t>(clamped) << OFFSET_BITS) | ((offsetMinutes / 15) & OFFSET_MASK);
+        return result;
+    }
+
+    /// \brief Create a timestamp from seconds since the epoch
+    /// \param seconds Seconds since 1970-01-01T00:00:00Z, clamped like FromMicroseconds()
+    /// \param offsetMinutes Timezone offset used for formatting, a multiple of 15 minutes
+    /// \return Timestamp
+    static constexpr Timestamp FromSeconds(const int64_t seconds, const int offsetMinutes = 0) noexcept
+    {
+        constexpr int64_t LIMIT = MAX_MICROSECONDS / 1000000 + 1;
+        const int64_t clamped   = (seconds < -LIMIT) ? -LIMIT : ((seconds > LIMIT) ? LIMIT : seconds);
+        return FromMicroseconds(clamped * 1000000, offsetMinutes);
+    }
+
+    /// \brief Get the current time in UTC
+    /// \return Current timestamp
+    static Timestamp Now() noexcept;
+
+    /// \brief Parse an RFC 822 / RFC 2822 date as used by RSS pubDate
+    /// \details Accepts an optional weekday, one or two digit days, two or four digit years, optional
+    /// seconds, numeric offsets and the zone names UT, GMT, UTC, Z, EST, EDT, CST, CDT, MST, MDT, PST
+    /// and PDT. A missing zone is read as UTC.
+    /// \param text Text to parse, e.g. "Wed, 02 Oct 2002 13:00:00 GMT"
+    /// \return Parsed timestamp, or no value if the text is not a valid date or out of range
+    static std::optional<Timestamp> ParseRfc822(const std::string_view text) noexcept;
+
+    /// \brief Parse an ISO 8601 / RFC 3339 date
+    /// \details Accepts a calendar date optionally followed by 'T' or ' ', a time with optional
+    /// seconds and fraction, and a zone designator 'Z', "+hh:mm", "+hhmm" or "+hh". A date without
+    /// time is midnight, a time without zone is read as UTC.
+    /// \param text Text to parse, e.g. "2002-10-02T13:00:00+02:00"
+    /// \return Parsed timestamp, or no value if the text is not a valid date or out of range
+    static std::optional<Timestamp> ParseIso8601(const std::string_view text) noexcept;
+
+    /// \brief Format as RFC 822 date in the stored timezone offset
+    /// \param buffer Target buffer, not terminated
+    /// \param size Size of the target buffer, at least RFC822_LENGTH
+    /// \return Number of characters written, 0 if the buffer is too small or the year is not in 0..9999
+    size_t FormatRfc822(char* buffer, const size_t size) const noexcept;
+
+    /// \brief Format as ISO 8601 date in the stored timezone offset
+    /// \details Fractional seconds are written only if present, UTC is written as 'Z'
+    /// \param buffer Target buffer, not terminated
+    /// \param size Size of the target buffer, at least ISO8601_MAX_LENGTH
+    /// \return Number of characters written, 0 if the buffer is too small or the year is not in 0..9999
+    size_t FormatIso8601(char* buffer, const size_t size) const noexcept;
+
+    /// \brief Get the instant
+    /// \return Microseconds since 1970-01-01T00:00:00Z
+    constexpr int64_t GetMicroseconds() const noexcept
+    {
+        return value_ >> OFFSET_BITS;
+    }
+
+    /// \brief Get the instant in whole seconds
+    /// \return Seconds since 1970-01-01T00:00:00Z, rounded towards negative infinity
+    constexpr int64_t GetSeconds() const noexcept
+    {
+        const int64_t microseconds = GetMicroseconds();
+        return (microseconds >= 0) ? (microseconds / 1000000) : -((-microseconds + 999999) / 1000000);
+    }
+
+    /// \brief Get the timezone offset
+    /// \return Offset from UTC in minutes
+    constexpr int GetOffsetMinutes() const noexcept
+    {
+        // Sign-extend the low bits
+        return static_cast<int>(static_cast<int64_t>(static_cast<uint64_t>(value_) << (64 - OFFSET_BITS)) >> (64 - OFFSET_BITS)) * 15;
+    }
+
+    /// \brief Get the same instant expressed in another timezone
+    /// \param offsetMinutes Timezone offset, a multiple of 15 minutes
+    /// \return Timestamp with the new offset
+    constexpr Timestamp WithOffset(const int offsetMinutes) const noexcept
+    {
+        return FromMicroseconds(GetMicroseconds(), offsetMinutes);
+    }
+
+    /// \brief Move a timestamp by a duration, keeping its timezone offset
+    friend constexpr Timestamp operator+(const Timestamp& lhs, const Timespan rhs) noexcept
+    {
+        return FromMicroseconds(lhs.GetMicroseconds() + rhs.GetMicroseconds(), lhs.GetOffsetMinutes());
+    }
+
+    /// \brief Move a timestamp back by a duration, keeping its timezone offset
+    friend constexpr Timestamp operator-(const Timestamp& lhs, const Timespan rhs) noexcept
+    {
+        return FromMicroseconds(lhs.GetMicroseconds() - rhs.GetMicroseconds(), lhs.GetOffsetMinutes());
+    }
+
+    /// \brief Get the duration between two instants
+    friend constexpr Timespan operator-(const Timestamp& lhs, const Timestamp& rhs) noexcept
+    {
+        return Timespan::FromMicroseconds(lhs.GetMicroseconds() - rhs.GetMicroseconds());
+    }
+
+    /// \brief Compare two instants for equality, ignoring the timezone offset
+    friend constexpr bool operator==(const Timestamp& lhs, const Timestamp& rhs) noexcept
+    {
+        return lhs.GetMicroseconds() == rhs.GetMicroseconds();
+    }
+
+    /// \brief Order two instants, ignoring the timezone offset
+    friend constexpr std::strong_ordering operator<=>(const Timestamp& lhs, const Timestamp& rhs) noexcept
+    {
+        return lhs.GetMicroseconds() <=> rhs.GetMicroseconds();
+    }
+
+private:
+    static constexpr int OFFSET_BITS     = 7;
+    static constexpr int64_t OFFSET_MASK = (int64_t{1} << OFFSET_BITS) - 1;
+
+    static_assert(MAX_MICROSECONDS == (INT64_MAX >> OFFSET_BITS), "the instant must fit above the offset bits");
+
+    // Microseconds in the upper 57 bits, offset in quarter hours as 7 bit two's complement
+    int64_t value_ = 0;
 };
+
+static_assert(sizeof(Timestamp) == 8, "runtime::Timestamp must stay 8 bytes");
 } // namespace ultralove::p3::runtime
 
 #pragma pack(pop)
@@ -0,0 +1,305 @@
+///
+// \file runtimexmlreader.cpp
+// \brief Streaming XML reader implementation
+// \details Tokenizer and reference decoding
+//
+
+#include "runtimexmlreader.h"
+#include "runtimeparsing.h"
+
+#include <cstring>
+
+namespace ultralove::p3::runtime {
+namespace {
+// Bytes that end a name inside a tag
+constexpr auto NAME_DELIMITERS = [] {
+    struct Table
+    {
+        bool delimiter[256];
+    } table{};
+    for (const char c : std::string_view(" \t\r\n/>=")) {
+        table.delimiter[static_cast<uint8_t>(c)] = true;
+    }
+    return table;
+}();
+
+const char* Find(const char* current, const char* end, const char c) noexcept
+{
+    const void* found = std::memchr(current, c, static_cast<size_t>(end - current));
+    return (found != nullptr) ? static_cast<const char*>(found) : end;
+}
+
+bool Contains(const std::string_view value, const char c) noexcept
+{
+    return (value.empty() == false) && (std::memchr(value.data(), c, value.size()) != nullptr);
+}
+
+// Bytes searched for the ';' of a reference, "&#x10FFFF;" is the longest one that is recognized
+constexpr size_t REFERENCE_WINDOW = parsing::MAX_REFERENCE_LENGTH + 2;
+
+using parsing::DecodeReference;
+using parsing::IsSpace;
+using parsing::StartsWith;
+} // namespace
+
+XmlReader::XmlReader(const std::string_view document) noexcept :
+    begin_(document.data()), current_(document.data()), end_(document.data() + document.size())
+{
+    // A UTF-8 byte order mark is not part of the document
+    if (StartsWith(current_, end_, "\xef\xbb\xbf")) {
+        current_ += 3;
+    }
+}
+
+XmlToken XmlReader::Next() noexcept
+{
+    if (failed_) {
+        return XmlToken::INVALID;
+    }
+    if (pendingEnd_) {
+        pendingEnd_ = false;
+        tokenDepth_ = depth_--;
+        return XmlToken::END_ELEMENT;
+    }
+
+    while (current_ != end_) {
+        if (*current_ != '<') {
+            const char* start = current_;
+            current_          = Find(current_, end_, '<');
+            if (depth_ == 0) {
+                // Whitespace around the root element
+                continue;
+            }
+            text_.raw     = std::string_view(start, static_cast<size_t>(current_ - start));
+            text_.encoded = Contains(text_.raw, '&');
+            tokenDepth_   = depth_;
+            return XmlToken::TEXT;
+        }
+
+        const char* markup = current_ + 1;
+        if (markup == end_) {
+            return Fail();
+        }
+        if (*markup == '/') {
+            return ParseEndTag();
+        }
+        if (*markup == '?') {
+            if (SkipPast("?>") == false) {
+                return Fail();
+            }
+            continue;
+        }
+        if (*markup == '!') {
+            if (StartsWith(markup, end_, "!--")) {
+                if (SkipPast("-->") == false) {
+                    return Fail();
+                }
+                continue;
+            }
+            if (StartsWith(markup, end_, "![CDATA[")) {
+                const char* start = markup + 8;
+                current_          = start;
+                if (SkipPast("]]>") == false) {
+                    return Fail();
+                }
+                text_.raw     = std::string_view(start, static_cast<size_t>(current_ - 3 - start));
+                text_.encoded = false;
+                tokenDepth_   = depth_;
+                return XmlToken::TEXT;
+            }
+            if (SkipDeclaration() == false) {
+                return Fail();
+            }
+            continue;
+        }
+        return ParseStartTag();
+    }
+    return (depth_ == 0) ? XmlToken::END : Fail();
+}
+
+bool XmlReader::Skip() noexcept
+{
+    const size_t depth = tokenDepth_;
+    for (;;) {
+        const XmlToken token = Next();
+        if ((token == XmlToken::END_ELEMENT) && (tokenDepth_ == depth)) {
+            return true;
+        }
+        if ((token == XmlToken::END) || (token == XmlToken::INVALID)) {
+            return false;
+        }
+    }
+}
+
+std::optional<XmlValue> XmlReader::GetAttribute(const std::string_view name) const noexcept
+{
+    for (size_t i = 0; i < attributeCount_; ++i) {
+        if (attributes_[i].name == name) {
+            return attributes_[i].value;
+        }
+    }
+    return std::nullopt;
+}
+
+size_t XmlReader::Decode(const std::string_view raw, char* target) noexcept
+{
+    const char* current = raw.data();
+    const char* end     = current + raw.size();
+    char* output        = target;
+    while (current != end) {
+        const char* ampersand = Find(current, end, '&');
+        const size_t run      = static_cast<size_t>(ampersand - current);
+        if (run > 0) {
+            std::memmove(output, current, run);
+            output += run;
+        }
+        current = ampersand;
+        if (current == end) {
+            break;
+        }
+
+        const size_t window     = static_cast<size_t>(end - current);
+        const char* semicolon   = Find(current + 1, current + ((window < REFERENCE_WINDOW) ? window : REFERENCE_WINDOW), ';');
+        const size_t decoded    = (semicolon < end) && (*semicolon == ';')
+                                      ? DecodeReference(std::string_view(current + 1, static_cast<size_t>(semicolon - current - 1)), output)
+                                      : 0;
+        if (decoded > 0) {
+            output += decoded;
+            current = semicolon + 1;
+        }
+        else {
+            *output++ = *current++;
+        }
+    }
+    return static_cast<size_t>(output - target);
+}
+
+XmlToken XmlReader::ParseStartTag() noexcept
+{
+    const char* p     = current_ + 1;
+    const char* start = p;
+    while ((p != end_) && (NAME_DELIMITERS.delimiter[static_cast<uint8_t>(*p)] == false)) {
+        ++p;
+    }
+    if (p == start) {
+        return Fail();
+    }
+    name_           = std::string_view(start, static_cast<size_t>(p - start));
+    attributeCount_ = 0;
+
+    for (;;) {
+        while ((p != end_) && IsSpace(*p)) {
+            ++p;
+        }
+        if (p == end_) {
+            return Fail();
+        }
+        if (*p == '>') {
+            ++p;
+            break;
+        }
+        if (*p == '/') {
+            if (((p + 1) == end_) || (p[1] != '>')) {
+                return Fail();
+            }
+            p += 2;
+            pendingEnd_ = true;
+            break;
+        }
+
+        const char* attributeName = p;
+        while ((p != end_) && (NAME_DELIMITERS.delimiter[static_cast<uint8_t>(*p)] == false)) {
+            ++p;
+        }
+        const std::string_view name(attributeName, static_cast<size_t>(p - attributeName));
+        while ((p != end_) && IsSpace(*p)) {
+            ++p;
+        }
+        if ((name.empty()) || (p == end_) || (*p != '=')) {
+            return Fail();
+        }
+        ++p;
+        while ((p != end_) && IsSpace(*p)) {
+            ++p;
+        }
+        if ((p == end_) || ((*p != '"') && (*p != '\''))) {
+            return Fail();
+        }
+        const char quote      = *p++;
+        const char* value     = p;
+        p                     = Find(p, end_, quote);
+        if (p == end_) {
+            return Fail();
+        }
+        if (attributeCount_ < MAX_ATTRIBUTES) {
+            Attribute& attribute   = attributes_[attributeCount_++];
+            attribute.name         = name;
+            attribute.value.raw    = std::string_view(value, static_cast<size_t>(p - value));
+            attribute.value.encoded = Contains(attribute.value.raw, '&');
+        }
+        ++p;
+    }
+
+    current_    = p;
+    tokenDepth_ = ++depth_;
+    return XmlToken::START_ELEMENT;
+}
+
+XmlToken XmlReader::ParseEndTag() noexcept
+{
+    const char* start = current_ + 2;
+    const char* p     = start;
+    while ((p != end_) && (NAME_DELIMITERS.delimiter[static_cast<uint8_t>(*p)] == false)) {
+        ++p;
+    }
+    name_ = std::string_view(start, static_cast<size_t>(p - start));
+    p     = Find(p, end_, '>');
+    if ((p == end_) || (depth_ == 0)) {
+        return Fail();
+    }
+    current_    = p + 1;
+    tokenDepth_ = depth_--;
+    return XmlToken::END_ELEMENT;
+}
+
+XmlToken XmlReader::Fail() noexcept
+{
+    failed_ = true;
+    return XmlToken::INVALID;
+}
+
+bool XmlReader::SkipPast(const std::string_view terminator) noexcept
+{
+    const char* p = current_;
+    for (;;) {
+        p = Find(p, end_, terminator[0]);
+        if (p == end_) {
+            return false;
+        }
+        if (StartsWith(p, end_, terminator)) {
+            current_ = p + terminator.size();
+            return true;
+        }
+        ++p;
+    }
+}
+
+bool XmlReader::SkipDeclaration() noexcept
+{
+    // <!DOCTYPE ...> with an optional internal subset in brackets
+    size_t brackets = 0;
+    for (const char* p = current_ + 2; p != end_; ++p) {
+        if (*p == '[') {
+            ++brackets;
+        }
+        else if ((*p == ']') && (brackets > 0)) {
+            --brackets;
+        }
+        else if ((*p == '>') && (brackets == 0)) {
+            current_ = p + 1;
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace ultralove::p3::runtime
@@ -0,0 +1,140 @@
+///
+// \file runtimexmlreader.h
+// \brief Streaming XML reader for the P3 Model library
+// \details Zero-copy pull tokenizer over an XML document in memory
+//
+
+#ifndef __P3_RUNTIME_XML_READER_H_INCL__
+#define __P3_RUNTIME_XML_READER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace ultralove::p3::runtime {
+/// \brief Token types reported by XmlReader
+enum class XmlToken : uint8_t
+{
+    START_ELEMENT, ///< Start tag, name and attributes are available
+    END_ELEMENT,   ///< End tag, also reported right after the start tag of an empty element
+    TEXT,          ///< Character data or a CDATA section
+    END,           ///< End of the document
+    INVALID        ///< Malformed markup, the reader stops here
+};
+
+/// \brief Raw XML value
+/// \details Refers into the document. Values that contain entity or character references have to
+/// be decoded before use, see XmlReader::Decode(); all other values can be used as they are.
+struct XmlValue
+{
+    /// \brief Characters as they appear in the document
+    std::string_view raw;
+
+    /// \brief True if raw contains references that need decoding
+    bool encoded = false;
+};
+
+/// \brief Streaming XML reader
+/// \details Pull parser that reports one token per call to Next() without building a tree and
+/// without allocating; names, attribute values and text are views into the document, which must
+/// outlive the reader. Comments, processing instructions and the document type declaration are
+/// skipped. Namespace prefixes are not resolved, names are reported as written, e.g.
+/// "itunes:image". Well-formedness is only checked as far as needed to tokenize the input.
+class XmlReader
+{
+public:
+    /// \brief Maximum number of attributes kept per element, further attributes are ignored
+    static constexpr size_t MAX_ATTRIBUTES = 16;
+
+    /// \brief Create a reader
+    /// \param document Complete XML document, e.g. the view of a MappedFile
+    explicit XmlReader(const std::string_view document) noexcept;
+
+    /// \brief Destroy the reader
+    virtual ~XmlReader() = default;
+
+    /// \brief Advance to the next token
+    /// \return Type of the token
+    XmlToken Next() noexcept;
+
+    /// \brief Skip the content of the current element
+    /// \details Must be called on a START_ELEMENT token; afterwards the reader is positioned on the
+    /// matching END_ELEMENT token
+    /// \return False if the document ended or is malformed
+    bool Skip() noexcept;
+
+    /// \brief Get the element name of the current START_ELEMENT or END_ELEMENT token
+    /// \return Qualified name
+    std::string_view GetName() const noexcept
+    {
+        return name_;
+    }
+
+    /// \brief Get the nesting depth of the current element
+    /// \details The root element has depth 1; start and end token of an element report the same depth
+    /// \return Depth of the current element
+    size_t GetDepth() const noexcept
+    {
+        return tokenDepth_;
+    }
+
+    /// \brief Get the current TEXT token
+    /// \return Character data, CDATA sections are never encoded
+    const XmlValue& GetText() const noexcept
+    {
+        return text_;
+    }
+
+    /// \brief Get an attribute of the current START_ELEMENT token
+    /// \param name Qualified attribute name
+    /// \return Attribute value, or no value if the element does not have the attribute
+    std::optional<XmlValue> GetAttribute(const std::string_view name) const noexcept;
+
+    /// \brief Get the byte offset of the reader in the document
+    /// \return Offset of the end of the current token
+    size_t GetOffset() const noexcept
+    {
+        return static_cast<size_t>(current_ - begin_);
+    }
+
+    /// \brief Decode entity and character references
+    /// \details Handles the five predefined entities and decimal and hexadecimal character
+    /// references; unknown references are copied unchanged. The result is never longer than the input.
+    /// \param raw Encoded characters
+    /// \param target Buffer of at least raw.size() bytes, not terminated
+    /// \return Number of bytes written
+    static size_t Decode(const std::string_view raw, char* target) noexcept;
+
+private:
+    struct Attribute
+    {
+        std::string_view name;
+        XmlValue value;
+    };
+
+    XmlToken ParseStartTag() noexcept;
+    XmlToken ParseEndTag() noexcept;
+    XmlToken Fail() noexcept;
+    bool SkipPast(const std::string_view terminator) noexcept;
+    bool SkipDeclaration() noexcept;
+
+    const char* begin_   = nullptr;
+    const char* current_ = nullptr;
+    const char* end_     = nullptr;
+    std::string_view name_;
+    XmlValue text_;
+    Attribute attributes_[MAX_ATTRIBUTES];
+    size_t attributeCount_ = 0;
+    size_t depth_          = 0;
+    size_t tokenDepth_     = 0;
+    bool pendingEnd_       = false;
+    bool failed_           = false;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_XML_READER_H_INCL__
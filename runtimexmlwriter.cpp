@@ -0,0 +1,248 @@
+///
+// \file runtimexmlwriter.cpp
+// \brief Streaming XML writer implementation
+// \details Buffer management and table-driven escaping
+//
+
+#include "runtimexmlwriter.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace ultralove::p3::runtime {
+namespace {
+constexpr size_t MIN_BUFFER_SIZE = 256;
+
+// Character classes of the escape table
+constexpr uint8_t ESCAPE_TEXT      = 0x01; // Must be escaped in text content
+constexpr uint8_t ESCAPE_ATTRIBUTE = 0x02; // Must be escaped in attribute values
+constexpr uint8_t ESCAPE_INVALID   = 0x04; // Not allowed in XML 1.0, dropped everywhere
+
+constexpr auto ESCAPE_CLASSES = [] {
+    struct Table
+    {
+        uint8_t classes[256];
+    } table{};
+    for (unsigned c = 0; c < 0x20; ++c) {
+        table.classes[c] = ESCAPE_INVALID;
+    }
+    // Whitespace is kept in text but would be normalized to spaces in attribute values
+    table.classes['\t'] = ESCAPE_ATTRIBUTE;
+    table.classes['\n'] = ESCAPE_ATTRIBUTE;
+    table.classes['\r'] = ESCAPE_ATTRIBUTE;
+    table.classes['&']  = ESCAPE_TEXT | ESCAPE_ATTRIBUTE;
+    table.classes['<']  = ESCAPE_TEXT | ESCAPE_ATTRIBUTE;
+    table.classes['>']  = ESCAPE_TEXT | ESCAPE_ATTRIBUTE; // Guards against "]]>" in text
+    table.classes['"']  = ESCAPE_ATTRIBUTE;
+    return table;
+}();
+
+constexpr std::string_view Replacement(const char c) noexcept
+{
+    switch (c) {
+    case '&':
+        return "&amp;";
+    case '<':
+        return "&lt;";
+    case '>':
+        return "&gt;";
+    case '"':
+        return "&quot;";
+    case '\t':
+        return "&#9;";
+    case '\n':
+        return "&#10;";
+    case '\r':
+        return "&#13;";
+    default:
+        return std::string_view();
+    }
+}
+
+constexpr std::string_view INDENTATION = "                                                                ";
+} // namespace
+
+XmlWriter::XmlWriter(OutputSink& sink, const size_t bufferSize) :
+    sink_(sink), buffer_(new char[(bufferSize < MIN_BUFFER_SIZE) ? MIN_BUFFER_SIZE : bufferSize]),
+    capacity_((bufferSize < MIN_BUFFER_SIZE) ? MIN_BUFFER_SIZE : bufferSize)
+{
+}
+
+void XmlWriter::Declaration()
+{
+    Append(std::string_view("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"));
+    closeOnNewLine_ = true;
+}
+
+void XmlWriter::OpenElement(const std::string_view name)
+{
+    CloseStartTag();
+    if ((GetBytesWritten() > 0) || (depth_ > 0)) {
+        NewLine();
+    }
+    Append('<');
+    Append(name);
+    startTagOpen_   = true;
+    closeOnNewLine_ = false;
+    ++depth_;
+}
+
+void XmlWriter::Attribute(const std::string_view name, const std::string_view value)
+{
+    Append(' ');
+    Append(name);
+    Append(std::string_view("=\""));
+    AppendEscaped(value, ESCAPE_ATTRIBUTE | ESCAPE_INVALID);
+    Append('"');
+}
+
+void XmlWriter::Attribute(const std::string_view name, const uint64_t value)
+{
+    char digits[20];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    Append(' ');
+    Append(name);
+    Append(std::string_view("=\""));
+    Append(digits, static_cast<size_t>(result.ptr - digits));
+    Append('"');
+}
+
+void XmlWriter::Text(const std::string_view value)
+{
+    CloseStartTag();
+    AppendEscaped(value, ESCAPE_TEXT | ESCAPE_INVALID);
+    closeOnNewLine_ = false;
+}
+
+void XmlWriter::Text(const uint64_t value)
+{
+    char digits[20];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    Raw(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+}
+
+void XmlWriter::Raw(const std::string_view value)
+{
+    CloseStartTag();
+    Append(value);
+    closeOnNewLine_ = false;
+}
+
+void XmlWriter::CloseElement(const std::string_view name)
+{
+    if (depth_ > 0) {
+        --depth_;
+    }
+    if (startTagOpen_) {
+        Append(std::string_view("/>"));
+        startTagOpen_ = false;
+    }
+    else {
+        if (closeOnNewLine_) {
+            NewLine();
+        }
+        Append(std::string_view("</"));
+        Append(name);
+        Append('>');
+    }
+    closeOnNewLine_ = true;
+}
+
+void XmlWriter::TextElement(const std::string_view name, const std::string_view value)
+{
+    OpenElement(name);
+    Text(value);
+    CloseElement(name);
+}
+
+void XmlWriter::BeginFragment(const size_t depth)
+{
+    depth_          = depth;
+    startTagOpen_   = false;
+    closeOnNewLine_ = true;
+}
+
+void XmlWriter::AppendFragment(const std::string_view fragment)
+{
+    CloseStartTag();
+    Append(fragment);
+    closeOnNewLine_ = true;
+}
+
+bool XmlWriter::Flush()
+{
+    if (used_ > 0) {
+        if (good_ && (sink_.Write(buffer_.get(), used_) == false)) {
+            good_ = false;
+        }
+        bytesFlushed_ += used_;
+        used_ = 0;
+    }
+    return good_;
+}
+
+void XmlWriter::Append(const char* data, const size_t size)
+{
+    if (size <= capacity_ - used_) {
+        std::memcpy(buffer_.get() + used_, data, size);
+        used_ += size;
+        return;
+    }
+    AppendSlow(data, size);
+}
+
+void XmlWriter::AppendSlow(const char* data, const size_t size)
+{
+    Flush();
+    if (size < capacity_) {
+        std::memcpy(buffer_.get(), data, size);
+        used_ = size;
+        return;
+    }
+
+    // Large values bypass the buffer
+    if (good_ && (sink_.Write(data, size) == false)) {
+        good_ = false;
+    }
+    bytesFlushed_ += size;
+}
+
+void XmlWriter::AppendEscaped(const std::string_view value, const uint8_t mask)
+{
+    // Copy runs of plain characters in one piece, most values contain nothing to escape at all
+    const char* current = value.data();
+    const char* end     = current + value.size();
+    while (current != end) {
+        const char* run = current;
+        while ((current != end) && ((ESCAPE_CLASSES.classes[static_cast<uint8_t>(*current)] & mask) == 0)) {
+            ++current;
+        }
+        if (current != run) {
+            Append(run, static_cast<size_t>(current - run));
+        }
+        if (current != end) {
+            Append(Replacement(*current));
+            ++current;
+        }
+    }
+}
+
+void XmlWriter::CloseStartTag()
+{
+    if (startTagOpen_) {
+        Append('>');
+        startTagOpen_ = false;
+    }
+}
+
+void XmlWriter::NewLine()
+{
+    Append('\n');
+    size_t remaining = depth_ * 2;
+    while (remaining > 0) {
+        const size_t count = (remaining < INDENTATION.size()) ? remaining : INDENTATION.size();
+        Append(INDENTATION.data(), count);
+        remaining -= count;
+    }
+}
+} // namespace ultralove::p3::runtime
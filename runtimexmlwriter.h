@@ -0,0 +1,150 @@
+///
+// \file runtimexmlwriter.h
+// \brief Streaming XML writer for the P3 Model library
+// \details Buffered, allocation-free XML serialization into an OutputSink
+//
+
+#ifndef __P3_RUNTIME_XML_WRITER_H_INCL__
+#define __P3_RUNTIME_XML_WRITER_H_INCL__
+
+#pragma pack(push, 8)
+
+#include "runtimeoutputsink.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace ultralove::p3::runtime {
+/// \brief Streaming XML writer
+/// \details Writes elements, attributes and text straight into a fixed-size buffer that is handed
+/// to an OutputSink whenever it fills up; no document tree and no intermediate strings are built,
+/// so memory use is bounded by the buffer size regardless of the document size. Text and attribute
+/// values are escaped, and characters that XML 1.0 does not allow are dropped. Nested elements are
+/// indented by two spaces, text content is written as is.
+///
+/// The writer does not check that elements are balanced; callers close every element they open,
+/// passing the same name. After the sink has reported an error all further output is discarded and
+/// IsGood() returns false.
+class XmlWriter
+{
+public:
+    /// \brief Default size of the output buffer
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+    /// \brief Create a writer
+    /// \param sink Destination of the output, must outlive the writer
+    /// \param bufferSize Size of the output buffer
+    explicit XmlWriter(OutputSink& sink, const size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /// \brief Destroy the writer without flushing pending output
+    virtual ~XmlWriter() = default;
+
+    XmlWriter(const XmlWriter&)            = delete;
+    XmlWriter& operator=(const XmlWriter&) = delete;
+
+    /// \brief Write the XML declaration for UTF-8 documents
+    void Declaration();
+
+    /// \brief Start an element
+    /// \details Attributes may be added until the next element or text is written
+    /// \param name Qualified element name, written without escaping
+    void OpenElement(const std::string_view name);
+
+    /// \brief Add an attribute to the element just started
+    /// \param name Qualified attribute name, written without escaping
+    /// \param value Attribute value, escaped
+    void Attribute(const std::string_view name, const std::string_view value);
+
+    /// \brief Add a numeric attribute to the element just started
+    /// \param name Qualified attribute name, written without escaping
+    /// \param value Attribute value
+    void Attribute(const std::string_view name, const uint64_t value);
+
+    /// \brief Write text content into the current element
+    /// \param value Text, escaped
+    void Text(const std::string_view value);
+
+    /// \brief Write numeric text content into the current element
+    /// \param value Number
+    void Text(const uint64_t value);
+
+    /// \brief Write preformatted content into the current element
+    /// \details For dates, durations and identifiers that are known not to need escaping
+    /// \param value Characters written verbatim
+    void Raw(const std::string_view value);
+
+    /// \brief End the current element
+    /// \details Elements without content are written as empty-element tags
+    /// \param name Name the element was opened with
+    void CloseElement(const std::string_view name);
+
+    /// \brief Write an element containing only text
+    /// \param name Qualified element name
+    /// \param value Text, escaped
+    void TextElement(const std::string_view name, const std::string_view value);
+
+    /// \brief Continue as a fragment of a document that is written elsewhere
+    /// \details Output is laid out as if it followed a closed sibling element at the given depth, so
+    /// the bytes can later be inserted into the document with AppendFragment() by a writer at that
+    /// depth. Fragments are used to cache parts of documents that did not change.
+    /// \param depth Number of elements that are open around the fragment
+    void BeginFragment(const size_t depth);
+
+    /// \brief Insert a fragment produced by a writer started with BeginFragment()
+    /// \param fragment Complete elements written at the current depth, inserted verbatim
+    void AppendFragment(const std::string_view fragment);
+
+    /// \brief Hand all buffered output to the sink
+    /// \return True if all output so far reached the sink
+    bool Flush();
+
+    /// \brief Check whether all output so far was accepted by the sink
+    /// \return False after the sink has reported an error
+    bool IsGood() const noexcept
+    {
+        return good_;
+    }
+
+    /// \brief Get the number of bytes produced so far, including buffered bytes
+    /// \return Byte count
+    uint64_t GetBytesWritten() const noexcept
+    {
+        return bytesFlushed_ + used_;
+    }
+
+private:
+    void Append(const char* data, const size_t size);
+    void AppendSlow(const char* data, const size_t size);
+    void AppendEscaped(const std::string_view value, const uint8_t mask);
+    void CloseStartTag();
+    void NewLine();
+
+    void Append(const std::string_view value)
+    {
+        Append(value.data(), value.size());
+    }
+
+    void Append(const char c)
+    {
+        if (used_ == capacity_) {
+            Flush();
+        }
+        buffer_[used_++] = c;
+    }
+
+    OutputSink& sink_;
+    std::unique_ptr<char[]> buffer_;
+    size_t capacity_       = 0;
+    size_t used_           = 0;
+    uint64_t bytesFlushed_ = 0;
+    size_t depth_          = 0;
+    bool startTagOpen_     = false;
+    bool closeOnNewLine_   = false;
+    bool good_             = true;
+};
+} // namespace ultralove::p3::runtime
+
+#pragma pack(pop)
+
+#endif // __P3_RUNTIME_XML_WRITER_H_INCL__
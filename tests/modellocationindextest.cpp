@@ -0,0 +1,186 @@
+///
+// \file modellocationindextest.cpp
+// \brief Tests of the location index
+// \details Radius and box queries are compared with a scan over all locations
+//
+
+#include "model.h"
+#include "testing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+namespace {
+namespace runtime = ultralove::p3::runtime;
+using namespace ultralove::p3::model;
+
+constexpr double EARTH_RADIUS       = 6371008.8; // Mean radius in meters, as the index uses it
+constexpr double RADIANS_PER_DEGREE = std::numbers::pi / 180.0;
+
+struct Generator
+{
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+
+    // Uniform in [minimum, maximum]
+    double Next(const double minimum, const double maximum) noexcept
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return minimum + (maximum - minimum) * static_cast<double>(state >> 11) / static_cast<double>(1ull << 53);
+    }
+};
+
+double Distance(const LocationTag& from, const LocationTag& to) noexcept
+{
+    const double phi1    = from.latitude * RADIANS_PER_DEGREE;
+    const double phi2    = to.latitude * RADIANS_PER_DEGREE;
+    const double sinPhi  = std::sin((phi2 - phi1) / 2);
+    const double sinLamb = std::sin((to.longitude - from.longitude) * RADIANS_PER_DEGREE / 2);
+    const double a       = sinPhi * sinPhi + std::cos(phi1) * std::cos(phi2) * sinLamb * sinLamb;
+    return 2.0 * EARTH_RADIUS * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+LocationTag MakeLocation(const double latitude, const double longitude)
+{
+    LocationTag location{};
+    location.latitude  = latitude;
+    location.longitude = longitude;
+    return location;
+}
+
+// Identifiers of the hits in ascending order, each episode carries the index of its location
+std::vector<uint64_t> Identify(const std::vector<LocationHit>& hits)
+{
+    std::vector<uint64_t> result;
+    for (const LocationHit& hit : hits) {
+        result.push_back(hit.episode.low);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void TestEmpty()
+{
+    LocationIndex index;
+    index.Build();
+    std::vector<LocationHit> hits;
+    P3_CHECK(index.GetCount() == 0);
+    P3_CHECK(index.FindWithin(0.0, 0.0, 1.0e7, hits) == 0);
+    P3_CHECK(index.FindInBox(-90.0, -180.0, 90.0, 180.0, hits) == 0);
+    index.Add(runtime::Guid{}, EntityHandle<LocationTag>());
+    index.Build();
+    P3_CHECK(index.GetCount() == 0);
+}
+
+void TestWithin(const LocationIndex& index, const std::vector<LocationTag>& locations, const LocationTag& center, const double radius)
+{
+    std::vector<LocationHit> hits;
+    const size_t count = index.FindWithin(center.latitude, center.longitude, radius, hits);
+    P3_CHECK(count == hits.size());
+    for (size_t i = 1; i < hits.size(); ++i) {
+        P3_CHECK(hits[i - 1].distance <= hits[i].distance);
+    }
+    for (const LocationHit& hit : hits) {
+        P3_CHECK(hit.distance <= radius);
+        P3_CHECK(hit.location.Get() != nullptr);
+    }
+
+    // Locations on the circle may go either way with rounding and are not compared
+    const std::vector<uint64_t> found = Identify(hits);
+    for (uint64_t i = 0; i < locations.size(); ++i) {
+        const double distance = Distance(center, locations[i]);
+        if (std::abs(distance - radius) <= 1.0e-6 * radius) {
+            continue;
+        }
+        P3_CHECK((distance < radius) == std::binary_search(found.begin(), found.end(), i));
+    }
+}
+
+void TestInBox(const LocationIndex& index, const std::vector<LocationTag>& locations, const double south, const double west, const double north,
+    const double east)
+{
+    std::vector<LocationHit> hits;
+    P3_CHECK(index.FindInBox(south, west, north, east, hits) == hits.size());
+    const std::vector<uint64_t> found = Identify(hits);
+    P3_CHECK(std::adjacent_find(found.begin(), found.end()) == found.end());
+    std::vector<uint64_t> expected;
+    for (uint64_t i = 0; i < locations.size(); ++i) {
+        const LocationTag& location = locations[i];
+        const bool longitude = (west <= east) ? ((location.longitude >= west) && (location.longitude <= east))
+                                              : ((location.longitude >= west) || (location.longitude <= east));
+        if ((location.latitude >= south) && (location.latitude <= north) && longitude) {
+            expected.push_back(i);
+        }
+    }
+    P3_CHECK(found == expected);
+}
+
+void TestAgainstScan(const size_t count, Generator& generator)
+{
+    // Half of the locations crowd the antimeridian and the poles, where the circle bounds wrap
+    std::vector<LocationTag> locations;
+    for (size_t i = 0; i < count; ++i) {
+        if ((i % 2) == 0) {
+            locations.push_back(MakeLocation(generator.Next(-90.0, 90.0), generator.Next(-180.0, 180.0)));
+        }
+        else if ((i % 4) == 1) {
+            const double longitude = generator.Next(175.0, 185.0);
+            locations.push_back(MakeLocation(generator.Next(-60.0, 60.0), (longitude > 180.0) ? longitude - 360.0 : longitude));
+        }
+        else {
+            locations.push_back(MakeLocation(generator.Next(80.0, 90.0) * ((i % 8) == 3 ? 1.0 : -1.0), generator.Next(-180.0, 180.0)));
+        }
+    }
+    LocationIndex index;
+    for (uint64_t i = 0; i < locations.size(); ++i) {
+        index.Add(runtime::Guid{0, i}, EntityHandle<LocationTag>::Make(locations[i]));
+    }
+    index.Build();
+    P3_CHECK(index.GetCount() == count);
+
+    for (int i = 0; i < 200; ++i) {
+        // Centers on a location, next to the antimeridian or anywhere
+        LocationTag center = MakeLocation(generator.Next(-90.0, 90.0), generator.Next(-180.0, 180.0));
+        if ((i % 3) == 0) {
+            center = locations[static_cast<size_t>(generator.Next(0.0, static_cast<double>(count) - 1.0))];
+        }
+        else if ((i % 3) == 1) {
+            center = MakeLocation(generator.Next(-60.0, 60.0), generator.Next(178.0, 180.0) * ((i % 2) == 0 ? 1.0 : -1.0));
+        }
+        TestWithin(index, locations, center, std::pow(10.0, generator.Next(3.0, 7.0)));
+    }
+    TestWithin(index, locations, MakeLocation(90.0, 0.0), 1.2e6);
+    TestWithin(index, locations, MakeLocation(-90.0, 0.0), 1.2e6);
+    TestWithin(index, locations, MakeLocation(0.0, 0.0), 2.1e7);
+
+    for (int i = 0; i < 200; ++i) {
+        const double south = generator.Next(-90.0, 90.0);
+        const double north = std::min(90.0, south + generator.Next(0.0, 60.0));
+        const double west  = generator.Next(-180.0, 180.0);
+        const double east  = generator.Next(-180.0, 180.0);
+        TestInBox(index, locations, south, west, north, east);
+    }
+    TestInBox(index, locations, -90.0, -180.0, 90.0, 180.0);
+    TestInBox(index, locations, -60.0, 175.0, 60.0, -175.0);
+
+    // Hits are appended to what the caller already has
+    std::vector<LocationHit> hits(3);
+    const size_t appended = index.FindInBox(-90.0, -180.0, 90.0, 180.0, hits);
+    P3_CHECK((appended == count) && (hits.size() == count + 3));
+}
+} // namespace
+
+int main()
+{
+    TestEmpty();
+    Generator generator;
+    // Sizes around the node capacity exercise leaves and levels that are not full
+    for (const size_t count : {1uz, 2uz, 15uz, 16uz, 17uz, 256uz, 257uz, 5000uz}) {
+        TestAgainstScan(count, generator);
+    }
+    return ultralove::p3::tests::Finish("modellocationindextest");
+}
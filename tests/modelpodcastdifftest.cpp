@@ -0,0 +1,187 @@
+///
+// \file modelpodcastdifftest.cpp
+// \brief Tests of podcast patches
+// \details Diff() and Apply() keep a replica with its own registries equal to the source
+//
+
+#include "model.h"
+#include "testing.h"
+
+#include <string>
+
+namespace {
+namespace runtime = ultralove::p3::runtime;
+using namespace ultralove::p3::model;
+
+struct Source
+{
+    Podcast podcast;
+    EntityRegistry<Contributor> contributors;
+    EntityRegistry<Tag> tags;
+    ContentHasher hasher;
+};
+
+struct Replica
+{
+    Podcast podcast;
+    EntityRegistry<Contributor> contributors;
+    EntityRegistry<Tag> tags;
+    ContentHasher hasher;
+};
+
+Episode MakeEpisode(const std::string& title, const EntityHandle<Contributor>& host, const EntityHandle<Tag>& tag)
+{
+    Episode episode{};
+    episode.id              = runtime::Guid::NewV7();
+    episode.title           = runtime::String(title);
+    episode.publicationDate = runtime::Timestamp::FromSeconds(1700000000);
+    episode.contributors.push_back(Contribution{host, runtime::String("host"), runtime::String()});
+    episode.tags.push_back(TagReference{tag, 1.0});
+    return episode;
+}
+
+void RefreshHandles(Source& source)
+{
+    for (Season& season : source.podcast.seasons) {
+        for (Episode& episode : season.episodes) {
+            for (Contribution& contribution : episode.contributors) {
+                source.contributors.Refresh(contribution.contributor);
+            }
+            for (TagReference& reference : episode.tags) {
+                source.tags.Refresh(reference.tag);
+            }
+        }
+    }
+}
+
+// Sends the changes of the source to the replica and checks that both have the same content
+bool Synchronize(Source& source, Replica& replica, PodcastPatch& patch)
+{
+    if ((Diff(replica.podcast, source.podcast, source.hasher, patch) == false) ||
+        (Apply(replica.podcast, patch, replica.contributors, replica.tags, replica.hasher) == false)) {
+        return false;
+    }
+    return source.hasher.Hash(source.podcast) == replica.hasher.Hash(replica.podcast);
+}
+
+void TestRoundTrip()
+{
+    Source source;
+    Replica replica;
+    Contributor alice{};
+    alice.id                             = runtime::Guid::NewV7();
+    alice.name                           = runtime::String("Alice");
+    const EntityHandle<Contributor> host = source.contributors.Register(alice);
+    Tag news{};
+    news.id                     = runtime::Guid::NewV7();
+    news.name                   = runtime::String("News");
+    const EntityHandle<Tag> tag = source.tags.Register(news);
+
+    source.podcast.id    = runtime::Guid::NewV7();
+    source.podcast.title = runtime::String("Show");
+    for (int s = 0; s < 2; ++s) {
+        Season season{};
+        season.id           = runtime::Guid::NewV7();
+        season.seasonNumber = static_cast<uint32_t>(s + 1);
+        for (int e = 0; e < 3; ++e) {
+            season.episodes.push_back(MakeEpisode("Episode " + std::to_string(s * 3 + e), host, tag));
+        }
+        source.podcast.seasons.push_back(std::move(season));
+    }
+
+    // The first patch carries everything
+    PodcastPatch patch;
+    P3_CHECK(Synchronize(source, replica, patch));
+    P3_CHECK((patch.episodes.size() == 6) && (patch.contributors.size() == 1) && (patch.tags.size() == 1));
+    P3_CHECK(replica.podcast.seasons.size() == 2);
+    P3_CHECK(replica.podcast.seasons[1].episodes[2].title.GetView() == "Episode 5");
+    P3_CHECK(replica.contributors.Find(alice.id)->name.GetView() == "Alice");
+    P3_CHECK(replica.podcast.seasons[0].episodes[0].contributors[0].contributor.Get() == replica.contributors.Find(alice.id).Get());
+
+    // Without changes the patch is empty and applying it changes nothing
+    P3_CHECK(Synchronize(source, replica, patch));
+    P3_CHECK(patch.IsEmpty() && patch.episodes.empty());
+
+    // One changed episode, one added, one removed and a shared contributor changed copy-on-write
+    Season& first           = source.podcast.seasons[0];
+    first.episodes[1].title = runtime::String("Episode 1, revised");
+    MarkModified(source.podcast, first, first.episodes[1]);
+    first.episodes.push_back(MakeEpisode("Episode 6", host, tag));
+    MarkModified(source.podcast, first, first.episodes.back());
+    source.podcast.seasons[1].episodes.erase(source.podcast.seasons[1].episodes.begin());
+    MarkModified(source.podcast, source.podcast.seasons[1]);
+    Contributor renamed = *host;
+    renamed.name        = runtime::String("Alicia");
+    MarkModified(renamed);
+    source.contributors.Register(renamed);
+    RefreshHandles(source);
+
+    const EntityHandle<Contributor> before = replica.contributors.Find(alice.id);
+    P3_CHECK(Synchronize(source, replica, patch));
+    P3_CHECK(patch.contributors.size() == 1);
+    P3_CHECK(replica.podcast.seasons[0].episodes.size() == 4);
+    P3_CHECK(replica.podcast.seasons[1].episodes.size() == 2);
+    P3_CHECK(replica.podcast.seasons[0].episodes[1].title.GetView() == "Episode 1, revised");
+    P3_CHECK(replica.podcast.seasons[1].episodes[1].contributors[0].contributor->name.GetView() == "Alicia");
+    // Readers of the previous contributor keep their copy
+    P3_CHECK(before->name.GetView() == "Alice");
+
+    // Reordered seasons travel as an order only
+    std::swap(source.podcast.seasons[0], source.podcast.seasons[1]);
+    MarkModified(source.podcast);
+    P3_CHECK(Synchronize(source, replica, patch));
+    P3_CHECK(patch.episodes.empty() && (patch.seasonOrder.size() == 2));
+    P3_CHECK(replica.podcast.seasons[0].id == source.podcast.seasons[0].id);
+}
+
+void TestRejectedPatch()
+{
+    Source source;
+    Replica replica;
+    source.podcast.id    = runtime::Guid::NewV7();
+    source.podcast.title = runtime::String("Show");
+    Season season{};
+    season.id = runtime::Guid::NewV7();
+    Contributor bob{};
+    bob.id   = runtime::Guid::NewV7();
+    bob.name = runtime::String("Bob");
+    Tag tech{};
+    tech.id   = runtime::Guid::NewV7();
+    tech.name = runtime::String("Tech");
+    season.episodes.push_back(MakeEpisode("Pilot", source.contributors.Register(bob), source.tags.Register(tech)));
+    source.podcast.seasons.push_back(std::move(season));
+
+    PodcastPatch patch;
+    P3_CHECK(Synchronize(source, replica, patch));
+    const runtime::Hash128 replicaHash = replica.hasher.Hash(replica.podcast);
+
+    Contributor renamed = *source.contributors.Find(bob.id);
+    renamed.name        = runtime::String("Robert");
+    MarkModified(renamed);
+    source.contributors.Register(renamed);
+    RefreshHandles(source);
+    P3_CHECK(Diff(replica.podcast, source.podcast, source.hasher, patch));
+
+    // A patch that does not produce its target leaves replica and registries untouched
+    PodcastPatch damaged = patch;
+    damaged.targetHash.low ^= 1;
+    P3_CHECK(Apply(replica.podcast, damaged, replica.contributors, replica.tags, replica.hasher) == false);
+    P3_CHECK(replica.contributors.Find(bob.id)->name.GetView() == "Bob");
+    P3_CHECK(replica.hasher.Hash(replica.podcast) == replicaHash);
+
+    // A patch for another base is refused as well
+    damaged = patch;
+    damaged.baseHash.high ^= 1;
+    P3_CHECK(Apply(replica.podcast, damaged, replica.contributors, replica.tags, replica.hasher) == false);
+
+    P3_CHECK(Apply(replica.podcast, patch, replica.contributors, replica.tags, replica.hasher));
+    P3_CHECK(replica.contributors.Find(bob.id)->name.GetView() == "Robert");
+}
+} // namespace
+
+int main()
+{
+    TestRoundTrip();
+    TestRejectedPatch();
+    return ultralove::p3::tests::Finish("modelpodcastdifftest");
+}
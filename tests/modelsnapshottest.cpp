@@ -0,0 +1,134 @@
+///
+// \file modelsnapshottest.cpp
+// \brief Tests of podcast snapshots
+// \details Snapshots written with and without a dictionary read back through the views as written
+//
+
+#include "model.h"
+#include "testing.h"
+
+#include <string>
+
+namespace {
+namespace runtime = ultralove::p3::runtime;
+using namespace ultralove::p3::model;
+
+Podcast MakePodcast(const EntityHandle<Contributor>& host)
+{
+    Podcast podcast{};
+    podcast.id          = runtime::Guid::NewV7();
+    podcast.title       = runtime::String("Show");
+    podcast.description = runtime::String("A weekly show about the craft of building podcast feeds, hosted by Alice.");
+    for (int s = 0; s < 3; ++s) {
+        Season season{};
+        season.id           = runtime::Guid::NewV7();
+        season.title        = runtime::String("Season " + std::to_string(s + 1));
+        season.seasonNumber = static_cast<uint32_t>(s + 1);
+        for (int e = 0; e < 20; ++e) {
+            const std::string number = std::to_string(s * 20 + e);
+            Episode episode{};
+            episode.id              = runtime::Guid::NewV7();
+            episode.title           = runtime::String("Episode " + number);
+            episode.description     = runtime::String(
+                "In episode " + number + " of the weekly show about the craft of building podcast feeds, Alice talks about enclosures and chapters.");
+            episode.publicationDate = runtime::Timestamp::FromSeconds(1700000000 + (s * 20 + e) * 604800);
+            episode.contributors.push_back(Contribution{host, runtime::String("host"), runtime::String()});
+            season.episodes.push_back(std::move(episode));
+        }
+        podcast.seasons.push_back(std::move(season));
+    }
+    return podcast;
+}
+
+// The views of an open snapshot show the podcast as it was written
+bool Matches(const Snapshot& snapshot, const Podcast& podcast)
+{
+    const PodcastView view = snapshot.GetPodcast();
+    if ((view.GetTitle() != podcast.title.GetView()) || (view.GetDescription() != podcast.description.GetView()) ||
+        (view.GetSeasons().GetCount() != podcast.seasons.size()) || (snapshot.GetContributors().GetCount() != 1)) {
+        return false;
+    }
+    for (size_t s = 0; s < podcast.seasons.size(); ++s) {
+        const SeasonView season = view.GetSeasons()[s];
+        if ((season.GetTitle() != podcast.seasons[s].title.GetView()) || (season.GetEpisodes().GetCount() != podcast.seasons[s].episodes.size())) {
+            return false;
+        }
+        for (size_t e = 0; e < podcast.seasons[s].episodes.size(); ++e) {
+            const Episode& episode = podcast.seasons[s].episodes[e];
+            const EpisodeView read = season.GetEpisodes()[e];
+            if ((read.GetId() != episode.id) || (read.GetTitle() != episode.title.GetView()) ||
+                (read.GetDescription() != episode.description.GetView()) || (read.GetPublicationDate() != episode.publicationDate) ||
+                (read.GetContributors()[0].GetContributor().GetName() != "Alice")) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// A truncated or damaged copy of a snapshot must not pass as valid
+void TestDamaged(const std::string& data)
+{
+    Snapshot snapshot;
+    const std::string truncated = data.substr(0, data.size() - 8);
+    P3_CHECK(snapshot.Attach(truncated) == false);
+    P3_CHECK(snapshot.Attach(std::string_view(data).substr(0, 16)) == false);
+
+    std::string damaged = data;
+    damaged[0]          = 'X';
+    P3_CHECK(snapshot.Attach(damaged) == false);
+
+    // The header is intact, the seasons of the podcast point past the end
+    damaged                        = data;
+    const SnapshotHeader& header   = *reinterpret_cast<const SnapshotHeader*>(damaged.data());
+    SnapshotPodcastRecord& podcast = *reinterpret_cast<SnapshotPodcastRecord*>(damaged.data() + header.podcast);
+    podcast.seasons.count          = 0xffffffffu;
+    P3_CHECK(snapshot.Attach(damaged));
+    P3_CHECK(snapshot.Validate() == false);
+}
+
+void TestRoundTrip()
+{
+    Contributor alice{};
+    alice.id                             = runtime::Guid::NewV7();
+    alice.name                           = runtime::String("Alice");
+    const EntityHandle<Contributor> host = EntityHandle<Contributor>::Make(alice);
+    const Podcast podcast                = MakePodcast(host);
+
+    std::string data;
+    runtime::StringOutputSink sink(data);
+    P3_CHECK(Snapshot::Write(podcast, sink));
+    Snapshot snapshot;
+    P3_CHECK(snapshot.Attach(data));
+    P3_CHECK(snapshot.Validate());
+    P3_CHECK(Matches(snapshot, podcast));
+    TestDamaged(data);
+
+    // Descriptions compressed with a dictionary read back the same and take less space
+    const runtime::TextDictionary dictionary = LazyText::Train(podcast);
+    P3_CHECK(dictionary.GetSize() > 0);
+    std::string compressed;
+    runtime::StringOutputSink compressedSink(compressed);
+    runtime::TextCompressionReport report;
+    P3_CHECK(Snapshot::Write(podcast, compressedSink, dictionary, &report));
+    P3_CHECK((report.values > 0) && (report.storedBytes < report.rawBytes));
+    P3_CHECK(compressed.size() < data.size());
+    P3_CHECK(snapshot.Attach(compressed));
+    P3_CHECK(snapshot.Validate());
+    P3_CHECK(Matches(snapshot, podcast));
+    TestDamaged(compressed);
+
+    // An empty podcast is a valid snapshot, too
+    std::string empty;
+    runtime::StringOutputSink emptySink(empty);
+    P3_CHECK(Snapshot::Write(Podcast{}, emptySink));
+    P3_CHECK(snapshot.Attach(empty) && snapshot.Validate());
+    P3_CHECK(snapshot.GetPodcast().GetSeasons().GetCount() == 0);
+}
+} // namespace
+
+int main()
+{
+    TestRoundTrip();
+    return ultralove::p3::tests::Finish("modelsnapshottest");
+}
@@ -0,0 +1,155 @@
+///
+// \file modeltimelineindextest.cpp
+// \brief Tests of the timeline interval index
+// \details Point and range queries are compared with a scan over all ranges
+//
+
+#include "model.h"
+#include "testing.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace {
+namespace runtime = ultralove::p3::runtime;
+using namespace ultralove::p3::model;
+
+struct Generator
+{
+    uint64_t state = 0x2545f4914f6cdd1dull;
+
+    int64_t Next(const int64_t bound) noexcept
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<int64_t>(state % static_cast<uint64_t>(bound));
+    }
+};
+
+using Key = std::tuple<int, uint32_t>;
+
+Key MakeKey(const TimelineEntry& entry)
+{
+    return Key{static_cast<int>(entry.type), entry.item};
+}
+
+// Every range of the index in its own order, found by looking at all of them
+std::vector<Key> Scan(const std::vector<TimelineEntry>& all, const int64_t from, const int64_t until)
+{
+    std::vector<Key> keys;
+    for (const TimelineEntry& entry : all) {
+        if ((entry.startTime.GetNanoseconds() < until) && (from < entry.endTime.GetNanoseconds())) {
+            keys.push_back(MakeKey(entry));
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+std::vector<Key> Keys(const std::vector<TimelineEntry>& entries)
+{
+    std::vector<Key> keys;
+    for (const TimelineEntry& entry : entries) {
+        keys.push_back(MakeKey(entry));
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+bool IsOrdered(const std::vector<TimelineEntry>& entries)
+{
+    return std::is_sorted(entries.begin(), entries.end(), [](const TimelineEntry& lhs, const TimelineEntry& rhs) {
+        return lhs.startTime < rhs.startTime;
+    });
+}
+
+void TestAgainstScan(const size_t chapterCount, const size_t segmentCount, Generator& generator)
+{
+    const int64_t length = 3600 * runtime::Timespan::NANOSECONDS_PER_SECOND;
+    std::vector<EntityHandle<ChapterTag>> chapters;
+    for (size_t i = 0; i < chapterCount; ++i) {
+        ChapterTag chapter{};
+        chapter.startTime = runtime::Timespan::FromNanoseconds(generator.Next(length));
+        chapter.endTime   = chapter.startTime + runtime::Timespan::FromNanoseconds(generator.Next(length / 4));
+        chapters.push_back(EntityHandle<ChapterTag>::Make(chapter));
+    }
+    std::vector<EntityHandle<TranscriptTag>> segments;
+    for (size_t i = 0; i < segmentCount; ++i) {
+        TranscriptTag segment{};
+        segment.startTime = runtime::Timespan::FromNanoseconds(generator.Next(length));
+        // Some segments are empty or reversed and must never be found
+        const int64_t duration = generator.Next(10 * runtime::Timespan::NANOSECONDS_PER_SECOND) - 1000;
+        segment.endTime        = segment.startTime + runtime::Timespan::FromNanoseconds(duration);
+        segments.push_back(EntityHandle<TranscriptTag>::Make(segment));
+    }
+    Contributor host{};
+    for (int i = 0; i < 20; ++i) {
+        const int64_t start = generator.Next(length);
+        const int64_t end   = start + generator.Next(length / 10);
+        host.presence.push_back(ContributorPresence{runtime::Timespan::FromNanoseconds(start), runtime::Timespan::FromNanoseconds(end)});
+    }
+    Episode episode{};
+    const EntityHandle<Contributor> handle = EntityHandle<Contributor>::Make(host);
+    episode.contributors.push_back(Contribution{handle, runtime::String("host"), runtime::String()});
+    // A second role of the same contributor adds no ranges
+    episode.contributors.push_back(Contribution{handle, runtime::String("editor"), runtime::String()});
+
+    const TimelineIndex index(episode, chapters, segments);
+    std::vector<TimelineEntry> all;
+    index.Find(runtime::Timespan::FromNanoseconds(INT64_MIN), runtime::Timespan::FromNanoseconds(INT64_MAX), all);
+    P3_CHECK(all.size() == index.GetCount());
+    P3_CHECK(IsOrdered(all));
+    for (const TimelineEntry& entry : all) {
+        P3_CHECK(entry.endTime > entry.startTime);
+    }
+
+    std::vector<TimelineEntry> found;
+    for (int query = 0; query < 500; ++query) {
+        const int64_t time = generator.Next(length + length / 10) - length / 20;
+        found.clear();
+        index.Find(runtime::Timespan::FromNanoseconds(time), found);
+        P3_CHECK(IsOrdered(found));
+        P3_CHECK(Keys(found) == Scan(all, time, time + 1));
+
+        const int64_t until = time + generator.Next(length / 5);
+        found.clear();
+        index.Find(runtime::Timespan::FromNanoseconds(time), runtime::Timespan::FromNanoseconds(until), found);
+        P3_CHECK(IsOrdered(found));
+        P3_CHECK(Keys(found) == Scan(all, time, until));
+    }
+
+    // Boundaries: a range contains its start and not its end
+    for (const TimelineEntry& entry : all) {
+        found.clear();
+        index.Find(entry.startTime, found);
+        const std::vector<Key> atStart = Keys(found);
+        P3_CHECK(std::binary_search(atStart.begin(), atStart.end(), MakeKey(entry)));
+        found.clear();
+        index.Find(entry.endTime, found);
+        const std::vector<Key> atEnd = Keys(found);
+        P3_CHECK(std::binary_search(atEnd.begin(), atEnd.end(), MakeKey(entry)) == false);
+    }
+}
+
+void TestEmpty()
+{
+    const TimelineIndex index;
+    std::vector<TimelineEntry> found;
+    P3_CHECK(index.GetCount() == 0);
+    P3_CHECK(index.Find(runtime::Timespan::FromSeconds(1), found) == 0);
+}
+} // namespace
+
+int main()
+{
+    TestEmpty();
+    Generator generator;
+    // Sizes around powers of two exercise the incomplete right edge of the implicit tree
+    for (const size_t count : {1uz, 2uz, 3uz, 15uz, 16uz, 17uz, 100uz, 1023uz, 1500uz}) {
+        TestAgainstScan(count, count, generator);
+    }
+    return ultralove::p3::tests::Finish("modeltimelineindextest");
+}
@@ -0,0 +1,130 @@
+///
+// \file runtimeparsingtest.cpp
+// \brief Tests of the date, duration and seconds parsers
+// \details Round trips and boundaries of Timestamp, Timespan and parsing::ParseSeconds
+//
+
+#include "runtimeparsing.h"
+#include "runtimetimespan.h"
+#include "runtimetimestamp.h"
+#include "testing.h"
+
+#include <string_view>
+
+namespace {
+namespace runtime = ultralove::p3::runtime;
+
+std::string_view FormatRfc822(const runtime::Timestamp& timestamp, char* buffer)
+{
+    return std::string_view(buffer, timestamp.FormatRfc822(buffer, runtime::Timestamp::RFC822_LENGTH));
+}
+
+std::string_view FormatIso8601(const runtime::Timestamp& timestamp, char* buffer)
+{
+    return std::string_view(buffer, timestamp.FormatIso8601(buffer, runtime::Timestamp::ISO8601_MAX_LENGTH));
+}
+
+void TestTimestamp()
+{
+    char buffer[runtime::Timestamp::ISO8601_MAX_LENGTH];
+
+    const auto pubDate = runtime::Timestamp::ParseRfc822("Wed, 02 Oct 2002 13:00:00 GMT");
+    P3_CHECK(pubDate.has_value() && (pubDate->GetSeconds() == 1033563600));
+    P3_CHECK(pubDate.has_value() && (FormatRfc822(*pubDate, buffer) == "Wed, 02 Oct 2002 13:00:00 +0000"));
+
+    const auto zoned = runtime::Timestamp::ParseRfc822("2 Oct 02 15:00 +0200");
+    P3_CHECK(zoned.has_value() && (*zoned == *pubDate) && (zoned->GetOffsetMinutes() == 120));
+    P3_CHECK(runtime::Timestamp::ParseRfc822("Wed, 02 Oct 2002 13:00:00 EDT")->GetSeconds() == 1033563600 + 4 * 3600);
+
+    const auto iso = runtime::Timestamp::ParseIso8601("2002-10-02T15:00:00.25+02:00");
+    P3_CHECK(iso.has_value() && (iso->GetMicroseconds() == 1033563600250000) && (iso->GetOffsetMinutes() == 120));
+    P3_CHECK(iso.has_value() && (FormatIso8601(*iso, buffer) == "2002-10-02T15:00:00.250000+02:00"));
+    P3_CHECK(runtime::Timestamp::ParseIso8601("2002-10-02")->GetSeconds() == 1033516800);
+    P3_CHECK(FormatIso8601(runtime::Timestamp::FromSeconds(0), buffer) == "1970-01-01T00:00:00Z");
+
+    // Every format parses back to the instant and offset it was written from, a day inside the range
+    // keeps the local date inside it for every offset
+    const int64_t first = -62167219200 + 86400;
+    const int64_t last  = runtime::Timestamp::MAX_MICROSECONDS / 1000000 - 86400;
+    for (int64_t seconds = first; seconds < last; seconds += 7777777) {
+        const runtime::Timestamp timestamp = runtime::Timestamp::FromSeconds(seconds, static_cast<int>(seconds % 57) * 15);
+        const auto fromRfc822              = runtime::Timestamp::ParseRfc822(FormatRfc822(timestamp, buffer));
+        P3_CHECK(fromRfc822.has_value() && (*fromRfc822 == timestamp) && (fromRfc822->GetOffsetMinutes() == timestamp.GetOffsetMinutes()));
+        const auto fromIso8601 = runtime::Timestamp::ParseIso8601(FormatIso8601(timestamp, buffer));
+        P3_CHECK(fromIso8601.has_value() && (*fromIso8601 == timestamp));
+    }
+
+    // The instant covers the year 0000 up to May 4253, later dates do not fit and are rejected
+    P3_CHECK(runtime::Timestamp::ParseIso8601("0000-01-01T00:00:00Z")->GetSeconds() == -62167219200);
+    P3_CHECK(FormatIso8601(runtime::Timestamp::ParseIso8601("0000-01-01T00:00:00Z").value(), buffer) == "0000-01-01T00:00:00Z");
+    const runtime::Timestamp latest = runtime::Timestamp::FromMicroseconds(runtime::Timestamp::MAX_MICROSECONDS);
+    P3_CHECK(FormatIso8601(latest, buffer) == "4253-05-31T22:20:37.927935Z");
+    P3_CHECK(runtime::Timestamp::ParseIso8601("4253-05-31T22:20:37.927935Z") == latest);
+    P3_CHECK(runtime::Timestamp::ParseIso8601("4253-05-31T22:20:38Z").has_value() == false);
+    P3_CHECK(runtime::Timestamp::ParseIso8601("4254-01-01T00:00:00Z").has_value() == false);
+    P3_CHECK(runtime::Timestamp::ParseIso8601("9999-12-31T23:59:59Z").has_value() == false);
+    P3_CHECK(runtime::Timestamp::ParseRfc822("Fri, 31 Dec 9999 23:59:59 GMT").has_value() == false);
+    P3_CHECK(runtime::Timestamp::FromMicroseconds(INT64_MAX).GetMicroseconds() == runtime::Timestamp::MAX_MICROSECONDS);
+    P3_CHECK(runtime::Timestamp::FromSeconds(INT64_MIN).GetMicroseconds() == runtime::Timestamp::MIN_MICROSECONDS);
+
+    P3_CHECK(runtime::Timestamp::ParseIso8601("2002-02-30").has_value() == false);
+    P3_CHECK(runtime::Timestamp::ParseIso8601("2002-10-02T24:00:01Z").has_value() == false);
+    P3_CHECK(runtime::Timestamp::ParseRfc822("Wed, 32 Oct 2002 13:00:00 GMT").has_value() == false);
+    P3_CHECK(runtime::Timestamp::ParseRfc822("").has_value() == false);
+}
+
+void TestTimespan()
+{
+    char buffer[runtime::Timespan::FORMAT_MAX_LENGTH];
+
+    P3_CHECK(runtime::Timespan::Parse("01:02:03.456") == runtime::Timespan::FromMilliseconds(3723456));
+    P3_CHECK(runtime::Timespan::Parse("00:00:05,250") == runtime::Timespan::FromMilliseconds(5250));
+    P3_CHECK(runtime::Timespan::Parse("70:00") == runtime::Timespan::FromMinutes(70));
+    P3_CHECK(runtime::Timespan::Parse("3723") == runtime::Timespan::FromSeconds(3723));
+    P3_CHECK(runtime::Timespan::Parse("0.000000001") == runtime::Timespan::FromNanoseconds(1));
+    P3_CHECK(runtime::Timespan::Parse("").has_value() == false);
+    P3_CHECK(runtime::Timespan::Parse("1:2:3:4").has_value() == false);
+    P3_CHECK(runtime::Timespan::Parse("12:60").has_value() == false);
+    P3_CHECK(runtime::Timespan::Parse("99999999999999999999").has_value() == false);
+
+    const runtime::Timespan span = runtime::Timespan::FromMilliseconds(3723456);
+    P3_CHECK(std::string_view(buffer, span.FormatClock(buffer, sizeof(buffer))) == "01:02:03");
+    P3_CHECK(std::string_view(buffer, span.FormatWebVtt(buffer, sizeof(buffer))) == "01:02:03.456");
+    P3_CHECK(std::string_view(buffer, span.FormatSrt(buffer, sizeof(buffer))) == "01:02:03,456");
+    for (int64_t milliseconds = 0; milliseconds < 400000000; milliseconds += 1234567) {
+        const runtime::Timespan value = runtime::Timespan::FromMilliseconds(milliseconds);
+        P3_CHECK(runtime::Timespan::Parse(std::string_view(buffer, value.FormatWebVtt(buffer, sizeof(buffer)))) == value);
+        P3_CHECK(runtime::Timespan::Parse(std::string_view(buffer, value.FormatSrt(buffer, sizeof(buffer)))) == value);
+    }
+}
+
+void TestParseSeconds()
+{
+    using runtime::parsing::ParseSeconds;
+
+    P3_CHECK(ParseSeconds("12.5") == runtime::Timespan::FromMilliseconds(12500));
+    P3_CHECK(ParseSeconds("-3") == runtime::Timespan::FromSeconds(-3));
+    P3_CHECK(ParseSeconds("1e3") == runtime::Timespan::FromSeconds(1000));
+    P3_CHECK(ParseSeconds("0.1234567891") == runtime::Timespan::FromNanoseconds(123456789));
+    P3_CHECK(ParseSeconds("9223372036") == runtime::Timespan::FromSeconds(9223372036));
+
+    // The whole text must be one number
+    P3_CHECK(ParseSeconds("").has_value() == false);
+    P3_CHECK(ParseSeconds("-").has_value() == false);
+    P3_CHECK(ParseSeconds("12.").has_value() == false);
+    P3_CHECK(ParseSeconds("1.5.3").has_value() == false);
+    P3_CHECK(ParseSeconds("12.5abc").has_value() == false);
+    P3_CHECK(ParseSeconds("12abc").has_value() == false);
+    P3_CHECK(ParseSeconds("1.5e").has_value() == false);
+    P3_CHECK(ParseSeconds("9223372037").has_value() == false);
+    P3_CHECK(ParseSeconds("1e300").has_value() == false);
+}
+} // namespace
+
+int main()
+{
+    TestTimestamp();
+    TestTimespan();
+    TestParseSeconds();
+    return ultralove::p3::tests::Finish("runtimeparsingtest");
+}
@@ -0,0 +1,102 @@
+///
+// \file runtimetextdictionarytest.cpp
+// \brief Tests of the text compression dictionary
+// \details Compress and decompress round trips with and without a trained dictionary
+//
+
+#include "runtimetextdictionary.h"
+#include "testing.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+namespace runtime = ultralove::p3::runtime;
+
+bool RoundTrips(const runtime::TextDictionary& dictionary, const std::string_view value)
+{
+    std::string encoded;
+    dictionary.Compress(value, encoded);
+    if (value.size() > runtime::TextDictionary::GetMaxDecodedLength(encoded.size())) {
+        return false;
+    }
+    std::string decoded(value.size(), '\0');
+    return dictionary.Decompress(encoded, decoded.data(), decoded.size()) && (decoded == value) &&
+           (runtime::TextDictionary::Decompress(dictionary.GetContent(), encoded, decoded.data(), decoded.size())) && (decoded == value);
+}
+
+std::vector<std::string> MakeShowNotes()
+{
+    const std::string sponsor = "This episode is brought to you by Example Hosting, the hosting platform for podcasters who care. ";
+    const std::string footer  = "Follow us on https://social.example/@show and support the show at https://support.example/show.";
+    std::vector<std::string> notes;
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (int i = 0; i < 64; ++i) {
+        std::string note = "Episode " + std::to_string(i) + ": ";
+        for (int word = 0; word < 40 + i; ++word) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            note += static_cast<char>('a' + state % 26);
+            note += static_cast<char>('a' + (state >> 8) % 26);
+            note += ' ';
+        }
+        notes.push_back(((i % 3) != 0) ? sponsor + note + footer : note);
+    }
+    return notes;
+}
+
+void TestWithoutDictionary()
+{
+    const runtime::TextDictionary empty;
+    P3_CHECK(empty.GetSize() == 0);
+    P3_CHECK(RoundTrips(empty, ""));
+    P3_CHECK(RoundTrips(empty, "a"));
+    P3_CHECK(RoundTrips(empty, "abcabcabcabcabcabcabcabcabcabcabcabcabc"));
+    P3_CHECK(RoundTrips(empty, std::string(100000, 'x')));
+    P3_CHECK(RoundTrips(empty, std::string_view("\0binary\0\xff\xfe", 10)));
+}
+
+void TestTrainedDictionary()
+{
+    const std::vector<std::string> notes = MakeShowNotes();
+    const std::vector<std::string_view> samples(notes.begin(), notes.end());
+    const runtime::TextDictionary dictionary = runtime::TextDictionary::Train(samples, 4096);
+    P3_CHECK((dictionary.GetSize() > 0) && (dictionary.GetSize() <= 4096));
+
+    size_t raw    = 0;
+    size_t stored = 0;
+    for (const std::string& note : notes) {
+        P3_CHECK(RoundTrips(dictionary, note));
+        std::string encoded;
+        dictionary.Compress(note, encoded);
+        raw += note.size();
+        stored += encoded.size();
+    }
+    // The sponsor read and the footer are in the dictionary, so the notes must shrink
+    P3_CHECK(stored < raw);
+
+    // A dictionary loaded from its content decodes what the trained one encoded
+    const runtime::TextDictionary loaded(dictionary.GetContent());
+    std::string encoded;
+    dictionary.Compress(notes[1], encoded);
+    std::string decoded(notes[1].size(), '\0');
+    P3_CHECK(loaded.Decompress(encoded, decoded.data(), decoded.size()) && (decoded == notes[1]));
+
+    // A wrong length or a cut value fails instead of producing partial output
+    P3_CHECK(loaded.Decompress(encoded, decoded.data(), decoded.size() - 1) == false);
+    P3_CHECK(loaded.Decompress(std::string_view(encoded).substr(0, encoded.size() / 2), decoded.data(), decoded.size()) == false);
+
+    // Samples without shared passages train an empty dictionary
+    P3_CHECK(runtime::TextDictionary::Train({"abcdefghijkl", "mnopqrstuvwx"}).GetSize() == 0);
+}
+} // namespace
+
+int main()
+{
+    TestWithoutDictionary();
+    TestTrainedDictionary();
+    return ultralove::p3::tests::Finish("runtimetextdictionarytest");
+}
@@ -0,0 +1,47 @@
+///
+// \file testing.h
+// \brief Test support for the P3 Model library
+// \details Checks that report a failure and keep going; every test program returns nonzero if one failed
+//
+#ifndef __P3_TESTS_TESTING_H_INCL__
+#define __P3_TESTS_TESTING_H_INCL__
+
+#include <cstdio>
+
+namespace ultralove::p3::tests {
+/// \brief Number of failed checks of the running test program
+inline int g_failures = 0;
+
+/// \brief Report a failed check
+/// \param file Source file of the check
+/// \param line Line of the check
+/// \param expression Text of the expression that did not hold
+inline void Fail(const char* file, const int line, const char* expression) noexcept
+{
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    ++g_failures;
+}
+
+/// \brief Report the outcome of a test program
+/// \param name Name of the test program
+/// \return Exit code of the test program
+inline int Finish(const char* name) noexcept
+{
+    if (g_failures > 0) {
+        std::fprintf(stderr, "%s: %d check(s) failed\n", name, g_failures);
+        return 1;
+    }
+    std::printf("%s: passed\n", name);
+    return 0;
+}
+} // namespace ultralove::p3::tests
+
+/// \brief Check that an expression holds, reporting it and continuing if it does not
+#define P3_CHECK(expression)                                                      \
+    do {                                                                          \
+        if (static_cast<bool>(expression) == false) {                             \
+            ultralove::p3::tests::Fail(__FILE__, __LINE__, #expression);          \
+        }                                                                         \
+    } while (false)
+
+#endif // __P3_TESTS_TESTING_H_INCL__